@@ -4,11 +4,27 @@
 
 #include "cpusupport.h"
 #include "crc32c_arm.h"
+#include "crc32c_pclmul.h"
+#include "crc32c_pmull.h"
 #include "crc32c_sse42.h"
+#include "crc32c_vpclmul.h"
+#include "hwaccel.h"
+#include "sysendian.h"
 #include "warnp.h"
 
 #include "crc32c.h"
 
+/* The folding code also uses the CRC32 instructions. */
+#if defined(CPUSUPPORT_X86_PCLMUL) && defined(CPUSUPPORT_X86_SSE42_64)
+#define HWACCEL_X86_PCLMUL
+#if defined(CPUSUPPORT_X86_VPCLMUL)
+#define HWACCEL_X86_VPCLMUL
+#endif
+#endif
+#if defined(CPUSUPPORT_ARM_PMULL) && defined(CPUSUPPORT_ARM_CRC32_64)
+#define HWACCEL_ARM_PMULL
+#endif
+
 #if defined(CPUSUPPORT_X86_SSE42) || defined(CPUSUPPORT_ARM_CRC32_64)
 #define HWACCEL
 
@@ -17,8 +33,17 @@ static enum {
 #if defined(CPUSUPPORT_X86_SSE42)
 	HW_X86_CRC32,
 #endif
+#if defined(HWACCEL_X86_PCLMUL)
+	HW_X86_PCLMUL,
+#endif
+#if defined(HWACCEL_X86_VPCLMUL)
+	HW_X86_VPCLMUL,
+#endif
 #if defined(CPUSUPPORT_ARM_CRC32_64)
 	HW_ARM_CRC32_64,
+#endif
+#if defined(HWACCEL_ARM_PMULL)
+	HW_ARM_PMULL,
 #endif
 	HW_UNSET
 } hwaccel = HW_UNSET;
@@ -26,19 +51,42 @@ static enum {
 
 /**
  * CRC32C tables:
- * T[0][i] = reverse32(reverse8(i) * x^32 mod p(x) mod 2)
- * T[1][i] = reverse32(reverse8(i) * x^40 mod p(x) mod 2)
- * T[2][i] = reverse32(reverse8(i) * x^48 mod p(x) mod 2)
- * T[3][i] = reverse32(reverse8(i) * x^56 mod p(x) mod 2)
+ * T[k][i] = reverse32(reverse8(i) * x^(32 + 8 * k) mod p(x) mod 2)
+ * for k = 0 ... 15; T[k] accounts for a byte which is followed by k more
+ * bytes in a block.  Blocks of 16, 8, or 4 bytes are processed at once using
+ * T[0..15], T[0..7], or T[0..3] ("slicing-by-16", etc.).
  */
-static uint32_t T0[256];
-static uint32_t T1[256];
-static uint32_t T2[256];
-static uint32_t T3[256];
+static uint32_t T[16][256];
 
 /* Optimization: Precomputed value of T[0][0x80]. */
 #define T_0_0x80 0x82f63b78
 
+#ifdef HWACCEL
+/**
+ * Large buffers are split into three blocks of LONGBLK or SHORTBLK bytes,
+ * the CRCs of which are computed in parallel and then combined using the
+ * shift tables
+ * TL[j][i] = reverse32(reverse8(i) * x^(8 * j + 8 * LONGBLK) mod p(x) mod 2)
+ * TS[j][i] = reverse32(reverse8(i) * x^(8 * j + 8 * SHORTBLK) mod p(x) mod 2)
+ * which advance a CRC state past LONGBLK or SHORTBLK zero bytes.
+ */
+#define LONGBLK 8192
+#define SHORTBLK 256
+
+/* Smaller buffers aren't worth splitting into three streams. */
+#define LARGE_MIN (3 * SHORTBLK + 16)
+
+/*
+ * Buffers of at least FOLD_MIN (or FOLD512_MIN) bytes are processed by
+ * folding 64-byte (or 256-byte) blocks with carry-less multiplication, if
+ * available; below these sizes the CRC32 instructions are faster.
+ */
+#define FOLD_MIN 128
+#define FOLD512_MIN 256
+static uint32_t TL[4][256];
+static uint32_t TS[4][256];
+#endif
+
 /**
  * reverse(x):
  * Return x with reversed bit-order.
@@ -72,6 +120,68 @@ times256(uint32_t r)
 	return (r);
 }
 
+/**
+ * multmodp(a, b):
+ * Return a(x) * b(x) mod p(x), where the polynomials are represented in
+ * reversed bit-order (i.e., with the x^0 coefficient in the high bit).
+ */
+static uint32_t
+multmodp(uint32_t a, uint32_t b)
+{
+	uint32_t p = 0;
+	int k;
+
+	/* Add b(x) * x^k for each term x^k of a(x). */
+	for (k = 0; k < 32; k++) {
+		if (a & 0x80000000)
+			p ^= b;
+		a <<= 1;
+
+		/* Multiply b(x) by x. */
+		if (b & 1)
+			b = (b >> 1) ^ 0x82f63b78;
+		else
+			b = (b >> 1);
+	}
+
+	return (p);
+}
+
+/**
+ * xpow8n(n):
+ * Return x^(8 * n) mod p(x), in reversed bit-order.
+ */
+static uint32_t
+xpow8n(size_t n)
+{
+	uint32_t r = 0x80000000;	/* x^0 */
+	uint32_t s = 0x00800000;	/* x^8 */
+
+	/* Square-and-multiply. */
+	for (; n > 0; n >>= 1) {
+		if (n & 1)
+			r = multmodp(r, s);
+		s = multmodp(s, s);
+	}
+
+	return (r);
+}
+
+#ifdef HWACCEL
+/**
+ * shift(T, state):
+ * Return the CRC32C state obtained by feeding zero bytes into ${state}, where
+ * the number of zero bytes is the one ${T} was built for.
+ */
+static uint32_t
+shift(uint32_t T[4][256], uint32_t state)
+{
+
+	return (T[0][state & 0xff] ^ T[1][(state >> 8) & 0xff] ^
+	    T[2][(state >> 16) & 0xff] ^ T[3][state >> 24]);
+}
+#endif /* HWACCEL */
+
 /**
  * init(void):
  * Initialize tables.
@@ -81,22 +191,192 @@ init(void)
 {
 	size_t i;
 	uint32_t r;
+	int k;
+#ifdef HWACCEL
+	uint32_t xl, xs;
+	int j;
+#endif
 
 	/* Fill in tables. */
 	for (i = 0; i < 256; i++) {
 		r = reverse((uint32_t)i);
-		T0[i] = reverse(r = times256(r));
-		T1[i] = reverse(r = times256(r));
-		T2[i] = reverse(r = times256(r));
-		T3[i] = reverse(r = times256(r));
-
-		(void)r; /* r is not used beyond this point. */
+		for (k = 0; k < 16; k++)
+			T[k][i] = reverse(r = times256(r));
 	}
 
 	/* Make sure we optimized correctly. */
-	assert(T0[0x80] == T_0_0x80);
+	assert(T[0][0x80] == T_0_0x80);
+
+#ifdef HWACCEL
+	/* Fill in shift tables. */
+	xl = xpow8n(LONGBLK);
+	xs = xpow8n(SHORTBLK);
+	for (j = 0; j < 4; j++) {
+		for (i = 0; i < 256; i++) {
+			TL[j][i] = multmodp(xl, (uint32_t)i << (8 * j));
+			TS[j][i] = multmodp(xs, (uint32_t)i << (8 * j));
+		}
+	}
+#endif
+}
+
+/**
+ * update_sw(state, buf, len):
+ * Feed ${len} bytes from the buffer ${buf} into the CRC32C whose state is
+ * ${state}, using the tables, and return the new state.
+ */
+static uint32_t
+update_sw(uint32_t state, const uint8_t * buf, size_t len)
+{
+
+	/* Handle blocks of 16 bytes. */
+	for (; len >= 16; len -= 16, buf += 16) {
+		state =
+		    T[0][buf[15]] ^ T[1][buf[14]] ^
+		    T[2][buf[13]] ^ T[3][buf[12]] ^
+		    T[4][buf[11]] ^ T[5][buf[10]] ^
+		    T[6][buf[9]]  ^ T[7][buf[8]] ^
+		    T[8][buf[7]]  ^ T[9][buf[6]] ^
+		    T[10][buf[5]] ^ T[11][buf[4]] ^
+		    T[12][((state >> 24) & 0xff) ^ buf[3]] ^
+		    T[13][((state >> 16) & 0xff) ^ buf[2]] ^
+		    T[14][((state >> 8)  & 0xff) ^ buf[1]] ^
+		    T[15][((state)       & 0xff) ^ buf[0]];
+	}
+
+	/* Handle a block of 8 bytes. */
+	if (len >= 8) {
+		state =
+		    T[0][buf[7]] ^ T[1][buf[6]] ^
+		    T[2][buf[5]] ^ T[3][buf[4]] ^
+		    T[4][((state >> 24) & 0xff) ^ buf[3]] ^
+		    T[5][((state >> 16) & 0xff) ^ buf[2]] ^
+		    T[6][((state >> 8)  & 0xff) ^ buf[1]] ^
+		    T[7][((state)       & 0xff) ^ buf[0]];
+		len -= 8;
+		buf += 8;
+	}
+
+	/* Handle a block of 4 bytes. */
+	if (len >= 4) {
+		state =
+		    T[0][((state >> 24) & 0xff) ^ buf[3]] ^
+		    T[1][((state >> 16) & 0xff) ^ buf[2]] ^
+		    T[2][((state >> 8)  & 0xff) ^ buf[1]] ^
+		    T[3][((state)       & 0xff) ^ buf[0]];
+		len -= 4;
+		buf += 4;
+	}
+
+	/* Handle individual bytes. */
+	for (; len > 0; len--, buf++)
+		state = (state >> 8) ^ T[0][((state) & 0xff) ^ buf[0]];
+
+	return (state);
 }
 
+#ifdef HWACCEL
+/**
+ * update_large(state, buf, len, update, update3):
+ * Feed ${len} bytes from the buffer ${buf} into the CRC32C whose state is
+ * ${state}, using the single-stream hardware function ${update} and the
+ * three-stream hardware function ${update3}, and return the new state.  The
+ * length ${len} must be at least LARGE_MIN.
+ */
+static uint32_t
+update_large(uint32_t state, const uint8_t * buf, size_t len,
+    uint32_t (* update)(uint32_t, const uint8_t *, size_t),
+    void (* update3)(uint32_t[3], const uint8_t *, size_t))
+{
+	uint32_t s[3];
+	size_t pre;
+
+	/* Sanity check. */
+	assert(len >= LARGE_MIN);
+
+	/* Advance to an 8-byte boundary (using at least 8 bytes). */
+	pre = 8 + ((8 - ((uintptr_t)buf & 7)) & 7);
+	state = update(state, buf, pre);
+	buf += pre;
+	len -= pre;
+
+	/*
+	 * Process three blocks at once, leaving at least 8 bytes for the
+	 * single-stream function.  The first block continues from the
+	 * current state; the others start from zero, since the CRC state is
+	 * linear and we add them in after shifting.
+	 */
+	for (; len >= 3 * LONGBLK + 8; len -= 3 * LONGBLK) {
+		s[0] = state;
+		s[1] = s[2] = 0;
+		update3(s, buf, LONGBLK);
+		state = shift(TL, shift(TL, s[0]) ^ s[1]) ^ s[2];
+		buf += 3 * LONGBLK;
+	}
+	for (; len >= 3 * SHORTBLK + 8; len -= 3 * SHORTBLK) {
+		s[0] = state;
+		s[1] = s[2] = 0;
+		update3(s, buf, SHORTBLK);
+		state = shift(TS, shift(TS, s[0]) ^ s[1]) ^ s[2];
+		buf += 3 * SHORTBLK;
+	}
+
+	/* Handle whatever is left. */
+	return (update(state, buf, len));
+}
+
+/**
+ * update_fold(state, buf, len, fold, blklen, update):
+ * Feed ${len} bytes from the buffer ${buf} into the CRC32C whose state is
+ * ${state}, using the folding function ${fold} for as many ${blklen}-byte
+ * blocks as possible and the single-stream hardware function ${update} for
+ * the rest, and return the new state.  The length ${len} must be at least
+ * ${blklen}.
+ */
+static uint32_t
+update_fold(uint32_t state, const uint8_t * buf, size_t len,
+    uint32_t (* fold)(uint32_t, const uint8_t *, size_t), size_t blklen,
+    uint32_t (* update)(uint32_t, const uint8_t *, size_t))
+{
+	size_t n = len - (len % blklen);
+
+	/* Sanity check. */
+	assert(n > 0);
+
+	/* Fold whole blocks. */
+	state = fold(state, buf, n);
+	buf += n;
+	len -= n;
+
+	/* Handle whatever is left. */
+	if (len >= 8)
+		return (update(state, buf, len));
+	else
+		return (update_sw(state, buf, len));
+}
+
+/**
+ * update_hw(state, buf, len, update, update3):
+ * Feed ${len} bytes from the buffer ${buf} into the CRC32C whose state is
+ * ${state}, using the single-stream hardware function ${update} and the
+ * three-stream hardware function ${update3} if the buffer is long enough to
+ * benefit from them, and return the new state.
+ */
+static uint32_t
+update_hw(uint32_t state, const uint8_t * buf, size_t len,
+    uint32_t (* update)(uint32_t, const uint8_t *, size_t),
+    void (* update3)(uint32_t[3], const uint8_t *, size_t))
+{
+
+	if (len >= LARGE_MIN)
+		return (update_large(state, buf, len, update, update3));
+	else if (len >= 8)
+		return (update(state, buf, len));
+	else
+		return (update_sw(state, buf, len));
+}
+#endif
+
 #ifdef HWACCEL
 static struct crc32_test {
 	const char * buf;
@@ -107,46 +387,97 @@ static struct crc32_test {
 };
 
 /*
- * Test whether hardware extensions and software code produce the same results.
+ * Test whether hardware extensions and software code produce the same results,
+ * using the single-stream function ${update}, the three-stream function
+ * ${update3}, and (if non-NULL) the folding function ${fold} which operates on
+ * ${blklen}-byte blocks.
  */
 static int
-hwtest(void)
+hwtest(uint32_t (* update)(uint32_t, const uint8_t *, size_t),
+    void (* update3)(uint32_t[3], const uint8_t *, size_t),
+    uint32_t (* fold)(uint32_t, const uint8_t *, size_t), size_t blklen)
 {
+	uint8_t buf[3 * SHORTBLK + 100];
 	uint32_t state = T_0_0x80;
+	uint32_t state_sw;
+	size_t i;
 
 	/* Test hardware transform function. */
-#if defined(CPUSUPPORT_X86_SSE42)
-	state = CRC32C_Update_SSE42(state, (const uint8_t *)testcase.buf,
+	state = update(state, (const uint8_t *)testcase.buf,
 	    strlen(testcase.buf));
-#elif defined(CPUSUPPORT_ARM_CRC32_64)
-	state = CRC32C_Update_ARM(state, (const uint8_t *)testcase.buf,
-	    strlen(testcase.buf));
-#endif
 
 	/* Is the output correct? */
-	return (memcmp(&state, testcase.crc, 4));
+	if (memcmp(&state, testcase.crc, 4))
+		return (1);
+
+	/* Compute the CRC of a misaligned buffer in software. */
+	for (i = 0; i < sizeof(buf); i++)
+		buf[i] = (uint8_t)(i * i + 7);
+	state_sw = update_sw(T_0_0x80, &buf[1], sizeof(buf) - 1);
+
+	/* Test the three-stream code. */
+	if (update_large(T_0_0x80, &buf[1], sizeof(buf) - 1, update,
+	    update3) != state_sw)
+		return (1);
+
+	/* Test the folding code. */
+	if ((fold != NULL) && (update_fold(T_0_0x80, &buf[1],
+	    sizeof(buf) - 1, fold, blklen, update) != state_sw))
+		return (1);
+
+	/* Success! */
+	return (0);
 }
 
+/* Time a CRC using the implementation ${id}; defined below. */
+static void hwbench(int);
+
 /* Which type of hardware acceleration should we use, if any? */
 static void
 hwaccel_init(void)
 {
+	struct hwaccel_choice C;
 
 	/* If we've already set hwaccel, we're finished. */
 	if (hwaccel != HW_UNSET)
 		return;
 
-	/* Default to software. */
+	/* Use software while we test the alternatives. */
 	hwaccel = HW_SOFTWARE;
-
+	hwaccel_begin(&C, "crc32c");
+
+#if defined(HWACCEL_X86_VPCLMUL)
+	HWACCEL_OFFER(&C, HW_X86_VPCLMUL, "x86-vpclmul",
+	    cpusupport_x86_vpclmul() && cpusupport_x86_pclmul() &&
+	    cpusupport_x86_sse42(),
+	    hwtest(CRC32C_Update_SSE42, CRC32C_Update3_SSE42,
+	    CRC32C_Update_VPCLMUL, 256));
+#endif
+#if defined(HWACCEL_X86_PCLMUL)
+	HWACCEL_OFFER(&C, HW_X86_PCLMUL, "x86-pclmul",
+	    cpusupport_x86_pclmul() && cpusupport_x86_sse42(),
+	    hwtest(CRC32C_Update_SSE42, CRC32C_Update3_SSE42,
+	    CRC32C_Update_PCLMUL, 64));
+#endif
 #if defined(CPUSUPPORT_X86_SSE42)
-	CPUSUPPORT_VALIDATE(hwaccel, HW_X86_CRC32, cpusupport_x86_sse42(),
-	    hwtest());
+	HWACCEL_OFFER(&C, HW_X86_CRC32, "x86-crc32", cpusupport_x86_sse42(),
+	    hwtest(CRC32C_Update_SSE42, CRC32C_Update3_SSE42, NULL, 0));
+#endif
+#if defined(HWACCEL_ARM_PMULL)
+	HWACCEL_OFFER(&C, HW_ARM_PMULL, "arm-pmull",
+	    cpusupport_arm_pmull() && cpusupport_arm_crc32_64(),
+	    hwtest(CRC32C_Update_ARM, CRC32C_Update3_ARM,
+	    CRC32C_Update_PMULL, 64));
 #endif
 #if defined(CPUSUPPORT_ARM_CRC32_64)
-	CPUSUPPORT_VALIDATE(hwaccel, HW_ARM_CRC32_64, cpusupport_arm_crc32_64(),
-	    hwtest());
+	HWACCEL_OFFER(&C, HW_ARM_CRC32_64, "arm-crc32",
+	    cpusupport_arm_crc32_64(),
+	    hwtest(CRC32C_Update_ARM, CRC32C_Update3_ARM, NULL, 0));
 #endif
+	hwaccel_offer(&C, HW_SOFTWARE, "software");
+
+	/* Pick one. */
+	hwaccel = hwaccel_choose(&C, hwbench);
 }
 #endif /* HWACCEL */
 
@@ -183,34 +514,81 @@ void
 CRC32C_Update(CRC32C_CTX * ctx, const uint8_t * buf, size_t len)
 {
 
+#ifdef HWACCEL
+	/*
+	 * Pick a function based on the length: each case uses the widest
+	 * folding code the buffer is long enough for, and otherwise the same
+	 * functions as the next-best option.
+	 */
+	switch (hwaccel) {
+#if defined(HWACCEL_X86_VPCLMUL)
+	case HW_X86_VPCLMUL:
+		if (len >= FOLD512_MIN)
+			ctx->state = update_fold(ctx->state, buf, len,
+			    CRC32C_Update_VPCLMUL, 256, CRC32C_Update_SSE42);
+		else if (len >= FOLD_MIN)
+			ctx->state = update_fold(ctx->state, buf, len,
+			    CRC32C_Update_PCLMUL, 64, CRC32C_Update_SSE42);
+		else
+			ctx->state = update_hw(ctx->state, buf, len,
+			    CRC32C_Update_SSE42, CRC32C_Update3_SSE42);
+		return;
+#endif
+#if defined(HWACCEL_X86_PCLMUL)
+	case HW_X86_PCLMUL:
+		if (len >= FOLD_MIN)
+			ctx->state = update_fold(ctx->state, buf, len,
+			    CRC32C_Update_PCLMUL, 64, CRC32C_Update_SSE42);
+		else
+			ctx->state = update_hw(ctx->state, buf, len,
+			    CRC32C_Update_SSE42, CRC32C_Update3_SSE42);
+		return;
+#endif
 #if defined(CPUSUPPORT_X86_SSE42)
-	if ((len >= 8) && (hwaccel == HW_X86_CRC32)) {
-		ctx->state = CRC32C_Update_SSE42(ctx->state, buf, len);
+	case HW_X86_CRC32:
+		ctx->state = update_hw(ctx->state, buf, len,
+		    CRC32C_Update_SSE42, CRC32C_Update3_SSE42);
+		return;
+#endif
+#if defined(HWACCEL_ARM_PMULL)
+	case HW_ARM_PMULL:
+		if (len >= FOLD_MIN)
+			ctx->state = update_fold(ctx->state, buf, len,
+			    CRC32C_Update_PMULL, 64, CRC32C_Update_ARM);
+		else
+			ctx->state = update_hw(ctx->state, buf, len,
+			    CRC32C_Update_ARM, CRC32C_Update3_ARM);
 		return;
-	}
 #endif
 #if defined(CPUSUPPORT_ARM_CRC32_64)
-	if ((len >= 8) && (hwaccel == HW_ARM_CRC32_64)) {
-		ctx->state = CRC32C_Update_ARM(ctx->state, buf, len);
+	case HW_ARM_CRC32_64:
+		ctx->state = update_hw(ctx->state, buf, len,
+		    CRC32C_Update_ARM, CRC32C_Update3_ARM);
 		return;
+#endif
+	case HW_SOFTWARE:
+	case HW_UNSET:
+		break;
 	}
 #endif
 
-	/* Handle blocks of 4 bytes. */
-	for (; len >= 4; len -= 4, buf += 4) {
-		ctx->state =
-		    T0[((ctx->state >> 24) & 0xff) ^ buf[3]] ^
-		    T1[((ctx->state >> 16) & 0xff) ^ buf[2]] ^
-		    T2[((ctx->state >> 8)  & 0xff) ^ buf[1]] ^
-		    T3[((ctx->state)       & 0xff) ^ buf[0]];
-	}
+	/* Use the tables. */
+	ctx->state = update_sw(ctx->state, buf, len);
+}
 
-	/* Handle individual bytes. */
-	for (; len > 0; len--, buf++) {
-		ctx->state = (ctx->state >> 8) ^
-		    T0[((ctx->state) & 0xff) ^ buf[0]];
-	}
+#ifdef HWACCEL
+/* Compute the CRC32C of 16 kB of data using the implementation ${id}. */
+static void
+hwbench(int id)
+{
+	static const uint8_t buf[16384];
+	CRC32C_CTX ctx;
+
+	hwaccel = id;
+	ctx.state = T_0_0x80;
+	CRC32C_Update(&ctx, buf, sizeof(buf));
 }
+#endif
 
 /**
  * CRC32C_Final(cbuf, ctx):
@@ -229,3 +607,26 @@ CRC32C_Final(uint8_t cbuf[4], CRC32C_CTX * ctx)
 	cbuf[2] = (ctx->state >> 16) & 0xff;
 	cbuf[3] = (ctx->state >> 24) & 0xff;
 }
+
+/**
+ * CRC32C_Combine(cbufA, cbufB, lenB, cbuf):
+ * Given the values ${cbufA} and ${cbufB} stored by CRC32C_Final for buffers
+ * A and B, where B is ${lenB} bytes long, store in ${cbuf} the value which
+ * CRC32C_Final would store for the concatenation of A and B.
+ */
+void
+CRC32C_Combine(const uint8_t cbufA[4], const uint8_t cbufB[4], size_t lenB,
+    uint8_t cbuf[4])
+{
+	uint32_t stateA = le32dec(cbufA);
+	uint32_t stateB = le32dec(cbufB);
+
+	/*
+	 * The state is linear in the initial state and the data, so feeding
+	 * B into stateA gives stateB plus the effect of having started from
+	 * stateA rather than the initial state; and that effect is the
+	 * difference of the two starting states advanced by ${lenB} zero
+	 * bytes, i.e., multiplied by x^(8 * lenB).
+	 */
+	le32enc(cbuf, multmodp(xpow8n(lenB), stateA ^ T_0_0x80) ^ stateB);
+}
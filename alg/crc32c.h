@@ -35,4 +35,12 @@ void CRC32C_Update(CRC32C_CTX *, const uint8_t *, size_t);
  */
 void CRC32C_Final(uint8_t[4], CRC32C_CTX *);
 
+/**
+ * CRC32C_Combine(cbufA, cbufB, lenB, cbuf):
+ * Given the values ${cbufA} and ${cbufB} stored by CRC32C_Final for buffers
+ * A and B, where B is ${lenB} bytes long, store in ${cbuf} the value which
+ * CRC32C_Final would store for the concatenation of A and B.
+ */
+void CRC32C_Combine(const uint8_t[4], const uint8_t[4], size_t, uint8_t[4]);
+
 #endif /* !_CRC32C_H_ */
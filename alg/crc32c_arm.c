@@ -67,4 +67,45 @@ CRC32C_Update_ARM(uint32_t state, const uint8_t * buf, size_t len)
 	return (state);
 }
 
+/**
+ * CRC32C_Update3_ARM(state, buf, blocklen):
+ * Feed the three consecutive ${blocklen}-byte blocks starting at ${buf} into
+ * the three CRC32Cs whose states are ${state}[0], ${state}[1], and
+ * ${state}[2] respectively, interleaving the three computations.  This
+ * implementation uses ARM CRC32 instructions, and should only be used if
+ * CPUSUPPORT_ARM_CRC32_64 is defined and cpusupport_arm_crc32() returns
+ * nonzero.  ${buf} must be 8-byte aligned and ${blocklen} must be a multiple
+ * of 8.
+ */
+void
+CRC32C_Update3_ARM(uint32_t state[3], const uint8_t * buf, size_t blocklen)
+{
+	const uint8_t * buf0 = &buf[0];
+	const uint8_t * buf1 = &buf[blocklen];
+	const uint8_t * buf2 = &buf[2 * blocklen];
+	uint32_t s0 = state[0];
+	uint32_t s1 = state[1];
+	uint32_t s2 = state[2];
+	size_t i;
+
+	/* Sanity test. */
+	assert((((uintptr_t)buf) & 7) == 0);
+	assert((blocklen % 8) == 0);
+
+	/*
+	 * The CRC32 instructions are pipelined, so three independent streams
+	 * keep them busy where one would stall on each result.
+	 */
+	for (i = 0; i < blocklen; i += 8) {
+		s0 = __crc32cd(s0, *(const uint64_t *)(&buf0[i]));
+		s1 = __crc32cd(s1, *(const uint64_t *)(&buf1[i]));
+		s2 = __crc32cd(s2, *(const uint64_t *)(&buf2[i]));
+	}
+
+	/* Return the new states. */
+	state[0] = s0;
+	state[1] = s1;
+	state[2] = s2;
+}
+
 #endif /* CPUSUPPORT_ARM_CRC32_64 */
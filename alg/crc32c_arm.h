@@ -13,4 +13,16 @@
  */
 uint32_t CRC32C_Update_ARM(uint32_t, const uint8_t *, size_t);
 
+/**
+ * CRC32C_Update3_ARM(state, buf, blocklen):
+ * Feed the three consecutive ${blocklen}-byte blocks starting at ${buf} into
+ * the three CRC32Cs whose states are ${state}[0], ${state}[1], and
+ * ${state}[2] respectively, interleaving the three computations.  This
+ * implementation uses ARM CRC32 instructions, and should only be used if
+ * CPUSUPPORT_ARM_CRC32_64 is defined and cpusupport_arm_crc32() returns
+ * nonzero.  ${buf} must be 8-byte aligned and ${blocklen} must be a multiple
+ * of 8.
+ */
+void CRC32C_Update3_ARM(uint32_t[3], const uint8_t *, size_t);
+
 #endif /* !_CRC32C_ARM_H_ */
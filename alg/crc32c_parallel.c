@@ -0,0 +1,102 @@
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "crc32c.h"
+#include "warnp.h"
+#include "workshare.h"
+
+#include "crc32c_parallel.h"
+
+/*
+ * Don't give a thread less than this many bytes; below this, the cost of
+ * starting a thread outweighs the time spent computing the CRC.
+ */
+#define MINSHARE 65536
+
+/* A share of the buffer. */
+struct crc32c_share {
+	const uint8_t * buf;
+	size_t len;
+	uint8_t cbuf[4];
+};
+
+/* Compute the CRC32C of a share of the buffer. */
+static void *
+workthread(void * cookie)
+{
+	struct crc32c_share * S = cookie;
+	CRC32C_CTX ctx;
+
+	CRC32C_Init(&ctx);
+	CRC32C_Update(&ctx, S->buf, S->len);
+	CRC32C_Final(S->cbuf, &ctx);
+
+	return (NULL);
+}
+
+/**
+ * CRC32C_Buf_parallel(buf, len, cbuf, nthreads):
+ * Compute the CRC32C of ${len} bytes from ${buf} and store in ${cbuf} the
+ * value which CRC32C_Final would store, splitting the buffer into pieces
+ * which are processed by up to ${nthreads} threads (including the calling
+ * thread) and combining the results.  Return 0 on success or -1 on error.
+ */
+int
+CRC32C_Buf_parallel(const uint8_t * buf, size_t len, uint8_t cbuf[4],
+    size_t nthreads)
+{
+	struct crc32c_share * shares;
+	CRC32C_CTX ctx;
+	size_t i, pos;
+
+	/*
+	 * Initialize the CRC32C code (and pick which hardware acceleration
+	 * to use) before starting any threads.
+	 */
+	CRC32C_Init(&ctx);
+
+	/* There's no point having threads with very little work to do. */
+	if (nthreads > len / MINSHARE)
+		nthreads = len / MINSHARE;
+	if (nthreads <= 1) {
+		CRC32C_Update(&ctx, buf, len);
+		CRC32C_Final(cbuf, &ctx);
+		return (0);
+	}
+
+	/* Allocate and divide up the work. */
+	if ((shares = calloc(nthreads, sizeof(struct crc32c_share))) == NULL) {
+		warnp("calloc");
+		goto err0;
+	}
+	for (i = pos = 0; i < nthreads; i++) {
+		shares[i].buf = &buf[pos];
+		shares[i].len = workshare_len(len, nthreads, i);
+		pos += shares[i].len;
+	}
+
+	/*
+	 * Compute the CRC32C of each share; if this fails, threads might
+	 * still be running, so leak their state.
+	 */
+	if (workshare_run(workthread, shares, sizeof(struct crc32c_share),
+	    nthreads))
+		goto err0;
+
+	/* Combine the CRCs of the shares. */
+	memcpy(cbuf, shares[0].cbuf, 4);
+	for (i = 1; i < nthreads; i++)
+		CRC32C_Combine(cbuf, shares[i].cbuf, shares[i].len, cbuf);
+
+	/* Clean up. */
+	free(shares);
+
+	/* Success! */
+	return (0);
+
+err0:
+	/* Failure! */
+	return (-1);
+}
@@ -0,0 +1,16 @@
+#ifndef _CRC32C_PARALLEL_H_
+#define _CRC32C_PARALLEL_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * CRC32C_Buf_parallel(buf, len, cbuf, nthreads):
+ * Compute the CRC32C of ${len} bytes from ${buf} and store in ${cbuf} the
+ * value which CRC32C_Final would store, splitting the buffer into pieces
+ * which are processed by up to ${nthreads} threads (including the calling
+ * thread) and combining the results.  Return 0 on success or -1 on error.
+ */
+int CRC32C_Buf_parallel(const uint8_t *, size_t, uint8_t[4], size_t);
+
+#endif /* !_CRC32C_PARALLEL_H_ */
@@ -0,0 +1,80 @@
+#include "cpusupport.h"
+#if defined(CPUSUPPORT_X86_PCLMUL) && defined(CPUSUPPORT_X86_SSE42_64)
+/**
+ * CPUSUPPORT CFLAGS: X86_PCLMUL X86_SSE42_64
+ */
+
+#include <assert.h>
+#include <stdint.h>
+
+#include <smmintrin.h>
+#include <wmmintrin.h>
+
+#include "crc32c_pclmul.h"
+
+/**
+ * Folding constants: K(D) = reverse32(x^(D - 1) mod p(x)) << 32.  Folding a
+ * 16-byte value forward by D bits multiplies its first 8 bytes by K(D + 64)
+ * and its last 8 bytes by K(D); each pair is stored as { K(D + 64), K(D) }.
+ */
+#define K_512 _mm_set_epi64x(0x75bba45b00000000, 0x1c19243b00000000)
+#define K_384 _mm_set_epi64x(0x6051243f00000000, 0xa46ef4aa00000000)
+#define K_256 _mm_set_epi64x(0xa2158b3400000000, 0x33ccbbbc00000000)
+#define K_128 _mm_set_epi64x(0x3171d43000000000, 0x3743f7bd00000000)
+
+/* Fold x forward by the distance for which k was computed. */
+#define FOLD(x, k)						\
+	_mm_xor_si128(_mm_clmulepi64_si128(x, k, 0x00),		\
+	    _mm_clmulepi64_si128(x, k, 0x11))
+
+/**
+ * CRC32C_Update_PCLMUL(state, buf, len):
+ * Feed ${len} bytes from the buffer ${buf} into the CRC32C whose state is
+ * ${state}, by folding 64-byte blocks with carry-less multiplication.  This
+ * implementation uses x86 PCLMULQDQ and SSE4.2 instructions, and should only
+ * be used if CPUSUPPORT_X86_PCLMUL and CPUSUPPORT_X86_SSE42_64 are defined
+ * and cpusupport_x86_pclmul() and cpusupport_x86_sse42() return nonzero.
+ * ${len} must be a nonzero multiple of 64.
+ */
+uint32_t
+CRC32C_Update_PCLMUL(uint32_t state, const uint8_t * buf, size_t len)
+{
+	const __m128i * p = (const __m128i *)buf;
+	const __m128i k512 = K_512;
+	__m128i x0, x1, x2, x3;
+	uint64_t crc;
+
+	/* Sanity test. */
+	assert((len > 0) && ((len % 64) == 0));
+
+	/*
+	 * Load the first block.  Adding the state into the first 4 bytes
+	 * turns this into computing a CRC from a zero state.
+	 */
+	x0 = _mm_xor_si128(_mm_loadu_si128(&p[0]),
+	    _mm_cvtsi32_si128((int)state));
+	x1 = _mm_loadu_si128(&p[1]);
+	x2 = _mm_loadu_si128(&p[2]);
+	x3 = _mm_loadu_si128(&p[3]);
+
+	/* Fold each block into the next one. */
+	for (p += 4, len -= 64; len > 0; p += 4, len -= 64) {
+		x0 = _mm_xor_si128(FOLD(x0, k512), _mm_loadu_si128(&p[0]));
+		x1 = _mm_xor_si128(FOLD(x1, k512), _mm_loadu_si128(&p[1]));
+		x2 = _mm_xor_si128(FOLD(x2, k512), _mm_loadu_si128(&p[2]));
+		x3 = _mm_xor_si128(FOLD(x3, k512), _mm_loadu_si128(&p[3]));
+	}
+
+	/* Fold the four 16-byte pieces of the last block into one. */
+	x3 = _mm_xor_si128(x3, FOLD(x0, K_384));
+	x3 = _mm_xor_si128(x3, FOLD(x1, K_256));
+	x3 = _mm_xor_si128(x3, FOLD(x2, K_128));
+
+	/* The CRC of the remaining 16 bytes is the CRC of the input. */
+	crc = _mm_crc32_u64(0, (uint64_t)_mm_cvtsi128_si64(x3));
+	crc = _mm_crc32_u64(crc, (uint64_t)_mm_extract_epi64(x3, 1));
+
+	return ((uint32_t)crc);
+}
+
+#endif /* CPUSUPPORT_X86_PCLMUL && CPUSUPPORT_X86_SSE42_64 */
@@ -0,0 +1,18 @@
+#ifndef _CRC32C_PCLMUL_H_
+#define _CRC32C_PCLMUL_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * CRC32C_Update_PCLMUL(state, buf, len):
+ * Feed ${len} bytes from the buffer ${buf} into the CRC32C whose state is
+ * ${state}, by folding 64-byte blocks with carry-less multiplication.  This
+ * implementation uses x86 PCLMULQDQ and SSE4.2 instructions, and should only
+ * be used if CPUSUPPORT_X86_PCLMUL and CPUSUPPORT_X86_SSE42_64 are defined
+ * and cpusupport_x86_pclmul() and cpusupport_x86_sse42() return nonzero.
+ * ${len} must be a nonzero multiple of 64.
+ */
+uint32_t CRC32C_Update_PCLMUL(uint32_t, const uint8_t *, size_t);
+
+#endif /* !_CRC32C_PCLMUL_H_ */
@@ -0,0 +1,89 @@
+#include "cpusupport.h"
+#if defined(CPUSUPPORT_ARM_PMULL) && defined(CPUSUPPORT_ARM_CRC32_64)
+/**
+ * CPUSUPPORT CFLAGS: ARM_CRC32_64 ARM_PMULL
+ */
+
+#include <assert.h>
+#include <stdint.h>
+
+#ifdef __ARM_NEON
+#include <arm_neon.h>
+#endif
+
+#ifdef __ARM_ACLE
+#include <arm_acle.h>
+#endif
+
+#include "crc32c_pmull.h"
+
+/**
+ * Folding constants: K(D) = reverse32(x^(D - 1) mod p(x)) << 32.  Folding a
+ * 16-byte value forward by D bits multiplies its first 8 bytes by K(D + 64)
+ * and its last 8 bytes by K(D); each pair is stored as { K(D + 64), K(D) }.
+ */
+static const uint64_t K_512[2] = {0x1c19243b00000000, 0x75bba45b00000000};
+static const uint64_t K_384[2] = {0xa46ef4aa00000000, 0x6051243f00000000};
+static const uint64_t K_256[2] = {0x33ccbbbc00000000, 0xa2158b3400000000};
+static const uint64_t K_128[2] = {0x3743f7bd00000000, 0x3171d43000000000};
+
+/* Fold x forward by the distance for which k was computed. */
+#define FOLD(x, k)							\
+	veorq_u8(vreinterpretq_u8_p128(vmull_p64(			\
+	    vgetq_lane_p64(vreinterpretq_p64_u8(x), 0),			\
+	    vgetq_lane_p64(k, 0))),					\
+	    vreinterpretq_u8_p128(vmull_high_p64(			\
+	    vreinterpretq_p64_u8(x), k)))
+
+/**
+ * CRC32C_Update_PMULL(state, buf, len):
+ * Feed ${len} bytes from the buffer ${buf} into the CRC32C whose state is
+ * ${state}, by folding 64-byte blocks with carry-less multiplication.  This
+ * implementation uses ARM PMULL and CRC32 instructions, and should only be
+ * used if CPUSUPPORT_ARM_PMULL and CPUSUPPORT_ARM_CRC32_64 are defined and
+ * cpusupport_arm_pmull() and cpusupport_arm_crc32_64() return nonzero.
+ * ${len} must be a nonzero multiple of 64.
+ */
+uint32_t
+CRC32C_Update_PMULL(uint32_t state, const uint8_t * buf, size_t len)
+{
+	const poly64x2_t k512 = vreinterpretq_p64_u64(vld1q_u64(K_512));
+	uint8x16_t x0, x1, x2, x3;
+	uint64x2_t x;
+	uint32_t crc;
+
+	/* Sanity test. */
+	assert((len > 0) && ((len % 64) == 0));
+
+	/*
+	 * Load the first block.  Adding the state into the first 4 bytes
+	 * turns this into computing a CRC from a zero state.
+	 */
+	x0 = veorq_u8(vld1q_u8(&buf[0]),
+	    vreinterpretq_u8_u32(vsetq_lane_u32(state, vdupq_n_u32(0), 0)));
+	x1 = vld1q_u8(&buf[16]);
+	x2 = vld1q_u8(&buf[32]);
+	x3 = vld1q_u8(&buf[48]);
+
+	/* Fold each block into the next one. */
+	for (buf += 64, len -= 64; len > 0; buf += 64, len -= 64) {
+		x0 = veorq_u8(FOLD(x0, k512), vld1q_u8(&buf[0]));
+		x1 = veorq_u8(FOLD(x1, k512), vld1q_u8(&buf[16]));
+		x2 = veorq_u8(FOLD(x2, k512), vld1q_u8(&buf[32]));
+		x3 = veorq_u8(FOLD(x3, k512), vld1q_u8(&buf[48]));
+	}
+
+	/* Fold the four 16-byte pieces of the last block into one. */
+	x3 = veorq_u8(x3, FOLD(x0, vreinterpretq_p64_u64(vld1q_u64(K_384))));
+	x3 = veorq_u8(x3, FOLD(x1, vreinterpretq_p64_u64(vld1q_u64(K_256))));
+	x3 = veorq_u8(x3, FOLD(x2, vreinterpretq_p64_u64(vld1q_u64(K_128))));
+
+	/* The CRC of the remaining 16 bytes is the CRC of the input. */
+	x = vreinterpretq_u64_u8(x3);
+	crc = __crc32cd(0, vgetq_lane_u64(x, 0));
+	crc = __crc32cd(crc, vgetq_lane_u64(x, 1));
+
+	return (crc);
+}
+
+#endif /* CPUSUPPORT_ARM_PMULL && CPUSUPPORT_ARM_CRC32_64 */
@@ -0,0 +1,18 @@
+#ifndef _CRC32C_PMULL_H_
+#define _CRC32C_PMULL_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * CRC32C_Update_PMULL(state, buf, len):
+ * Feed ${len} bytes from the buffer ${buf} into the CRC32C whose state is
+ * ${state}, by folding 64-byte blocks with carry-less multiplication.  This
+ * implementation uses ARM PMULL and CRC32 instructions, and should only be
+ * used if CPUSUPPORT_ARM_PMULL and CPUSUPPORT_ARM_CRC32_64 are defined and
+ * cpusupport_arm_pmull() and cpusupport_arm_crc32_64() return nonzero.
+ * ${len} must be a nonzero multiple of 64.
+ */
+uint32_t CRC32C_Update_PMULL(uint32_t, const uint8_t *, size_t);
+
+#endif /* !_CRC32C_PMULL_H_ */
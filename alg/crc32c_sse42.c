@@ -78,4 +78,54 @@ CRC32C_Update_SSE42(uint32_t state, const uint8_t * buf, size_t len)
 	return (state);
 }
 
+/**
+ * CRC32C_Update3_SSE42(state, buf, blocklen):
+ * Feed the three consecutive ${blocklen}-byte blocks starting at ${buf} into
+ * the three CRC32Cs whose states are ${state}[0], ${state}[1], and
+ * ${state}[2] respectively, interleaving the three computations.  This
+ * implementation uses x86 SSE4.2 instructions, and should only be used if
+ * CPUSUPPORT_X86_SSE42 is defined and cpusupport_x86_sse42() returns nonzero.
+ * ${buf} must be 8-byte aligned and ${blocklen} must be a multiple of 8.
+ */
+void
+CRC32C_Update3_SSE42(uint32_t state[3], const uint8_t * buf, size_t blocklen)
+{
+	const uint8_t * buf0 = &buf[0];
+	const uint8_t * buf1 = &buf[blocklen];
+	const uint8_t * buf2 = &buf[2 * blocklen];
+	uint32_t s0 = state[0];
+	uint32_t s1 = state[1];
+	uint32_t s2 = state[2];
+	size_t i;
+
+	/* Sanity test. */
+	assert((((uintptr_t)buf) & 7) == 0);
+	assert((blocklen % 8) == 0);
+
+	/*
+	 * The CRC32 instruction has a latency of 3 cycles but a throughput
+	 * of one per cycle, so three independent streams keep it busy.
+	 */
+	for (i = 0; i < blocklen; i += 8) {
+#ifdef CPUSUPPORT_X86_SSE42_64
+		s0 = (uint32_t)_mm_crc32_u64(s0, *(const uint64_t *)&buf0[i]);
+		s1 = (uint32_t)_mm_crc32_u64(s1, *(const uint64_t *)&buf1[i]);
+		s2 = (uint32_t)_mm_crc32_u64(s2, *(const uint64_t *)&buf2[i]);
+#else
+		/* Only process 32 bits at once. */
+		s0 = _mm_crc32_u32(s0, *(const uint32_t *)&buf0[i]);
+		s1 = _mm_crc32_u32(s1, *(const uint32_t *)&buf1[i]);
+		s2 = _mm_crc32_u32(s2, *(const uint32_t *)&buf2[i]);
+		s0 = _mm_crc32_u32(s0, *(const uint32_t *)&buf0[i + 4]);
+		s1 = _mm_crc32_u32(s1, *(const uint32_t *)&buf1[i + 4]);
+		s2 = _mm_crc32_u32(s2, *(const uint32_t *)&buf2[i + 4]);
+#endif
+	}
+
+	/* Return the new states. */
+	state[0] = s0;
+	state[1] = s1;
+	state[2] = s2;
+}
+
 #endif /* CPUSUPPORT_X86_SSE42 */
@@ -14,4 +14,15 @@
  */
 uint32_t CRC32C_Update_SSE42(uint32_t, const uint8_t *, size_t);
 
+/**
+ * CRC32C_Update3_SSE42(state, buf, blocklen):
+ * Feed the three consecutive ${blocklen}-byte blocks starting at ${buf} into
+ * the three CRC32Cs whose states are ${state}[0], ${state}[1], and
+ * ${state}[2] respectively, interleaving the three computations.  This
+ * implementation uses x86 SSE4.2 instructions, and should only be used if
+ * CPUSUPPORT_X86_SSE42 is defined and cpusupport_x86_sse42() returns nonzero.
+ * ${buf} must be 8-byte aligned and ${blocklen} must be a multiple of 8.
+ */
+void CRC32C_Update3_SSE42(uint32_t[3], const uint8_t *, size_t);
+
 #endif /* !_CRC32C_SSE42_H_ */
@@ -0,0 +1,104 @@
+#include "cpusupport.h"
+#if defined(CPUSUPPORT_X86_VPCLMUL) && defined(CPUSUPPORT_X86_PCLMUL) && \
+    defined(CPUSUPPORT_X86_SSE42_64)
+/**
+ * CPUSUPPORT CFLAGS: X86_VPCLMUL X86_PCLMUL X86_SSE42_64
+ */
+
+#include <assert.h>
+#include <stdint.h>
+
+#include <immintrin.h>
+
+#include "crc32c_vpclmul.h"
+
+/**
+ * Folding constants: K(D) = reverse32(x^(D - 1) mod p(x)) << 32.  Folding a
+ * 16-byte value forward by D bits multiplies its first 8 bytes by K(D + 64)
+ * and its last 8 bytes by K(D); each pair is stored as { K(D + 64), K(D) }.
+ */
+#define K_2048 _mm_set_epi64x(0x1426a81500000000, 0xe9a5d8be00000000)
+#define K_1536 _mm_set_epi64x(0x31c9460800000000, 0x7ccbbbf200000000)
+#define K_1024 _mm_set_epi64x(0x7417153f00000000, 0x6577b24500000000)
+#define K_512 _mm_set_epi64x(0x75bba45b00000000, 0x1c19243b00000000)
+#define K_384 _mm_set_epi64x(0x6051243f00000000, 0xa46ef4aa00000000)
+#define K_256 _mm_set_epi64x(0xa2158b3400000000, 0x33ccbbbc00000000)
+#define K_128 _mm_set_epi64x(0x3171d43000000000, 0x3743f7bd00000000)
+
+/* Fold each 16-byte lane of z forward by the distance k was computed for. */
+#define FOLD512(z, k)						\
+	_mm512_xor_si512(_mm512_clmulepi64_epi128(z, k, 0x00),	\
+	    _mm512_clmulepi64_epi128(z, k, 0x11))
+#define FOLD(x, k)						\
+	_mm_xor_si128(_mm_clmulepi64_si128(x, k, 0x00),		\
+	    _mm_clmulepi64_si128(x, k, 0x11))
+
+/**
+ * CRC32C_Update_VPCLMUL(state, buf, len):
+ * Feed ${len} bytes from the buffer ${buf} into the CRC32C whose state is
+ * ${state}, by folding 256-byte blocks with carry-less multiplication.  This
+ * implementation uses x86 AVX-512 VPCLMULQDQ, PCLMULQDQ, and SSE4.2
+ * instructions, and should only be used if CPUSUPPORT_X86_VPCLMUL,
+ * CPUSUPPORT_X86_PCLMUL, and CPUSUPPORT_X86_SSE42_64 are defined and
+ * cpusupport_x86_vpclmul(), cpusupport_x86_pclmul(), and
+ * cpusupport_x86_sse42() return nonzero.  ${len} must be a nonzero multiple
+ * of 256.
+ */
+uint32_t
+CRC32C_Update_VPCLMUL(uint32_t state, const uint8_t * buf, size_t len)
+{
+	const __m512i k2048 = _mm512_broadcast_i32x4(K_2048);
+	__m512i z0, z1, z2, z3;
+	__m128i x0, x1, x2, x3;
+	uint64_t crc;
+
+	/* Sanity test. */
+	assert((len > 0) && ((len % 256) == 0));
+
+	/*
+	 * Load the first block.  Adding the state into the first 4 bytes
+	 * turns this into computing a CRC from a zero state.
+	 */
+	z0 = _mm512_xor_si512(_mm512_loadu_si512(&buf[0]),
+	    _mm512_zextsi128_si512(_mm_cvtsi32_si128((int)state)));
+	z1 = _mm512_loadu_si512(&buf[64]);
+	z2 = _mm512_loadu_si512(&buf[128]);
+	z3 = _mm512_loadu_si512(&buf[192]);
+
+	/* Fold each block into the next one. */
+	for (buf += 256, len -= 256; len > 0; buf += 256, len -= 256) {
+		z0 = _mm512_xor_si512(FOLD512(z0, k2048),
+		    _mm512_loadu_si512(&buf[0]));
+		z1 = _mm512_xor_si512(FOLD512(z1, k2048),
+		    _mm512_loadu_si512(&buf[64]));
+		z2 = _mm512_xor_si512(FOLD512(z2, k2048),
+		    _mm512_loadu_si512(&buf[128]));
+		z3 = _mm512_xor_si512(FOLD512(z3, k2048),
+		    _mm512_loadu_si512(&buf[192]));
+	}
+
+	/* Fold the four 64-byte pieces of the last block into one. */
+	z3 = _mm512_xor_si512(z3,
+	    FOLD512(z0, _mm512_broadcast_i32x4(K_1536)));
+	z3 = _mm512_xor_si512(z3,
+	    FOLD512(z1, _mm512_broadcast_i32x4(K_1024)));
+	z3 = _mm512_xor_si512(z3,
+	    FOLD512(z2, _mm512_broadcast_i32x4(K_512)));
+
+	/* Fold the four 16-byte pieces of that into one. */
+	x0 = _mm512_extracti32x4_epi32(z3, 0);
+	x1 = _mm512_extracti32x4_epi32(z3, 1);
+	x2 = _mm512_extracti32x4_epi32(z3, 2);
+	x3 = _mm512_extracti32x4_epi32(z3, 3);
+	x3 = _mm_xor_si128(x3, FOLD(x0, K_384));
+	x3 = _mm_xor_si128(x3, FOLD(x1, K_256));
+	x3 = _mm_xor_si128(x3, FOLD(x2, K_128));
+
+	/* The CRC of the remaining 16 bytes is the CRC of the input. */
+	crc = _mm_crc32_u64(0, (uint64_t)_mm_cvtsi128_si64(x3));
+	crc = _mm_crc32_u64(crc, (uint64_t)_mm_extract_epi64(x3, 1));
+
+	return ((uint32_t)crc);
+}
+
+#endif /* CPUSUPPORT_X86_VPCLMUL && _PCLMUL && _SSE42_64 */
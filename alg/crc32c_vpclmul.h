@@ -0,0 +1,20 @@
+#ifndef _CRC32C_VPCLMUL_H_
+#define _CRC32C_VPCLMUL_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * CRC32C_Update_VPCLMUL(state, buf, len):
+ * Feed ${len} bytes from the buffer ${buf} into the CRC32C whose state is
+ * ${state}, by folding 256-byte blocks with carry-less multiplication.  This
+ * implementation uses x86 AVX-512 VPCLMULQDQ, PCLMULQDQ, and SSE4.2
+ * instructions, and should only be used if CPUSUPPORT_X86_VPCLMUL,
+ * CPUSUPPORT_X86_PCLMUL, and CPUSUPPORT_X86_SSE42_64 are defined and
+ * cpusupport_x86_vpclmul(), cpusupport_x86_pclmul(), and
+ * cpusupport_x86_sse42() return nonzero.  ${len} must be a nonzero multiple
+ * of 256.
+ */
+uint32_t CRC32C_Update_VPCLMUL(uint32_t, const uint8_t *, size_t);
+
+#endif /* !_CRC32C_VPCLMUL_H_ */
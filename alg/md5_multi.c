@@ -0,0 +1,187 @@
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "cpusupport.h"
+#include "md5.h"
+#include "md5_multi_avx2.h"
+#include "md5_multi_avx512f.h"
+#include "md5_multi_sse2.h"
+#include "multilane.h"
+#include "warnp.h"
+
+#include "md5_multi.h"
+
+/* Number of part hashes which MD5_ETag_multipart computes at once. */
+#define ETAG_BATCH 64
+
+#if defined(CPUSUPPORT_X86_SSE2) ||					\
+    defined(CPUSUPPORT_X86_AVX2) ||					\
+    defined(CPUSUPPORT_X86_AVX512F)
+#define HWACCEL
+
+static enum {
+	HW_SOFTWARE = 0,
+#if defined(CPUSUPPORT_X86_SSE2)
+	HW_X86_SSE2,
+#endif
+#if defined(CPUSUPPORT_X86_AVX2)
+	HW_X86_AVX2,
+#endif
+#if defined(CPUSUPPORT_X86_AVX512F)
+	HW_X86_AVX512F,
+#endif
+	HW_UNSET
+} hwaccel = HW_UNSET;
+
+/* Initial state of each message. */
+static const uint32_t initial_state[4] = {
+	0x67452301, 0xEFCDAB89, 0x98BADCFE, 0x10325476
+};
+
+/* MD5, for the lane scheduler. */
+static const struct multilane_alg md5_alg = {
+	.nwords = 4,
+	.initial_state = initial_state,
+	.bigendian = 0
+};
+
+/* Hash the ${n} messages using ${func}, which handles ${nlanes} at once. */
+static void
+multi(multilane_transform func, size_t nlanes, const uint8_t * const * in,
+    const size_t * len, uint8_t (* digests)[16], size_t n)
+{
+
+	multilane_hash(&md5_alg, func, nlanes, in, len, (uint8_t *)digests, n,
+	    SIZE_MAX);
+}
+
+/*
+ * Test whether hashing a set of messages of awkward lengths with ${func}
+ * gives the same results as hashing them one at a time.  Must be called
+ * with (hwaccel == HW_SOFTWARE).
+ */
+static int
+hwtest(multilane_transform func, size_t nlanes)
+{
+	uint8_t buf[256];
+	const uint8_t * in[19];
+	size_t len[19] = {0, 1, 55, 56, 63, 64, 65, 119, 120, 256, 3,
+	    128, 200, 17, 0, 64, 250, 100, 7};
+	uint8_t digests_sw[19][16];
+	uint8_t digests_hw[19][16];
+	size_t i;
+
+	/* Test case: Messages which are prefixes of 0x00 0x01 0x02 ... */
+	for (i = 0; i < 256; i++)
+		buf[i] = (uint8_t)i;
+	for (i = 0; i < 19; i++)
+		in[i] = buf;
+
+	/* Hash the messages one at a time. */
+	for (i = 0; i < 19; i++)
+		MD5_Buf(in[i], len[i], digests_sw[i]);
+
+	/* Hash the messages several at a time. */
+	multi(func, nlanes, in, len, digests_hw, 19);
+
+	/* Do the results match? */
+	return (memcmp(digests_sw, digests_hw, sizeof(digests_sw)));
+}
+
+/* Which type of hardware acceleration should we use, if any? */
+static void
+hwaccel_init(void)
+{
+
+	/* If we've already set hwaccel, we're finished. */
+	if (hwaccel != HW_UNSET)
+		return;
+
+	/* Default to software. */
+	hwaccel = HW_SOFTWARE;
+
+#if defined(CPUSUPPORT_X86_AVX512F)
+	CPUSUPPORT_VALIDATE(hwaccel, HW_X86_AVX512F, cpusupport_x86_avx512f(),
+	    hwtest(MD5_Transform_multi_avx512f, 16));
+#endif
+#if defined(CPUSUPPORT_X86_AVX2)
+	CPUSUPPORT_VALIDATE(hwaccel, HW_X86_AVX2, cpusupport_x86_avx2(),
+	    hwtest(MD5_Transform_multi_avx2, 8));
+#endif
+#if defined(CPUSUPPORT_X86_SSE2)
+	CPUSUPPORT_VALIDATE(hwaccel, HW_X86_SSE2, cpusupport_x86_sse2(),
+	    hwtest(MD5_Transform_multi_sse2, 4));
+#endif
+}
+#endif /* HWACCEL */
+
+/**
+ * MD5_Buf_multi(in, len, digests, n):
+ * Compute the MD5 hashes of the ${n} independent messages ${in}[i] of lengths
+ * ${len}[i], writing the hash of message i into ${digests}[i].  When SIMD
+ * hardware is available, 4, 8, or 16 messages are hashed at once.
+ */
+void
+MD5_Buf_multi(const uint8_t * const * in, const size_t * len,
+    uint8_t (* digests)[16], size_t n)
+{
+	size_t i;
+
+#ifdef HWACCEL
+	/* Pick the best implementation. */
+	hwaccel_init();
+
+	/* Hash the messages several at a time. */
+	switch (hwaccel) {
+#if defined(CPUSUPPORT_X86_AVX512F)
+	case HW_X86_AVX512F:
+		multi(MD5_Transform_multi_avx512f, 16, in, len, digests, n);
+		return;
+#endif
+#if defined(CPUSUPPORT_X86_AVX2)
+	case HW_X86_AVX2:
+		multi(MD5_Transform_multi_avx2, 8, in, len, digests, n);
+		return;
+#endif
+#if defined(CPUSUPPORT_X86_SSE2)
+	case HW_X86_SSE2:
+		multi(MD5_Transform_multi_sse2, 4, in, len, digests, n);
+		return;
+#endif
+	case HW_SOFTWARE:
+	case HW_UNSET:
+		break;
+	}
+#endif
+
+	/* Hash the messages one at a time. */
+	for (i = 0; i < n; i++)
+		MD5_Buf(in[i], len[i], digests[i]);
+}
+
+/**
+ * MD5_ETag_multipart(parts, lens, nparts, digest):
+ * Compute the MD5 hash of the concatenated MD5 hashes of the ${nparts} parts
+ * ${parts}[i] of lengths ${lens}[i], and write it to ${digest}.  This is the
+ * digest used in the ETag of an S3 multipart upload, which is the hex
+ * encoding of ${digest} followed by "-${nparts}".  The parts are hashed
+ * several at a time using MD5_Buf_multi.
+ */
+void
+MD5_ETag_multipart(const uint8_t * const * parts, const size_t * lens,
+    size_t nparts, uint8_t digest[16])
+{
+	MD5_CTX ctx;
+	uint8_t partdigests[ETAG_BATCH][16];
+	size_t i, n;
+
+	/* Hash the parts in batches, and feed the hashes to the outer MD5. */
+	MD5_Init(&ctx);
+	for (i = 0; i < nparts; i += n) {
+		n = (nparts - i < ETAG_BATCH) ? nparts - i : ETAG_BATCH;
+		MD5_Buf_multi(&parts[i], &lens[i], partdigests, n);
+		MD5_Update(&ctx, partdigests, n * 16);
+	}
+	MD5_Final(digest, &ctx);
+}
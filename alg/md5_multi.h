@@ -0,0 +1,27 @@
+#ifndef _MD5_MULTI_H_
+#define _MD5_MULTI_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * MD5_Buf_multi(in, len, digests, n):
+ * Compute the MD5 hashes of the ${n} independent messages ${in}[i] of lengths
+ * ${len}[i], writing the hash of message i into ${digests}[i].  When SIMD
+ * hardware is available, 4, 8, or 16 messages are hashed at once.
+ */
+void MD5_Buf_multi(const uint8_t * const *, const size_t *, uint8_t (*)[16],
+    size_t);
+
+/**
+ * MD5_ETag_multipart(parts, lens, nparts, digest):
+ * Compute the MD5 hash of the concatenated MD5 hashes of the ${nparts} parts
+ * ${parts}[i] of lengths ${lens}[i], and write it to ${digest}.  This is the
+ * digest used in the ETag of an S3 multipart upload, which is the hex
+ * encoding of ${digest} followed by "-${nparts}".  The parts are hashed
+ * several at a time using MD5_Buf_multi.
+ */
+void MD5_ETag_multipart(const uint8_t * const *, const size_t *, size_t,
+    uint8_t[16]);
+
+#endif /* !_MD5_MULTI_H_ */
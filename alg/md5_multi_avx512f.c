@@ -0,0 +1,166 @@
+#include "cpusupport.h"
+#ifdef CPUSUPPORT_X86_AVX512F
+/**
+ * CPUSUPPORT CFLAGS: X86_AVX512F
+ */
+
+#include <stdint.h>
+
+#include <immintrin.h>
+
+#include "md5_multi_avx512f.h"
+
+/**
+ * We hold word i of the state (or of the message block) for sixteen
+ * independent messages in vector i; each 32-bit lane is a separate message.
+ */
+
+/* MD5 round constants. */
+static const uint32_t Krnd[64] = {
+	0xd76aa478, 0xe8c7b756, 0x242070db, 0xc1bdceee,
+	0xf57c0faf, 0x4787c62a, 0xa8304613, 0xfd469501,
+	0x698098d8, 0x8b44f7af, 0xffff5bb1, 0x895cd7be,
+	0x6b901122, 0xfd987193, 0xa679438e, 0x49b40821,
+	0xf61e2562, 0xc040b340, 0x265e5a51, 0xe9b6c7aa,
+	0xd62f105d, 0x02441453, 0xd8a1e681, 0xe7d3fbc8,
+	0x21e1cde6, 0xc33707d6, 0xf4d50d87, 0x455a14ed,
+	0xa9e3e905, 0xfcefa3f8, 0x676f02d9, 0x8d2a4c8a,
+	0xfffa3942, 0x8771f681, 0x6d9d6122, 0xfde5380c,
+	0xa4beea44, 0x4bdecfa9, 0xf6bb4b60, 0xbebfbc70,
+	0x289b7ec6, 0xeaa127fa, 0xd4ef3085, 0x04881d05,
+	0xd9d4d039, 0xe6db99e5, 0x1fa27cf8, 0xc4ac5665,
+	0xf4292244, 0x432aff97, 0xab9423a7, 0xfc93a039,
+	0x655b59c3, 0x8f0ccc92, 0xffeff47d, 0x85845dd1,
+	0x6fa87e4f, 0xfe2ce6e0, 0xa3014314, 0x4e0811a1,
+	0xf7537e82, 0xbd3af235, 0x2ad7d2bb, 0xeb86d391
+};
+
+/*
+ * Elementary functions used by MD5, applied to each lane.  Each of the
+ * round functions is a single three-input logic instruction.
+ */
+#define ADD(x, y)	_mm512_add_epi32(x, y)
+#define ROTL(x, n)	_mm512_rol_epi32(x, n)
+#define F(x, y, z)	_mm512_ternarylogic_epi32(x, y, z, 0xca)
+#define G(x, y, z)	_mm512_ternarylogic_epi32(x, y, z, 0xe4)
+#define H(x, y, z)	_mm512_ternarylogic_epi32(x, y, z, 0x96)
+#define I(x, y, z)	_mm512_ternarylogic_epi32(x, y, z, 0x39)
+
+/* Message word used in step i. */
+#define KF(i)	((i) % 16)
+#define KG(i)	((5 * (i) + 1) % 16)
+#define KH(i)	((3 * (i) + 5) % 16)
+#define KI(i)	((7 * (i)) % 16)
+
+/* MD5 step i, using the round function f and message word k. */
+#define STEP(f, a, b, c, d, k, i, s)					\
+	a = ADD(b, ROTL(ADD(f(b, c, d),					\
+	    ADD(a, ADD(W[k], _mm512_set1_epi32((int)Krnd[i])))), s))
+
+/* Four MD5 steps, starting with step i. */
+#define STEP4(f, k, i, s0, s1, s2, s3) do {				\
+	STEP(f, a, b, c, d, k(i + 0), i + 0, s0);			\
+	STEP(f, d, a, b, c, k(i + 1), i + 1, s1);			\
+	STEP(f, c, d, a, b, k(i + 2), i + 2, s2);			\
+	STEP(f, b, c, d, a, k(i + 3), i + 3, s3);			\
+} while (0)
+
+/*
+ * Transpose the sixteen vectors ${x}[0..15], viewed as a 16x16 matrix of
+ * words.
+ */
+static inline void
+transpose16(__m512i x[16])
+{
+	__m512i t[16], u[16];
+	int i;
+
+	/* Transpose 4x4 matrices within each 128-bit quarter. */
+	for (i = 0; i < 16; i += 4) {
+		t[i + 0] = _mm512_unpacklo_epi32(x[i + 0], x[i + 1]);
+		t[i + 1] = _mm512_unpackhi_epi32(x[i + 0], x[i + 1]);
+		t[i + 2] = _mm512_unpacklo_epi32(x[i + 2], x[i + 3]);
+		t[i + 3] = _mm512_unpackhi_epi32(x[i + 2], x[i + 3]);
+		u[i + 0] = _mm512_unpacklo_epi64(t[i + 0], t[i + 2]);
+		u[i + 1] = _mm512_unpackhi_epi64(t[i + 0], t[i + 2]);
+		u[i + 2] = _mm512_unpacklo_epi64(t[i + 1], t[i + 3]);
+		u[i + 3] = _mm512_unpackhi_epi64(t[i + 1], t[i + 3]);
+	}
+
+	/* Transpose the 4x4 matrix of 4x4 matrices. */
+	for (i = 0; i < 4; i++) {
+		t[i + 0] = _mm512_shuffle_i32x4(u[i + 0], u[i + 4], 0x44);
+		t[i + 4] = _mm512_shuffle_i32x4(u[i + 0], u[i + 4], 0xee);
+		t[i + 8] = _mm512_shuffle_i32x4(u[i + 8], u[i + 12], 0x44);
+		t[i + 12] = _mm512_shuffle_i32x4(u[i + 8], u[i + 12], 0xee);
+	}
+	for (i = 0; i < 4; i++) {
+		x[i + 0] = _mm512_shuffle_i32x4(t[i + 0], t[i + 8], 0x88);
+		x[i + 4] = _mm512_shuffle_i32x4(t[i + 0], t[i + 8], 0xdd);
+		x[i + 8] = _mm512_shuffle_i32x4(t[i + 4], t[i + 12], 0x88);
+		x[i + 12] = _mm512_shuffle_i32x4(t[i + 4], t[i + 12], 0xdd);
+	}
+}
+
+/**
+ * MD5_Transform_multi_avx512f(state, blocks):
+ * Compute the MD5 block compression function for sixteen independent messages,
+ * transforming ${state} using the data in ${blocks}.  Word i of the state for
+ * message j is held in ${state}[16 * i + j], and the next block of message j
+ * is ${blocks}[j].  This implementation uses x86 AVX512F instructions, and
+ * should only be used if CPUSUPPORT_X86_AVX512F is defined and
+ * cpusupport_x86_avx512f() returns nonzero.
+ */
+void
+MD5_Transform_multi_avx512f(uint32_t state[static restrict 64],
+    const uint8_t * const blocks[static restrict 16])
+{
+	__m512i W[16];
+	__m512i S[4];
+	__m512i a, b, c, d;
+	int i;
+
+	/*
+	 * 1. Load the message blocks.  MD5 words are little-endian, so we
+	 * can load each block and transpose them into place.
+	 */
+	for (i = 0; i < 16; i++)
+		W[i] = _mm512_loadu_si512((const __m512i *)blocks[i]);
+	transpose16(W);
+
+	/* 2. Initialize working variables. */
+	for (i = 0; i < 4; i++)
+		S[i] = _mm512_loadu_si512((const __m512i *)&state[16 * i]);
+	a = S[0];
+	b = S[1];
+	c = S[2];
+	d = S[3];
+
+	/* 3. Mix. */
+	STEP4(F, KF, 0, 7, 12, 17, 22);
+	STEP4(F, KF, 4, 7, 12, 17, 22);
+	STEP4(F, KF, 8, 7, 12, 17, 22);
+	STEP4(F, KF, 12, 7, 12, 17, 22);
+	STEP4(G, KG, 16, 5, 9, 14, 20);
+	STEP4(G, KG, 20, 5, 9, 14, 20);
+	STEP4(G, KG, 24, 5, 9, 14, 20);
+	STEP4(G, KG, 28, 5, 9, 14, 20);
+	STEP4(H, KH, 32, 4, 11, 16, 23);
+	STEP4(H, KH, 36, 4, 11, 16, 23);
+	STEP4(H, KH, 40, 4, 11, 16, 23);
+	STEP4(H, KH, 44, 4, 11, 16, 23);
+	STEP4(I, KI, 48, 6, 10, 15, 21);
+	STEP4(I, KI, 52, 6, 10, 15, 21);
+	STEP4(I, KI, 56, 6, 10, 15, 21);
+	STEP4(I, KI, 60, 6, 10, 15, 21);
+
+	/* 4. Mix local working variables into global state. */
+	S[0] = ADD(S[0], a);
+	S[1] = ADD(S[1], b);
+	S[2] = ADD(S[2], c);
+	S[3] = ADD(S[3], d);
+	for (i = 0; i < 4; i++)
+		_mm512_storeu_si512((__m512i *)&state[16 * i], S[i]);
+}
+
+#endif /* CPUSUPPORT_X86_AVX512F */
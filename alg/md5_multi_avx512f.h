@@ -0,0 +1,23 @@
+#ifndef _MD5_MULTI_AVX512F_H_
+#define _MD5_MULTI_AVX512F_H_
+
+#include <stdint.h>
+
+/**
+ * MD5_Transform_multi_avx512f(state, blocks):
+ * Compute the MD5 block compression function for sixteen independent messages,
+ * transforming ${state} using the data in ${blocks}.  Word i of the state for
+ * message j is held in ${state}[16 * i + j], and the next block of message j
+ * is ${blocks}[j].  This implementation uses x86 AVX512F instructions, and
+ * should only be used if CPUSUPPORT_X86_AVX512F is defined and
+ * cpusupport_x86_avx512f() returns nonzero.
+ */
+#ifdef POSIXFAIL_ABSTRACT_DECLARATOR
+void MD5_Transform_multi_avx512f(uint32_t state[static restrict 64],
+    const uint8_t * const blocks[static restrict 16]);
+#else
+void MD5_Transform_multi_avx512f(uint32_t[static restrict 64],
+    const uint8_t * const[static restrict 16]);
+#endif
+
+#endif /* !_MD5_MULTI_AVX512F_H_ */
@@ -0,0 +1,147 @@
+#include "cpusupport.h"
+#ifdef CPUSUPPORT_X86_SSE2
+/**
+ * CPUSUPPORT CFLAGS: X86_SSE2
+ */
+
+#include <stdint.h>
+
+#include <emmintrin.h>
+
+#include "md5_multi_sse2.h"
+
+/**
+ * We hold word i of the state (or of the message block) for four independent
+ * messages in vector i; each 32-bit lane is a separate message.
+ */
+
+/* MD5 round constants. */
+static const uint32_t Krnd[64] = {
+	0xd76aa478, 0xe8c7b756, 0x242070db, 0xc1bdceee,
+	0xf57c0faf, 0x4787c62a, 0xa8304613, 0xfd469501,
+	0x698098d8, 0x8b44f7af, 0xffff5bb1, 0x895cd7be,
+	0x6b901122, 0xfd987193, 0xa679438e, 0x49b40821,
+	0xf61e2562, 0xc040b340, 0x265e5a51, 0xe9b6c7aa,
+	0xd62f105d, 0x02441453, 0xd8a1e681, 0xe7d3fbc8,
+	0x21e1cde6, 0xc33707d6, 0xf4d50d87, 0x455a14ed,
+	0xa9e3e905, 0xfcefa3f8, 0x676f02d9, 0x8d2a4c8a,
+	0xfffa3942, 0x8771f681, 0x6d9d6122, 0xfde5380c,
+	0xa4beea44, 0x4bdecfa9, 0xf6bb4b60, 0xbebfbc70,
+	0x289b7ec6, 0xeaa127fa, 0xd4ef3085, 0x04881d05,
+	0xd9d4d039, 0xe6db99e5, 0x1fa27cf8, 0xc4ac5665,
+	0xf4292244, 0x432aff97, 0xab9423a7, 0xfc93a039,
+	0x655b59c3, 0x8f0ccc92, 0xffeff47d, 0x85845dd1,
+	0x6fa87e4f, 0xfe2ce6e0, 0xa3014314, 0x4e0811a1,
+	0xf7537e82, 0xbd3af235, 0x2ad7d2bb, 0xeb86d391
+};
+
+/* Elementary functions used by MD5, applied to each lane. */
+#define ADD(x, y)	_mm_add_epi32(x, y)
+#define XOR(x, y)	_mm_xor_si128(x, y)
+#define ROTL(x, n)	_mm_or_si128(_mm_slli_epi32(x, n),		\
+	_mm_srli_epi32(x, 32 - n))
+#define F(x, y, z)	XOR(_mm_and_si128(x, XOR(y, z)), z)
+#define G(x, y, z)	XOR(_mm_and_si128(z, XOR(x, y)), y)
+#define H(x, y, z)	XOR(XOR(x, y), z)
+#define I(x, y, z)	XOR(_mm_or_si128(x, XOR(z, _mm_set1_epi32(-1))), y)
+
+/* Message word used in step i. */
+#define KF(i)	((i) % 16)
+#define KG(i)	((5 * (i) + 1) % 16)
+#define KH(i)	((3 * (i) + 5) % 16)
+#define KI(i)	((7 * (i)) % 16)
+
+/* MD5 step i, using the round function f and message word k. */
+#define STEP(f, a, b, c, d, k, i, s)					\
+	a = ADD(b, ROTL(ADD(f(b, c, d),					\
+	    ADD(a, ADD(W[k], _mm_set1_epi32((int)Krnd[i])))), s))
+
+/* Four MD5 steps, starting with step i. */
+#define STEP4(f, k, i, s0, s1, s2, s3) do {				\
+	STEP(f, a, b, c, d, k(i + 0), i + 0, s0);			\
+	STEP(f, d, a, b, c, k(i + 1), i + 1, s1);			\
+	STEP(f, c, d, a, b, k(i + 2), i + 2, s2);			\
+	STEP(f, b, c, d, a, k(i + 3), i + 3, s3);			\
+} while (0)
+
+/* Transpose the four vectors ${x}[0..3], viewed as a 4x4 matrix of words. */
+static inline void
+transpose4(__m128i x[4])
+{
+	__m128i t0, t1, t2, t3;
+
+	t0 = _mm_unpacklo_epi32(x[0], x[1]);
+	t1 = _mm_unpacklo_epi32(x[2], x[3]);
+	t2 = _mm_unpackhi_epi32(x[0], x[1]);
+	t3 = _mm_unpackhi_epi32(x[2], x[3]);
+	x[0] = _mm_unpacklo_epi64(t0, t1);
+	x[1] = _mm_unpackhi_epi64(t0, t1);
+	x[2] = _mm_unpacklo_epi64(t2, t3);
+	x[3] = _mm_unpackhi_epi64(t2, t3);
+}
+
+/**
+ * MD5_Transform_multi_sse2(state, blocks):
+ * Compute the MD5 block compression function for four independent messages,
+ * transforming ${state} using the data in ${blocks}.  Word i of the state for
+ * message j is held in ${state}[4 * i + j], and the next block of message j
+ * is ${blocks}[j].  This implementation uses x86 SSE2 instructions, and
+ * should only be used if CPUSUPPORT_X86_SSE2 is defined and
+ * cpusupport_x86_sse2() returns nonzero.
+ */
+void
+MD5_Transform_multi_sse2(uint32_t state[static restrict 16],
+    const uint8_t * const blocks[static restrict 4])
+{
+	__m128i W[16];
+	__m128i S[4];
+	__m128i a, b, c, d;
+	int i, j;
+
+	/*
+	 * 1. Load the message blocks.  MD5 words are little-endian, so we
+	 * can load four words from each block and transpose them into place.
+	 */
+	for (i = 0; i < 16; i += 4) {
+		for (j = 0; j < 4; j++)
+			W[i + j] = _mm_loadu_si128(
+			    (const __m128i *)&blocks[j][i * 4]);
+		transpose4(&W[i]);
+	}
+
+	/* 2. Initialize working variables. */
+	for (i = 0; i < 4; i++)
+		S[i] = _mm_loadu_si128((const __m128i *)&state[4 * i]);
+	a = S[0];
+	b = S[1];
+	c = S[2];
+	d = S[3];
+
+	/* 3. Mix. */
+	STEP4(F, KF, 0, 7, 12, 17, 22);
+	STEP4(F, KF, 4, 7, 12, 17, 22);
+	STEP4(F, KF, 8, 7, 12, 17, 22);
+	STEP4(F, KF, 12, 7, 12, 17, 22);
+	STEP4(G, KG, 16, 5, 9, 14, 20);
+	STEP4(G, KG, 20, 5, 9, 14, 20);
+	STEP4(G, KG, 24, 5, 9, 14, 20);
+	STEP4(G, KG, 28, 5, 9, 14, 20);
+	STEP4(H, KH, 32, 4, 11, 16, 23);
+	STEP4(H, KH, 36, 4, 11, 16, 23);
+	STEP4(H, KH, 40, 4, 11, 16, 23);
+	STEP4(H, KH, 44, 4, 11, 16, 23);
+	STEP4(I, KI, 48, 6, 10, 15, 21);
+	STEP4(I, KI, 52, 6, 10, 15, 21);
+	STEP4(I, KI, 56, 6, 10, 15, 21);
+	STEP4(I, KI, 60, 6, 10, 15, 21);
+
+	/* 4. Mix local working variables into global state. */
+	S[0] = ADD(S[0], a);
+	S[1] = ADD(S[1], b);
+	S[2] = ADD(S[2], c);
+	S[3] = ADD(S[3], d);
+	for (i = 0; i < 4; i++)
+		_mm_storeu_si128((__m128i *)&state[4 * i], S[i]);
+}
+
+#endif /* CPUSUPPORT_X86_SSE2 */
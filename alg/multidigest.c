@@ -0,0 +1,429 @@
+#include <assert.h>
+#include <pthread.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "crc32c.h"
+#include "md5.h"
+#include "sha256.h"
+#include "warnp.h"
+
+#include "multidigest.h"
+
+/*
+ * Without threads, data is fed to each digest in turn in blocks of BLOCKLEN
+ * bytes, which should stay in the L1 or L2 cache between digests.  With
+ * threads, the digests work through blocks of THREAD_BLOCKLEN bytes at once,
+ * synchronizing between blocks; these should stay in the last-level cache
+ * while all the threads read them, and be large enough that the cost of
+ * waking the threads up is small.
+ */
+#define BLOCKLEN 16384
+#define THREAD_BLOCKLEN 1048576
+
+/* All the digests we know how to compute. */
+#define ALLALGS (MULTIDIGEST_CRC32C | MULTIDIGEST_MD5 | MULTIDIGEST_SHA256)
+#define NALGS 3
+
+/* A thread computing one of the digests. */
+struct worker {
+	struct multidigest * M;
+	int alg;
+	pthread_t thr;
+};
+
+struct multidigest {
+	int algs;
+	CRC32C_CTX crc32c_ctx;
+	MD5_CTX md5_ctx;
+	SHA256_CTX sha256_ctx;
+
+	/* The first digest is always computed by the calling thread. */
+	int firstalg;
+
+	/* Worker threads, if we're using them, for the other digests. */
+	int threaded;
+	struct worker workers[NALGS - 1];
+	size_t nworkers;
+
+	/* Work handed out to the worker threads; protected by mtx. */
+	pthread_mutex_t mtx;
+	pthread_cond_t cv_work;
+	pthread_cond_t cv_done;
+	const uint8_t * buf;
+	size_t len;
+	uint64_t generation;
+	size_t nbusy;
+	int shutdown;
+};
+
+/* Feed ${len} bytes from ${buf} into the digest ${alg}. */
+static void
+feed(struct multidigest * M, int alg, const uint8_t * buf, size_t len)
+{
+
+	switch (alg) {
+	case MULTIDIGEST_CRC32C:
+		CRC32C_Update(&M->crc32c_ctx, buf, len);
+		break;
+	case MULTIDIGEST_MD5:
+		MD5_Update(&M->md5_ctx, buf, len);
+		break;
+	case MULTIDIGEST_SHA256:
+		SHA256_Update(&M->sha256_ctx, buf, len);
+		break;
+	}
+}
+
+/*
+ * Feed each block handed out by multidigest_update into one digest.  The
+ * pthread functions used here can only fail if the mutex or condition
+ * variables are invalid, so we don't check for errors.
+ */
+static void *
+workthread(void * cookie)
+{
+	struct worker * W = cookie;
+	struct multidigest * M = W->M;
+	uint64_t generation = 0;
+	const uint8_t * buf;
+	size_t len;
+
+	pthread_mutex_lock(&M->mtx);
+	do {
+		/* Wait until there's new work or we're told to stop. */
+		while ((M->generation == generation) && !M->shutdown)
+			pthread_cond_wait(&M->cv_work, &M->mtx);
+		if (M->shutdown)
+			break;
+		generation = M->generation;
+		buf = M->buf;
+		len = M->len;
+
+		/* Process the block without holding the mutex. */
+		pthread_mutex_unlock(&M->mtx);
+		feed(M, W->alg, buf, len);
+		pthread_mutex_lock(&M->mtx);
+
+		/* If we're the last to finish, wake up multidigest_update. */
+		if (--M->nbusy == 0)
+			pthread_cond_signal(&M->cv_done);
+	} while (1);
+	pthread_mutex_unlock(&M->mtx);
+
+	return (NULL);
+}
+
+/* Stop and wait for the worker threads. */
+static int
+stopthreads(struct multidigest * M)
+{
+	size_t i;
+	int rc;
+
+	/* Tell the threads to stop. */
+	if ((rc = pthread_mutex_lock(&M->mtx)) != 0) {
+		warn0("pthread_mutex_lock: %s", strerror(rc));
+		goto err0;
+	}
+	M->shutdown = 1;
+	if ((rc = pthread_cond_broadcast(&M->cv_work)) != 0) {
+		warn0("pthread_cond_broadcast: %s", strerror(rc));
+		pthread_mutex_unlock(&M->mtx);
+		goto err0;
+	}
+	if ((rc = pthread_mutex_unlock(&M->mtx)) != 0) {
+		warn0("pthread_mutex_unlock: %s", strerror(rc));
+		goto err0;
+	}
+
+	/* Wait for them to finish. */
+	for (i = 0; i < M->nworkers; i++) {
+		if ((rc = pthread_join(M->workers[i].thr, NULL)) != 0) {
+			warn0("pthread_join: %s", strerror(rc));
+			goto err0;
+		}
+	}
+
+	/* Clean up synchronization objects. */
+	pthread_cond_destroy(&M->cv_done);
+	pthread_cond_destroy(&M->cv_work);
+	pthread_mutex_destroy(&M->mtx);
+
+	/* Success! */
+	return (0);
+
+err0:
+	/* Failure! */
+	return (-1);
+}
+
+/**
+ * multidigest_init(algs, threaded):
+ * Prepare to compute the digests selected by ${algs}, which is a nonzero
+ * bitwise OR of MULTIDIGEST_CRC32C, MULTIDIGEST_MD5, and MULTIDIGEST_SHA256.
+ * If ${threaded} is nonzero, each selected digest after the first will be
+ * computed by a separate thread.
+ */
+struct multidigest *
+multidigest_init(int algs, int threaded)
+{
+	struct multidigest * M;
+	struct worker * W;
+	int alg;
+	int rc;
+
+	/* Sanity-check. */
+	assert((algs != 0) && ((algs & ~ALLALGS) == 0));
+
+	/* Allocate structure. */
+	if ((M = malloc(sizeof(struct multidigest))) == NULL) {
+		warnp("malloc");
+		goto err0;
+	}
+	M->algs = algs;
+	M->threaded = 0;
+	M->nworkers = 0;
+	M->generation = 0;
+	M->nbusy = 0;
+	M->shutdown = 0;
+
+	/*
+	 * Initialize the digests.  We do this before starting any threads,
+	 * since this is where hardware acceleration is detected.
+	 */
+	if (algs & MULTIDIGEST_CRC32C)
+		CRC32C_Init(&M->crc32c_ctx);
+	if (algs & MULTIDIGEST_MD5)
+		MD5_Init(&M->md5_ctx);
+	if (algs & MULTIDIGEST_SHA256)
+		SHA256_Init(&M->sha256_ctx);
+
+	/* Find the first digest. */
+	for (alg = 1; (algs & alg) == 0; alg <<= 1)
+		continue;
+	M->firstalg = alg;
+
+	/* Are we using threads for the other digests? */
+	if (!threaded || (algs == alg))
+		goto done;
+
+	/* Initialize synchronization objects. */
+	if ((rc = pthread_mutex_init(&M->mtx, NULL)) != 0) {
+		warn0("pthread_mutex_init: %s", strerror(rc));
+		goto err1;
+	}
+	if ((rc = pthread_cond_init(&M->cv_work, NULL)) != 0) {
+		warn0("pthread_cond_init: %s", strerror(rc));
+		goto err2;
+	}
+	if ((rc = pthread_cond_init(&M->cv_done, NULL)) != 0) {
+		warn0("pthread_cond_init: %s", strerror(rc));
+		goto err3;
+	}
+	M->threaded = 1;
+
+	/* Start a thread for each of the other digests. */
+	for (alg <<= 1; alg & ALLALGS; alg <<= 1) {
+		if ((algs & alg) == 0)
+			continue;
+		W = &M->workers[M->nworkers];
+		W->M = M;
+		W->alg = alg;
+		if ((rc = pthread_create(&W->thr, NULL, workthread, W)) != 0) {
+			warn0("pthread_create: %s", strerror(rc));
+			goto err4;
+		}
+		M->nworkers++;
+	}
+
+done:
+	/* Success! */
+	return (M);
+
+err4:
+	/* Stop any threads we started; if this fails, leak our state. */
+	if (stopthreads(M))
+		goto err0;
+	goto err1;
+err3:
+	pthread_cond_destroy(&M->cv_work);
+err2:
+	pthread_mutex_destroy(&M->mtx);
+err1:
+	free(M);
+err0:
+	/* Failure! */
+	return (NULL);
+}
+
+/**
+ * multidigest_update(M, buf, len):
+ * Feed ${len} bytes from ${buf} into all of the digests being computed by
+ * ${M}.  The data is fed to the digests one cache-sized block at a time, so
+ * that it is only read from memory once.  Return 0 on success or -1 on error.
+ */
+int
+multidigest_update(struct multidigest * M, const uint8_t * buf, size_t len)
+{
+	size_t n;
+	int alg;
+	int rc;
+
+	/* Without threads, feed each block into each digest in turn. */
+	if (!M->threaded) {
+		for (; len > 0; buf += n, len -= n) {
+			n = (len > BLOCKLEN) ? BLOCKLEN : len;
+			for (alg = 1; alg & ALLALGS; alg <<= 1) {
+				if (M->algs & alg)
+					feed(M, alg, buf, n);
+			}
+		}
+		goto done;
+	}
+
+	/* With threads, process blocks in parallel. */
+	for (; len > 0; buf += n, len -= n) {
+		n = (len > THREAD_BLOCKLEN) ? THREAD_BLOCKLEN : len;
+
+		/* Hand the block to the worker threads. */
+		if ((rc = pthread_mutex_lock(&M->mtx)) != 0) {
+			warn0("pthread_mutex_lock: %s", strerror(rc));
+			goto err0;
+		}
+		M->buf = buf;
+		M->len = n;
+		M->nbusy = M->nworkers;
+		M->generation++;
+		if ((rc = pthread_cond_broadcast(&M->cv_work)) != 0) {
+			warn0("pthread_cond_broadcast: %s", strerror(rc));
+			goto err1;
+		}
+		if ((rc = pthread_mutex_unlock(&M->mtx)) != 0) {
+			warn0("pthread_mutex_unlock: %s", strerror(rc));
+			goto err0;
+		}
+
+		/* Compute the first digest ourselves. */
+		feed(M, M->firstalg, buf, n);
+
+		/* Wait for the worker threads to finish. */
+		if ((rc = pthread_mutex_lock(&M->mtx)) != 0) {
+			warn0("pthread_mutex_lock: %s", strerror(rc));
+			goto err0;
+		}
+		while (M->nbusy > 0) {
+			if ((rc = pthread_cond_wait(&M->cv_done,
+			    &M->mtx)) != 0) {
+				warn0("pthread_cond_wait: %s", strerror(rc));
+				goto err1;
+			}
+		}
+		if ((rc = pthread_mutex_unlock(&M->mtx)) != 0) {
+			warn0("pthread_mutex_unlock: %s", strerror(rc));
+			goto err0;
+		}
+	}
+
+done:
+	/* Success! */
+	return (0);
+
+err1:
+	pthread_mutex_unlock(&M->mtx);
+err0:
+	/* Failure! */
+	return (-1);
+}
+
+/**
+ * multidigest_final(M, crc32c, md5, sha256):
+ * Store the digests of the data fed into ${M} into ${crc32c}, ${md5}, and
+ * ${sha256}, in the formats used by CRC32C_Final, MD5_Final, and
+ * SHA256_Final; the buffers for digests which were not selected may be NULL.
+ * Free ${M}.  Return 0 on success or -1 on error.
+ */
+int
+multidigest_final(struct multidigest * M, uint8_t crc32c[4], uint8_t md5[16],
+    uint8_t sha256[32])
+{
+
+	/* Stop the worker threads; if this fails, leak our state. */
+	if (M->threaded && stopthreads(M))
+		goto err0;
+
+	/* Output the digests. */
+	if (M->algs & MULTIDIGEST_CRC32C)
+		CRC32C_Final(crc32c, &M->crc32c_ctx);
+	if (M->algs & MULTIDIGEST_MD5)
+		MD5_Final(md5, &M->md5_ctx);
+	if (M->algs & MULTIDIGEST_SHA256)
+		SHA256_Final(sha256, &M->sha256_ctx);
+
+	/* Free the structure. */
+	free(M);
+
+	/* Success! */
+	return (0);
+
+err0:
+	/* Failure! */
+	return (-1);
+}
+
+/**
+ * multidigest_free(M):
+ * Free ${M} without computing its digests.
+ */
+void
+multidigest_free(struct multidigest * M)
+{
+
+	/* Behave consistently with free(NULL). */
+	if (M == NULL)
+		return;
+
+	/* Stop the worker threads; if this fails, leak our state. */
+	if (M->threaded && stopthreads(M))
+		return;
+
+	/* Free the structure. */
+	free(M);
+}
+
+/**
+ * multidigest_buf(algs, buf, len, threaded, crc32c, md5, sha256):
+ * Compute the digests selected by ${algs} of ${len} bytes from ${buf} and
+ * store them into ${crc32c}, ${md5}, and ${sha256}, as multidigest_init,
+ * multidigest_update, and multidigest_final would.  Return 0 on success or
+ * -1 on error.
+ */
+int
+multidigest_buf(int algs, const uint8_t * buf, size_t len, int threaded,
+    uint8_t crc32c[4], uint8_t md5[16], uint8_t sha256[32])
+{
+	struct multidigest * M;
+
+	/* Set up the engine. */
+	if ((M = multidigest_init(algs, threaded)) == NULL)
+		goto err0;
+
+	/* Process the buffer. */
+	if (multidigest_update(M, buf, len))
+		goto err1;
+
+	/* Output the digests. */
+	if (multidigest_final(M, crc32c, md5, sha256))
+		goto err0;
+
+	/* Success! */
+	return (0);
+
+err1:
+	multidigest_free(M);
+err0:
+	/* Failure! */
+	return (-1);
+}
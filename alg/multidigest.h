@@ -0,0 +1,63 @@
+#ifndef _MULTIDIGEST_H_
+#define _MULTIDIGEST_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * Engine for computing several digests of the same data in a single pass
+ * over memory.
+ */
+
+/* Opaque type. */
+struct multidigest;
+
+/* Digests which can be computed. */
+#define MULTIDIGEST_CRC32C	1
+#define MULTIDIGEST_MD5		2
+#define MULTIDIGEST_SHA256	4
+
+/**
+ * multidigest_init(algs, threaded):
+ * Prepare to compute the digests selected by ${algs}, which is a nonzero
+ * bitwise OR of MULTIDIGEST_CRC32C, MULTIDIGEST_MD5, and MULTIDIGEST_SHA256.
+ * If ${threaded} is nonzero, each selected digest after the first will be
+ * computed by a separate thread.
+ */
+struct multidigest * multidigest_init(int, int);
+
+/**
+ * multidigest_update(M, buf, len):
+ * Feed ${len} bytes from ${buf} into all of the digests being computed by
+ * ${M}.  The data is fed to the digests one cache-sized block at a time, so
+ * that it is only read from memory once.  Return 0 on success or -1 on error.
+ */
+int multidigest_update(struct multidigest *, const uint8_t *, size_t);
+
+/**
+ * multidigest_final(M, crc32c, md5, sha256):
+ * Store the digests of the data fed into ${M} into ${crc32c}, ${md5}, and
+ * ${sha256}, in the formats used by CRC32C_Final, MD5_Final, and
+ * SHA256_Final; the buffers for digests which were not selected may be NULL.
+ * Free ${M}.  Return 0 on success or -1 on error.
+ */
+int multidigest_final(struct multidigest *, uint8_t[4], uint8_t[16],
+    uint8_t[32]);
+
+/**
+ * multidigest_free(M):
+ * Free ${M} without computing its digests.
+ */
+void multidigest_free(struct multidigest *);
+
+/**
+ * multidigest_buf(algs, buf, len, threaded, crc32c, md5, sha256):
+ * Compute the digests selected by ${algs} of ${len} bytes from ${buf} and
+ * store them into ${crc32c}, ${md5}, and ${sha256}, as multidigest_init,
+ * multidigest_update, and multidigest_final would.  Return 0 on success or
+ * -1 on error.
+ */
+int multidigest_buf(int, const uint8_t *, size_t, int, uint8_t[4],
+    uint8_t[16], uint8_t[32]);
+
+#endif /* !_MULTIDIGEST_H_ */
@@ -0,0 +1,163 @@
+#include <assert.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "insecure_memzero.h"
+#include "sysendian.h"
+
+#include "multilane.h"
+
+/* Per-lane position within the message being hashed. */
+struct lane {
+	size_t msg;		/* Index of the message in this lane. */
+	const uint8_t * p;	/* Next complete block of input. */
+	size_t nfull;		/* Number of complete blocks remaining. */
+	uint8_t pad[128];	/* Final block(s), including padding. */
+	size_t npad;		/* Number of padding blocks. */
+	size_t padpos;		/* Number of padding blocks processed. */
+};
+
+/* Start hashing message ${msg} in lane ${l} of ${nlanes}. */
+static void
+lane_start(const struct multilane_alg * H, struct lane * lane,
+    uint32_t * state, size_t l, size_t nlanes, size_t msg,
+    const uint8_t * in, size_t len)
+{
+	size_t r = len % 64;
+	size_t i;
+
+	/* Record where the message is. */
+	lane->msg = msg;
+	lane->p = in;
+	lane->nfull = len / 64;
+
+	/* Construct the final block(s): tail, 0x80, zeros, bit length. */
+	lane->npad = (r < 56) ? 1 : 2;
+	lane->padpos = 0;
+	memset(lane->pad, 0, 64 * lane->npad);
+	if (r > 0)
+		memcpy(lane->pad, &in[len - r], r);
+	lane->pad[r] = 0x80;
+	if (H->bigendian)
+		be64enc(&lane->pad[64 * lane->npad - 8], (uint64_t)len << 3);
+	else
+		le64enc(&lane->pad[64 * lane->npad - 8], (uint64_t)len << 3);
+
+	/* Reset this lane's state. */
+	for (i = 0; i < H->nwords; i++)
+		state[i * nlanes + l] = H->initial_state[i];
+}
+
+/* Return the next block to be processed in ${lane}. */
+static const uint8_t *
+lane_block(struct lane * lane)
+{
+	const uint8_t * block;
+
+	/* Process the input directly as long as we have complete blocks. */
+	if (lane->nfull > 0) {
+		block = lane->p;
+		lane->p += 64;
+		lane->nfull--;
+	} else {
+		block = &lane->pad[64 * lane->padpos];
+		lane->padpos++;
+	}
+
+	return (block);
+}
+
+/* Write out the hash in lane ${l} of ${nlanes}. */
+static void
+lane_output(const struct multilane_alg * H, const uint32_t * state,
+    size_t l, size_t nlanes, uint8_t * digest)
+{
+	size_t i;
+
+	for (i = 0; i < H->nwords; i++) {
+		if (H->bigendian)
+			be32enc(&digest[i * 4], state[i * nlanes + l]);
+		else
+			le32enc(&digest[i * 4], state[i * nlanes + l]);
+	}
+}
+
+/* Return the first message at or after ${i} which is shorter than ${maxlen}. */
+static size_t
+next_msg(size_t i, const size_t * len, size_t n, size_t maxlen)
+{
+
+	while ((i < n) && (len[i] >= maxlen))
+		i++;
+	return (i);
+}
+
+/**
+ * multilane_hash(H, func, nlanes, in, len, digests, n, maxlen):
+ * Compute the hashes, using the hash function ${H}, of those of the ${n}
+ * messages ${in}[i] of lengths ${len}[i] which are shorter than ${maxlen},
+ * writing the hash of message i into the 4 * ${H}->nwords bytes starting at
+ * ${digests} + i * 4 * ${H}->nwords.  The transform ${func} processes one
+ * block from each of ${nlanes} messages at once; as each message finishes, its
+ * lane moves on to the next message.
+ */
+void
+multilane_hash(const struct multilane_alg * H, multilane_transform func,
+    size_t nlanes, const uint8_t * const * in, const size_t * len,
+    uint8_t * digests, size_t n, size_t maxlen)
+{
+	static const uint8_t zeros[64] = {0};
+	struct lane lanes[MULTILANE_MAXLANES];
+	uint32_t state[MULTILANE_MAXWORDS * MULTILANE_MAXLANES];
+	const uint8_t * blocks[MULTILANE_MAXLANES];
+	int active[MULTILANE_MAXLANES];
+	size_t dlen = 4 * H->nwords;
+	size_t nactive = 0;
+	size_t next;
+	size_t l;
+
+	/* Sanity-check. */
+	assert(nlanes <= MULTILANE_MAXLANES);
+	assert(H->nwords <= MULTILANE_MAXWORDS);
+
+	/* Fill as many lanes as we can. */
+	next = next_msg(0, len, n, maxlen);
+	for (l = 0; l < nlanes; l++) {
+		if ((active[l] = (next < n)) != 0) {
+			lane_start(H, &lanes[l], state, l, nlanes, next,
+			    in[next], len[next]);
+			next = next_msg(next + 1, len, n, maxlen);
+			nactive++;
+		}
+	}
+
+	/* Keep going until every message has been hashed. */
+	while (nactive > 0) {
+		/* Idle lanes process a dummy block. */
+		for (l = 0; l < nlanes; l++)
+			blocks[l] = active[l] ? lane_block(&lanes[l]) : zeros;
+		func(state, blocks);
+
+		/* Output finished hashes and start on new messages. */
+		for (l = 0; l < nlanes; l++) {
+			if (!active[l] || (lanes[l].nfull > 0) ||
+			    (lanes[l].padpos < lanes[l].npad))
+				continue;
+			lane_output(H, state, l, nlanes,
+			    &digests[lanes[l].msg * dlen]);
+			if (next < n) {
+				lane_start(H, &lanes[l], state, l, nlanes,
+				    next, in[next], len[next]);
+				next = next_msg(next + 1, len, n, maxlen);
+			} else {
+				active[l] = 0;
+				nactive--;
+			}
+		}
+	}
+
+	/* Clean the stack. */
+	insecure_memzero(lanes, sizeof(lanes));
+	insecure_memzero(state, sizeof(state));
+}
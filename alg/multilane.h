@@ -0,0 +1,38 @@
+#ifndef _MULTILANE_H_
+#define _MULTILANE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* Maximum number of lanes which a transform may process at once. */
+#define MULTILANE_MAXLANES 16
+
+/* Maximum number of 32-bit words of state per lane. */
+#define MULTILANE_MAXWORDS 8
+
+/*
+ * A transform which processes one 64-byte block from each of several
+ * messages; word i of the state of lane l is state[i * nlanes + l].
+ */
+typedef void (* multilane_transform)(uint32_t *, const uint8_t * const *);
+
+/* A Merkle-Damgard hash function with 64-byte blocks. */
+struct multilane_alg {
+	size_t nwords;			/* Words of state (and of digest). */
+	const uint32_t * initial_state;	/* Initial state of each message. */
+	int bigendian;			/* Big-endian lengths and digests? */
+};
+
+/**
+ * multilane_hash(H, func, nlanes, in, len, digests, n, maxlen):
+ * Compute the hashes, using the hash function ${H}, of those of the ${n}
+ * messages ${in}[i] of lengths ${len}[i] which are shorter than ${maxlen},
+ * writing the hash of message i into the 4 * ${H}->nwords bytes starting at
+ * ${digests} + i * 4 * ${H}->nwords.  The transform ${func} processes one
+ * block from each of ${nlanes} messages at once; as each message finishes, its
+ * lane moves on to the next message.
+ */
+void multilane_hash(const struct multilane_alg *, multilane_transform, size_t,
+    const uint8_t * const *, const size_t *, uint8_t *, size_t, size_t);
+
+#endif /* !_MULTILANE_H_ */
@@ -1,11 +1,32 @@
 #include <stdint.h>
 #include <string.h>
 
+#include "cpusupport.h"
+#include "hwaccel.h"
 #include "insecure_memzero.h"
+#include "sha1_arm.h"
+#include "sha1_shani.h"
 #include "sysendian.h"
+#include "warnp.h"
 
 #include "sha1.h"
 
+#if defined(CPUSUPPORT_X86_SHANI) && defined(CPUSUPPORT_X86_SSSE3) ||	\
+    defined(CPUSUPPORT_ARM_SHA1)
+#define HWACCEL
+
+static enum {
+	HW_SOFTWARE = 0,
+#if defined(CPUSUPPORT_X86_SHANI) && defined(CPUSUPPORT_X86_SSSE3)
+	HW_X86_SHANI,
+#endif
+#if defined(CPUSUPPORT_ARM_SHA1)
+	HW_ARM_SHA1,
+#endif
+	HW_UNSET
+} hwaccel = HW_UNSET;
+#endif
+
 /*
  * Encode a length len/4 vector of (uint32_t) into a length len vector of
  * (uint8_t) in big-endian form.  Assumes len is a multiple of 4.
@@ -84,6 +105,24 @@ SHA1_Transform(uint32_t * state, const uint8_t block[64])
 	uint32_t S[5];
 	int i;
 
+#ifdef HWACCEL
+	switch (hwaccel) {
+#if defined(CPUSUPPORT_X86_SHANI) && defined(CPUSUPPORT_X86_SSSE3)
+	case HW_X86_SHANI:
+		SHA1_Transform_shani(state, block);
+		return;
+#endif
+#if defined(CPUSUPPORT_ARM_SHA1)
+	case HW_ARM_SHA1:
+		SHA1_Transform_arm(state, block);
+		return;
+#endif
+	case HW_SOFTWARE:
+	case HW_UNSET:
+		break;
+	}
+#endif /* HWACCEL */
+
 	/* 1. Prepare message schedule W. */
 	be32dec_vect(W, block, 64);
 	for (i = 16; i < 80; i++) {
@@ -185,6 +224,143 @@ SHA1_Transform(uint32_t * state, const uint8_t block[64])
 	insecure_memzero(S, 20);
 }
 
+/*
+ * Apply the SHA1 block compression function to each of ${nblocks} blocks in
+ * turn.  Hardware implementations which can keep the state in registers
+ * across blocks are given all of the blocks at once.
+ */
+static void
+SHA1_Transform_blocks(uint32_t * state, const uint8_t * data, size_t nblocks)
+{
+
+#ifdef HWACCEL
+	switch (hwaccel) {
+#if defined(CPUSUPPORT_X86_SHANI) && defined(CPUSUPPORT_X86_SSSE3)
+	case HW_X86_SHANI:
+		SHA1_Transform_shani_blocks(state, data, nblocks);
+		return;
+#endif
+#if defined(CPUSUPPORT_ARM_SHA1)
+	case HW_ARM_SHA1:
+		SHA1_Transform_arm_blocks(state, data, nblocks);
+		return;
+#endif
+	case HW_SOFTWARE:
+	case HW_UNSET:
+		break;
+	}
+#endif /* HWACCEL */
+
+	/* Transform one block at a time. */
+	for (; nblocks > 0; nblocks--) {
+		SHA1_Transform(state, data);
+		data += 64;
+	}
+}
+
+#ifdef HWACCEL
+/*
+ * Test whether software and hardware extensions transform code produce the
+ * same results.  Must be called with (hwaccel == HW_SOFTWARE).
+ */
+static int
+hwtest(const uint32_t state[static restrict 5],
+    const uint8_t block[static restrict 64],
+    void(* func)(uint32_t [static restrict 5],
+    const uint8_t [static restrict 64]))
+{
+	uint32_t state_sw[5];
+	uint32_t state_hw[5];
+
+	/* Software transform. */
+	memcpy(state_sw, state, sizeof(state_sw));
+	SHA1_Transform(state_sw, block);
+
+	/* Hardware transform. */
+	memcpy(state_hw, state, sizeof(state_hw));
+	func(state_hw, block);
+
+	/* Do the results match? */
+	return (memcmp(state_sw, state_hw, sizeof(state_sw)));
+}
+
+/*
+ * Test whether the software transform and a hardware multi-block transform
+ * produce the same results on ${nblocks} blocks.  Must be called with
+ * (hwaccel == HW_SOFTWARE).
+ */
+static int
+hwtest_blocks(const uint32_t state[static restrict 5],
+    const uint8_t * restrict data, size_t nblocks,
+    void(* func)(uint32_t [static restrict 5], const uint8_t * restrict,
+    size_t))
+{
+	uint32_t state_sw[5];
+	uint32_t state_hw[5];
+	size_t i;
+
+	/* Software transform, one block at a time. */
+	memcpy(state_sw, state, sizeof(state_sw));
+	for (i = 0; i < nblocks; i++)
+		SHA1_Transform(state_sw, &data[i * 64]);
+
+	/* Hardware transform, all of the blocks at once. */
+	memcpy(state_hw, state, sizeof(state_hw));
+	func(state_hw, data, nblocks);
+
+	/* Do the results match? */
+	return (memcmp(state_sw, state_hw, sizeof(state_sw)));
+}
+
+/* Time a hash using the implementation ${id}; defined below. */
+static void hwbench(int);
+
+/* Which type of hardware acceleration should we use, if any? */
+static void
+hwaccel_init(void)
+{
+	static const uint32_t initial_state[5] = {
+		0x67452301, 0xEFCDAB89, 0x98BADCFE, 0x10325476, 0xC3D2E1F0
+	};
+	struct hwaccel_choice C;
+	uint8_t block[256];
+	size_t i;
+
+	/* If we've already set hwaccel, we're finished. */
+	if (hwaccel != HW_UNSET)
+		return;
+
+	/* Use software while we test the alternatives. */
+	hwaccel = HW_SOFTWARE;
+	hwaccel_begin(&C, "sha1");
+
+	/*
+	 * Test cases: Transform the block 0x00 0x01 0x02 ... 0x3f; and, for
+	 * multi-block transforms, the four blocks 0x00 0x01 ... 0xff.
+	 */
+	for (i = 0; i < 256; i++)
+		block[i] = (uint8_t)i;
+
+#if defined(CPUSUPPORT_X86_SHANI) && defined(CPUSUPPORT_X86_SSSE3)
+	HWACCEL_OFFER(&C, HW_X86_SHANI, "x86-shani",
+	    cpusupport_x86_shani() && cpusupport_x86_ssse3(),
+	    hwtest(initial_state, block, SHA1_Transform_shani) ||
+	    hwtest_blocks(initial_state, block, 4,
+		SHA1_Transform_shani_blocks));
+#endif
+#if defined(CPUSUPPORT_ARM_SHA1)
+	HWACCEL_OFFER(&C, HW_ARM_SHA1, "arm-sha1", cpusupport_arm_sha1(),
+	    hwtest(initial_state, block, SHA1_Transform_arm) ||
+	    hwtest_blocks(initial_state, block, 4,
+		SHA1_Transform_arm_blocks));
+#endif
+	hwaccel_offer(&C, HW_SOFTWARE, "software");
+
+	/* Pick one. */
+	hwaccel = hwaccel_choose(&C, hwbench);
+}
+#endif /* HWACCEL */
+
 static uint8_t PAD[64] = {
 	0x80, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
 	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
@@ -231,6 +407,11 @@ SHA1_Init(SHA1_CTX * ctx)
 	ctx->state[2] = 0x98BADCFE;
 	ctx->state[3] = 0x10325476;
 	ctx->state[4] = 0xC3D2E1F0;
+
+#ifdef HWACCEL
+	/* Ensure that we've chosen the type of hardware acceleration. */
+	hwaccel_init();
+#endif
 }
 
 /**
@@ -273,11 +454,9 @@ SHA1_Update(SHA1_CTX * ctx, const void * in, size_t len)
 	len -= 64 - r;
 
 	/* Perform complete blocks. */
-	while (len >= 64) {
-		SHA1_Transform(ctx->state, src);
-		src += 64;
-		len -= 64;
-	}
+	SHA1_Transform_blocks(ctx->state, src, len / 64);
+	src += len & ~(size_t)63;
+	len &= 63;
 
 	/* Copy left over data into buffer. */
 	memcpy(ctx->buf, src, len);
@@ -316,6 +495,19 @@ SHA1_Buf(const void * in, size_t len, uint8_t digest[20])
 	SHA1_Final(digest, &ctx);
 }
 
+#ifdef HWACCEL
+/* Hash 4 kB of data using the implementation ${id}. */
+static void
+hwbench(int id)
+{
+	static const uint8_t buf[4096];
+	uint8_t digest[20];
+
+	hwaccel = id;
+	SHA1_Buf(buf, sizeof(buf), digest);
+}
+#endif
+
 /**
  * HMAC_SHA1_Init(ctx, K, Klen):
  * Initialize the HMAC-SHA1 context ${ctx} with ${Klen} bytes of key from ${K}.
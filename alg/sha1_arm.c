@@ -0,0 +1,149 @@
+#include "cpusupport.h"
+#ifdef CPUSUPPORT_ARM_SHA1
+/**
+ * CPUSUPPORT CFLAGS: ARM_SHA1
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __ARM_NEON
+#include <arm_neon.h>
+#endif
+
+#include "sha1_arm.h"
+
+/* SHA1 round constants. */
+#define K0 0x5A827999
+#define K1 0x6ED9EBA1
+#define K2 0x8F1BBCDC
+#define K3 0xCA62C1D6
+
+/*
+ * Run four rounds of SHA1 using the round function vsha1${F}q_u32, the
+ * message words ${W}, and the round constant ${K}.  The value of "e" for the
+ * next four rounds is derived from the current "a".
+ */
+#define RND4(F, ABCD, E, W, K) do {					\
+	uint32_t E_next;						\
+	uint32x4_t WK;							\
+									\
+	WK = vaddq_u32(W, vdupq_n_u32(K));				\
+	E_next = vsha1h_u32(vgetq_lane_u32(ABCD, 0));			\
+	ABCD = vsha1##F##q_u32(ABCD, E, WK);				\
+	E = E_next;							\
+} while (0)
+
+/* Compute the ith set of four words of message schedule. */
+#define MSG4(W, i)							\
+	W[(i) % 4] = vsha1su1q_u32(vsha1su0q_u32(W[(i) % 4],		\
+	    W[(i + 1) % 4], W[(i + 2) % 4]), W[(i + 3) % 4])
+
+/* Perform 4 rounds of SHA1 and generate more message schedule if needed. */
+#define RNDMSG(F, ABCD, E, W, i, K) do {			\
+	RND4(F, ABCD, E, W[(i) % 4], K);			\
+	if (i < 16)						\
+		MSG4(W, i);					\
+} while (0)
+
+/* Transform the state (${ABCD}, ${E}) using ${block}. */
+static inline void
+transform(uint32x4_t * ABCD, uint32_t * E, const uint8_t * block)
+{
+	uint32x4_t W[4];
+	uint32x4_t S;
+	uint32_t Se;
+
+	/* Load input block; this is the start of the message schedule. */
+	W[0] = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(&block[0])));
+	W[1] = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(&block[16])));
+	W[2] = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(&block[32])));
+	W[3] = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(&block[48])));
+
+	/* Initialize working variables. */
+	S = *ABCD;
+	Se = *E;
+
+	/* Perform 80 rounds, 4 at a time. */
+	RNDMSG(c, S, Se, W, 0, K0);
+	RNDMSG(c, S, Se, W, 1, K0);
+	RNDMSG(c, S, Se, W, 2, K0);
+	RNDMSG(c, S, Se, W, 3, K0);
+	RNDMSG(c, S, Se, W, 4, K0);
+	RNDMSG(p, S, Se, W, 5, K1);
+	RNDMSG(p, S, Se, W, 6, K1);
+	RNDMSG(p, S, Se, W, 7, K1);
+	RNDMSG(p, S, Se, W, 8, K1);
+	RNDMSG(p, S, Se, W, 9, K1);
+	RNDMSG(m, S, Se, W, 10, K2);
+	RNDMSG(m, S, Se, W, 11, K2);
+	RNDMSG(m, S, Se, W, 12, K2);
+	RNDMSG(m, S, Se, W, 13, K2);
+	RNDMSG(m, S, Se, W, 14, K2);
+	RNDMSG(p, S, Se, W, 15, K3);
+	RNDMSG(p, S, Se, W, 16, K3);
+	RNDMSG(p, S, Se, W, 17, K3);
+	RNDMSG(p, S, Se, W, 18, K3);
+	RNDMSG(p, S, Se, W, 19, K3);
+
+	/* Mix local working variables into global state. */
+	*ABCD = vaddq_u32(*ABCD, S);
+	*E += Se;
+}
+
+/**
+ * SHA1_Transform_arm_blocks(state, data, nblocks):
+ * Compute the SHA1 block compression function on each of the ${nblocks}
+ * 64-byte blocks in ${data} in turn, transforming ${state}.  The state is kept
+ * in registers from one block to the next.  This implementation uses ARM SHA1
+ * instructions, and should only be used if CPUSUPPORT_ARM_SHA1 is defined and
+ * cpusupport_arm_sha1() returns nonzero.
+ */
+#ifdef POSIXFAIL_ABSTRACT_DECLARATOR
+void
+SHA1_Transform_arm_blocks(uint32_t state[5], const uint8_t * data,
+    size_t nblocks)
+#else
+void
+SHA1_Transform_arm_blocks(uint32_t state[static restrict 5],
+    const uint8_t * restrict data, size_t nblocks)
+#endif
+{
+	uint32x4_t ABCD;
+	uint32_t E;
+
+	/* Load state. */
+	ABCD = vld1q_u32(&state[0]);
+	E = state[4];
+
+	/* Process the blocks. */
+	for (; nblocks > 0; nblocks--) {
+		transform(&ABCD, &E, data);
+		data += 64;
+	}
+
+	/* Store state. */
+	vst1q_u32(&state[0], ABCD);
+	state[4] = E;
+}
+
+/**
+ * SHA1_Transform_arm(state, block):
+ * Compute the SHA1 block compression function, transforming ${state} using
+ * the data in ${block}.  This implementation uses ARM SHA1 instructions, and
+ * should only be used if CPUSUPPORT_ARM_SHA1 is defined and
+ * cpusupport_arm_sha1() returns nonzero.
+ */
+#ifdef POSIXFAIL_ABSTRACT_DECLARATOR
+void
+SHA1_Transform_arm(uint32_t state[5], const uint8_t block[64])
+#else
+void
+SHA1_Transform_arm(uint32_t state[static restrict 5],
+    const uint8_t block[static restrict 64])
+#endif
+{
+
+	SHA1_Transform_arm_blocks(state, block, 1);
+}
+#endif /* CPUSUPPORT_ARM_SHA1 */
@@ -0,0 +1,37 @@
+#ifndef _SHA1_ARM_H_
+#define _SHA1_ARM_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * SHA1_Transform_arm(state, block):
+ * Compute the SHA1 block compression function, transforming ${state} using
+ * the data in ${block}.  This implementation uses ARM SHA1 instructions, and
+ * should only be used if CPUSUPPORT_ARM_SHA1 is defined and
+ * cpusupport_arm_sha1() returns nonzero.
+ */
+#ifdef POSIXFAIL_ABSTRACT_DECLARATOR
+void SHA1_Transform_arm(uint32_t state[5], const uint8_t block[64]);
+#else
+void SHA1_Transform_arm(uint32_t[static restrict 5],
+    const uint8_t[static restrict 64]);
+#endif
+
+/**
+ * SHA1_Transform_arm_blocks(state, data, nblocks):
+ * Compute the SHA1 block compression function on each of the ${nblocks}
+ * 64-byte blocks in ${data} in turn, transforming ${state}.  The state is kept
+ * in registers from one block to the next.  This implementation uses ARM SHA1
+ * instructions, and should only be used if CPUSUPPORT_ARM_SHA1 is defined and
+ * cpusupport_arm_sha1() returns nonzero.
+ */
+#ifdef POSIXFAIL_ABSTRACT_DECLARATOR
+void SHA1_Transform_arm_blocks(uint32_t state[5], const uint8_t * data,
+    size_t nblocks);
+#else
+void SHA1_Transform_arm_blocks(uint32_t[static restrict 5],
+    const uint8_t * restrict, size_t);
+#endif
+
+#endif /* !_SHA1_ARM_H_ */
@@ -0,0 +1,160 @@
+#include "cpusupport.h"
+#if defined(CPUSUPPORT_X86_SHANI) && defined(CPUSUPPORT_X86_SSSE3)
+/**
+ * CPUSUPPORT CFLAGS: X86_SHANI X86_SSSE3
+ */
+
+#include <immintrin.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "sha1_shani.h"
+
+/**
+ * This code uses intrinsics from the following feature sets:
+ * SHANI: _mm_sha1msg1_epu32, _mm_sha1msg2_epu32, _mm_sha1nexte_epu32,
+ *     _mm_sha1rnds4_epu32
+ * SSSE3: _mm_shuffle_epi8
+ * SSE2: Everything else
+ */
+
+/* Load a 16-byte block of big-endian words, with the first in the top lane. */
+static __m128i
+be128dec(const uint8_t * src)
+{
+	const __m128i SHUF = _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7,
+	    8, 9, 10, 11, 12, 13, 14, 15);
+	__m128i x;
+
+	/* Load four 32-bit words. */
+	x = _mm_loadu_si128((const __m128i *)src);
+
+	/* Reverse the order of all 16 bytes. */
+	return (_mm_shuffle_epi8(x, SHUF));
+}
+
+/*
+ * Run four rounds of SHA1 using message words ${W}.  ${E} holds the value
+ * from which the next "e" is derived (in its top lane); for the first four
+ * rounds this is e itself, and afterwards it is the "a" value from four
+ * rounds earlier, which needs to be rotated.
+ */
+#define RND4(ABCD, E, W, i) do {					\
+	__m128i EW;							\
+									\
+	/* Add e to the first message word. */				\
+	if (i == 0)							\
+		EW = _mm_add_epi32(E, W);				\
+	else								\
+		EW = _mm_sha1nexte_epu32(E, W);				\
+									\
+	/* Remember "a" and perform the rounds. */			\
+	E = ABCD;							\
+	ABCD = _mm_sha1rnds4_epu32(ABCD, EW, (i) / 5);			\
+} while (0)
+
+/* Compute the ith set of four words of message schedule. */
+#define MSG4(W, i) do {							\
+	W[(i) % 4] = _mm_sha1msg1_epu32(W[(i) % 4], W[(i + 1) % 4]);	\
+	W[(i) % 4] = _mm_xor_si128(W[(i) % 4], W[(i + 2) % 4]);		\
+	W[(i) % 4] = _mm_sha1msg2_epu32(W[(i) % 4], W[(i + 3) % 4]);	\
+} while (0)
+
+/* Perform 4 rounds of SHA1 and generate more message schedule if needed. */
+#define RNDMSG(ABCD, E, W, i) do {				\
+	RND4(ABCD, E, W[(i) % 4], i);				\
+	if (i < 16)						\
+		MSG4(W, i);					\
+} while (0)
+
+/* Transform the state (ABCD, E) using ${block}. */
+static inline void
+transform(__m128i * ABCD, __m128i * E, const uint8_t * block)
+{
+	__m128i W[4];
+	__m128i S, Eacc;
+
+	/* Load input block; this is the start of the message schedule. */
+	W[0] = be128dec(&block[0]);
+	W[1] = be128dec(&block[16]);
+	W[2] = be128dec(&block[32]);
+	W[3] = be128dec(&block[48]);
+
+	/* Initialize working variables. */
+	S = *ABCD;
+	Eacc = *E;
+
+	/* Perform 80 rounds, 4 at a time. */
+	RNDMSG(S, Eacc, W, 0);
+	RNDMSG(S, Eacc, W, 1);
+	RNDMSG(S, Eacc, W, 2);
+	RNDMSG(S, Eacc, W, 3);
+	RNDMSG(S, Eacc, W, 4);
+	RNDMSG(S, Eacc, W, 5);
+	RNDMSG(S, Eacc, W, 6);
+	RNDMSG(S, Eacc, W, 7);
+	RNDMSG(S, Eacc, W, 8);
+	RNDMSG(S, Eacc, W, 9);
+	RNDMSG(S, Eacc, W, 10);
+	RNDMSG(S, Eacc, W, 11);
+	RNDMSG(S, Eacc, W, 12);
+	RNDMSG(S, Eacc, W, 13);
+	RNDMSG(S, Eacc, W, 14);
+	RNDMSG(S, Eacc, W, 15);
+	RNDMSG(S, Eacc, W, 16);
+	RNDMSG(S, Eacc, W, 17);
+	RNDMSG(S, Eacc, W, 18);
+	RNDMSG(S, Eacc, W, 19);
+
+	/* Mix local working variables into global state. */
+	*E = _mm_sha1nexte_epu32(Eacc, *E);
+	*ABCD = _mm_add_epi32(*ABCD, S);
+}
+
+/**
+ * SHA1_Transform_shani_blocks(state, data, nblocks):
+ * Compute the SHA1 block compression function on each of the ${nblocks}
+ * 64-byte blocks in ${data} in turn, transforming ${state}.  The state is kept
+ * in registers from one block to the next.  This implementation uses x86
+ * SHANI and SSSE3 instructions, and should only be used if
+ * CPUSUPPORT_X86_SHANI and _SSSE3 are defined and cpusupport_x86_shani() and
+ * _ssse3() return nonzero.
+ */
+void
+SHA1_Transform_shani_blocks(uint32_t state[static restrict 5],
+    const uint8_t * restrict data, size_t nblocks)
+{
+	__m128i ABCD, E;
+
+	/* Load state, with "a" and "e" in the top lanes of ABCD and E. */
+	ABCD = _mm_loadu_si128((const __m128i *)&state[0]);
+	ABCD = _mm_shuffle_epi32(ABCD, 0x1B);
+	E = _mm_set_epi32((int32_t)state[4], 0, 0, 0);
+
+	/* Process the blocks. */
+	for (; nblocks > 0; nblocks--) {
+		transform(&ABCD, &E, data);
+		data += 64;
+	}
+
+	/* Shuffle state back to the original word order and store. */
+	ABCD = _mm_shuffle_epi32(ABCD, 0x1B);
+	_mm_storeu_si128((__m128i *)&state[0], ABCD);
+	state[4] = (uint32_t)_mm_cvtsi128_si32(_mm_srli_si128(E, 12));
+}
+
+/**
+ * SHA1_Transform_shani(state, block):
+ * Compute the SHA1 block compression function, transforming ${state} using
+ * the data in ${block}.  This implementation uses x86 SHANI and SSSE3
+ * instructions, and should only be used if CPUSUPPORT_X86_SHANI and _SSSE3
+ * are defined and cpusupport_x86_shani() and _ssse3() return nonzero.
+ */
+void
+SHA1_Transform_shani(uint32_t state[static restrict 5],
+    const uint8_t block[static restrict 64])
+{
+
+	SHA1_Transform_shani_blocks(state, block, 1);
+}
+#endif /* CPUSUPPORT_X86_SHANI && CPUSUPPORT_X86_SSSE3 */
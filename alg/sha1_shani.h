@@ -0,0 +1,39 @@
+#ifndef _SHA1_SHANI_H_
+#define _SHA1_SHANI_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * SHA1_Transform_shani(state, block):
+ * Compute the SHA1 block compression function, transforming ${state} using
+ * the data in ${block}.  This implementation uses x86 SHANI and SSSE3
+ * instructions, and should only be used if CPUSUPPORT_X86_SHANI and _SSSE3
+ * are defined and cpusupport_x86_shani() and _ssse3() return nonzero.
+ */
+#ifdef POSIXFAIL_ABSTRACT_DECLARATOR
+void SHA1_Transform_shani(uint32_t state[static restrict 5],
+    const uint8_t block[static restrict 64]);
+#else
+void SHA1_Transform_shani(uint32_t[static restrict 5],
+    const uint8_t[static restrict 64]);
+#endif
+
+/**
+ * SHA1_Transform_shani_blocks(state, data, nblocks):
+ * Compute the SHA1 block compression function on each of the ${nblocks}
+ * 64-byte blocks in ${data} in turn, transforming ${state}.  The state is kept
+ * in registers from one block to the next.  This implementation uses x86
+ * SHANI and SSSE3 instructions, and should only be used if
+ * CPUSUPPORT_X86_SHANI and _SSSE3 are defined and cpusupport_x86_shani() and
+ * _ssse3() return nonzero.
+ */
+#ifdef POSIXFAIL_ABSTRACT_DECLARATOR
+void SHA1_Transform_shani_blocks(uint32_t state[static restrict 5],
+    const uint8_t * restrict data, size_t nblocks);
+#else
+void SHA1_Transform_shani_blocks(uint32_t[static restrict 5],
+    const uint8_t * restrict, size_t);
+#endif
+
+#endif /* !_SHA1_SHANI_H_ */
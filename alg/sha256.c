@@ -3,6 +3,7 @@
 #include <string.h>
 
 #include "cpusupport.h"
+#include "hwaccel.h"
 #include "insecure_memzero.h"
 #include "sha256_arm.h"
 #include "sha256_shani.h"
@@ -159,40 +160,88 @@ hwtest(const uint32_t state[static restrict 8],
 	return (memcmp(state_sw, state_hw, sizeof(state_sw)));
 }
 
+#if defined(CPUSUPPORT_X86_SHANI) && defined(CPUSUPPORT_X86_SSSE3) ||	\
+    defined(CPUSUPPORT_ARM_SHA256)
+/*
+ * Test whether the software transform and a hardware multi-block transform
+ * produce the same results on ${nblocks} blocks.  Must be called with
+ * (hwaccel == HW_SOFTWARE).
+ */
+static int
+hwtest_blocks(const uint32_t state[static restrict 8],
+    const uint8_t * restrict data, size_t nblocks,
+    uint32_t W[static restrict 64], uint32_t S[static restrict 8],
+    void(* func)(uint32_t [static restrict 8], const uint8_t * restrict,
+    size_t))
+{
+	uint32_t state_sw[8];
+	uint32_t state_hw[8];
+	size_t i;
+
+	/* Software transform, one block at a time. */
+	memcpy(state_sw, state, sizeof(state_sw));
+	for (i = 0; i < nblocks; i++)
+		SHA256_Transform(state_sw, &data[i * 64], W, S);
+
+	/* Hardware transform, all of the blocks at once. */
+	memcpy(state_hw, state, sizeof(state_hw));
+	func(state_hw, data, nblocks);
+
+	/* Do the results match? */
+	return (memcmp(state_sw, state_hw, sizeof(state_sw)));
+}
+#endif
+
+/* Time a hash using the implementation ${id}; defined below. */
+static void hwbench(int);
+
 /* Which type of hardware acceleration should we use, if any? */
 static void
 hwaccel_init(void)
 {
+	struct hwaccel_choice C;
 	uint32_t W[64];
 	uint32_t S[8];
-	uint8_t block[64];
-	uint8_t i;
+	uint8_t block[256];
+	size_t i;
 
 	/* If we've already set hwaccel, we're finished. */
 	if (hwaccel != HW_UNSET)
 		return;
 
-	/* Default to software. */
+	/* Use software while we test the alternatives. */
 	hwaccel = HW_SOFTWARE;
+	hwaccel_begin(&C, "sha256");
 
-	/* Test case: Hash 0x00 0x01 0x02 ... 0x3f. */
-	for (i = 0; i < 64; i++)
-		block[i] = i;
+	/*
+	 * Test cases: Transform the block 0x00 0x01 0x02 ... 0x3f; and, for
+	 * multi-block transforms, the four blocks 0x00 0x01 ... 0xff.
+	 */
+	for (i = 0; i < 256; i++)
+		block[i] = (uint8_t)i;
 
 #if defined(CPUSUPPORT_X86_SHANI) && defined(CPUSUPPORT_X86_SSSE3)
-	CPUSUPPORT_VALIDATE(hwaccel, HW_X86_SHANI,
+	HWACCEL_OFFER(&C, HW_X86_SHANI, "x86-shani",
 	    cpusupport_x86_shani() && cpusupport_x86_ssse3(),
 	    hwtest(initial_state, block, W, S,
-		SHA256_Transform_shani_with_W_S));
+		SHA256_Transform_shani_with_W_S) ||
+	    hwtest_blocks(initial_state, block, 4, W, S,
+		SHA256_Transform_shani_blocks));
 #endif
 #if defined(CPUSUPPORT_X86_SSE2)
-	CPUSUPPORT_VALIDATE(hwaccel, HW_X86_SSE2, cpusupport_x86_sse2(),
+	HWACCEL_OFFER(&C, HW_X86_SSE2, "x86-sse2", cpusupport_x86_sse2(),
 	    hwtest(initial_state, block, W, S, SHA256_Transform_sse2));
 #endif
 #if defined(CPUSUPPORT_ARM_SHA256)
-	CPUSUPPORT_VALIDATE(hwaccel, HW_ARM_SHA256, cpusupport_arm_sha256(),
-	    hwtest(initial_state, block, W, S, SHA256_Transform_arm_with_W_S));
+	HWACCEL_OFFER(&C, HW_ARM_SHA256, "arm-sha256", cpusupport_arm_sha256(),
+	    hwtest(initial_state, block, W, S, SHA256_Transform_arm_with_W_S) ||
+	    hwtest_blocks(initial_state, block, 4, W, S,
+		SHA256_Transform_arm_blocks));
 #endif
+	hwaccel_offer(&C, HW_SOFTWARE, "software");
+
+	/* Pick one. */
+	hwaccel = hwaccel_choose(&C, hwbench);
 }
 #endif /* HWACCEL */
 
@@ -225,54 +274,16 @@ hwaccel_init(void)
 	W[i + ii + 16] = s1(W[i + ii + 14]) + W[i + ii + 9] + s0(W[i + ii + 1]) + W[i + ii]
 
 /*
- * SHA256 block compression function.  The 256-bit state is transformed via
- * the 512-bit input block to produce a new state.  The arrays W and S may be
- * filled with sensitive data, and should be sanitized by the callee.
+ * SHA256 block compression function in software, with the first 16 words of
+ * the message schedule already in ${W}.  The arrays W and S may be filled
+ * with sensitive data, and should be sanitized by the callee.
  */
 static void
-SHA256_Transform(uint32_t state[static restrict 8],
-    const uint8_t block[static restrict 64],
+SHA256_Transform_W(uint32_t state[static restrict 8],
     uint32_t W[static restrict 64], uint32_t S[static restrict 8])
 {
 	int i;
 
-#ifdef HWACCEL
-
-#if defined(__GNUC__) && defined(__aarch64__)
-	/*
-	 * We require that SHA256_Init() is called before SHA256_Transform(),
-	 * but the compiler has no way of knowing that.  This assert adds a
-	 * significant speed boost for gcc on 64-bit ARM, and a minor penalty
-	 * on other systems & compilers.
-	 */
-	assert(hwaccel != HW_UNSET);
-#endif
-
-	switch(hwaccel) {
-#if defined(CPUSUPPORT_X86_SHANI) && defined(CPUSUPPORT_X86_SSSE3)
-	case HW_X86_SHANI:
-		SHA256_Transform_shani(state, block);
-		return;
-#endif
-#if defined(CPUSUPPORT_X86_SSE2)
-	case HW_X86_SSE2:
-		SHA256_Transform_sse2(state, block, W, S);
-		return;
-#endif
-#if defined(CPUSUPPORT_ARM_SHA256)
-	case HW_ARM_SHA256:
-		SHA256_Transform_arm(state, block);
-		return;
-#endif
-	case HW_SOFTWARE:
-	case HW_UNSET:
-		break;
-	}
-#endif /* HWACCEL */
-
-	/* 1. Prepare the first part of the message schedule W. */
-	be32dec_vect(W, block, 64);
-
 	/* 2. Initialize working variables. */
 	memcpy(S, state, 32);
 
@@ -320,6 +331,97 @@ SHA256_Transform(uint32_t state[static restrict 8],
 		state[i] += S[i];
 }
 
+/*
+ * SHA256 block compression function.  The 256-bit state is transformed via
+ * the 512-bit input block to produce a new state.  The arrays W and S may be
+ * filled with sensitive data, and should be sanitized by the callee.
+ */
+static void
+SHA256_Transform(uint32_t state[static restrict 8],
+    const uint8_t block[static restrict 64],
+    uint32_t W[static restrict 64], uint32_t S[static restrict 8])
+{
+
+#ifdef HWACCEL
+
+#if defined(__GNUC__) && defined(__aarch64__)
+	/*
+	 * We require that SHA256_Init() is called before SHA256_Transform(),
+	 * but the compiler has no way of knowing that.  This assert adds a
+	 * significant speed boost for gcc on 64-bit ARM, and a minor penalty
+	 * on other systems & compilers.
+	 */
+	assert(hwaccel != HW_UNSET);
+#endif
+
+	switch(hwaccel) {
+#if defined(CPUSUPPORT_X86_SHANI) && defined(CPUSUPPORT_X86_SSSE3)
+	case HW_X86_SHANI:
+		SHA256_Transform_shani(state, block);
+		return;
+#endif
+#if defined(CPUSUPPORT_X86_SSE2)
+	case HW_X86_SSE2:
+		SHA256_Transform_sse2(state, block, W, S);
+		return;
+#endif
+#if defined(CPUSUPPORT_ARM_SHA256)
+	case HW_ARM_SHA256:
+		SHA256_Transform_arm(state, block);
+		return;
+#endif
+	case HW_SOFTWARE:
+	case HW_UNSET:
+		break;
+	}
+#endif /* HWACCEL */
+
+	/* 1. Prepare the first part of the message schedule W. */
+	be32dec_vect(W, block, 64);
+
+	/* 2-4. Perform the transform. */
+	SHA256_Transform_W(state, W, S);
+}
+
+/*
+ * Apply the SHA256 block compression function to each of ${nblocks} blocks
+ * in turn.  Hardware implementations which can keep the state in registers
+ * across blocks are given all of the blocks at once.
+ */
+static void
+SHA256_Transform_blocks(uint32_t state[static restrict 8],
+    const uint8_t * restrict data, size_t nblocks,
+    uint32_t W[static restrict 64], uint32_t S[static restrict 8])
+{
+
+#ifdef HWACCEL
+	switch(hwaccel) {
+#if defined(CPUSUPPORT_X86_SHANI) && defined(CPUSUPPORT_X86_SSSE3)
+	case HW_X86_SHANI:
+		SHA256_Transform_shani_blocks(state, data, nblocks);
+		return;
+#endif
+#if defined(CPUSUPPORT_ARM_SHA256)
+	case HW_ARM_SHA256:
+		SHA256_Transform_arm_blocks(state, data, nblocks);
+		return;
+#endif
+#if defined(CPUSUPPORT_X86_SSE2)
+	case HW_X86_SSE2:
+#endif
+	case HW_SOFTWARE:
+	case HW_UNSET:
+		break;
+	}
+#endif /* HWACCEL */
+
+	/* Transform one block at a time. */
+	for (; nblocks > 0; nblocks--) {
+		SHA256_Transform(state, data, W, S);
+		data += 64;
+	}
+}
+
 static const uint8_t PAD[64] = {
 	0x80, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
 	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
@@ -410,11 +512,10 @@ _SHA256_Update(SHA256_CTX * ctx, const void * in, size_t len,
 	len -= 64 - r;
 
 	/* Perform complete blocks. */
-	while (len >= 64) {
-		SHA256_Transform(ctx->state, src, &tmp32[0], &tmp32[64]);
-		src += 64;
-		len -= 64;
-	}
+	SHA256_Transform_blocks(ctx->state, src, len / 64, &tmp32[0],
+	    &tmp32[64]);
+	src += len & ~(size_t)63;
+	len &= 63;
 
 	/* Copy left over data into buffer. */
 	memcpy(ctx->buf, src, len);
@@ -485,6 +586,64 @@ SHA256_Buf(const void * in, size_t len, uint8_t digest[32])
 	insecure_memzero(tmp32, sizeof(uint32_t) * 72);
 }
 
+/**
+ * SHA256_Update_public(ctx, in, len):
+ * Input ${len} bytes from ${in} into the SHA256 context ${ctx}, as
+ * SHA256_Update, without clearing intermediate values from the stack.
+ */
+void
+SHA256_Update_public(SHA256_CTX * ctx, const void * in, size_t len)
+{
+	uint32_t tmp32[72];
+
+	_SHA256_Update(ctx, in, len, tmp32);
+}
+
+/**
+ * SHA256_Final_public(digest, ctx):
+ * Output the SHA256 hash of the data input to the context ${ctx} into the
+ * buffer ${digest}, as SHA256_Final, without clearing intermediate values
+ * from the stack or clearing the context state.  The context must be
+ * reinitialized before it is used again.
+ */
+void
+SHA256_Final_public(uint8_t digest[32], SHA256_CTX * ctx)
+{
+	uint32_t tmp32[72];
+
+	_SHA256_Final(digest, ctx, tmp32);
+}
+
+/**
+ * SHA256_Buf_public(in, len, digest):
+ * Compute the SHA256 hash of ${len} bytes from ${in} and write it to
+ * ${digest}, as SHA256_Buf, without clearing intermediate values from the
+ * stack.
+ */
+void
+SHA256_Buf_public(const void * in, size_t len, uint8_t digest[32])
+{
+	SHA256_CTX ctx;
+	uint32_t tmp32[72];
+
+	SHA256_Init(&ctx);
+	_SHA256_Update(&ctx, in, len, tmp32);
+	_SHA256_Final(digest, &ctx, tmp32);
+}
+
+#ifdef HWACCEL
+/* Hash 4 kB of data using the implementation ${id}. */
+static void
+hwbench(int id)
+{
+	static const uint8_t buf[4096];
+	uint8_t digest[32];
+
+	hwaccel = id;
+	SHA256_Buf_public(buf, sizeof(buf), digest);
+}
+#endif
+
 /**
  * HMAC_SHA256_Init(ctx, K, Klen):
  * Initialize the HMAC-SHA256 context ${ctx} with ${Klen} bytes of key from
@@ -627,13 +786,169 @@ HMAC_SHA256_Buf(const void * K, size_t Klen, const void * in, size_t len,
 }
 
 /**
- * PBKDF2_SHA256(passwd, passwdlen, salt, saltlen, c, buf, dkLen):
- * Compute PBKDF2(passwd, salt, c, dkLen) using HMAC-SHA256 as the PRF, and
- * write the output to buf.  The value dkLen must be at most 32 * (2^32 - 1).
+ * HMAC_SHA256_Key_Init(key, K, Klen):
+ * Precompute the HMAC-SHA256 key ${key} from ${Klen} bytes of key from ${K},
+ * for use in computing many HMACs with the same key.
  */
 void
-PBKDF2_SHA256(const uint8_t * passwd, size_t passwdlen, const uint8_t * salt,
-    size_t saltlen, uint64_t c, uint8_t * buf, size_t dkLen)
+HMAC_SHA256_Key_Init(HMAC_SHA256_KEY * key, const void * K, size_t Klen)
+{
+	HMAC_SHA256_CTX ctx;
+	uint32_t tmp32[72];
+	uint8_t tmp8[96];
+
+	/* Absorb the padded key, and keep the resulting states. */
+	_HMAC_SHA256_Init(&ctx, K, Klen, tmp32, &tmp8[0], &tmp8[64]);
+	memcpy(key->istate, ctx.ictx.state, 32);
+	memcpy(key->ostate, ctx.octx.state, 32);
+
+	/* Clean the stack. */
+	insecure_memzero(&ctx, sizeof(HMAC_SHA256_CTX));
+	insecure_memzero(tmp32, sizeof(uint32_t) * 72);
+	insecure_memzero(tmp8, 96);
+}
+
+/**
+ * HMAC_SHA256_Init_prekeyed(ctx, key):
+ * Initialize the HMAC-SHA256 context ${ctx} with the precomputed key ${key};
+ * this is equivalent to HMAC_SHA256_Init with the original key, but performs
+ * no hashing.
+ */
+void
+HMAC_SHA256_Init_prekeyed(HMAC_SHA256_CTX * ctx, const HMAC_SHA256_KEY * key)
+{
+
+	/* Each SHA256 operation has absorbed one 64-byte block. */
+	memcpy(ctx->ictx.state, key->istate, 32);
+	ctx->ictx.count = 512;
+	memcpy(ctx->octx.state, key->ostate, 32);
+	ctx->octx.count = 512;
+}
+
+/*
+ * Padding for a 32-byte message following one 64-byte block, as bytes; i.e.,
+ * the last 32 bytes of the final block of the outer SHA256 operation in
+ * HMAC-SHA256.
+ */
+static const uint8_t PAD32B[32] = {
+	0x80, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0x03, 0x00
+};
+
+/**
+ * HMAC_SHA256_Buf_prekeyed(key, in, len, digest):
+ * Compute the HMAC-SHA256 of ${len} bytes from ${in} using the precomputed
+ * key ${key}, and write the result to ${digest}.  This requires one SHA256
+ * block compression more than hashing the message alone.
+ */
+void
+HMAC_SHA256_Buf_prekeyed(const HMAC_SHA256_KEY * key, const void * in,
+    size_t len, uint8_t digest[32])
+{
+	SHA256_CTX ctx;
+	uint32_t tmp32[72];
+	uint8_t block[64];
+	uint32_t state[8];
+
+	/* Inner SHA256 operation, starting from the precomputed state. */
+	memcpy(ctx.state, key->istate, 32);
+	ctx.count = 512;
+	_SHA256_Update(&ctx, in, len, tmp32);
+	_SHA256_Final(block, &ctx, tmp32);
+
+	/* Outer SHA256 operation: one pre-padded block. */
+	memcpy(&block[32], PAD32B, 32);
+	memcpy(state, key->ostate, 32);
+	SHA256_Transform(state, block, &tmp32[0], &tmp32[64]);
+	be32enc_vect(digest, state, 32);
+
+	/* Clean the stack. */
+	insecure_memzero(&ctx, sizeof(SHA256_CTX));
+	insecure_memzero(tmp32, sizeof(uint32_t) * 72);
+	insecure_memzero(block, 64);
+	insecure_memzero(state, 32);
+}
+
+/*
+ * Padding for a 32-byte message following one 64-byte block, i.e., the last
+ * eight words of the second (and final) block of each HMAC-SHA256 hash
+ * computed by PBKDF2 after the first iteration.
+ */
+static const uint32_t PAD32[8] = {
+	0x80000000, 0, 0, 0, 0, 0, 0, 0x00000300
+};
+
+/*
+ * Given the HMAC-SHA256 inner and outer states ${istate} and ${ostate} after
+ * absorbing the padded key, and U_1 in ${T} as 32-bit words, compute U_2 ...
+ * U_${c} and XOR them into ${T}.  Each U_j is hashed directly from pre-padded
+ * words, without going through the generic HMAC code.  The arrays W and S may
+ * be filled with sensitive data, and should be cleared by the callee.
+ */
+static void
+PBKDF2_SHA256_iterate(const uint32_t istate[static restrict 8],
+    const uint32_t ostate[static restrict 8], uint32_t T[static restrict 8],
+    uint64_t c, uint32_t W[static restrict 64], uint32_t S[static restrict 8])
+{
+	uint32_t U[8];
+	uint64_t j;
+	int k;
+
+#ifdef HWACCEL
+	/* Keep everything in registers if we can. */
+	switch (hwaccel) {
+#if defined(CPUSUPPORT_X86_SHANI) && defined(CPUSUPPORT_X86_SSSE3)
+	case HW_X86_SHANI:
+		PBKDF2_SHA256_iterate_shani(istate, ostate, T, c);
+		return;
+#endif
+#if defined(CPUSUPPORT_ARM_SHA256)
+	case HW_ARM_SHA256:
+		PBKDF2_SHA256_iterate_arm(istate, ostate, T, c);
+		return;
+#endif
+#if defined(CPUSUPPORT_X86_SSE2)
+	case HW_X86_SSE2:
+#endif
+	case HW_SOFTWARE:
+	case HW_UNSET:
+		break;
+	}
+#endif /* HWACCEL */
+
+	/* U_1 = T_i. */
+	memcpy(U, T, 32);
+
+	for (j = 2; j <= c; j++) {
+		/* Compute H(ipad || U_{j-1}). */
+		memcpy(&W[0], U, 32);
+		memcpy(&W[8], PAD32, 32);
+		memcpy(U, istate, 32);
+		SHA256_Transform_W(U, W, S);
+
+		/* Compute U_j = H(opad || H(ipad || U_{j-1})). */
+		memcpy(&W[0], U, 32);
+		memcpy(&W[8], PAD32, 32);
+		memcpy(U, ostate, 32);
+		SHA256_Transform_W(U, W, S);
+
+		/* ... xor U_j ... */
+		for (k = 0; k < 8; k++)
+			T[k] ^= U[k];
+	}
+
+	/* Clean the stack. */
+	insecure_memzero(U, 32);
+}
+
+/*
+ * Compute ${dkLen} bytes of PBKDF2(passwd, salt, c, ...) output using
+ * HMAC-SHA256 as the PRF, starting at the beginning of output block ${first}
+ * (counting from zero), and write them to buf.
+ */
+static void
+pbkdf2(const uint8_t * passwd, size_t passwdlen, const uint8_t * salt,
+    size_t saltlen, uint64_t c, uint8_t * buf, size_t first, size_t dkLen)
 {
 	HMAC_SHA256_CTX Phctx, PShctx, hctx;
 	uint32_t tmp32[72];
@@ -641,13 +956,12 @@ PBKDF2_SHA256(const uint8_t * passwd, size_t passwdlen, const uint8_t * salt,
 	size_t i;
 	uint8_t ivec[4];
 	uint8_t U[32];
-	uint8_t T[32];
-	uint64_t j;
-	int k;
+	uint32_t T[8];
+	uint8_t Tb[32];
 	size_t clen;
 
 	/* Sanity-check. */
-	assert(dkLen <= 32 * (size_t)(UINT32_MAX));
+	assert(first + (dkLen + 31) / 32 <= (size_t)(UINT32_MAX));
 
 	/* Compute HMAC state after processing P. */
 	_HMAC_SHA256_Init(&Phctx, passwd, passwdlen,
@@ -659,33 +973,27 @@ PBKDF2_SHA256(const uint8_t * passwd, size_t passwdlen, const uint8_t * salt,
 
 	/* Iterate through the blocks. */
 	for (i = 0; i * 32 < dkLen; i++) {
-		/* Generate INT(i + 1). */
-		be32enc(ivec, (uint32_t)(i + 1));
+		/* Generate INT(first + i + 1). */
+		be32enc(ivec, (uint32_t)(first + i + 1));
 
-		/* Compute U_1 = PRF(P, S || INT(i)). */
+		/* Compute U_1 = PRF(P, S || INT(first + i + 1)). */
 		memcpy(&hctx, &PShctx, sizeof(HMAC_SHA256_CTX));
 		_HMAC_SHA256_Update(&hctx, ivec, 4, tmp32);
 		_HMAC_SHA256_Final(U, &hctx, tmp32, tmp8);
 
 		/* T_i = U_1 ... */
-		memcpy(T, U, 32);
-
-		for (j = 2; j <= c; j++) {
-			/* Compute U_j. */
-			memcpy(&hctx, &Phctx, sizeof(HMAC_SHA256_CTX));
-			_HMAC_SHA256_Update(&hctx, U, 32, tmp32);
-			_HMAC_SHA256_Final(U, &hctx, tmp32, tmp8);
+		be32dec_vect(T, U, 32);
 
-			/* ... xor U_j ... */
-			for (k = 0; k < 32; k++)
-				T[k] ^= U[k];
-		}
+		/* ... xor U_2 ... xor U_c. */
+		PBKDF2_SHA256_iterate(Phctx.ictx.state, Phctx.octx.state, T, c,
+		    &tmp32[0], &tmp32[64]);
+		be32enc_vect(Tb, T, 32);
 
 		/* Copy as many bytes as necessary into buf. */
 		clen = dkLen - i * 32;
 		if (clen > 32)
 			clen = 32;
-		memcpy(&buf[i * 32], T, clen);
+		memcpy(&buf[i * 32], Tb, clen);
 	}
 
 	/* Clean the stack. */
@@ -696,4 +1004,40 @@ PBKDF2_SHA256(const uint8_t * passwd, size_t passwdlen, const uint8_t * salt,
 	insecure_memzero(tmp8, 96);
 	insecure_memzero(U, 32);
 	insecure_memzero(T, 32);
+	insecure_memzero(Tb, 32);
+}
+
+/**
+ * PBKDF2_SHA256(passwd, passwdlen, salt, saltlen, c, buf, dkLen):
+ * Compute PBKDF2(passwd, salt, c, dkLen) using HMAC-SHA256 as the PRF, and
+ * write the output to buf.  The value dkLen must be at most 32 * (2^32 - 1).
+ */
+void
+PBKDF2_SHA256(const uint8_t * passwd, size_t passwdlen, const uint8_t * salt,
+    size_t saltlen, uint64_t c, uint8_t * buf, size_t dkLen)
+{
+
+	/* Sanity-check. */
+	assert(dkLen <= 32 * (size_t)(UINT32_MAX));
+
+	/* Compute all of the output. */
+	pbkdf2(passwd, passwdlen, salt, saltlen, c, buf, 0, dkLen);
+}
+
+/**
+ * PBKDF2_SHA256_blocks(passwd, passwdlen, salt, saltlen, c, buf, first,
+ *     nblocks):
+ * Compute the ${nblocks} 32-byte blocks of PBKDF2(passwd, salt, c, ...)
+ * output starting with block ${first} (counting from zero) using HMAC-SHA256
+ * as the PRF, and write them to buf.  The value ${first} + ${nblocks} must be
+ * at most 2^32 - 1.
+ */
+void
+PBKDF2_SHA256_blocks(const uint8_t * passwd, size_t passwdlen,
+    const uint8_t * salt, size_t saltlen, uint64_t c, uint8_t * buf,
+    size_t first, size_t nblocks)
+{
+
+	/* Compute the requested blocks. */
+	pbkdf2(passwd, passwdlen, salt, saltlen, c, buf, first, nblocks * 32);
 }
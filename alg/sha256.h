@@ -12,12 +12,19 @@
 #define SHA256_Update libcperciva_SHA256_Update
 #define SHA256_Final libcperciva_SHA256_Final
 #define SHA256_Buf libcperciva_SHA256_Buf
+#define SHA256_Update_public libcperciva_SHA256_Update_public
+#define SHA256_Final_public libcperciva_SHA256_Final_public
+#define SHA256_Buf_public libcperciva_SHA256_Buf_public
 #define SHA256_CTX libcperciva_SHA256_CTX
 #define HMAC_SHA256_Init libcperciva_HMAC_SHA256_Init
 #define HMAC_SHA256_Update libcperciva_HMAC_SHA256_Update
 #define HMAC_SHA256_Final libcperciva_HMAC_SHA256_Final
 #define HMAC_SHA256_Buf libcperciva_HMAC_SHA256_Buf
 #define HMAC_SHA256_CTX libcperciva_HMAC_SHA256_CTX
+#define HMAC_SHA256_Key_Init libcperciva_HMAC_SHA256_Key_Init
+#define HMAC_SHA256_Init_prekeyed libcperciva_HMAC_SHA256_Init_prekeyed
+#define HMAC_SHA256_Buf_prekeyed libcperciva_HMAC_SHA256_Buf_prekeyed
+#define HMAC_SHA256_KEY libcperciva_HMAC_SHA256_KEY
 
 /* Context structure for SHA256 operations. */
 typedef struct {
@@ -51,6 +58,37 @@ void SHA256_Final(uint8_t[32], SHA256_CTX *);
  */
 void SHA256_Buf(const void *, size_t, uint8_t[32]);
 
+/*
+ * The functions above clear intermediate values from the stack, since the
+ * data being hashed may be secret.  The following functions do not, and
+ * should only be used to hash data which is not secret (e.g., checksums of
+ * public files); they may be mixed freely with the functions above.
+ */
+
+/**
+ * SHA256_Update_public(ctx, in, len):
+ * Input ${len} bytes from ${in} into the SHA256 context ${ctx}, as
+ * SHA256_Update, without clearing intermediate values from the stack.
+ */
+void SHA256_Update_public(SHA256_CTX *, const void *, size_t);
+
+/**
+ * SHA256_Final_public(digest, ctx):
+ * Output the SHA256 hash of the data input to the context ${ctx} into the
+ * buffer ${digest}, as SHA256_Final, without clearing intermediate values
+ * from the stack or clearing the context state.  The context must be
+ * reinitialized before it is used again.
+ */
+void SHA256_Final_public(uint8_t[32], SHA256_CTX *);
+
+/**
+ * SHA256_Buf_public(in, len, digest):
+ * Compute the SHA256 hash of ${len} bytes from ${in} and write it to
+ * ${digest}, as SHA256_Buf, without clearing intermediate values from the
+ * stack.
+ */
+void SHA256_Buf_public(const void *, size_t, uint8_t[32]);
+
 /* Context structure for HMAC-SHA256 operations. */
 typedef struct {
 	SHA256_CTX ictx;
@@ -84,6 +122,40 @@ void HMAC_SHA256_Final(uint8_t[32], HMAC_SHA256_CTX *);
  */
 void HMAC_SHA256_Buf(const void *, size_t, const void *, size_t, uint8_t[32]);
 
+/*
+ * Precomputed HMAC-SHA256 key: the SHA256 states after absorbing the key
+ * XORed with the inner and outer pads.  This contains secret data, and
+ * should be cleared with insecure_memzero when no longer needed.
+ */
+typedef struct {
+	uint32_t istate[8];
+	uint32_t ostate[8];
+} HMAC_SHA256_KEY;
+
+/**
+ * HMAC_SHA256_Key_Init(key, K, Klen):
+ * Precompute the HMAC-SHA256 key ${key} from ${Klen} bytes of key from ${K},
+ * for use in computing many HMACs with the same key.
+ */
+void HMAC_SHA256_Key_Init(HMAC_SHA256_KEY *, const void *, size_t);
+
+/**
+ * HMAC_SHA256_Init_prekeyed(ctx, key):
+ * Initialize the HMAC-SHA256 context ${ctx} with the precomputed key ${key};
+ * this is equivalent to HMAC_SHA256_Init with the original key, but performs
+ * no hashing.
+ */
+void HMAC_SHA256_Init_prekeyed(HMAC_SHA256_CTX *, const HMAC_SHA256_KEY *);
+
+/**
+ * HMAC_SHA256_Buf_prekeyed(key, in, len, digest):
+ * Compute the HMAC-SHA256 of ${len} bytes from ${in} using the precomputed
+ * key ${key}, and write the result to ${digest}.  This requires one SHA256
+ * block compression more than hashing the message alone.
+ */
+void HMAC_SHA256_Buf_prekeyed(const HMAC_SHA256_KEY *, const void *, size_t,
+    uint8_t[32]);
+
 /**
  * PBKDF2_SHA256(passwd, passwdlen, salt, saltlen, c, buf, dkLen):
  * Compute PBKDF2(passwd, salt, c, dkLen) using HMAC-SHA256 as the PRF, and
@@ -92,4 +164,15 @@ void HMAC_SHA256_Buf(const void *, size_t, const void *, size_t, uint8_t[32]);
 void PBKDF2_SHA256(const uint8_t *, size_t, const uint8_t *, size_t,
     uint64_t, uint8_t *, size_t);
 
+/**
+ * PBKDF2_SHA256_blocks(passwd, passwdlen, salt, saltlen, c, buf, first,
+ *     nblocks):
+ * Compute the ${nblocks} 32-byte blocks of PBKDF2(passwd, salt, c, ...)
+ * output starting with block ${first} (counting from zero) using HMAC-SHA256
+ * as the PRF, and write them to buf.  The value ${first} + ${nblocks} must be
+ * at most 2^32 - 1.
+ */
+void PBKDF2_SHA256_blocks(const uint8_t *, size_t, const uint8_t *, size_t,
+    uint64_t, uint8_t *, size_t, size_t);
+
 #endif /* !_SHA256_H_ */
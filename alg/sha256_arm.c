@@ -48,6 +48,81 @@ static const uint32_t Krnd[64] = {
 #define MSG4(X0, X1, X2, X3)					\
 	X0 = vsha256su1q_u32(vsha256su0q_u32(X0, X1), X2, X3)
 
+/* Transform ${_state} using the message words in ${Y}. */
+static inline void
+transform(uint32x4_t _state[2], uint32x4_t Y[4])
+{
+	uint32x4_t S[2];
+	int i;
+
+	/* Initialize working variables. */
+	S[0] = _state[0];
+	S[1] = _state[1];
+
+	/* Mix. */
+	for (i = 0; i < 64; i += 16) {
+		RND4(S, Y[0], &Krnd[i + 0]);
+		RND4(S, Y[1], &Krnd[i + 4]);
+		RND4(S, Y[2], &Krnd[i + 8]);
+		RND4(S, Y[3], &Krnd[i + 12]);
+
+		if (i == 48)
+			break;
+		MSG4(Y[0], Y[1], Y[2], Y[3]);
+		MSG4(Y[1], Y[2], Y[3], Y[0]);
+		MSG4(Y[2], Y[3], Y[0], Y[1]);
+		MSG4(Y[3], Y[0], Y[1], Y[2]);
+	}
+
+	/* Mix local working variables into global state. */
+	_state[0] = vaddq_u32(_state[0], S[0]);
+	_state[1] = vaddq_u32(_state[1], S[1]);
+}
+
+/**
+ * SHA256_Transform_arm_blocks(state, data, nblocks):
+ * Compute the SHA256 block compression function on each of the ${nblocks}
+ * 64-byte blocks in ${data} in turn, transforming ${state}.  The state is kept
+ * in registers from one block to the next.  This implementation uses ARM
+ * SHA256 instructions, and should only be used if _SHA256 is defined and
+ * cpusupport_arm_sha256() returns nonzero.
+ */
+#ifdef POSIXFAIL_ABSTRACT_DECLARATOR
+void
+SHA256_Transform_arm_blocks(uint32_t state[8], const uint8_t * data,
+    size_t nblocks)
+#else
+void
+SHA256_Transform_arm_blocks(uint32_t state[static restrict 8],
+    const uint8_t * restrict data, size_t nblocks)
+#endif
+{
+	uint32x4_t Y[4];
+	uint32x4_t _state[2];
+
+	/* Load state. */
+	_state[0] = vld1q_u32(&state[0]);
+	_state[1] = vld1q_u32(&state[4]);
+
+	for (; nblocks > 0; nblocks--) {
+		/* Prepare the first part of the message schedule W. */
+		Y[0] = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(&data[0])));
+		Y[1] = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(&data[16])));
+		Y[2] = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(&data[32])));
+		Y[3] = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(&data[48])));
+
+		/* Transform the state. */
+		transform(_state, Y);
+
+		/* Move on to the next block. */
+		data += 64;
+	}
+
+	/* Store state. */
+	vst1q_u32(&state[0], _state[0]);
+	vst1q_u32(&state[4], _state[1]);
+}
+
 /**
  * SHA256_Transform_arm(state, block, W, S):
  * Compute the SHA256 block compression function, transforming ${state} using
@@ -65,38 +140,75 @@ SHA256_Transform_arm(uint32_t state[static restrict 8],
     const uint8_t block[static restrict 64])
 #endif
 {
+
+	SHA256_Transform_arm_blocks(state, block, 1);
+}
+/* Padding for a 32-byte message following one 64-byte block. */
+static const uint32_t PAD32[8] = {
+	0x80000000, 0, 0, 0, 0, 0, 0, 0x00000300
+};
+
+/**
+ * PBKDF2_SHA256_iterate_arm(istate, ostate, T, c):
+ * Given the HMAC-SHA256 inner and outer states ${istate} and ${ostate} after
+ * absorbing the padded key, and U_1 in ${T} as 32-bit words, compute U_2 ...
+ * U_${c} and XOR them into ${T}.  This implementation uses ARM SHA256
+ * instructions, and should only be used if _SHA256 is defined and
+ * cpusupport_arm_sha256() returns nonzero.
+ */
+#ifdef POSIXFAIL_ABSTRACT_DECLARATOR
+void
+PBKDF2_SHA256_iterate_arm(const uint32_t istate[8], const uint32_t ostate[8],
+    uint32_t T[8], uint64_t c)
+#else
+void
+PBKDF2_SHA256_iterate_arm(const uint32_t istate[static restrict 8],
+    const uint32_t ostate[static restrict 8], uint32_t T[static restrict 8],
+    uint64_t c)
+#endif
+{
+	uint32x4_t I[2], O[2];
+	uint32x4_t H[2], U[2], _T[2];
+	uint32x4_t PAD[2];
 	uint32x4_t Y[4];
-	uint32x4_t S[2];
-	uint32x4_t _state[2];
-	int i;
+	uint64_t j;
 
-	/* 1. Prepare the first part of the message schedule W. */
-	Y[0] = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(&block[0])));
-	Y[1] = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(&block[16])));
-	Y[2] = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(&block[32])));
-	Y[3] = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(&block[48])));
+	/* Load the HMAC states, the padding, and T_i = U_1. */
+	I[0] = vld1q_u32(&istate[0]);
+	I[1] = vld1q_u32(&istate[4]);
+	O[0] = vld1q_u32(&ostate[0]);
+	O[1] = vld1q_u32(&ostate[4]);
+	PAD[0] = vld1q_u32(&PAD32[0]);
+	PAD[1] = vld1q_u32(&PAD32[4]);
+	U[0] = _T[0] = vld1q_u32(&T[0]);
+	U[1] = _T[1] = vld1q_u32(&T[4]);
 
-	/* 2. Initialize working variables. */
-	S[0] = _state[0] = vld1q_u32(&state[0]);
-	S[1] = _state[1] = vld1q_u32(&state[4]);
+	for (j = 2; j <= c; j++) {
+		/* Compute H(ipad || U_{j-1}). */
+		Y[0] = U[0];
+		Y[1] = U[1];
+		Y[2] = PAD[0];
+		Y[3] = PAD[1];
+		H[0] = I[0];
+		H[1] = I[1];
+		transform(H, Y);
 
-	/* 3. Mix. */
-	for (i = 0; i < 64; i += 16) {
-		RND4(S, Y[0], &Krnd[i + 0]);
-		RND4(S, Y[1], &Krnd[i + 4]);
-		RND4(S, Y[2], &Krnd[i + 8]);
-		RND4(S, Y[3], &Krnd[i + 12]);
+		/* Compute U_j = H(opad || H(ipad || U_{j-1})). */
+		Y[0] = H[0];
+		Y[1] = H[1];
+		Y[2] = PAD[0];
+		Y[3] = PAD[1];
+		U[0] = O[0];
+		U[1] = O[1];
+		transform(U, Y);
 
-		if (i == 48)
-			break;
-		MSG4(Y[0], Y[1], Y[2], Y[3]);
-		MSG4(Y[1], Y[2], Y[3], Y[0]);
-		MSG4(Y[2], Y[3], Y[0], Y[1]);
-		MSG4(Y[3], Y[0], Y[1], Y[2]);
+		/* ... xor U_j ... */
+		_T[0] = veorq_u32(_T[0], U[0]);
+		_T[1] = veorq_u32(_T[1], U[1]);
 	}
 
-	/* 4. Mix local working variables into global state. */
-	vst1q_u32(&state[0], vaddq_u32(_state[0], S[0]));
-	vst1q_u32(&state[4], vaddq_u32(_state[1], S[1]));
+	/* Store T_i. */
+	vst1q_u32(&T[0], _T[0]);
+	vst1q_u32(&T[4], _T[1]);
 }
 #endif /* CPUSUPPORT_ARM_SHA256 */
@@ -1,6 +1,7 @@
 #ifndef _SHA256_ARM_H_
 #define _SHA256_ARM_H_
 
+#include <stddef.h>
 #include <stdint.h>
 
 /**
@@ -18,4 +19,36 @@ void SHA256_Transform_arm(uint32_t[static restrict 8],
     const uint8_t[static restrict 64]);
 #endif
 
+/**
+ * SHA256_Transform_arm_blocks(state, data, nblocks):
+ * Compute the SHA256 block compression function on each of the ${nblocks}
+ * 64-byte blocks in ${data} in turn, transforming ${state}.  The state is kept
+ * in registers from one block to the next.  This implementation uses ARM
+ * SHA256 instructions, and should only be used if _SHA256 is defined and
+ * cpusupport_arm_sha256() returns nonzero.
+ */
+#ifdef POSIXFAIL_ABSTRACT_DECLARATOR
+void SHA256_Transform_arm_blocks(uint32_t state[8], const uint8_t * data,
+    size_t nblocks);
+#else
+void SHA256_Transform_arm_blocks(uint32_t[static restrict 8],
+    const uint8_t * restrict, size_t);
+#endif
+
+/**
+ * PBKDF2_SHA256_iterate_arm(istate, ostate, T, c):
+ * Given the HMAC-SHA256 inner and outer states ${istate} and ${ostate} after
+ * absorbing the padded key, and U_1 in ${T} as 32-bit words, compute U_2 ...
+ * U_${c} and XOR them into ${T}.  This implementation uses ARM SHA256
+ * instructions, and should only be used if _SHA256 is defined and
+ * cpusupport_arm_sha256() returns nonzero.
+ */
+#ifdef POSIXFAIL_ABSTRACT_DECLARATOR
+void PBKDF2_SHA256_iterate_arm(const uint32_t istate[8],
+    const uint32_t ostate[8], uint32_t T[8], uint64_t c);
+#else
+void PBKDF2_SHA256_iterate_arm(const uint32_t[static restrict 8],
+    const uint32_t[static restrict 8], uint32_t[static restrict 8], uint64_t);
+#endif
+
 #endif /* !_SHA256_ARM_H_ */
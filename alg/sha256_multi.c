@@ -0,0 +1,403 @@
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "cpusupport.h"
+#include "hwaccel.h"
+#include "insecure_memzero.h"
+#include "multilane.h"
+#include "sha256.h"
+#include "sha256_multi_arm.h"
+#include "sha256_multi_avx2.h"
+#include "sha256_multi_sse2.h"
+#include "sysendian.h"
+#include "warnp.h"
+
+#include "sha256_multi.h"
+
+/* Maximum number of messages which any transform handles at once. */
+#define MAXLANES 8
+
+/*
+ * If the single-message code has dedicated SHA256 instructions, messages of
+ * at least this length are faster to hash one at a time.
+ */
+#define SERIAL_MINLEN 448
+
+#if defined(CPUSUPPORT_X86_SSE2) ||					\
+    defined(CPUSUPPORT_X86_AVX2) ||					\
+    defined(CPUSUPPORT_ARM_NEON)
+#define HWACCEL
+
+static enum {
+	HW_SOFTWARE = 0,
+#if defined(CPUSUPPORT_X86_SSE2)
+	HW_X86_SSE2,
+#endif
+#if defined(CPUSUPPORT_X86_AVX2)
+	HW_X86_AVX2,
+#endif
+#if defined(CPUSUPPORT_ARM_NEON)
+	HW_ARM_NEON,
+#endif
+	HW_UNSET
+} hwaccel = HW_UNSET;
+
+/* Messages of at least this length are hashed one at a time. */
+static size_t serial_minlen = SIZE_MAX;
+
+#if defined(CPUSUPPORT_X86_SSE2)
+/* Has the 4-lane SSE2 code passed its self-test? */
+static int sse2_ok = 0;
+#endif
+
+/* Initial state of each message. */
+static const uint32_t initial_state[8] = {
+	0x6A09E667, 0xBB67AE85, 0x3C6EF372, 0xA54FF53A,
+	0x510E527F, 0x9B05688C, 0x1F83D9AB, 0x5BE0CD19
+};
+
+/* SHA256, for the lane scheduler. */
+static const struct multilane_alg sha256_alg = {
+	.nwords = 8,
+	.initial_state = initial_state,
+	.bigendian = 1
+};
+
+/*
+ * Hash those of the ${n} messages which are shorter than ${maxlen} using
+ * ${func}, which handles ${nlanes} messages at once.
+ */
+static void
+multi(multilane_transform func, size_t nlanes, const uint8_t * const * in,
+    const size_t * len, uint8_t (* digests)[32], size_t n, size_t maxlen)
+{
+
+	multilane_hash(&sha256_alg, func, nlanes, in, len, (uint8_t *)digests,
+	    n, maxlen);
+}
+
+/* Padding for a 32-byte message following one 64-byte block. */
+static const uint8_t PAD32[32] = {
+	0x80, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0x03, 0x00
+};
+
+/* Hash the blocks in ${block} into the ${nlanes} lanes of ${state}. */
+static void
+hash_lanes(multilane_transform func, size_t nlanes, uint32_t * state,
+    const uint32_t istate[8], uint8_t (* block)[64])
+{
+	const uint8_t * blocks[MAXLANES];
+	size_t i, l;
+
+	/* Start from the same state in every lane. */
+	for (i = 0; i < 8; i++) {
+		for (l = 0; l < nlanes; l++)
+			state[i * nlanes + l] = istate[i];
+	}
+
+	/* Hash one block in each lane. */
+	for (l = 0; l < nlanes; l++)
+		blocks[l] = block[l];
+	func(state, blocks);
+
+	/* The hashes are the first halves of the next blocks. */
+	for (i = 0; i < 8; i++) {
+		for (l = 0; l < nlanes; l++)
+			be32enc(&block[l][i * 4], state[i * nlanes + l]);
+	}
+}
+
+/*
+ * Compute the ${nblocks} 32-byte blocks of PBKDF2-SHA256 output starting with
+ * block ${first}, using ${func} to compute ${nlanes} of them at once.
+ */
+static void
+pbkdf2_multi(multilane_transform func, size_t nlanes, const uint8_t * passwd,
+    size_t passwdlen, const uint8_t * salt, size_t saltlen, uint64_t c,
+    uint8_t * buf, size_t first, size_t nblocks)
+{
+	HMAC_SHA256_CTX Phctx, PShctx, hctx;
+	uint8_t block[MAXLANES][64];
+	uint32_t state[8 * MAXLANES];
+	uint32_t T[8 * MAXLANES];
+	uint8_t ivec[4];
+	size_t b, i, l, nl;
+	uint64_t j;
+
+	/* Compute HMAC states after processing P, and after P and S. */
+	HMAC_SHA256_Init(&Phctx, passwd, passwdlen);
+	memcpy(&PShctx, &Phctx, sizeof(HMAC_SHA256_CTX));
+	HMAC_SHA256_Update(&PShctx, salt, saltlen);
+
+	/* Idle lanes hash zeros. */
+	memset(block, 0, sizeof(block));
+
+	/* Compute up to ${nlanes} output blocks at a time. */
+	for (b = 0; b < nblocks; b += nl) {
+		nl = (nblocks - b < nlanes) ? nblocks - b : nlanes;
+
+		/* Compute U_1 for each block, followed by padding. */
+		for (l = 0; l < nl; l++) {
+			be32enc(ivec, (uint32_t)(first + b + l + 1));
+			memcpy(&hctx, &PShctx, sizeof(HMAC_SHA256_CTX));
+			HMAC_SHA256_Update(&hctx, ivec, 4);
+			HMAC_SHA256_Final(block[l], &hctx);
+			memcpy(&block[l][32], PAD32, 32);
+		}
+
+		/* T_i = U_1 ... */
+		for (i = 0; i < 8; i++) {
+			for (l = 0; l < nlanes; l++)
+				T[i * nlanes + l] = be32dec(&block[l][i * 4]);
+		}
+
+		/* ... xor U_2 ... xor U_c. */
+		for (j = 2; j <= c; j++) {
+			hash_lanes(func, nlanes, state, Phctx.ictx.state,
+			    block);
+			hash_lanes(func, nlanes, state, Phctx.octx.state,
+			    block);
+			for (i = 0; i < 8 * nlanes; i++)
+				T[i] ^= state[i];
+		}
+
+		/* Write out the output blocks. */
+		for (l = 0; l < nl; l++) {
+			for (i = 0; i < 8; i++)
+				be32enc(&buf[(b + l) * 32 + i * 4],
+				    T[i * nlanes + l]);
+		}
+	}
+
+	/* Clean the stack. */
+	insecure_memzero(&Phctx, sizeof(HMAC_SHA256_CTX));
+	insecure_memzero(&PShctx, sizeof(HMAC_SHA256_CTX));
+	insecure_memzero(&hctx, sizeof(HMAC_SHA256_CTX));
+	insecure_memzero(block, sizeof(block));
+	insecure_memzero(state, sizeof(state));
+	insecure_memzero(T, sizeof(T));
+}
+
+/*
+ * Test whether hashing a set of messages of awkward lengths with ${func}
+ * gives the same results as hashing them one at a time.  Must be called
+ * with (hwaccel == HW_SOFTWARE).
+ */
+static int
+hwtest(multilane_transform func, size_t nlanes)
+{
+	uint8_t buf[256];
+	const uint8_t * in[11];
+	size_t len[11] = {0, 1, 55, 56, 63, 64, 65, 119, 120, 256, 3};
+	uint8_t digests_sw[11][32];
+	uint8_t digests_hw[11][32];
+	size_t i;
+
+	/* Test case: Messages which are prefixes of 0x00 0x01 0x02 ... */
+	for (i = 0; i < 256; i++)
+		buf[i] = (uint8_t)i;
+	for (i = 0; i < 11; i++)
+		in[i] = buf;
+
+	/* Hash the messages one at a time. */
+	for (i = 0; i < 11; i++)
+		SHA256_Buf(in[i], len[i], digests_sw[i]);
+
+	/* Hash the messages several at a time. */
+	multi(func, nlanes, in, len, digests_hw, 11, SIZE_MAX);
+
+	/* Do the results match? */
+	return (memcmp(digests_sw, digests_hw, sizeof(digests_sw)));
+}
+
+/* Has sha256.c chosen an implementation using SHA256 instructions? */
+static int
+serial_has_sha256_insns(void)
+{
+	static const uint8_t empty[1];
+	uint8_t digest[32];
+	const char * impl;
+
+	/* Make sure sha256.c has made its choice. */
+	SHA256_Buf_public(empty, 0, digest);
+
+	/* Ask which implementation it chose. */
+	if ((impl = hwaccel_selected("sha256")) == NULL)
+		return (0);
+	return ((strcmp(impl, "x86-shani") == 0) ||
+	    (strcmp(impl, "arm-sha256") == 0));
+}
+
+/* Which type of hardware acceleration should we use, if any? */
+static void
+hwaccel_init(void)
+{
+
+	/* If we've already set hwaccel, we're finished. */
+	if (hwaccel != HW_UNSET)
+		return;
+
+	/* Default to software. */
+	hwaccel = HW_SOFTWARE;
+
+	/*
+	 * Is the single-message code using dedicated SHA256 instructions?  If
+	 * so, they beat 4-lane SIMD at every length, and 8-lane SIMD for long
+	 * messages.
+	 */
+	if (serial_has_sha256_insns())
+		serial_minlen = SERIAL_MINLEN;
+
+#if defined(CPUSUPPORT_X86_SSE2)
+	/*
+	 * Test the SSE2 code even if we end up using AVX2, since the AVX2
+	 * path hands small remainders to it.
+	 */
+	if (cpusupport_x86_sse2()) {
+		if (hwtest(SHA256_Transform_multi_sse2, 4) == 0)
+			sse2_ok = 1;
+		else
+			warn0("Disabling HW_X86_SSE2 due to failed self-test");
+	}
+#endif
+
+#if defined(CPUSUPPORT_X86_AVX2)
+	CPUSUPPORT_VALIDATE(hwaccel, HW_X86_AVX2, cpusupport_x86_avx2(),
+	    hwtest(SHA256_Transform_multi_avx2, 8));
+#endif
+#if defined(CPUSUPPORT_X86_SSE2)
+	CPUSUPPORT_VALIDATE(hwaccel, HW_X86_SSE2,
+	    sse2_ok && (serial_minlen == SIZE_MAX), 0);
+#endif
+#if defined(CPUSUPPORT_ARM_NEON)
+	CPUSUPPORT_VALIDATE(hwaccel, HW_ARM_NEON,
+	    cpusupport_arm_neon() && (serial_minlen == SIZE_MAX),
+	    hwtest(SHA256_Transform_multi_arm, 4));
+#endif
+}
+#endif /* HWACCEL */
+
+/**
+ * SHA256_Buf_multi(in, len, digests, n):
+ * Compute the SHA256 hashes of the ${n} independent messages ${in}[i] of
+ * lengths ${len}[i], writing the hash of message i into ${digests}[i].  When
+ * SIMD hardware is available, several messages are hashed at once; this is
+ * most useful when there are many short messages to hash.
+ */
+void
+SHA256_Buf_multi(const uint8_t * const * in, const size_t * len,
+    uint8_t (* digests)[32], size_t n)
+{
+	size_t minlen = 0;
+	size_t i;
+
+#ifdef HWACCEL
+	/* Pick the best implementation. */
+	hwaccel_init();
+
+	/* Hash the shorter messages several at a time. */
+	switch (hwaccel) {
+#if defined(CPUSUPPORT_X86_AVX2)
+	case HW_X86_AVX2:
+		multi(SHA256_Transform_multi_avx2, 8, in, len, digests, n,
+		    serial_minlen);
+		minlen = serial_minlen;
+		break;
+#endif
+#if defined(CPUSUPPORT_X86_SSE2)
+	case HW_X86_SSE2:
+		multi(SHA256_Transform_multi_sse2, 4, in, len, digests, n,
+		    serial_minlen);
+		minlen = serial_minlen;
+		break;
+#endif
+#if defined(CPUSUPPORT_ARM_NEON)
+	case HW_ARM_NEON:
+		multi(SHA256_Transform_multi_arm, 4, in, len, digests, n,
+		    serial_minlen);
+		minlen = serial_minlen;
+		break;
+#endif
+	case HW_SOFTWARE:
+	case HW_UNSET:
+		break;
+	}
+#endif
+
+	/* Hash any remaining messages one at a time. */
+	for (i = 0; i < n; i++) {
+		if (len[i] >= minlen)
+			SHA256_Buf(in[i], len[i], digests[i]);
+	}
+}
+
+/**
+ * PBKDF2_SHA256_blocks_multi(passwd, passwdlen, salt, saltlen, c, buf, first,
+ *     nblocks):
+ * Compute the ${nblocks} 32-byte blocks of PBKDF2(passwd, salt, c, ...)
+ * output starting with block ${first} (counting from zero) using HMAC-SHA256
+ * as the PRF, and write them to buf, exactly as PBKDF2_SHA256_blocks.  When
+ * SIMD hardware is available and there are no dedicated SHA256 instructions,
+ * several output blocks are computed at once.
+ */
+void
+PBKDF2_SHA256_blocks_multi(const uint8_t * passwd, size_t passwdlen,
+    const uint8_t * salt, size_t saltlen, uint64_t c, uint8_t * buf,
+    size_t first, size_t nblocks)
+{
+#if defined(CPUSUPPORT_X86_AVX2) && defined(CPUSUPPORT_X86_SSE2)
+	size_t n;
+#endif
+
+#ifdef HWACCEL
+	/* Pick the best implementation. */
+	hwaccel_init();
+
+	/* Dedicated SHA256 instructions beat SIMD lanes for long hashes. */
+	if ((serial_minlen == SIZE_MAX) && (nblocks > 1)) {
+		switch (hwaccel) {
+#if defined(CPUSUPPORT_X86_AVX2)
+		case HW_X86_AVX2:
+#if defined(CPUSUPPORT_X86_SSE2)
+			/* Half-empty 8-lane groups are faster with 4 lanes. */
+			if ((nblocks % 8 > 0) && (nblocks % 8 <= 4) &&
+			    sse2_ok) {
+				n = nblocks - nblocks % 8;
+				pbkdf2_multi(SHA256_Transform_multi_avx2, 8,
+				    passwd, passwdlen, salt, saltlen, c, buf,
+				    first, n);
+				pbkdf2_multi(SHA256_Transform_multi_sse2, 4,
+				    passwd, passwdlen, salt, saltlen, c,
+				    &buf[n * 32], first + n, nblocks - n);
+				return;
+			}
+#endif
+			pbkdf2_multi(SHA256_Transform_multi_avx2, 8, passwd,
+			    passwdlen, salt, saltlen, c, buf, first, nblocks);
+			return;
+#endif
+#if defined(CPUSUPPORT_X86_SSE2)
+		case HW_X86_SSE2:
+			pbkdf2_multi(SHA256_Transform_multi_sse2, 4, passwd,
+			    passwdlen, salt, saltlen, c, buf, first, nblocks);
+			return;
+#endif
+#if defined(CPUSUPPORT_ARM_NEON)
+		case HW_ARM_NEON:
+			pbkdf2_multi(SHA256_Transform_multi_arm, 4, passwd,
+			    passwdlen, salt, saltlen, c, buf, first, nblocks);
+			return;
+#endif
+		case HW_SOFTWARE:
+		case HW_UNSET:
+			break;
+		}
+	}
+#endif
+
+	/* Compute the blocks one at a time. */
+	PBKDF2_SHA256_blocks(passwd, passwdlen, salt, saltlen, c, buf,
+	    first, nblocks);
+}
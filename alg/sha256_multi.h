@@ -0,0 +1,29 @@
+#ifndef _SHA256_MULTI_H_
+#define _SHA256_MULTI_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * SHA256_Buf_multi(in, len, digests, n):
+ * Compute the SHA256 hashes of the ${n} independent messages ${in}[i] of
+ * lengths ${len}[i], writing the hash of message i into ${digests}[i].  When
+ * SIMD hardware is available, several messages are hashed at once; this is
+ * most useful when there are many short messages to hash.
+ */
+void SHA256_Buf_multi(const uint8_t * const *, const size_t *,
+    uint8_t (*)[32], size_t);
+
+/**
+ * PBKDF2_SHA256_blocks_multi(passwd, passwdlen, salt, saltlen, c, buf, first,
+ *     nblocks):
+ * Compute the ${nblocks} 32-byte blocks of PBKDF2(passwd, salt, c, ...)
+ * output starting with block ${first} (counting from zero) using HMAC-SHA256
+ * as the PRF, and write them to buf, exactly as PBKDF2_SHA256_blocks.  When
+ * SIMD hardware is available and there are no dedicated SHA256 instructions,
+ * several output blocks are computed at once.
+ */
+void PBKDF2_SHA256_blocks_multi(const uint8_t *, size_t, const uint8_t *,
+    size_t, uint64_t, uint8_t *, size_t, size_t);
+
+#endif /* !_SHA256_MULTI_H_ */
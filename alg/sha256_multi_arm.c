@@ -0,0 +1,124 @@
+#include "cpusupport.h"
+#ifdef CPUSUPPORT_ARM_NEON
+/**
+ * CPUSUPPORT CFLAGS: ARM_NEON
+ */
+
+#include <stdint.h>
+
+#ifdef __ARM_NEON
+#include <arm_neon.h>
+#endif
+
+#include "sysendian.h"
+
+#include "sha256_multi_arm.h"
+
+/**
+ * We hold word i of the state (or of the message schedule) for four
+ * independent messages in vector i; each 32-bit lane is a separate message.
+ */
+
+/* SHA256 round constants. */
+static const uint32_t Krnd[64] = {
+	0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5,
+	0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+	0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3,
+	0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+	0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc,
+	0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+	0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7,
+	0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+	0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13,
+	0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+	0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3,
+	0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+	0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5,
+	0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+	0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208,
+	0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+/* Elementary functions used by SHA256, applied to each lane. */
+#define ADD(x, y)	vaddq_u32(x, y)
+#define XOR(x, y)	veorq_u32(x, y)
+#define SHR(x, n)	vshrq_n_u32(x, n)
+#define ROTR(x, n)	vsriq_n_u32(vshlq_n_u32(x, 32 - n), x, n)
+#define Ch(x, y, z)	XOR(vandq_u32(x, XOR(y, z)), z)
+#define Maj(x, y, z)	vorrq_u32(vandq_u32(x, vorrq_u32(y, z)),	\
+	vandq_u32(y, z))
+#define S0(x)		XOR(XOR(ROTR(x, 2), ROTR(x, 13)), ROTR(x, 22))
+#define S1(x)		XOR(XOR(ROTR(x, 6), ROTR(x, 11)), ROTR(x, 25))
+#define s0(x)		XOR(XOR(ROTR(x, 7), ROTR(x, 18)), SHR(x, 3))
+#define s1(x)		XOR(XOR(ROTR(x, 17), ROTR(x, 19)), SHR(x, 10))
+
+/**
+ * SHA256_Transform_multi_arm(state, blocks):
+ * Compute the SHA256 block compression function for four independent
+ * messages, transforming ${state} using the data in ${blocks}.  Word i of
+ * the state for message j is held in ${state}[4 * i + j], and the next block
+ * of message j is ${blocks}[j].  This implementation uses ARM NEON
+ * instructions, and should only be used if CPUSUPPORT_ARM_NEON is defined
+ * and cpusupport_arm_neon() returns nonzero.
+ */
+void
+SHA256_Transform_multi_arm(uint32_t state[static restrict 32],
+    const uint8_t * const blocks[static restrict 4])
+{
+	uint32_t Wt[16][4];
+	uint32x4_t W[64];
+	uint32x4_t S[8];
+	uint32x4_t a, b, c, d, e, f, g, h, T1, T2;
+	int i, j;
+
+	/* 1. Prepare the first part of the message schedule W. */
+	for (i = 0; i < 16; i++) {
+		for (j = 0; j < 4; j++)
+			Wt[i][j] = be32dec(&blocks[j][i * 4]);
+		W[i] = vld1q_u32(&Wt[i][0]);
+	}
+	for (i = 16; i < 64; i++)
+		W[i] = ADD(ADD(s1(W[i - 2]), W[i - 7]),
+		    ADD(s0(W[i - 15]), W[i - 16]));
+
+	/* 2. Initialize working variables. */
+	for (i = 0; i < 8; i++)
+		S[i] = vld1q_u32(&state[4 * i]);
+	a = S[0];
+	b = S[1];
+	c = S[2];
+	d = S[3];
+	e = S[4];
+	f = S[5];
+	g = S[6];
+	h = S[7];
+
+	/* 3. Mix. */
+	for (i = 0; i < 64; i++) {
+		T1 = ADD(ADD(ADD(h, S1(e)), Ch(e, f, g)),
+		    ADD(vdupq_n_u32(Krnd[i]), W[i]));
+		T2 = ADD(S0(a), Maj(a, b, c));
+		h = g;
+		g = f;
+		f = e;
+		e = ADD(d, T1);
+		d = c;
+		c = b;
+		b = a;
+		a = ADD(T1, T2);
+	}
+
+	/* 4. Mix local working variables into global state. */
+	S[0] = ADD(S[0], a);
+	S[1] = ADD(S[1], b);
+	S[2] = ADD(S[2], c);
+	S[3] = ADD(S[3], d);
+	S[4] = ADD(S[4], e);
+	S[5] = ADD(S[5], f);
+	S[6] = ADD(S[6], g);
+	S[7] = ADD(S[7], h);
+	for (i = 0; i < 8; i++)
+		vst1q_u32(&state[4 * i], S[i]);
+}
+
+#endif /* CPUSUPPORT_ARM_NEON */
@@ -0,0 +1,23 @@
+#ifndef _SHA256_MULTI_ARM_H_
+#define _SHA256_MULTI_ARM_H_
+
+#include <stdint.h>
+
+/**
+ * SHA256_Transform_multi_arm(state, blocks):
+ * Compute the SHA256 block compression function for four independent
+ * messages, transforming ${state} using the data in ${blocks}.  Word i of
+ * the state for message j is held in ${state}[4 * i + j], and the next block
+ * of message j is ${blocks}[j].  This implementation uses ARM NEON
+ * instructions, and should only be used if CPUSUPPORT_ARM_NEON is defined
+ * and cpusupport_arm_neon() returns nonzero.
+ */
+#ifdef POSIXFAIL_ABSTRACT_DECLARATOR
+void SHA256_Transform_multi_arm(uint32_t state[static restrict 32],
+    const uint8_t * const blocks[static restrict 4]);
+#else
+void SHA256_Transform_multi_arm(uint32_t[static restrict 32],
+    const uint8_t * const[static restrict 4]);
+#endif
+
+#endif /* !_SHA256_MULTI_ARM_H_ */
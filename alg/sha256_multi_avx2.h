@@ -0,0 +1,23 @@
+#ifndef _SHA256_MULTI_AVX2_H_
+#define _SHA256_MULTI_AVX2_H_
+
+#include <stdint.h>
+
+/**
+ * SHA256_Transform_multi_avx2(state, blocks):
+ * Compute the SHA256 block compression function for eight independent
+ * messages, transforming ${state} using the data in ${blocks}.  Word i of
+ * the state for message j is held in ${state}[8 * i + j], and the next block
+ * of message j is ${blocks}[j].  This implementation uses x86 AVX2
+ * instructions, and should only be used if CPUSUPPORT_X86_AVX2 is defined
+ * and cpusupport_x86_avx2() returns nonzero.
+ */
+#ifdef POSIXFAIL_ABSTRACT_DECLARATOR
+void SHA256_Transform_multi_avx2(uint32_t state[static restrict 64],
+    const uint8_t * const blocks[static restrict 8]);
+#else
+void SHA256_Transform_multi_avx2(uint32_t[static restrict 64],
+    const uint8_t * const[static restrict 8]);
+#endif
+
+#endif /* !_SHA256_MULTI_AVX2_H_ */
@@ -0,0 +1,23 @@
+#ifndef _SHA256_MULTI_SSE2_H_
+#define _SHA256_MULTI_SSE2_H_
+
+#include <stdint.h>
+
+/**
+ * SHA256_Transform_multi_sse2(state, blocks):
+ * Compute the SHA256 block compression function for four independent
+ * messages, transforming ${state} using the data in ${blocks}.  Word i of
+ * the state for message j is held in ${state}[4 * i + j], and the next block
+ * of message j is ${blocks}[j].  This implementation uses x86 SSE2
+ * instructions, and should only be used if CPUSUPPORT_X86_SSE2 is defined
+ * and cpusupport_x86_sse2() returns nonzero.
+ */
+#ifdef POSIXFAIL_ABSTRACT_DECLARATOR
+void SHA256_Transform_multi_sse2(uint32_t state[static restrict 32],
+    const uint8_t * const blocks[static restrict 4]);
+#else
+void SHA256_Transform_multi_sse2(uint32_t[static restrict 32],
+    const uint8_t * const[static restrict 4]);
+#endif
+
+#endif /* !_SHA256_MULTI_SSE2_H_ */
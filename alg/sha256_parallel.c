@@ -0,0 +1,132 @@
+#include <assert.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "insecure_memzero.h"
+#include "sha256_multi.h"
+#include "warnp.h"
+#include "workshare.h"
+
+#include "sha256_parallel.h"
+
+/* A share of the PBKDF2 output blocks. */
+struct pbkdf2_share {
+	const uint8_t * passwd;
+	size_t passwdlen;
+	const uint8_t * salt;
+	size_t saltlen;
+	uint64_t c;
+	uint8_t * out;
+	size_t first;
+	size_t nblocks;
+};
+
+/* Compute the output blocks in a share of the work. */
+static void *
+workthread(void * cookie)
+{
+	struct pbkdf2_share * S = cookie;
+
+	PBKDF2_SHA256_blocks_multi(S->passwd, S->passwdlen, S->salt,
+	    S->saltlen, S->c, S->out, S->first, S->nblocks);
+
+	return (NULL);
+}
+
+/**
+ * PBKDF2_SHA256_parallel(passwd, passwdlen, salt, saltlen, c, buf, dkLen,
+ *     nthreads):
+ * Compute PBKDF2(passwd, salt, c, dkLen) using HMAC-SHA256 as the PRF, and
+ * write the output to buf, exactly as PBKDF2_SHA256, but spread the 32-byte
+ * output blocks across up to ${nthreads} threads (including the calling
+ * thread).  Within each thread, several blocks are computed at once if SIMD
+ * hardware makes that faster.  The value dkLen must be at most
+ * 32 * (2^32 - 1).  Return 0 on success or -1 on error.
+ */
+int
+PBKDF2_SHA256_parallel(const uint8_t * passwd, size_t passwdlen,
+    const uint8_t * salt, size_t saltlen, uint64_t c, uint8_t * buf,
+    size_t dkLen, size_t nthreads)
+{
+	struct pbkdf2_share * shares;
+	struct pbkdf2_share * last;
+	uint8_t * lastbuf = NULL;
+	size_t nblocks = (dkLen + 31) / 32;
+	size_t i, pos;
+
+	/* Sanity-check. */
+	assert(dkLen <= 32 * (size_t)(UINT32_MAX));
+
+	/* Nothing to do? */
+	if (nblocks == 0)
+		return (0);
+
+	/* There's no point having more threads than output blocks. */
+	if (nthreads > nblocks)
+		nthreads = nblocks;
+	if (nthreads == 0)
+		nthreads = 1;
+
+	/* Allocate and divide up the work. */
+	if ((shares = calloc(nthreads, sizeof(struct pbkdf2_share))) == NULL) {
+		warnp("calloc");
+		goto err0;
+	}
+	for (i = pos = 0; i < nthreads; i++) {
+		shares[i].passwd = passwd;
+		shares[i].passwdlen = passwdlen;
+		shares[i].salt = salt;
+		shares[i].saltlen = saltlen;
+		shares[i].c = c;
+		shares[i].out = &buf[pos * 32];
+		shares[i].first = pos;
+		shares[i].nblocks = workshare_len(nblocks, nthreads, i);
+		pos += shares[i].nblocks;
+	}
+
+	/* If the final block is partial, the last share needs more space. */
+	last = &shares[nthreads - 1];
+	if (dkLen % 32) {
+		if ((lastbuf = malloc(last->nblocks * 32)) == NULL) {
+			warnp("malloc");
+			goto err1;
+		}
+		last->out = lastbuf;
+	}
+
+	/*
+	 * Pick which hardware acceleration to use before starting any
+	 * threads.
+	 */
+	SHA256_Buf_multi(NULL, NULL, NULL, 0);
+
+	/*
+	 * Compute the output blocks of each share; if this fails, threads
+	 * might still be running, so leak their state.
+	 */
+	if (workshare_run(workthread, shares, sizeof(struct pbkdf2_share),
+	    nthreads))
+		goto err0;
+
+	/* Copy out the end of the output. */
+	if (lastbuf != NULL) {
+		memcpy(&buf[last->first * 32], lastbuf,
+		    dkLen - last->first * 32);
+		insecure_memzero(lastbuf, last->nblocks * 32);
+		free(lastbuf);
+	}
+
+	/* Clean up. */
+	free(shares);
+
+	/* Success! */
+	return (0);
+
+err1:
+	free(shares);
+err0:
+	/* Failure! */
+	return (-1);
+}
@@ -0,0 +1,20 @@
+#ifndef _SHA256_PARALLEL_H_
+#define _SHA256_PARALLEL_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * PBKDF2_SHA256_parallel(passwd, passwdlen, salt, saltlen, c, buf, dkLen,
+ *     nthreads):
+ * Compute PBKDF2(passwd, salt, c, dkLen) using HMAC-SHA256 as the PRF, and
+ * write the output to buf, exactly as PBKDF2_SHA256, but spread the 32-byte
+ * output blocks across up to ${nthreads} threads (including the calling
+ * thread).  Within each thread, several blocks are computed at once if SIMD
+ * hardware makes that faster.  The value dkLen must be at most
+ * 32 * (2^32 - 1).  Return 0 on success or -1 on error.
+ */
+int PBKDF2_SHA256_parallel(const uint8_t *, size_t, const uint8_t *, size_t,
+    uint64_t, uint8_t *, size_t, size_t);
+
+#endif /* !_SHA256_PARALLEL_H_ */
@@ -5,6 +5,7 @@
  */
 
 #include <immintrin.h>
+#include <stddef.h>
 #include <stdint.h>
 
 #include "sha256_shani.h"
@@ -73,42 +74,18 @@ be32dec_128(const uint8_t * src)
 		MSG4(W, i + 4);					\
 } while (0)
 
-/**
- * SHA256_Transform_shani(state, block):
- * Compute the SHA256 block compression function, transforming ${state} using
- * the data in ${block}.  This implementation uses x86 SHANI and SSSE3
- * instructions, and should only be used if CPUSUPPORT_X86_SHANI and _SSSE3
- * are defined and cpusupport_x86_shani() and _ssse3() return nonzero.
+/*
+ * Transform the state, held in the order (S0145, S2367), using the message
+ * words in ${W}.
  */
-void
-SHA256_Transform_shani(uint32_t state[static restrict 8],
-    const uint8_t block[static restrict 64])
+static inline void
+transform_W(__m128i * S0145, __m128i * S2367, __m128i W[4])
 {
-	__m128i S3210, S7654;
-	__m128i S0123, S4567;
-	__m128i S0145, S2367;
-	__m128i W[4];
 	__m128i S[2];
 
-	/* Load state. */
-	S3210 = _mm_loadu_si128((const __m128i *)&state[0]);
-	S7654 = _mm_loadu_si128((const __m128i *)&state[4]);
-
-	/* Shuffle the 8 32-bit values into the order we need them. */
-	S0123 = _mm_shuffle_epi32(S3210, 0x1B);
-	S4567 = _mm_shuffle_epi32(S7654, 0x1B);
-	S0145 = _mm_unpackhi_epi64(S4567, S0123);
-	S2367 = _mm_unpacklo_epi64(S4567, S0123);
-
-	/* Load input block; this is the start of the message schedule. */
-	W[0] = be32dec_128(&block[0]);
-	W[1] = be32dec_128(&block[16]);
-	W[2] = be32dec_128(&block[32]);
-	W[3] = be32dec_128(&block[48]);
-
 	/* Initialize working variables. */
-	S[0] = S0145;
-	S[1] = S2367;
+	S[0] = *S0145;
+	S[1] = *S2367;
 
 	/* Perform 64 rounds, 4 at a time. */
 	RNDMSG(S, W, 0, 0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5);
@@ -129,15 +106,158 @@ SHA256_Transform_shani(uint32_t state[static restrict 8],
 	RNDMSG(S, W, 15, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2);
 
 	/* Mix local working variables into global state. */
-	S0145 = _mm_add_epi32(S0145, S[0]);
-	S2367 = _mm_add_epi32(S2367, S[1]);
+	*S0145 = _mm_add_epi32(*S0145, S[0]);
+	*S2367 = _mm_add_epi32(*S2367, S[1]);
+}
+
+/* Transform the state, held in the order (S0145, S2367), using ${block}. */
+static inline void
+transform(__m128i * S0145, __m128i * S2367, const uint8_t * block)
+{
+	__m128i W[4];
+
+	/* Load input block; this is the start of the message schedule. */
+	W[0] = be32dec_128(&block[0]);
+	W[1] = be32dec_128(&block[16]);
+	W[2] = be32dec_128(&block[32]);
+	W[3] = be32dec_128(&block[48]);
+
+	/* Perform the transform. */
+	transform_W(S0145, S2367, W);
+}
+
+/* Shuffle the state from word order into the order we need it. */
+static inline void
+state_in(__m128i S3210, __m128i S7654, __m128i * S0145, __m128i * S2367)
+{
+	__m128i S0123, S4567;
+
+	S0123 = _mm_shuffle_epi32(S3210, 0x1B);
+	S4567 = _mm_shuffle_epi32(S7654, 0x1B);
+	*S0145 = _mm_unpackhi_epi64(S4567, S0123);
+	*S2367 = _mm_unpacklo_epi64(S4567, S0123);
+}
+
+/* Shuffle the state back into word order. */
+static inline void
+state_out(__m128i S0145, __m128i S2367, __m128i * S3210, __m128i * S7654)
+{
+	__m128i S0123, S4567;
 
-	/* Shuffle state back to the original word order and store. */
 	S0123 = _mm_unpackhi_epi64(S2367, S0145);
 	S4567 = _mm_unpacklo_epi64(S2367, S0145);
-	S3210 = _mm_shuffle_epi32(S0123, 0x1B);
-	S7654 = _mm_shuffle_epi32(S4567, 0x1B);
+	*S3210 = _mm_shuffle_epi32(S0123, 0x1B);
+	*S7654 = _mm_shuffle_epi32(S4567, 0x1B);
+}
+
+/**
+ * SHA256_Transform_shani_blocks(state, data, nblocks):
+ * Compute the SHA256 block compression function on each of the ${nblocks}
+ * 64-byte blocks in ${data} in turn, transforming ${state}.  The state is kept
+ * in registers from one block to the next.  This implementation uses x86
+ * SHANI and SSSE3 instructions, and should only be used if
+ * CPUSUPPORT_X86_SHANI and _SSSE3 are defined and cpusupport_x86_shani() and
+ * _ssse3() return nonzero.
+ */
+void
+SHA256_Transform_shani_blocks(uint32_t state[static restrict 8],
+    const uint8_t * restrict data, size_t nblocks)
+{
+	__m128i S3210, S7654;
+	__m128i S0145, S2367;
+
+	/* Load state. */
+	S3210 = _mm_loadu_si128((const __m128i *)&state[0]);
+	S7654 = _mm_loadu_si128((const __m128i *)&state[4]);
+
+	/* Shuffle the 8 32-bit values into the order we need them. */
+	state_in(S3210, S7654, &S0145, &S2367);
+
+	/* Process the blocks. */
+	for (; nblocks > 0; nblocks--) {
+		transform(&S0145, &S2367, data);
+		data += 64;
+	}
+
+	/* Shuffle state back to the original word order and store. */
+	state_out(S0145, S2367, &S3210, &S7654);
 	_mm_storeu_si128((__m128i *)&state[0], S3210);
 	_mm_storeu_si128((__m128i *)&state[4], S7654);
 }
+
+/**
+ * SHA256_Transform_shani(state, block):
+ * Compute the SHA256 block compression function, transforming ${state} using
+ * the data in ${block}.  This implementation uses x86 SHANI and SSSE3
+ * instructions, and should only be used if CPUSUPPORT_X86_SHANI and _SSSE3
+ * are defined and cpusupport_x86_shani() and _ssse3() return nonzero.
+ */
+void
+SHA256_Transform_shani(uint32_t state[static restrict 8],
+    const uint8_t block[static restrict 64])
+{
+
+	SHA256_Transform_shani_blocks(state, block, 1);
+}
+/**
+ * PBKDF2_SHA256_iterate_shani(istate, ostate, T, c):
+ * Given the HMAC-SHA256 inner and outer states ${istate} and ${ostate} after
+ * absorbing the padded key, and U_1 in ${T} as 32-bit words, compute U_2 ...
+ * U_${c} and XOR them into ${T}.  This implementation uses x86 SHANI and
+ * SSSE3 instructions, and should only be used if CPUSUPPORT_X86_SHANI and
+ * _SSSE3 are defined and cpusupport_x86_shani() and _ssse3() return nonzero.
+ */
+void
+PBKDF2_SHA256_iterate_shani(const uint32_t istate[static restrict 8],
+    const uint32_t ostate[static restrict 8], uint32_t T[static restrict 8],
+    uint64_t c)
+{
+	/* Padding for a 32-byte message following one 64-byte block. */
+	const __m128i PAD0 = IMM4(0, 0, 0, 0x80000000);
+	const __m128i PAD1 = IMM4(0x00000300, 0, 0, 0);
+	__m128i I0145, I2367, O0145, O2367;
+	__m128i S0145, S2367;
+	__m128i T3210, T7654;
+	__m128i U3210, U7654;
+	__m128i W[4];
+	uint64_t j;
+
+	/* Load the HMAC states and shuffle them into the order we need. */
+	state_in(_mm_loadu_si128((const __m128i *)&istate[0]),
+	    _mm_loadu_si128((const __m128i *)&istate[4]), &I0145, &I2367);
+	state_in(_mm_loadu_si128((const __m128i *)&ostate[0]),
+	    _mm_loadu_si128((const __m128i *)&ostate[4]), &O0145, &O2367);
+
+	/* Load T_i = U_1. */
+	U3210 = T3210 = _mm_loadu_si128((const __m128i *)&T[0]);
+	U7654 = T7654 = _mm_loadu_si128((const __m128i *)&T[4]);
+
+	for (j = 2; j <= c; j++) {
+		/* Compute H(ipad || U_{j-1}). */
+		W[0] = U3210;
+		W[1] = U7654;
+		W[2] = PAD0;
+		W[3] = PAD1;
+		S0145 = I0145;
+		S2367 = I2367;
+		transform_W(&S0145, &S2367, W);
+
+		/* Compute U_j = H(opad || H(ipad || U_{j-1})). */
+		state_out(S0145, S2367, &W[0], &W[1]);
+		W[2] = PAD0;
+		W[3] = PAD1;
+		S0145 = O0145;
+		S2367 = O2367;
+		transform_W(&S0145, &S2367, W);
+		state_out(S0145, S2367, &U3210, &U7654);
+
+		/* ... xor U_j ... */
+		T3210 = _mm_xor_si128(T3210, U3210);
+		T7654 = _mm_xor_si128(T7654, U7654);
+	}
+
+	/* Store T_i. */
+	_mm_storeu_si128((__m128i *)&T[0], T3210);
+	_mm_storeu_si128((__m128i *)&T[4], T7654);
+}
 #endif /* CPUSUPPORT_X86_SHANI && CPUSUPPORT_X86_SSSE3 */
@@ -1,6 +1,7 @@
 #ifndef _SHA256_SHANI_H_
 #define _SHA256_SHANI_H_
 
+#include <stddef.h>
 #include <stdint.h>
 
 /**
@@ -18,4 +19,38 @@ void SHA256_Transform_shani(uint32_t[static restrict 8],
     const uint8_t[static restrict 64]);
 #endif
 
+/**
+ * SHA256_Transform_shani_blocks(state, data, nblocks):
+ * Compute the SHA256 block compression function on each of the ${nblocks}
+ * 64-byte blocks in ${data} in turn, transforming ${state}.  The state is kept
+ * in registers from one block to the next.  This implementation uses x86
+ * SHANI and SSSE3 instructions, and should only be used if
+ * CPUSUPPORT_X86_SHANI and _SSSE3 are defined and cpusupport_x86_shani() and
+ * _ssse3() return nonzero.
+ */
+#ifdef POSIXFAIL_ABSTRACT_DECLARATOR
+void SHA256_Transform_shani_blocks(uint32_t state[static restrict 8],
+    const uint8_t * restrict data, size_t nblocks);
+#else
+void SHA256_Transform_shani_blocks(uint32_t[static restrict 8],
+    const uint8_t * restrict, size_t);
+#endif
+
+/**
+ * PBKDF2_SHA256_iterate_shani(istate, ostate, T, c):
+ * Given the HMAC-SHA256 inner and outer states ${istate} and ${ostate} after
+ * absorbing the padded key, and U_1 in ${T} as 32-bit words, compute U_2 ...
+ * U_${c} and XOR them into ${T}.  This implementation uses x86 SHANI and
+ * SSSE3 instructions, and should only be used if CPUSUPPORT_X86_SHANI and
+ * _SSSE3 are defined and cpusupport_x86_shani() and _ssse3() return nonzero.
+ */
+#ifdef POSIXFAIL_ABSTRACT_DECLARATOR
+void PBKDF2_SHA256_iterate_shani(const uint32_t istate[static restrict 8],
+    const uint32_t ostate[static restrict 8], uint32_t T[static restrict 8],
+    uint64_t c);
+#else
+void PBKDF2_SHA256_iterate_shani(const uint32_t[static restrict 8],
+    const uint32_t[static restrict 8], uint32_t[static restrict 8], uint64_t);
+#endif
+
 #endif /* !_SHA256_SHANI_H_ */
@@ -0,0 +1,301 @@
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "insecure_memzero.h"
+#include "sha256.h"
+#include "sha256_multi.h"
+#include "warnp.h"
+#include "workshare.h"
+
+#include "sha256_tree.h"
+
+/*
+ * Hash at most this many chunks between starting and joining threads; this
+ * limits the memory needed for chunk hashes, while making the cost of
+ * starting threads negligible.
+ */
+#define BATCHLEN 1024
+
+/* Number of chunks to pass to SHA256_Buf_multi at once. */
+#define MULTILEN 8
+
+/* A share of the chunks. */
+struct tree_share {
+	const uint8_t * buf;
+	size_t nchunks;
+	uint8_t (* hashes)[32];
+};
+
+/* Add the hash ${h} of the next chunk to the tree. */
+static void
+push(SHA256_TREE_CTX * ctx, const uint8_t h[32])
+{
+	SHA256_CTX hctx;
+	uint8_t node[32];
+	size_t k;
+
+	/* Merge with the complete subtrees of 1, 2, 4, ... chunks. */
+	memcpy(node, h, 32);
+	for (k = 0; ctx->nleaves & ((uint64_t)1 << k); k++) {
+		SHA256_Init(&hctx);
+		SHA256_Update(&hctx, ctx->stack[k], 32);
+		SHA256_Update(&hctx, node, 32);
+		SHA256_Final(node, &hctx);
+	}
+
+	/* We now have a complete subtree of 2^k chunks. */
+	memcpy(ctx->stack[k], node, 32);
+	ctx->nleaves++;
+}
+
+/* Hash the chunks in a share of the work. */
+static void *
+workthread(void * cookie)
+{
+	struct tree_share * S = cookie;
+	const uint8_t * in[MULTILEN];
+	size_t len[MULTILEN];
+	size_t i, j, n;
+
+	for (i = 0; i < S->nchunks; i += n) {
+		n = (S->nchunks - i > MULTILEN) ? MULTILEN : S->nchunks - i;
+		for (j = 0; j < n; j++) {
+			in[j] = &S->buf[(i + j) * SHA256_TREE_CHUNKLEN];
+			len[j] = SHA256_TREE_CHUNKLEN;
+		}
+		SHA256_Buf_multi(in, len, &S->hashes[i], n);
+	}
+
+	return (NULL);
+}
+
+/*
+ * Hash ${nchunks} complete chunks from ${buf} using up to ${nthreads}.  On
+ * failure, threads might still be writing to ${hashes}, so it must not be
+ * freed.
+ */
+static int
+hashchunks(const uint8_t * buf, size_t nchunks, uint8_t (* hashes)[32],
+    size_t nthreads)
+{
+	struct tree_share * shares;
+	size_t i, pos;
+
+	/* There's no point having more threads than chunks. */
+	if (nthreads > nchunks)
+		nthreads = nchunks;
+	if (nthreads == 0)
+		nthreads = 1;
+
+	/* Allocate and divide up the work. */
+	if ((shares = calloc(nthreads, sizeof(struct tree_share))) == NULL) {
+		warnp("calloc");
+		goto err0;
+	}
+	for (i = pos = 0; i < nthreads; i++) {
+		shares[i].buf = &buf[pos * SHA256_TREE_CHUNKLEN];
+		shares[i].hashes = &hashes[pos];
+		shares[i].nchunks = workshare_len(nchunks, nthreads, i);
+		pos += shares[i].nchunks;
+	}
+
+	/*
+	 * Hash the chunks in each share; if this fails, threads might still
+	 * be running, so leak their state.
+	 */
+	if (workshare_run(workthread, shares, sizeof(struct tree_share),
+	    nthreads))
+		goto err0;
+
+	/* Clean up. */
+	free(shares);
+
+	/* Success! */
+	return (0);
+
+err0:
+	/* Failure! */
+	return (-1);
+}
+
+/**
+ * SHA256_Tree_Init(ctx):
+ * Initialize the SHA256 tree hashing context ${ctx}.
+ */
+void
+SHA256_Tree_Init(SHA256_TREE_CTX * ctx)
+{
+
+	SHA256_Init(&ctx->leaf);
+	ctx->leaflen = 0;
+	ctx->nleaves = 0;
+}
+
+/**
+ * SHA256_Tree_Update(ctx, in, len):
+ * Input ${len} bytes from ${in} into the SHA256 tree hashing context ${ctx}.
+ */
+void
+SHA256_Tree_Update(SHA256_TREE_CTX * ctx, const void * in, size_t len)
+{
+	const uint8_t * src = in;
+	uint8_t h[32];
+	size_t n;
+
+	while (len > 0) {
+		/* Add as much as we can to the current chunk. */
+		n = SHA256_TREE_CHUNKLEN - ctx->leaflen;
+		if (n > len)
+			n = len;
+		SHA256_Update(&ctx->leaf, src, n);
+		ctx->leaflen += n;
+		src += n;
+		len -= n;
+
+		/* If the chunk is complete, add it to the tree. */
+		if (ctx->leaflen == SHA256_TREE_CHUNKLEN) {
+			SHA256_Final(h, &ctx->leaf);
+			push(ctx, h);
+			SHA256_Init(&ctx->leaf);
+			ctx->leaflen = 0;
+		}
+	}
+}
+
+/**
+ * SHA256_Tree_Update_parallel(ctx, in, len, nthreads):
+ * Input ${len} bytes from ${in} into the SHA256 tree hashing context ${ctx},
+ * as SHA256_Tree_Update, but hash the complete chunks using up to
+ * ${nthreads} threads (including the calling thread).  Return 0 on success
+ * or -1 on error; on error, the state of ${ctx} is undefined.
+ */
+int
+SHA256_Tree_Update_parallel(SHA256_TREE_CTX * ctx, const void * in,
+    size_t len, size_t nthreads)
+{
+	const uint8_t * src = in;
+	uint8_t (* hashes)[32];
+	size_t nchunks;
+	size_t n, i;
+
+	/* Finish any partial chunk. */
+	if (ctx->leaflen > 0) {
+		n = SHA256_TREE_CHUNKLEN - ctx->leaflen;
+		if (n > len)
+			n = len;
+		SHA256_Tree_Update(ctx, src, n);
+		src += n;
+		len -= n;
+	}
+
+	/* Nothing to do in parallel? */
+	if ((nchunks = len / SHA256_TREE_CHUNKLEN) == 0)
+		goto done;
+
+	/* Allocate space for a batch of chunk hashes. */
+	n = (nchunks > BATCHLEN) ? BATCHLEN : nchunks;
+	if ((hashes = malloc(n * 32)) == NULL) {
+		warnp("malloc");
+		goto err0;
+	}
+
+	/*
+	 * Pick which hardware acceleration to use before starting any
+	 * threads.
+	 */
+	SHA256_Buf_multi(NULL, NULL, NULL, 0);
+
+	/* Hash batches of chunks in parallel, then add them to the tree. */
+	for (; nchunks > 0; nchunks -= n) {
+		n = (nchunks > BATCHLEN) ? BATCHLEN : nchunks;
+		if (hashchunks(src, n, hashes, nthreads)) {
+			/* Threads might still be using it; leak ${hashes}. */
+			goto err0;
+		}
+		for (i = 0; i < n; i++)
+			push(ctx, hashes[i]);
+		src += n * SHA256_TREE_CHUNKLEN;
+		len -= n * SHA256_TREE_CHUNKLEN;
+	}
+
+	/* Clean up. */
+	free(hashes);
+
+done:
+	/* Start the next chunk with whatever is left. */
+	SHA256_Tree_Update(ctx, src, len);
+
+	/* Success! */
+	return (0);
+
+err0:
+	/* Failure! */
+	return (-1);
+}
+
+/**
+ * SHA256_Tree_Final(digest, ctx):
+ * Output the SHA256 tree hash of the data input to the context ${ctx} into
+ * the buffer ${digest}, and clear the context state.
+ */
+void
+SHA256_Tree_Final(uint8_t digest[32], SHA256_TREE_CTX * ctx)
+{
+	SHA256_CTX hctx;
+	uint8_t node[32];
+	size_t k;
+
+	/* Add the final partial chunk, or an empty chunk if there's no data. */
+	if ((ctx->leaflen > 0) || (ctx->nleaves == 0)) {
+		SHA256_Final(node, &ctx->leaf);
+		push(ctx, node);
+	}
+
+	/*
+	 * Merge the complete subtrees from the smallest up; this carries an
+	 * unpaired node up the tree exactly as level-by-level pairing does.
+	 */
+	for (k = 0; (ctx->nleaves & ((uint64_t)1 << k)) == 0; k++)
+		continue;
+	memcpy(node, ctx->stack[k], 32);
+	for (k++; k < 64; k++) {
+		if ((ctx->nleaves & ((uint64_t)1 << k)) == 0)
+			continue;
+		SHA256_Init(&hctx);
+		SHA256_Update(&hctx, ctx->stack[k], 32);
+		SHA256_Update(&hctx, node, 32);
+		SHA256_Final(node, &hctx);
+	}
+	memcpy(digest, node, 32);
+
+	/* Clear the context state. */
+	insecure_memzero(ctx, sizeof(SHA256_TREE_CTX));
+	insecure_memzero(node, 32);
+}
+
+/**
+ * SHA256_Tree_Buf(in, len, digest, nthreads):
+ * Compute the SHA256 tree hash of ${len} bytes from ${in} using up to
+ * ${nthreads} threads, and write it to ${digest}.  Return 0 on success or
+ * -1 on error.
+ */
+int
+SHA256_Tree_Buf(const void * in, size_t len, uint8_t digest[32],
+    size_t nthreads)
+{
+	SHA256_TREE_CTX ctx;
+
+	SHA256_Tree_Init(&ctx);
+	if (SHA256_Tree_Update_parallel(&ctx, in, len, nthreads))
+		goto err0;
+	SHA256_Tree_Final(digest, &ctx);
+
+	/* Success! */
+	return (0);
+
+err0:
+	/* Failure! */
+	return (-1);
+}
@@ -0,0 +1,66 @@
+#ifndef _SHA256_TREE_H_
+#define _SHA256_TREE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "sha256.h"
+
+/**
+ * SHA256 tree hashing: the input is split into chunks of
+ * SHA256_TREE_CHUNKLEN bytes (the last of which may be shorter, and which
+ * is empty only if the input is empty), each chunk is hashed with SHA256,
+ * and then adjacent pairs of hashes are concatenated and hashed until one
+ * hash remains; at each level, an unpaired final hash is carried up to the
+ * next level unchanged.  This is the "tree hash" used by Amazon Glacier.
+ * Because the chunks are hashed independently, the hash can be computed
+ * using several threads, and the result does not depend on how many.
+ */
+#define SHA256_TREE_CHUNKLEN 1048576
+
+/* Context structure for SHA256 tree hashing operations. */
+typedef struct {
+	SHA256_CTX leaf;
+	size_t leaflen;
+	uint64_t nleaves;
+	uint8_t stack[64][32];
+} SHA256_TREE_CTX;
+
+/**
+ * SHA256_Tree_Init(ctx):
+ * Initialize the SHA256 tree hashing context ${ctx}.
+ */
+void SHA256_Tree_Init(SHA256_TREE_CTX *);
+
+/**
+ * SHA256_Tree_Update(ctx, in, len):
+ * Input ${len} bytes from ${in} into the SHA256 tree hashing context ${ctx}.
+ */
+void SHA256_Tree_Update(SHA256_TREE_CTX *, const void *, size_t);
+
+/**
+ * SHA256_Tree_Update_parallel(ctx, in, len, nthreads):
+ * Input ${len} bytes from ${in} into the SHA256 tree hashing context ${ctx},
+ * as SHA256_Tree_Update, but hash the complete chunks using up to
+ * ${nthreads} threads (including the calling thread).  Return 0 on success
+ * or -1 on error; on error, the state of ${ctx} is undefined.
+ */
+int SHA256_Tree_Update_parallel(SHA256_TREE_CTX *, const void *, size_t,
+    size_t);
+
+/**
+ * SHA256_Tree_Final(digest, ctx):
+ * Output the SHA256 tree hash of the data input to the context ${ctx} into
+ * the buffer ${digest}, and clear the context state.
+ */
+void SHA256_Tree_Final(uint8_t[32], SHA256_TREE_CTX *);
+
+/**
+ * SHA256_Tree_Buf(in, len, digest, nthreads):
+ * Compute the SHA256 tree hash of ${len} bytes from ${in} using up to
+ * ${nthreads} threads, and write it to ${digest}.  Return 0 on success or
+ * -1 on error.
+ */
+int SHA256_Tree_Buf(const void *, size_t, uint8_t[32], size_t);
+
+#endif /* !_SHA256_TREE_H_ */
@@ -46,7 +46,7 @@ aws_sign(const char * key_secret, const char * date, const char * datetime,
 	free(AWS4_key);
 
 	/* Generate the hexified hash of the Canonical Request string. */
-	SHA256_Buf(creq, strlen(creq), h_creq);
+	SHA256_Buf_public(creq, strlen(creq), h_creq);
 	hexify(h_creq, hhex_creq, 32);
 
 	/* Construct the String to Sign. */
@@ -123,7 +123,7 @@ aws_sign_s3_headers(const char * key_id, const char * key_secret,
 	}
 
 	/* Compute the hexified SHA256 of the payload. */
-	SHA256_Buf(body, body ? bodylen : 0, hbuf);
+	SHA256_Buf_public(body, body ? bodylen : 0, hbuf);
 	hexify(hbuf, content_sha256, 32);
 
 	/* Construct Canonical Request. */
@@ -311,7 +311,7 @@ aws_sign_svc_headers(const char * key_id, const char * key_secret,
 	}
 
 	/* Compute the hexified SHA256 of the payload. */
-	SHA256_Buf(body, body ? bodylen : 0, hbuf);
+	SHA256_Buf_public(body, body ? bodylen : 0, hbuf);
 	hexify(hbuf, content_sha256, 32);
 
 	/* Construct Canonical Request. */
@@ -416,7 +416,7 @@ aws_sign_dynamodb_headers(const char * key_id, const char * key_secret,
 	}
 
 	/* Compute the hexified SHA256 of the payload. */
-	SHA256_Buf(body, body ? bodylen : 0, hbuf);
+	SHA256_Buf_public(body, body ? bodylen : 0, hbuf);
 	hexify(hbuf, content_sha256, 32);
 
 	/* Construct Canonical Request. */
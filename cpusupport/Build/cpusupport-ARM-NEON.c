@@ -0,0 +1,16 @@
+#ifdef __ARM_NEON
+#include <arm_neon.h>
+#endif
+
+int
+main(void)
+{
+	uint32x4_t x;
+	uint32_t arr[4] = {0};
+
+	x = vld1q_u32(arr);
+	x = vaddq_u32(x, vshlq_n_u32(x, 7));
+	vst1q_u32(arr, x);
+
+	return ((int)arr[0]);
+}
@@ -0,0 +1,16 @@
+#ifdef __ARM_NEON
+#include <arm_neon.h>
+#endif
+
+int
+main(void)
+{
+	poly64x2_t a = {0};
+	poly64x2_t b = {0};
+	poly128_t output;
+
+	output = vmull_high_p64(a, b);
+	(void)output; /* UNUSED */
+
+	return (0);
+}
@@ -0,0 +1,16 @@
+#ifdef __ARM_NEON
+#include <arm_neon.h>
+#endif
+
+int
+main(void)
+{
+	uint32x4_t abcd = {0};
+	uint32x4_t wk = {0};
+	uint32x4_t output;
+
+	output = vsha1cq_u32(abcd, 0, wk);
+	(void)output; /* UNUSED */
+
+	return (0);
+}
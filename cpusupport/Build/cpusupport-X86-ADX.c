@@ -0,0 +1,17 @@
+#include <stdint.h>
+
+int
+main(void)
+{
+	uint64_t x = 3, y = 5, lo, hi;
+
+	/* Compilers don't generate ADCX and ADOX, so we need inline asm. */
+	__asm__ ("mulx	%3, %0, %1\n\t"
+	    "xorl	%%eax, %%eax\n\t"
+	    "adcx	%1, %0\n\t"
+	    "adox	%1, %0"
+	    : "=&r" (lo), "=&r" (hi)
+	    : "d" (x), "r" (y)
+	    : "rax", "cc");
+	return ((int)(lo + hi));
+}
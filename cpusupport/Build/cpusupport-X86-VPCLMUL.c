@@ -0,0 +1,28 @@
+#include <immintrin.h>
+
+static char a[64];
+
+/*
+ * Use a separate function for this, because that means that the alignment of
+ * the _mm512_loadu_si512() will move to function level, which may require
+ * -Wno-cast-align.
+ */
+static __m512i
+load_512(const char * src)
+{
+	__m512i x;
+
+	x = _mm512_loadu_si512((const __m512i *)src);
+	return (x);
+}
+
+int
+main(void)
+{
+	__m512i x;
+
+	x = load_512(a);
+	x = _mm512_clmulepi64_epi128(x, x, 0x10);
+	_mm512_storeu_si512((__m512i *)a, x);
+	return (a[0]);
+}
@@ -57,12 +57,19 @@ feature X86 CPUID ""
 feature X86 CPUID_COUNT ""
 
 # Detect specific features
+feature X86 ADX ""
 feature X86 AESNI "" "-maes"						\
     "-maes -Wno-cast-align"						\
     "-maes -Wno-missing-prototypes -Wno-cast-qual"			\
     "-maes -Wno-missing-prototypes -Wno-cast-qual -Wno-cast-align"	\
     "-maes -Wno-missing-prototypes -Wno-cast-qual -Wno-cast-align	\
     -DBROKEN_MM_LOADU_SI64"
+feature X86 AVX2 "" "-mavx2"						\
+    "-mavx2 -Wno-cast-align"
+feature X86 AVX512F "" "-mavx512f"					\
+    "-mavx512f -Wno-cast-align"
+feature X86 PCLMUL "" "-mpclmul"					\
+    "-mpclmul -Wno-cast-align"
 feature X86 RDRAND "" "-mrdrnd"
 feature X86 SHANI "" "-msse2 -msha"					\
     "-msse2 -msha -Wno-cast-align"
@@ -80,6 +87,8 @@ feature X86 SSE42_64 "" "-msse4.2"					\
     "-msse4.2 -Wno-cast-align -fno-strict-aliasing -Wno-cast-qual"
 feature X86 SSSE3 "" "-mssse3"						\
     "-mssse3 -Wno-cast-align"
+feature X86 VPCLMUL "" "-mavx512f -mvpclmulqdq"				\
+    "-mavx512f -mvpclmulqdq -Wno-cast-align"
 
 # Detect specific ARM features
 feature ARM AES "-march=armv8.1-a+crypto"				\
@@ -88,6 +97,13 @@ feature ARM CRC32_64 "-march=armv8.1-a"					\
     "-march=armv8.1-a+crc"						\
     "-march=armv8.1-a+crc -Wno-cast-align"				\
     "-march=armv8.1-a -D__ARM_ACLE=200"
+feature ARM NEON "" "-mfpu=neon"					\
+    "-mfpu=neon -Wno-cast-align"
+feature ARM PMULL "-march=armv8.1-a+crypto"				\
+    "-march=armv8.1-a+crypto -D__ARM_ACLE=200"
+feature ARM SHA1 "-march=armv8.1-a+crypto"				\
+    "-march=armv8.1-a+crypto -Wno-cast-align"				\
+    "-march=armv8.1-a+crypto -D__ARM_ACLE=200"
 feature ARM SHA256 "-march=armv8.1-a+crypto"				\
     "-march=armv8.1-a+crypto -Wno-cast-align"				\
     "-march=armv8.1-a+crypto -D__ARM_ACLE=200"
@@ -122,14 +122,22 @@
  * corresponding run-time detection code (cpusupport_arch_feature.c) must be
  * compiled and linked in.
  */
+CPUSUPPORT_FEATURE(x86, adx, X86_ADX);
 CPUSUPPORT_FEATURE(x86, aesni, X86_AESNI);
+CPUSUPPORT_FEATURE(x86, avx2, X86_AVX2);
+CPUSUPPORT_FEATURE(x86, avx512f, X86_AVX512F);
+CPUSUPPORT_FEATURE(x86, pclmul, X86_PCLMUL);
 CPUSUPPORT_FEATURE(x86, rdrand, X86_RDRAND);
 CPUSUPPORT_FEATURE(x86, shani, X86_SHANI);
 CPUSUPPORT_FEATURE(x86, sse2, X86_SSE2);
 CPUSUPPORT_FEATURE(x86, sse42, X86_SSE42);
 CPUSUPPORT_FEATURE(x86, ssse3, X86_SSSE3);
+CPUSUPPORT_FEATURE(x86, vpclmul, X86_VPCLMUL);
 CPUSUPPORT_FEATURE(arm, aes, ARM_AES);
 CPUSUPPORT_FEATURE(arm, crc32_64, ARM_CRC32_64);
+CPUSUPPORT_FEATURE(arm, neon, ARM_NEON);
+CPUSUPPORT_FEATURE(arm, pmull, ARM_PMULL);
+CPUSUPPORT_FEATURE(arm, sha1, ARM_SHA1);
 CPUSUPPORT_FEATURE(arm, sha256, ARM_SHA256);
 
 #endif /* !_CPUSUPPORT_H_ */
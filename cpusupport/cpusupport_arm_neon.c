@@ -0,0 +1,36 @@
+#include "cpusupport.h"
+
+#ifdef CPUSUPPORT_HWCAP_GETAUXVAL
+#include <sys/auxv.h>
+
+#if defined(__arm__)
+/**
+ * Workaround for a glibc bug: <bits/hwcap.h> contains a comment saying:
+ *     The following must match the kernel's <asm/hwcap.h>.
+ * However, it does not contain any of the HWCAP2_* entries from <asm/hwcap.h>.
+ */
+#ifndef HWCAP_NEON
+#include <asm/hwcap.h>
+#endif
+#endif /* __arm__ */
+#endif /* CPUSUPPORT_HWCAP_GETAUXVAL */
+
+CPUSUPPORT_FEATURE_DECL(arm, neon)
+{
+	int supported = 0;
+
+#if defined(CPUSUPPORT_ARM_NEON)
+#if defined(__aarch64__)
+	/* Advanced SIMD is a mandatory part of ARMv8-A. */
+	supported = 1;
+#elif defined(CPUSUPPORT_HWCAP_GETAUXVAL) && defined(__arm__)
+	unsigned long capabilities;
+
+	capabilities = getauxval(AT_HWCAP);
+	supported = (capabilities & HWCAP_NEON) ? 1 : 0;
+#endif
+#endif /* CPUSUPPORT_ARM_NEON */
+
+	/* Return the supported status. */
+	return (supported);
+}
@@ -0,0 +1,60 @@
+#include "cpusupport.h"
+
+#ifdef CPUSUPPORT_X86_CPUID_COUNT
+#include <cpuid.h>
+
+#define CPUID_OSXSAVE_BIT (1 << 27)
+#define CPUID_AVX_BIT (1 << 28)
+#define CPUID_AVX2_BIT (1 << 5)
+#define XCR0_SSE_BIT (1 << 1)
+#define XCR0_AVX_BIT (1 << 2)
+#endif
+
+CPUSUPPORT_FEATURE_DECL(x86, avx2)
+{
+#ifdef CPUSUPPORT_X86_CPUID_COUNT
+	unsigned int eax, ebx, ecx, edx;
+	unsigned int xcr0_lo, xcr0_hi;
+
+	/* Check if CPUID supports the level we need. */
+	if (!__get_cpuid(0, &eax, &ebx, &ecx, &edx))
+		goto unsupported;
+	if (eax < 7)
+		goto unsupported;
+
+	/* Ask about CPU features. */
+	if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx))
+		goto unsupported;
+
+	/*
+	 * The CPU supporting AVX is not enough; the OS must also have
+	 * enabled saving the YMM registers across context switches, which
+	 * we check via the XGETBV instruction (available if OSXSAVE is set).
+	 */
+	if ((ecx & CPUID_OSXSAVE_BIT) == 0)
+		goto unsupported;
+	if ((ecx & CPUID_AVX_BIT) == 0)
+		goto unsupported;
+	__asm__ __volatile__ ("xgetbv" : "=a" (xcr0_lo), "=d" (xcr0_hi) :
+	    "c" (0));
+	(void)xcr0_hi; /* UNUSED */
+	if ((xcr0_lo & (XCR0_SSE_BIT | XCR0_AVX_BIT)) !=
+	    (XCR0_SSE_BIT | XCR0_AVX_BIT))
+		goto unsupported;
+
+	/*
+	 * Ask about extended CPU features.  Note that this macro violates
+	 * the principle of being "function-like" by taking the variables
+	 * used for holding output registers as named parameters rather than
+	 * as pointers (which would be necessary if __cpuid_count were a
+	 * function).
+	 */
+	__cpuid_count(7, 0, eax, ebx, ecx, edx);
+
+	/* Return the relevant feature bit. */
+	return ((ebx & CPUID_AVX2_BIT) ? 1 : 0);
+
+unsupported:
+#endif
+	return (0);
+}
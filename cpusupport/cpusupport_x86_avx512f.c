@@ -0,0 +1,65 @@
+#include "cpusupport.h"
+
+#ifdef CPUSUPPORT_X86_CPUID_COUNT
+#include <cpuid.h>
+
+#define CPUID_OSXSAVE_BIT (1 << 27)
+#define CPUID_AVX_BIT (1 << 28)
+#define CPUID_AVX512F_BIT (1 << 16)
+#define XCR0_SSE_BIT (1 << 1)
+#define XCR0_AVX_BIT (1 << 2)
+#define XCR0_OPMASK_BIT (1 << 5)
+#define XCR0_ZMM_HI256_BIT (1 << 6)
+#define XCR0_HI16_ZMM_BIT (1 << 7)
+#define XCR0_AVX512_BITS (XCR0_SSE_BIT | XCR0_AVX_BIT | XCR0_OPMASK_BIT | \
+    XCR0_ZMM_HI256_BIT | XCR0_HI16_ZMM_BIT)
+#endif
+
+CPUSUPPORT_FEATURE_DECL(x86, avx512f)
+{
+#ifdef CPUSUPPORT_X86_CPUID_COUNT
+	unsigned int eax, ebx, ecx, edx;
+	unsigned int xcr0_lo, xcr0_hi;
+
+	/* Check if CPUID supports the level we need. */
+	if (!__get_cpuid(0, &eax, &ebx, &ecx, &edx))
+		goto unsupported;
+	if (eax < 7)
+		goto unsupported;
+
+	/* Ask about CPU features. */
+	if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx))
+		goto unsupported;
+
+	/*
+	 * The CPU supporting AVX-512 is not enough; the OS must also have
+	 * enabled saving the opmask and ZMM registers across context
+	 * switches, which we check via the XGETBV instruction (available if
+	 * OSXSAVE is set).
+	 */
+	if ((ecx & CPUID_OSXSAVE_BIT) == 0)
+		goto unsupported;
+	if ((ecx & CPUID_AVX_BIT) == 0)
+		goto unsupported;
+	__asm__ __volatile__ ("xgetbv" : "=a" (xcr0_lo), "=d" (xcr0_hi) :
+	    "c" (0));
+	(void)xcr0_hi; /* UNUSED */
+	if ((xcr0_lo & XCR0_AVX512_BITS) != XCR0_AVX512_BITS)
+		goto unsupported;
+
+	/*
+	 * Ask about extended CPU features.  Note that this macro violates
+	 * the principle of being "function-like" by taking the variables
+	 * used for holding output registers as named parameters rather than
+	 * as pointers (which would be necessary if __cpuid_count were a
+	 * function).
+	 */
+	__cpuid_count(7, 0, eax, ebx, ecx, edx);
+
+	/* Return the relevant feature bit. */
+	return ((ebx & CPUID_AVX512F_BIT) ? 1 : 0);
+
+unsupported:
+#endif
+	return (0);
+}
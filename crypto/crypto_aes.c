@@ -8,6 +8,7 @@
 #include "cpusupport.h"
 #include "crypto_aes_aesni.h"
 #include "crypto_aes_arm.h"
+#include "hwaccel.h"
 #include "insecure_memzero.h"
 #include "warnp.h"
 
@@ -154,35 +155,59 @@ openssl_oneshot(const uint8_t * key, size_t len, const uint8_t ptext[16],
 	return (0);
 }
 
+/* Time encryption using the implementation ${id}. */
+static void
+hwbench(int id)
+{
+	static const uint8_t key[32];
+	struct crypto_aes_key * kexp;
+	uint8_t block[16] = {0};
+	int i;
+
+	hwaccel = id;
+	if ((kexp = crypto_aes_key_expand(key, 32)) == NULL)
+		return;
+	for (i = 0; i < 64; i++)
+		crypto_aes_encrypt_block(block, block, kexp);
+	crypto_aes_key_free(kexp);
+}
+
 /* Which type of hardware acceleration should we use, if any? */
 static void
 hwaccel_init(void)
 {
+	struct hwaccel_choice C;
 
 	/* If we've already set hwaccel, we're finished. */
 	if (hwaccel != HW_UNSET)
 		return;
 
-	/* Default to software. */
+	/* Use software while we test the alternatives. */
 	hwaccel = HW_SOFTWARE;
+	hwaccel_begin(&C, "aes");
 
 #if defined(CPUSUPPORT_X86_AESNI)
-	CPUSUPPORT_VALIDATE(hwaccel, HW_X86_AESNI, cpusupport_x86_aesni(),
+	HWACCEL_OFFER(&C, HW_X86_AESNI, "x86-aesni", cpusupport_x86_aesni(),
 	    functest(x86_aesni_oneshot));
 #endif
 #if defined(CPUSUPPORT_ARM_AES)
-	CPUSUPPORT_VALIDATE(hwaccel, HW_ARM_AES, cpusupport_arm_aes(),
+	HWACCEL_OFFER(&C, HW_ARM_AES, "arm-aes", cpusupport_arm_aes(),
 	    functest(arm_aes_oneshot));
 #endif
 
 	/*
-	 * If we're here, we're not using any intrinsics.  Test OpenSSL; if
-	 * there's an error, print a warning and abort.
+	 * Test OpenSSL; if there's an error and we have no intrinsics to use
+	 * instead, print a warning and abort.
 	 */
-	if (functest(openssl_oneshot)) {
+	if (functest(openssl_oneshot) == 0) {
+		hwaccel_offer(&C, HW_SOFTWARE, "openssl");
+	} else if (C.n == 0) {
 		warn0("OpenSSL gives incorrect AES values.");
 		abort();
 	}
+
+	/* Pick one. */
+	hwaccel = hwaccel_choose(&C, hwbench);
 }
 #endif /* HWACCEL */
 
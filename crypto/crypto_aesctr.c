@@ -6,6 +6,7 @@
 #include "crypto_aes.h"
 #include "crypto_aesctr_aesni.h"
 #include "crypto_aesctr_arm.h"
+#include "hwaccel.h"
 #include "insecure_memzero.h"
 #include "sysendian.h"
 
@@ -41,28 +42,45 @@ static enum {
 #endif
 
 #ifdef HWACCEL
+/* Time encryption using the implementation ${id}. */
+static void
+hwbench(int id)
+{
+	static const uint8_t key[32];
+	static uint8_t buf[4096];
+	struct crypto_aes_key * kexp;
+
+	if ((kexp = crypto_aes_key_expand(key, 32)) == NULL)
+		return;
+	hwaccel = id;
+	crypto_aesctr_buf(kexp, 0, buf, buf, sizeof(buf));
+	crypto_aes_key_free(kexp);
+}
+
 /* Which type of hardware acceleration should we use, if any? */
 static void
 hwaccel_init(void)
 {
+	struct hwaccel_choice C;
 
 	/* If we've already set hwaccel, we're finished. */
 	if (hwaccel != HW_UNSET)
 		return;
 
-	/* Default to software. */
+	/* Use software while we look at the alternatives. */
 	hwaccel = HW_SOFTWARE;
+	hwaccel_begin(&C, "aesctr");
 
-	/* Can we use AESNI? */
+	/* We can only use intrinsics if crypto_aes expands keys for them. */
 	switch (crypto_aes_can_use_intrinsics()) {
 #ifdef CPUSUPPORT_X86_AESNI
 	case 1:
-		hwaccel = HW_X86_AESNI;
+		hwaccel_offer(&C, HW_X86_AESNI, "x86-aesni");
 		break;
 #endif
 #ifdef CPUSUPPORT_ARM_AES
 	case 2:
-		hwaccel = HW_ARM_AES;
+		hwaccel_offer(&C, HW_ARM_AES, "arm-aes");
 		break;
 #endif
 	case 0:
@@ -71,6 +89,10 @@ hwaccel_init(void)
 		/* Should never happen. */
 		assert(0);
 	}
+	hwaccel_offer(&C, HW_SOFTWARE, "software");
+
+	/* Pick one. */
+	hwaccel = hwaccel_choose(&C, hwbench);
 }
 #endif /* HWACCEL */
 
@@ -203,6 +225,38 @@ crypto_aesctr_stream(struct crypto_aesctr * stream, const uint8_t * inbuf,
 	crypto_aesctr_stream_post_wholeblock(stream, &inbuf, &outbuf, &buflen);
 }
 
+/**
+ * crypto_aesctr_seek(stream, offset):
+ * Reposition the AES-CTR stream ${stream} so that the next byte generated
+ * will be byte ${offset} of the cipherstream.  This takes constant time
+ * regardless of ${offset} or the current position.
+ */
+void
+crypto_aesctr_seek(struct crypto_aesctr * stream, uint64_t offset)
+{
+
+	/* Move to the requested byte of cipherstream. */
+	stream->bytectr = offset;
+
+	/* Are we positioned in the middle of a cipherblock? */
+	if (offset % 16 != 0) {
+		/*
+		 * Regenerate the cipherblock containing this byte, since
+		 * subsequent bytes will be taken from its remainder.
+		 */
+		be64enc(stream->pblk + 8, offset / 16);
+		crypto_aes_encrypt_block(stream->pblk, stream->buf,
+		    stream->key);
+	} else {
+		/*
+		 * Set the counter such that the least significant byte will
+		 * wrap once incremented; this causes the complete 64-bit
+		 * value to be re-encoded from bytectr.
+		 */
+		stream->pblk[15] = 0xff;
+	}
+}
+
 /**
  * crypto_aesctr_free(stream):
  * Free the AES-CTR stream ${stream}.
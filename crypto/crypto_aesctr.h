@@ -42,6 +42,14 @@ void crypto_aesctr_init2(struct crypto_aesctr *, const struct crypto_aes_key *,
 void crypto_aesctr_stream(struct crypto_aesctr *, const uint8_t *,
     uint8_t *, size_t);
 
+/**
+ * crypto_aesctr_seek(stream, offset):
+ * Reposition the AES-CTR stream ${stream} so that the next byte generated
+ * will be byte ${offset} of the cipherstream.  This takes constant time
+ * regardless of ${offset} or the current position.
+ */
+void crypto_aesctr_seek(struct crypto_aesctr *, uint64_t);
+
 /**
  * crypto_aesctr_free(stream):
  * Free the AES-CTR stream ${stream}.
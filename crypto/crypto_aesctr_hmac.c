@@ -0,0 +1,167 @@
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "crypto_aesctr.h"
+#include "crypto_verify_bytes.h"
+#include "insecure_memzero.h"
+#include "sha256.h"
+
+#include "crypto_aesctr_hmac.h"
+
+/*
+ * Data is processed in chunks which are small enough to remain in the L1
+ * cache between being encrypted and being added to the HMAC; without this,
+ * encrypting a large buffer and then computing the HMAC of the ciphertext
+ * would read the data from memory twice.
+ */
+#define CHUNKLEN 4096
+
+struct crypto_aesctr_hmac {
+	struct crypto_aesctr * aesctr;
+	HMAC_SHA256_CTX hctx;
+};
+
+/**
+ * crypto_aesctr_hmac_init(key, nonce, hkey, hkeylen):
+ * Prepare to encrypt/decrypt data with AES in CTR mode, using the provided
+ * expanded ${key} and ${nonce}, and to authenticate the ciphertext with
+ * HMAC-SHA256 using the ${hkeylen}-byte key ${hkey}.  The AES key provided
+ * must remain valid for the lifetime of the stream.
+ */
+struct crypto_aesctr_hmac *
+crypto_aesctr_hmac_init(const struct crypto_aes_key * key, uint64_t nonce,
+    const void * hkey, size_t hkeylen)
+{
+	struct crypto_aesctr_hmac * stream;
+
+	/* Allocate memory. */
+	if ((stream = malloc(sizeof(struct crypto_aesctr_hmac))) == NULL)
+		goto err0;
+
+	/* Initialize the encryption and authentication states. */
+	if ((stream->aesctr = crypto_aesctr_init(key, nonce)) == NULL)
+		goto err1;
+	HMAC_SHA256_Init(&stream->hctx, hkey, hkeylen);
+
+	/* Success! */
+	return (stream);
+
+err1:
+	free(stream);
+err0:
+	/* Failure! */
+	return (NULL);
+}
+
+/**
+ * crypto_aesctr_hmac_encrypt(stream, inbuf, outbuf, buflen):
+ * Encrypt ${buflen} bytes from ${inbuf} into ${outbuf} and add the ciphertext
+ * to the HMAC computed by ${stream}.  This produces the same output as
+ * crypto_aesctr_stream() followed by HMAC_SHA256_Update() on the ciphertext,
+ * but makes a single pass over the data.  If the buffers ${inbuf} and
+ * ${outbuf} overlap, they must be identical.
+ */
+void
+crypto_aesctr_hmac_encrypt(struct crypto_aesctr_hmac * stream,
+    const uint8_t * inbuf, uint8_t * outbuf, size_t buflen)
+{
+	size_t len;
+
+	while (buflen > 0) {
+		/* How much can we process in this chunk? */
+		len = (buflen > CHUNKLEN) ? CHUNKLEN : buflen;
+
+		/* Encrypt, then authenticate while the data is still hot. */
+		crypto_aesctr_stream(stream->aesctr, inbuf, outbuf, len);
+		HMAC_SHA256_Update(&stream->hctx, outbuf, len);
+
+		/* Move on to the next chunk. */
+		inbuf += len;
+		outbuf += len;
+		buflen -= len;
+	}
+}
+
+/**
+ * crypto_aesctr_hmac_decrypt(stream, inbuf, outbuf, buflen):
+ * Add ${buflen} bytes of ciphertext from ${inbuf} to the HMAC computed by
+ * ${stream} and decrypt them into ${outbuf}.  If the buffers ${inbuf} and
+ * ${outbuf} overlap, they must be identical.  The output must not be used
+ * until crypto_aesctr_hmac_verify() has confirmed that it is authentic.
+ */
+void
+crypto_aesctr_hmac_decrypt(struct crypto_aesctr_hmac * stream,
+    const uint8_t * inbuf, uint8_t * outbuf, size_t buflen)
+{
+	size_t len;
+
+	while (buflen > 0) {
+		/* How much can we process in this chunk? */
+		len = (buflen > CHUNKLEN) ? CHUNKLEN : buflen;
+
+		/* Authenticate before we (potentially) overwrite the input. */
+		HMAC_SHA256_Update(&stream->hctx, inbuf, len);
+		crypto_aesctr_stream(stream->aesctr, inbuf, outbuf, len);
+
+		/* Move on to the next chunk. */
+		inbuf += len;
+		outbuf += len;
+		buflen -= len;
+	}
+}
+
+/**
+ * crypto_aesctr_hmac_final(stream, mac):
+ * Write the HMAC-SHA256 of the ciphertext processed by ${stream} into ${mac}.
+ * No further data may be processed by ${stream}.
+ */
+void
+crypto_aesctr_hmac_final(struct crypto_aesctr_hmac * stream, uint8_t mac[32])
+{
+
+	HMAC_SHA256_Final(mac, &stream->hctx);
+}
+
+/**
+ * crypto_aesctr_hmac_verify(stream, mac):
+ * Compare the HMAC-SHA256 of the ciphertext processed by ${stream} against
+ * ${mac} without leaking information via timing side channels.  Return 0 if
+ * they match, or -1 otherwise.  No further data may be processed by
+ * ${stream}.
+ */
+int
+crypto_aesctr_hmac_verify(struct crypto_aesctr_hmac * stream,
+    const uint8_t mac[32])
+{
+	uint8_t mac_actual[32];
+	int rc;
+
+	/* Compute the HMAC and compare. */
+	HMAC_SHA256_Final(mac_actual, &stream->hctx);
+	rc = crypto_verify_bytes(mac_actual, mac, 32) ? -1 : 0;
+
+	/* Clean up. */
+	insecure_memzero(mac_actual, 32);
+
+	return (rc);
+}
+
+/**
+ * crypto_aesctr_hmac_free(stream):
+ * Free the AES-CTR + HMAC-SHA256 stream ${stream}.
+ */
+void
+crypto_aesctr_hmac_free(struct crypto_aesctr_hmac * stream)
+{
+
+	/* Behave consistently with free(NULL). */
+	if (stream == NULL)
+		return;
+
+	/* Free the AES-CTR stream and zero the HMAC state. */
+	crypto_aesctr_free(stream->aesctr);
+	insecure_memzero(stream, sizeof(struct crypto_aesctr_hmac));
+
+	/* Free the stream. */
+	free(stream);
+}
@@ -0,0 +1,64 @@
+#ifndef _CRYPTO_AESCTR_HMAC_H_
+#define _CRYPTO_AESCTR_HMAC_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* Opaque types. */
+struct crypto_aes_key;
+struct crypto_aesctr_hmac;
+
+/**
+ * crypto_aesctr_hmac_init(key, nonce, hkey, hkeylen):
+ * Prepare to encrypt/decrypt data with AES in CTR mode, using the provided
+ * expanded ${key} and ${nonce}, and to authenticate the ciphertext with
+ * HMAC-SHA256 using the ${hkeylen}-byte key ${hkey}.  The AES key provided
+ * must remain valid for the lifetime of the stream.
+ */
+struct crypto_aesctr_hmac * crypto_aesctr_hmac_init(
+    const struct crypto_aes_key *, uint64_t, const void *, size_t);
+
+/**
+ * crypto_aesctr_hmac_encrypt(stream, inbuf, outbuf, buflen):
+ * Encrypt ${buflen} bytes from ${inbuf} into ${outbuf} and add the ciphertext
+ * to the HMAC computed by ${stream}.  This produces the same output as
+ * crypto_aesctr_stream() followed by HMAC_SHA256_Update() on the ciphertext,
+ * but makes a single pass over the data.  If the buffers ${inbuf} and
+ * ${outbuf} overlap, they must be identical.
+ */
+void crypto_aesctr_hmac_encrypt(struct crypto_aesctr_hmac *, const uint8_t *,
+    uint8_t *, size_t);
+
+/**
+ * crypto_aesctr_hmac_decrypt(stream, inbuf, outbuf, buflen):
+ * Add ${buflen} bytes of ciphertext from ${inbuf} to the HMAC computed by
+ * ${stream} and decrypt them into ${outbuf}.  If the buffers ${inbuf} and
+ * ${outbuf} overlap, they must be identical.  The output must not be used
+ * until crypto_aesctr_hmac_verify() has confirmed that it is authentic.
+ */
+void crypto_aesctr_hmac_decrypt(struct crypto_aesctr_hmac *, const uint8_t *,
+    uint8_t *, size_t);
+
+/**
+ * crypto_aesctr_hmac_final(stream, mac):
+ * Write the HMAC-SHA256 of the ciphertext processed by ${stream} into ${mac}.
+ * No further data may be processed by ${stream}.
+ */
+void crypto_aesctr_hmac_final(struct crypto_aesctr_hmac *, uint8_t[32]);
+
+/**
+ * crypto_aesctr_hmac_verify(stream, mac):
+ * Compare the HMAC-SHA256 of the ciphertext processed by ${stream} against
+ * ${mac} without leaking information via timing side channels.  Return 0 if
+ * they match, or -1 otherwise.  No further data may be processed by
+ * ${stream}.
+ */
+int crypto_aesctr_hmac_verify(struct crypto_aesctr_hmac *, const uint8_t[32]);
+
+/**
+ * crypto_aesctr_hmac_free(stream):
+ * Free the AES-CTR + HMAC-SHA256 stream ${stream}.
+ */
+void crypto_aesctr_hmac_free(struct crypto_aesctr_hmac *);
+
+#endif /* !_CRYPTO_AESCTR_HMAC_H_ */
@@ -0,0 +1,857 @@
+#include <assert.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "cpusupport.h"
+#include "crypto_aes.h"
+#include "crypto_aesgcm_arm.h"
+#include "crypto_aesgcm_pclmul.h"
+#include "crypto_verify_bytes.h"
+#include "hwaccel.h"
+#include "insecure_memzero.h"
+#include "sysendian.h"
+#include "warnp.h"
+
+#include "crypto_aesgcm.h"
+
+#if defined(CPUSUPPORT_X86_AESNI) && defined(CPUSUPPORT_X86_PCLMUL) &&	\
+    defined(CPUSUPPORT_X86_SSSE3) ||					\
+    defined(CPUSUPPORT_ARM_AES) && defined(CPUSUPPORT_ARM_PMULL)
+#define HWACCEL
+
+static enum {
+	HW_SOFTWARE = 0,
+#if defined(CPUSUPPORT_X86_AESNI) && defined(CPUSUPPORT_X86_PCLMUL) &&	\
+    defined(CPUSUPPORT_X86_SSSE3)
+	HW_X86_PCLMUL,
+#endif
+#if defined(CPUSUPPORT_ARM_AES) && defined(CPUSUPPORT_ARM_PMULL)
+	HW_ARM_PMULL,
+#endif
+	HW_UNSET
+} hwaccel = HW_UNSET;
+#endif
+
+/* AES-GCM state. */
+struct crypto_aesgcm {
+	const struct crypto_aes_key * key;
+	uint8_t Htab[64];	/* GHASH key H, in backend-specific form. */
+	uint8_t EJ0[16];	/* Encrypted initial counter block. */
+	uint8_t ctr[16];	/* Next counter block to encrypt. */
+	uint8_t Y[16];		/* GHASH value. */
+	uint8_t buf[16];	/* Current cipherblock. */
+	uint8_t gbuf[16];	/* Partial block of data for GHASH. */
+	uint64_t aadlen;
+	uint64_t datalen;
+	int aad_done;
+};
+
+/* Increment the final 32 bits of the counter block ${ctr}, modulo 2^32. */
+static inline void
+ctr_inc(uint8_t ctr[16])
+{
+
+	be32enc(&ctr[12], be32dec(&ctr[12]) + 1);
+}
+
+/*
+ * Carry-less multiplication of ${x} and ${y}, truncated to 64 bits.  In order
+ * to avoid data-dependent timing, we use integer multiplications of values
+ * whose set bits are spaced four positions apart: the carries produced
+ * within each product never reach the next bit position of interest.
+ */
+static inline uint64_t
+bmul64(uint64_t x, uint64_t y)
+{
+	const uint64_t m0 = 0x1111111111111111;
+	const uint64_t m1 = 0x2222222222222222;
+	const uint64_t m2 = 0x4444444444444444;
+	const uint64_t m3 = 0x8888888888888888;
+	uint64_t x0, x1, x2, x3;
+	uint64_t y0, y1, y2, y3;
+	uint64_t z0, z1, z2, z3;
+
+	/* Split the inputs into interleaved sparse values. */
+	x0 = x & m0;
+	x1 = x & m1;
+	x2 = x & m2;
+	x3 = x & m3;
+	y0 = y & m0;
+	y1 = y & m1;
+	y2 = y & m2;
+	y3 = y & m3;
+
+	/* Multiply, collecting terms which land in the same positions. */
+	z0 = (x0 * y0) ^ (x1 * y3) ^ (x2 * y2) ^ (x3 * y1);
+	z1 = (x0 * y1) ^ (x1 * y0) ^ (x2 * y3) ^ (x3 * y2);
+	z2 = (x0 * y2) ^ (x1 * y1) ^ (x2 * y0) ^ (x3 * y3);
+	z3 = (x0 * y3) ^ (x1 * y2) ^ (x2 * y1) ^ (x3 * y0);
+
+	/* Discard the carries. */
+	return ((z0 & m0) | (z1 & m1) | (z2 & m2) | (z3 & m3));
+}
+
+/* Reverse the order of the bits in ${x}. */
+static inline uint64_t
+rev64(uint64_t x)
+{
+
+	x = ((x & 0x5555555555555555) << 1) | ((x >> 1) & 0x5555555555555555);
+	x = ((x & 0x3333333333333333) << 2) | ((x >> 2) & 0x3333333333333333);
+	x = ((x & 0x0F0F0F0F0F0F0F0F) << 4) | ((x >> 4) & 0x0F0F0F0F0F0F0F0F);
+	x = ((x & 0x00FF00FF00FF00FF) << 8) | ((x >> 8) & 0x00FF00FF00FF00FF);
+	x = ((x & 0x0000FFFF0000FFFF) << 16) | ((x >> 16) & 0x0000FFFF0000FFFF);
+	return ((x << 32) | (x >> 32));
+}
+
+/* Software version of crypto_aesgcm_*_init(). */
+static void
+crypto_aesgcm_soft_init(const uint8_t H[16], uint8_t Htab[64])
+{
+
+	/* We only need H itself. */
+	memcpy(Htab, H, 16);
+	memset(&Htab[16], 0, 48);
+}
+
+/* Software version of crypto_aesgcm_*_ghash(). */
+static void
+crypto_aesgcm_soft_ghash(const uint8_t Htab[64], uint8_t Y[16],
+    const uint8_t * buf, size_t nblocks)
+{
+	uint64_t h0, h1, h2, h0r, h1r, h2r;
+	uint64_t y0, y1, y2, y0r, y1r, y2r;
+	uint64_t z0, z1, z2, z0h, z1h, z2h;
+	uint64_t v0, v1, v2, v3;
+
+	/*
+	 * GHASH values are bit-reflected polynomials; we hold each one as a
+	 * pair of 64-bit words (y1 being the first 8 bytes).  The high halves
+	 * of the 64x64-bit products are obtained by multiplying the
+	 * bit-reversed inputs, and Karatsuba multiplication reduces the number
+	 * of 64x64-bit products from eight to six.
+	 */
+	h1 = be64dec(&Htab[0]);
+	h0 = be64dec(&Htab[8]);
+	h0r = rev64(h0);
+	h1r = rev64(h1);
+	h2 = h0 ^ h1;
+	h2r = h0r ^ h1r;
+	y1 = be64dec(&Y[0]);
+	y0 = be64dec(&Y[8]);
+
+	for (; nblocks > 0; nblocks--) {
+		/* Add the block to the GHASH value. */
+		y1 ^= be64dec(&buf[0]);
+		y0 ^= be64dec(&buf[8]);
+		buf += 16;
+
+		/* Multiply by H. */
+		y0r = rev64(y0);
+		y1r = rev64(y1);
+		y2 = y0 ^ y1;
+		y2r = y0r ^ y1r;
+		z0 = bmul64(y0, h0);
+		z1 = bmul64(y1, h1);
+		z2 = bmul64(y2, h2);
+		z0h = bmul64(y0r, h0r);
+		z1h = bmul64(y1r, h1r);
+		z2h = bmul64(y2r, h2r);
+		z2 ^= z0 ^ z1;
+		z2h ^= z0h ^ z1h;
+		z0h = rev64(z0h) >> 1;
+		z1h = rev64(z1h) >> 1;
+		z2h = rev64(z2h) >> 1;
+
+		/* Assemble the 256-bit product, shifted left by one bit. */
+		v0 = z0;
+		v1 = z0h ^ z2;
+		v2 = z1 ^ z2h;
+		v3 = z1h;
+		v3 = (v3 << 1) | (v2 >> 63);
+		v2 = (v2 << 1) | (v1 >> 63);
+		v1 = (v1 << 1) | (v0 >> 63);
+		v0 = (v0 << 1);
+
+		/* Reduce modulo x^128 + x^7 + x^2 + x + 1. */
+		v2 ^= v0 ^ (v0 >> 1) ^ (v0 >> 2) ^ (v0 >> 7);
+		v1 ^= (v0 << 63) ^ (v0 << 62) ^ (v0 << 57);
+		v3 ^= v1 ^ (v1 >> 1) ^ (v1 >> 2) ^ (v1 >> 7);
+		v2 ^= (v1 << 63) ^ (v1 << 62) ^ (v1 << 57);
+		y0 = v2;
+		y1 = v3;
+	}
+
+	/* Store the updated GHASH value. */
+	be64enc(&Y[0], y1);
+	be64enc(&Y[8], y0);
+}
+
+/* Software version of crypto_aesgcm_*_blocks(). */
+static void
+crypto_aesgcm_soft_blocks(const struct crypto_aes_key * key,
+    const uint8_t Htab[64], uint8_t ctr[16], uint8_t Y[16],
+    const uint8_t * inbuf, uint8_t * outbuf, size_t nblocks, int decrypt)
+{
+	uint8_t cblk[16];
+	uint8_t ctext[16];
+	size_t i;
+
+	for (; nblocks > 0; nblocks--) {
+		/* Encrypt the counter to get a cipherblock. */
+		crypto_aes_encrypt_block(ctr, cblk, key);
+		ctr_inc(ctr);
+
+		/* Encrypt or decrypt the block, remembering the ciphertext. */
+		for (i = 0; i < 16; i++) {
+			ctext[i] = decrypt ? inbuf[i] : inbuf[i] ^ cblk[i];
+			outbuf[i] = inbuf[i] ^ cblk[i];
+		}
+
+		/* Absorb the ciphertext. */
+		crypto_aesgcm_soft_ghash(Htab, Y, ctext, 1);
+
+		/* Move to the next block. */
+		inbuf += 16;
+		outbuf += 16;
+	}
+
+	/* Clean up. */
+	insecure_memzero(cblk, 16);
+}
+
+#ifdef HWACCEL
+/*
+ * Test whether software and hardware extensions GHASH and encryption code
+ * produce the same results.  Must be called with (hwaccel == HW_SOFTWARE).
+ */
+static int
+hwtest(void (* init)(const uint8_t[16], uint8_t[64]),
+    void (* ghash)(const uint8_t[64], uint8_t[16], const uint8_t *, size_t),
+    void (* blocks)(const struct crypto_aes_key *, const uint8_t[64],
+	uint8_t[16], uint8_t[16], const uint8_t *, uint8_t *, size_t, int))
+{
+	struct crypto_aes_key * key;
+	uint8_t keybuf[16];
+	uint8_t H[16];
+	uint8_t Htab_sw[64], Htab_hw[64];
+	uint8_t Y_sw[16], Y_hw[16];
+	uint8_t ctr_sw[16], ctr_hw[16];
+	uint8_t buf[80];
+	uint8_t out_sw[80], out_hw[80];
+	uint8_t i;
+
+	/* Test case: Key 0x00 0x01 ... 0x0f; data 0x00 0x01 ... 0x4f. */
+	for (i = 0; i < 16; i++)
+		keybuf[i] = i;
+	for (i = 0; i < 80; i++)
+		buf[i] = i;
+
+	/* Expand the key and compute H. */
+	if ((key = crypto_aes_key_expand(keybuf, 16)) == NULL)
+		goto err0;
+	memset(H, 0, 16);
+	crypto_aes_encrypt_block(H, H, key);
+	crypto_aesgcm_soft_init(H, Htab_sw);
+	init(H, Htab_hw);
+
+	/* Absorb five blocks (four at once, plus one). */
+	memset(Y_sw, 0, 16);
+	memset(Y_hw, 0, 16);
+	crypto_aesgcm_soft_ghash(Htab_sw, Y_sw, buf, 5);
+	ghash(Htab_hw, Y_hw, buf, 5);
+	if (memcmp(Y_sw, Y_hw, 16))
+		goto err1;
+
+	/* Encrypt five blocks with a counter which wraps. */
+	memset(ctr_sw, 0xa5, 12);
+	be32enc(&ctr_sw[12], 0xfffffffe);
+	memcpy(ctr_hw, ctr_sw, 16);
+	crypto_aesgcm_soft_blocks(key, Htab_sw, ctr_sw, Y_sw, buf, out_sw, 5,
+	    0);
+	blocks(key, Htab_hw, ctr_hw, Y_hw, buf, out_hw, 5, 0);
+	if (memcmp(out_sw, out_hw, 80) || memcmp(ctr_sw, ctr_hw, 16) ||
+	    memcmp(Y_sw, Y_hw, 16))
+		goto err1;
+
+	/* Decrypt the blocks in place. */
+	memset(ctr_hw, 0xa5, 12);
+	be32enc(&ctr_hw[12], 0xfffffffe);
+	blocks(key, Htab_hw, ctr_hw, Y_hw, out_hw, out_hw, 5, 1);
+	if (memcmp(out_hw, buf, 80) || memcmp(ctr_sw, ctr_hw, 16))
+		goto err1;
+
+	/* Clean up. */
+	crypto_aes_key_free(key);
+
+	/* Success! */
+	return (0);
+
+err1:
+	crypto_aes_key_free(key);
+err0:
+	/* Failure! */
+	return (-1);
+}
+
+/* Time encryption using the implementation ${id}; defined below. */
+static void hwbench(int);
+
+/* Which type of hardware acceleration should we use, if any? */
+static void
+hwaccel_init(void)
+{
+	struct hwaccel_choice C;
+
+	/* If we've already set hwaccel, we're finished. */
+	if (hwaccel != HW_UNSET)
+		return;
+
+	/* Use software while we test the alternatives. */
+	hwaccel = HW_SOFTWARE;
+	hwaccel_begin(&C, "aesgcm");
+
+#if defined(CPUSUPPORT_X86_AESNI) && defined(CPUSUPPORT_X86_PCLMUL) &&	\
+    defined(CPUSUPPORT_X86_SSSE3)
+	HWACCEL_OFFER(&C, HW_X86_PCLMUL, "x86-pclmul",
+	    (crypto_aes_can_use_intrinsics() == 1) &&
+	    cpusupport_x86_pclmul() && cpusupport_x86_ssse3(),
+	    hwtest(crypto_aesgcm_pclmul_init, crypto_aesgcm_pclmul_ghash,
+		crypto_aesgcm_pclmul_blocks));
+#endif
+#if defined(CPUSUPPORT_ARM_AES) && defined(CPUSUPPORT_ARM_PMULL)
+	HWACCEL_OFFER(&C, HW_ARM_PMULL, "arm-pmull",
+	    (crypto_aes_can_use_intrinsics() == 2) && cpusupport_arm_pmull(),
+	    hwtest(crypto_aesgcm_arm_init, crypto_aesgcm_arm_ghash,
+		crypto_aesgcm_arm_blocks));
+#endif
+	hwaccel_offer(&C, HW_SOFTWARE, "software");
+
+	/* Pick one. */
+	hwaccel = hwaccel_choose(&C, hwbench);
+}
+#endif /* HWACCEL */
+
+/* Prepare ${Htab} from the GHASH key ${H}. */
+static void
+crypto_aesgcm_Htab_init(const uint8_t H[16], uint8_t Htab[64])
+{
+
+#ifdef HWACCEL
+	switch (hwaccel) {
+#if defined(CPUSUPPORT_X86_AESNI) && defined(CPUSUPPORT_X86_PCLMUL) &&	\
+    defined(CPUSUPPORT_X86_SSSE3)
+	case HW_X86_PCLMUL:
+		crypto_aesgcm_pclmul_init(H, Htab);
+		return;
+#endif
+#if defined(CPUSUPPORT_ARM_AES) && defined(CPUSUPPORT_ARM_PMULL)
+	case HW_ARM_PMULL:
+		crypto_aesgcm_arm_init(H, Htab);
+		return;
+#endif
+	case HW_SOFTWARE:
+	case HW_UNSET:
+		break;
+	}
+#endif /* HWACCEL */
+
+	crypto_aesgcm_soft_init(H, Htab);
+}
+
+/* Absorb ${nblocks} 16-byte blocks from ${buf} into the GHASH value. */
+static void
+crypto_aesgcm_ghash(struct crypto_aesgcm * stream, const uint8_t * buf,
+    size_t nblocks)
+{
+
+#ifdef HWACCEL
+	switch (hwaccel) {
+#if defined(CPUSUPPORT_X86_AESNI) && defined(CPUSUPPORT_X86_PCLMUL) &&	\
+    defined(CPUSUPPORT_X86_SSSE3)
+	case HW_X86_PCLMUL:
+		crypto_aesgcm_pclmul_ghash(stream->Htab, stream->Y, buf,
+		    nblocks);
+		return;
+#endif
+#if defined(CPUSUPPORT_ARM_AES) && defined(CPUSUPPORT_ARM_PMULL)
+	case HW_ARM_PMULL:
+		crypto_aesgcm_arm_ghash(stream->Htab, stream->Y, buf, nblocks);
+		return;
+#endif
+	case HW_SOFTWARE:
+	case HW_UNSET:
+		break;
+	}
+#endif /* HWACCEL */
+
+	crypto_aesgcm_soft_ghash(stream->Htab, stream->Y, buf, nblocks);
+}
+
+/* Encrypt or decrypt ${nblocks} whole blocks, absorbing the ciphertext. */
+static void
+crypto_aesgcm_blocks(struct crypto_aesgcm * stream, const uint8_t * inbuf,
+    uint8_t * outbuf, size_t nblocks, int decrypt)
+{
+
+#ifdef HWACCEL
+	switch (hwaccel) {
+#if defined(CPUSUPPORT_X86_AESNI) && defined(CPUSUPPORT_X86_PCLMUL) &&	\
+    defined(CPUSUPPORT_X86_SSSE3)
+	case HW_X86_PCLMUL:
+		crypto_aesgcm_pclmul_blocks(stream->key, stream->Htab,
+		    stream->ctr, stream->Y, inbuf, outbuf, nblocks, decrypt);
+		return;
+#endif
+#if defined(CPUSUPPORT_ARM_AES) && defined(CPUSUPPORT_ARM_PMULL)
+	case HW_ARM_PMULL:
+		crypto_aesgcm_arm_blocks(stream->key, stream->Htab,
+		    stream->ctr, stream->Y, inbuf, outbuf, nblocks, decrypt);
+		return;
+#endif
+	case HW_SOFTWARE:
+	case HW_UNSET:
+		break;
+	}
+#endif /* HWACCEL */
+
+	crypto_aesgcm_soft_blocks(stream->key, stream->Htab, stream->ctr,
+	    stream->Y, inbuf, outbuf, nblocks, decrypt);
+}
+
+/* Pad and absorb any partial block of additional authenticated data. */
+static void
+crypto_aesgcm_aad_finish(struct crypto_aesgcm * stream)
+{
+	size_t bytemod;
+
+	/* Have we already done this? */
+	if (stream->aad_done)
+		return;
+
+	/* Absorb any partial block, padded with zeros. */
+	bytemod = stream->aadlen % 16;
+	if (bytemod != 0) {
+		memset(&stream->gbuf[bytemod], 0, 16 - bytemod);
+		crypto_aesgcm_ghash(stream, stream->gbuf, 1);
+	}
+
+	/* No more additional authenticated data is allowed. */
+	stream->aad_done = 1;
+}
+
+/*
+ * Encrypt or decrypt up to ${*buflen} bytes using the rest of the current
+ * cipherblock, then update ${inbuf}, ${outbuf}, and ${buflen}.
+ */
+static void
+crypto_aesgcm_crypt_bytes(struct crypto_aesgcm * stream,
+    const uint8_t ** inbuf, uint8_t ** outbuf, size_t * buflen, int decrypt)
+{
+	size_t bytemod = stream->datalen % 16;
+	size_t nbytes = 16 - bytemod;
+	size_t i;
+	uint8_t c;
+
+	/* We can't process more bytes than we have. */
+	if (nbytes > *buflen)
+		nbytes = *buflen;
+
+	/* Encrypt or decrypt the byte(s), remembering the ciphertext. */
+	for (i = 0; i < nbytes; i++) {
+		c = (*inbuf)[i];
+		(*outbuf)[i] = c ^ stream->buf[bytemod + i];
+		stream->gbuf[bytemod + i] = decrypt ? c : (*outbuf)[i];
+	}
+
+	/* Update the positions. */
+	stream->datalen += nbytes;
+	*inbuf += nbytes;
+	*outbuf += nbytes;
+	*buflen -= nbytes;
+
+	/* If we finished a block, absorb it. */
+	if (stream->datalen % 16 == 0)
+		crypto_aesgcm_ghash(stream, stream->gbuf, 1);
+}
+
+/* Encrypt or decrypt ${buflen} bytes. */
+static void
+crypto_aesgcm_crypt(struct crypto_aesgcm * stream, const uint8_t * inbuf,
+    uint8_t * outbuf, size_t buflen, int decrypt)
+{
+	size_t nblocks;
+
+	/* Don't let the block counter wrap around. */
+	if (buflen > CRYPTO_AESGCM_MAXLEN - stream->datalen) {
+		warn0("Too much data for one AES-GCM message");
+		abort();
+	}
+
+	/* Finish with the additional authenticated data. */
+	crypto_aesgcm_aad_finish(stream);
+
+	/* Process any bytes before we can process a whole block. */
+	if ((stream->datalen % 16 != 0) && (buflen > 0))
+		crypto_aesgcm_crypt_bytes(stream, &inbuf, &outbuf, &buflen,
+		    decrypt);
+
+	/* Process whole blocks of 16 bytes. */
+	if (buflen >= 16) {
+		nblocks = buflen / 16;
+		crypto_aesgcm_blocks(stream, inbuf, outbuf, nblocks, decrypt);
+		stream->datalen += 16 * nblocks;
+		inbuf += 16 * nblocks;
+		outbuf += 16 * nblocks;
+		buflen -= 16 * nblocks;
+	}
+
+	/* Process any final bytes; we need a new cipherblock. */
+	if (buflen > 0) {
+		crypto_aes_encrypt_block(stream->ctr, stream->buf,
+		    stream->key);
+		ctr_inc(stream->ctr);
+		crypto_aesgcm_crypt_bytes(stream, &inbuf, &outbuf, &buflen,
+		    decrypt);
+	}
+}
+
+/**
+ * crypto_aesgcm_alloc(void):
+ * Allocate an object for performing AES in GCM mode.  This must be followed
+ * by calling _init2().
+ */
+struct crypto_aesgcm *
+crypto_aesgcm_alloc(void)
+{
+	struct crypto_aesgcm * stream;
+
+	/* Allocate memory. */
+	if ((stream = malloc(sizeof(struct crypto_aesgcm))) == NULL)
+		goto err0;
+
+	/* Success! */
+	return (stream);
+
+err0:
+	/* Failure! */
+	return (NULL);
+}
+
+/**
+ * crypto_aesgcm_init2(stream, key, iv):
+ * Reset the AES-GCM stream ${stream}, using the ${key} and ${iv}.  If ${key}
+ * is NULL, retain the previous AES key (and the authentication key derived
+ * from it).
+ */
+void
+crypto_aesgcm_init2(struct crypto_aesgcm * stream,
+    const struct crypto_aes_key * key, const uint8_t iv[12])
+{
+	uint8_t H[16];
+
+#ifdef HWACCEL
+	hwaccel_init();
+#endif
+
+	/* If we have a new key, compute the GHASH key H = E_K(0^128). */
+	if (key != NULL) {
+		stream->key = key;
+		memset(H, 0, 16);
+		crypto_aes_encrypt_block(H, H, key);
+		crypto_aesgcm_Htab_init(H, stream->Htab);
+		insecure_memzero(H, 16);
+	}
+
+	/* Sanity check. */
+	assert(stream->key != NULL);
+
+	/* The initial counter block is IV || 0^31 || 1. */
+	memcpy(stream->ctr, iv, 12);
+	be32enc(&stream->ctr[12], 1);
+	crypto_aes_encrypt_block(stream->ctr, stream->EJ0, stream->key);
+	ctr_inc(stream->ctr);
+
+	/* Reset the GHASH value and lengths. */
+	memset(stream->Y, 0, 16);
+	stream->aadlen = 0;
+	stream->datalen = 0;
+	stream->aad_done = 0;
+}
+
+/**
+ * crypto_aesgcm_init(key, iv):
+ * Prepare to encrypt/decrypt data with AES in GCM mode, using the provided
+ * expanded ${key} and 96-bit ${iv}.  The key provided must remain valid for
+ * the lifetime of the stream.  This is the same as calling _alloc() followed
+ * by _init2().
+ */
+struct crypto_aesgcm *
+crypto_aesgcm_init(const struct crypto_aes_key * key, const uint8_t iv[12])
+{
+	struct crypto_aesgcm * stream;
+
+	/* Sanity check. */
+	assert(key != NULL);
+
+	/* Allocate memory. */
+	if ((stream = crypto_aesgcm_alloc()) == NULL)
+		goto err0;
+
+	/* Initialize values. */
+	crypto_aesgcm_init2(stream, key, iv);
+
+	/* Success! */
+	return (stream);
+
+err0:
+	/* Failure! */
+	return (NULL);
+}
+
+/**
+ * crypto_aesgcm_aad(stream, buf, buflen):
+ * Add ${buflen} bytes from ${buf} to the additional authenticated data of the
+ * AES-GCM stream ${stream}.  This must not be called after any data has been
+ * passed to crypto_aesgcm_encrypt() or crypto_aesgcm_decrypt().
+ */
+void
+crypto_aesgcm_aad(struct crypto_aesgcm * stream, const uint8_t * buf,
+    size_t buflen)
+{
+	size_t bytemod;
+	size_t nbytes;
+	size_t nblocks;
+
+	/* Sanity check. */
+	assert(stream->aad_done == 0);
+
+	/* Nothing to do? */
+	if (buflen == 0)
+		return;
+
+	/* Fill any partial block first. */
+	bytemod = stream->aadlen % 16;
+	stream->aadlen += buflen;
+	if (bytemod != 0) {
+		nbytes = 16 - bytemod;
+		if (nbytes > buflen)
+			nbytes = buflen;
+		memcpy(&stream->gbuf[bytemod], buf, nbytes);
+		buf += nbytes;
+		buflen -= nbytes;
+
+		/* Absorb the block if it is complete. */
+		if (bytemod + nbytes < 16)
+			return;
+		crypto_aesgcm_ghash(stream, stream->gbuf, 1);
+	}
+
+	/* Absorb whole blocks. */
+	nblocks = buflen / 16;
+	if (nblocks > 0) {
+		crypto_aesgcm_ghash(stream, buf, nblocks);
+		buf += 16 * nblocks;
+		buflen -= 16 * nblocks;
+	}
+
+	/* Save any remaining bytes. */
+	memcpy(stream->gbuf, buf, buflen);
+}
+
+/**
+ * crypto_aesgcm_encrypt(stream, inbuf, outbuf, buflen):
+ * Encrypt ${buflen} bytes from ${inbuf} using the AES-GCM stream ${stream},
+ * writing the result into ${outbuf} and adding it to the data being
+ * authenticated.  If the buffers ${inbuf} and ${outbuf} overlap, they must be
+ * identical.  Attempting to process more than CRYPTO_AESGCM_MAXLEN bytes in
+ * total is a fatal error.
+ */
+void
+crypto_aesgcm_encrypt(struct crypto_aesgcm * stream, const uint8_t * inbuf,
+    uint8_t * outbuf, size_t buflen)
+{
+
+	crypto_aesgcm_crypt(stream, inbuf, outbuf, buflen, 0);
+}
+
+/**
+ * crypto_aesgcm_decrypt(stream, inbuf, outbuf, buflen):
+ * Decrypt ${buflen} bytes from ${inbuf} using the AES-GCM stream ${stream},
+ * adding them to the data being authenticated and writing the result into
+ * ${outbuf}.  If the buffers ${inbuf} and ${outbuf} overlap, they must be
+ * identical.  The output must not be used until crypto_aesgcm_verify() has
+ * confirmed that it is authentic.  Attempting to process more than
+ * CRYPTO_AESGCM_MAXLEN bytes in total is a fatal error.
+ */
+void
+crypto_aesgcm_decrypt(struct crypto_aesgcm * stream, const uint8_t * inbuf,
+    uint8_t * outbuf, size_t buflen)
+{
+
+	crypto_aesgcm_crypt(stream, inbuf, outbuf, buflen, 1);
+}
+
+/**
+ * crypto_aesgcm_tag(stream, tag):
+ * Finish the AES-GCM stream ${stream} and write its 16-byte authentication
+ * tag into ${tag}.  The stream must be reset via _init2() before it can be
+ * used again.
+ */
+void
+crypto_aesgcm_tag(struct crypto_aesgcm * stream, uint8_t tag[16])
+{
+	uint8_t lenblk[16];
+	size_t bytemod;
+	size_t i;
+
+	/* Finish with the additional authenticated data. */
+	crypto_aesgcm_aad_finish(stream);
+
+	/* Absorb any partial block of ciphertext, padded with zeros. */
+	bytemod = stream->datalen % 16;
+	if (bytemod != 0) {
+		memset(&stream->gbuf[bytemod], 0, 16 - bytemod);
+		crypto_aesgcm_ghash(stream, stream->gbuf, 1);
+	}
+
+	/* Absorb the lengths (in bits) of the two inputs. */
+	be64enc(&lenblk[0], stream->aadlen * 8);
+	be64enc(&lenblk[8], stream->datalen * 8);
+	crypto_aesgcm_ghash(stream, lenblk, 1);
+
+	/* The tag is the GHASH value encrypted with the initial counter. */
+	for (i = 0; i < 16; i++)
+		tag[i] = stream->Y[i] ^ stream->EJ0[i];
+}
+
+/**
+ * crypto_aesgcm_verify(stream, tag):
+ * Finish the AES-GCM stream ${stream} and compare its authentication tag
+ * against ${tag} without leaking information via timing side channels.
+ * Return 0 if the tags match, or -1 otherwise.  The stream must be reset via
+ * _init2() before it can be used again.
+ */
+int
+crypto_aesgcm_verify(struct crypto_aesgcm * stream, const uint8_t tag[16])
+{
+	uint8_t tag_actual[16];
+	int rc;
+
+	/* Compute the tag and compare. */
+	crypto_aesgcm_tag(stream, tag_actual);
+	rc = crypto_verify_bytes(tag_actual, tag, 16) ? -1 : 0;
+
+	/* Clean up. */
+	insecure_memzero(tag_actual, 16);
+
+	return (rc);
+}
+
+/**
+ * crypto_aesgcm_free(stream):
+ * Free the AES-GCM stream ${stream}.
+ */
+void
+crypto_aesgcm_free(struct crypto_aesgcm * stream)
+{
+
+	/* Behave consistently with free(NULL). */
+	if (stream == NULL)
+		return;
+
+	/* Zero potentially sensitive information. */
+	insecure_memzero(stream, sizeof(struct crypto_aesgcm));
+
+	/* Free the stream. */
+	free(stream);
+}
+
+/**
+ * crypto_aesgcm_encrypt_buf(key, iv, aad, aadlen, inbuf, outbuf, buflen,
+ *     tag):
+ * Equivalent to _init(key, iv); _aad(aad, aadlen);
+ * _encrypt(inbuf, outbuf, buflen); _tag(tag); _free().
+ */
+void
+crypto_aesgcm_encrypt_buf(const struct crypto_aes_key * key,
+    const uint8_t iv[12], const uint8_t * aad, size_t aadlen,
+    const uint8_t * inbuf, uint8_t * outbuf, size_t buflen, uint8_t tag[16])
+{
+	struct crypto_aesgcm stream_rec;
+	struct crypto_aesgcm * stream = &stream_rec;
+
+	/* Sanity check. */
+	assert(key != NULL);
+
+	/* Initialize values. */
+	crypto_aesgcm_init2(stream, key, iv);
+
+	/* Perform the authenticated encryption. */
+	crypto_aesgcm_aad(stream, aad, aadlen);
+	crypto_aesgcm_encrypt(stream, inbuf, outbuf, buflen);
+	crypto_aesgcm_tag(stream, tag);
+
+	/* Zero potentially sensitive information. */
+	insecure_memzero(stream, sizeof(struct crypto_aesgcm));
+}
+
+/**
+ * crypto_aesgcm_decrypt_buf(key, iv, aad, aadlen, inbuf, outbuf, buflen,
+ *     tag):
+ * Equivalent to _init(key, iv); _aad(aad, aadlen);
+ * _decrypt(inbuf, outbuf, buflen); _verify(tag); _free().  If the
+ * authentication tag does not match, zero ${outbuf} and return -1; otherwise,
+ * return 0.
+ */
+int
+crypto_aesgcm_decrypt_buf(const struct crypto_aes_key * key,
+    const uint8_t iv[12], const uint8_t * aad, size_t aadlen,
+    const uint8_t * inbuf, uint8_t * outbuf, size_t buflen,
+    const uint8_t tag[16])
+{
+	struct crypto_aesgcm stream_rec;
+	struct crypto_aesgcm * stream = &stream_rec;
+	int rc;
+
+	/* Sanity check. */
+	assert(key != NULL);
+
+	/* Initialize values. */
+	crypto_aesgcm_init2(stream, key, iv);
+
+	/* Perform the authenticated decryption. */
+	crypto_aesgcm_aad(stream, aad, aadlen);
+	crypto_aesgcm_decrypt(stream, inbuf, outbuf, buflen);
+	rc = crypto_aesgcm_verify(stream, tag);
+
+	/* Don't release unauthenticated plaintext. */
+	if (rc)
+		memset(outbuf, 0, buflen);
+
+	/* Zero potentially sensitive information. */
+	insecure_memzero(stream, sizeof(struct crypto_aesgcm));
+
+	return (rc);
+}
+
+#ifdef HWACCEL
+/* Time encryption using the implementation ${id}. */
+static void
+hwbench(int id)
+{
+	static const uint8_t key[32];
+	static const uint8_t iv[12];
+	static uint8_t buf[4096];
+	struct crypto_aes_key * kexp;
+	uint8_t tag[16];
+
+	if ((kexp = crypto_aes_key_expand(key, 32)) == NULL)
+		return;
+	hwaccel = id;
+	crypto_aesgcm_encrypt_buf(kexp, iv, NULL, 0, buf, buf, sizeof(buf),
+	    tag);
+	crypto_aes_key_free(kexp);
+}
+#endif
@@ -0,0 +1,119 @@
+#ifndef _CRYPTO_AESGCM_H_
+#define _CRYPTO_AESGCM_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* Opaque types. */
+struct crypto_aes_key;
+struct crypto_aesgcm;
+
+/*
+ * Maximum number of bytes which can be encrypted or decrypted with one IV:
+ * after 2^32 - 2 blocks, the 32-bit block counter would wrap around.
+ */
+#define CRYPTO_AESGCM_MAXLEN 68719476704ULL
+
+/**
+ * crypto_aesgcm_init(key, iv):
+ * Prepare to encrypt/decrypt data with AES in GCM mode, using the provided
+ * expanded ${key} and 96-bit ${iv}.  The key provided must remain valid for
+ * the lifetime of the stream.  This is the same as calling _alloc() followed
+ * by _init2().
+ */
+struct crypto_aesgcm * crypto_aesgcm_init(const struct crypto_aes_key *,
+    const uint8_t[12]);
+
+/**
+ * crypto_aesgcm_alloc(void):
+ * Allocate an object for performing AES in GCM mode.  This must be followed
+ * by calling _init2().
+ */
+struct crypto_aesgcm * crypto_aesgcm_alloc(void);
+
+/**
+ * crypto_aesgcm_init2(stream, key, iv):
+ * Reset the AES-GCM stream ${stream}, using the ${key} and ${iv}.  If ${key}
+ * is NULL, retain the previous AES key (and the authentication key derived
+ * from it).
+ */
+void crypto_aesgcm_init2(struct crypto_aesgcm *,
+    const struct crypto_aes_key *, const uint8_t[12]);
+
+/**
+ * crypto_aesgcm_aad(stream, buf, buflen):
+ * Add ${buflen} bytes from ${buf} to the additional authenticated data of the
+ * AES-GCM stream ${stream}.  This must not be called after any data has been
+ * passed to crypto_aesgcm_encrypt() or crypto_aesgcm_decrypt().
+ */
+void crypto_aesgcm_aad(struct crypto_aesgcm *, const uint8_t *, size_t);
+
+/**
+ * crypto_aesgcm_encrypt(stream, inbuf, outbuf, buflen):
+ * Encrypt ${buflen} bytes from ${inbuf} using the AES-GCM stream ${stream},
+ * writing the result into ${outbuf} and adding it to the data being
+ * authenticated.  If the buffers ${inbuf} and ${outbuf} overlap, they must be
+ * identical.  Attempting to process more than CRYPTO_AESGCM_MAXLEN bytes in
+ * total is a fatal error.
+ */
+void crypto_aesgcm_encrypt(struct crypto_aesgcm *, const uint8_t *,
+    uint8_t *, size_t);
+
+/**
+ * crypto_aesgcm_decrypt(stream, inbuf, outbuf, buflen):
+ * Decrypt ${buflen} bytes from ${inbuf} using the AES-GCM stream ${stream},
+ * adding them to the data being authenticated and writing the result into
+ * ${outbuf}.  If the buffers ${inbuf} and ${outbuf} overlap, they must be
+ * identical.  The output must not be used until crypto_aesgcm_verify() has
+ * confirmed that it is authentic.  Attempting to process more than
+ * CRYPTO_AESGCM_MAXLEN bytes in total is a fatal error.
+ */
+void crypto_aesgcm_decrypt(struct crypto_aesgcm *, const uint8_t *,
+    uint8_t *, size_t);
+
+/**
+ * crypto_aesgcm_tag(stream, tag):
+ * Finish the AES-GCM stream ${stream} and write its 16-byte authentication
+ * tag into ${tag}.  The stream must be reset via _init2() before it can be
+ * used again.
+ */
+void crypto_aesgcm_tag(struct crypto_aesgcm *, uint8_t[16]);
+
+/**
+ * crypto_aesgcm_verify(stream, tag):
+ * Finish the AES-GCM stream ${stream} and compare its authentication tag
+ * against ${tag} without leaking information via timing side channels.
+ * Return 0 if the tags match, or -1 otherwise.  The stream must be reset via
+ * _init2() before it can be used again.
+ */
+int crypto_aesgcm_verify(struct crypto_aesgcm *, const uint8_t[16]);
+
+/**
+ * crypto_aesgcm_free(stream):
+ * Free the AES-GCM stream ${stream}.
+ */
+void crypto_aesgcm_free(struct crypto_aesgcm *);
+
+/**
+ * crypto_aesgcm_encrypt_buf(key, iv, aad, aadlen, inbuf, outbuf, buflen,
+ *     tag):
+ * Equivalent to _init(key, iv); _aad(aad, aadlen);
+ * _encrypt(inbuf, outbuf, buflen); _tag(tag); _free().
+ */
+void crypto_aesgcm_encrypt_buf(const struct crypto_aes_key *,
+    const uint8_t[12], const uint8_t *, size_t, const uint8_t *, uint8_t *,
+    size_t, uint8_t[16]);
+
+/**
+ * crypto_aesgcm_decrypt_buf(key, iv, aad, aadlen, inbuf, outbuf, buflen,
+ *     tag):
+ * Equivalent to _init(key, iv); _aad(aad, aadlen);
+ * _decrypt(inbuf, outbuf, buflen); _verify(tag); _free().  If the
+ * authentication tag does not match, zero ${outbuf} and return -1; otherwise,
+ * return 0.
+ */
+int crypto_aesgcm_decrypt_buf(const struct crypto_aes_key *,
+    const uint8_t[12], const uint8_t *, size_t, const uint8_t *, uint8_t *,
+    size_t, const uint8_t[16]);
+
+#endif /* !_CRYPTO_AESGCM_H_ */
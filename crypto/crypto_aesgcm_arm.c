@@ -0,0 +1,269 @@
+#include "cpusupport.h"
+#if defined(CPUSUPPORT_ARM_AES) && defined(CPUSUPPORT_ARM_PMULL)
+/**
+ * CPUSUPPORT CFLAGS: ARM_AES ARM_PMULL
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#ifdef __ARM_NEON
+#include <arm_neon.h>
+#endif
+
+#include "crypto_aes.h"
+#include "crypto_aes_arm_u8.h"
+#include "sysendian.h"
+
+#include "crypto_aesgcm_arm.h"
+
+/**
+ * This follows the same approach as crypto_aesgcm_pclmul.c: blocks are
+ * byte-reversed when loaded, 256-bit products are shifted left by one bit to
+ * account for the bits within each byte being reflected, and the reduction
+ * modulo x^128 + x^7 + x^2 + x + 1 is performed using shifts within 32-bit
+ * lanes.  The x86 byte shifts _mm_slli_si128 and _mm_srli_si128 are
+ * expressed here using vextq_u8 with a vector of zeros.
+ */
+
+/* Shift the vector ${x} towards its most significant end by ${n} bytes. */
+#define SLLI_U128(x, n)	vextq_u8(vdupq_n_u8(0), (x), 16 - (n))
+
+/* Shift the vector ${x} towards its least significant end by ${n} bytes. */
+#define SRLI_U128(x, n)	vextq_u8((x), vdupq_n_u8(0), (n))
+
+/* Shift each 32-bit lane of ${x} left or right by ${n} bits. */
+#define SLLI_U32(x, n)							\
+	vreinterpretq_u8_u32(vshlq_n_u32(vreinterpretq_u32_u8(x), (n)))
+#define SRLI_U32(x, n)							\
+	vreinterpretq_u8_u32(vshrq_n_u32(vreinterpretq_u32_u8(x), (n)))
+
+/* Carry-less multiply of 64-bit lane ${la} of ${a} by lane ${lb} of ${b}. */
+#define PMULL(a, la, b, lb)						\
+	vreinterpretq_u8_p128(vmull_p64(				\
+	    vgetq_lane_p64(vreinterpretq_p64_u8(a), (la)),		\
+	    vgetq_lane_p64(vreinterpretq_p64_u8(b), (lb))))
+
+/* Reverse the order of the bytes in ${x}. */
+static inline uint8x16_t
+bswap(uint8x16_t x)
+{
+
+	x = vrev64q_u8(x);
+	return (vextq_u8(x, x, 8));
+}
+
+/* Multiply ${a} by ${b}, adding the 256-bit product to (${lo}, ${hi}). */
+static inline void
+clmul_acc(uint8x16_t a, uint8x16_t b, uint8x16_t * lo, uint8x16_t * hi)
+{
+	uint8x16_t t0, t1, t2, t3;
+
+	/* Schoolbook multiplication of 64-bit halves. */
+	t0 = PMULL(a, 0, b, 0);
+	t1 = PMULL(a, 0, b, 1);
+	t2 = PMULL(a, 1, b, 0);
+	t3 = PMULL(a, 1, b, 1);
+
+	/* Combine the middle terms and add them into place. */
+	t1 = veorq_u8(t1, t2);
+	*lo = veorq_u8(*lo, veorq_u8(t0, SLLI_U128(t1, 8)));
+	*hi = veorq_u8(*hi, veorq_u8(t3, SRLI_U128(t1, 8)));
+}
+
+/* Shift the 256-bit product (${lo}, ${hi}) left one bit and reduce it. */
+static inline uint8x16_t
+reduce(uint8x16_t lo, uint8x16_t hi)
+{
+	uint8x16_t t0, t1, t2;
+
+	/* Shift (lo, hi) left by one bit, carrying between 32-bit lanes. */
+	t0 = SRLI_U32(lo, 31);
+	t1 = SRLI_U32(hi, 31);
+	lo = SLLI_U32(lo, 1);
+	hi = SLLI_U32(hi, 1);
+	t2 = SRLI_U128(t0, 12);
+	t0 = SLLI_U128(t0, 4);
+	t1 = SLLI_U128(t1, 4);
+	lo = vorrq_u8(lo, t0);
+	hi = vorrq_u8(hi, vorrq_u8(t1, t2));
+
+	/* First phase of the reduction. */
+	t0 = veorq_u8(SLLI_U32(lo, 31), SLLI_U32(lo, 30));
+	t0 = veorq_u8(t0, SLLI_U32(lo, 25));
+	t1 = SRLI_U128(t0, 4);
+	lo = veorq_u8(lo, SLLI_U128(t0, 12));
+
+	/* Second phase of the reduction. */
+	t0 = veorq_u8(SRLI_U32(lo, 1), SRLI_U32(lo, 2));
+	t0 = veorq_u8(t0, SRLI_U32(lo, 7));
+	t0 = veorq_u8(t0, t1);
+	lo = veorq_u8(lo, t0);
+
+	return (veorq_u8(hi, lo));
+}
+
+/* Return (${y} + ${x}) * ${h}, with all values byte-reversed. */
+static inline uint8x16_t
+ghash1(uint8x16_t y, uint8x16_t x, uint8x16_t h)
+{
+	uint8x16_t lo = vdupq_n_u8(0);
+	uint8x16_t hi = vdupq_n_u8(0);
+
+	clmul_acc(veorq_u8(y, x), h, &lo, &hi);
+	return (reduce(lo, hi));
+}
+
+/* Absorb the four byte-reversed blocks ${x}[0 .. 3] into ${y}. */
+static inline uint8x16_t
+ghash4(uint8x16_t y, const uint8x16_t x[4], const uint8x16_t h[4])
+{
+	uint8x16_t lo = vdupq_n_u8(0);
+	uint8x16_t hi = vdupq_n_u8(0);
+
+	clmul_acc(veorq_u8(y, x[0]), h[3], &lo, &hi);
+	clmul_acc(x[1], h[2], &lo, &hi);
+	clmul_acc(x[2], h[1], &lo, &hi);
+	clmul_acc(x[3], h[0], &lo, &hi);
+	return (reduce(lo, hi));
+}
+
+/**
+ * crypto_aesgcm_arm_init(H, Htab):
+ * Fill the 64-byte table ${Htab} with the powers of the GHASH key ${H} which
+ * are used by crypto_aesgcm_arm_ghash() and _blocks().  This implementation
+ * uses ARM PMULL instructions, and should only be used if CPUSUPPORT_ARM_PMULL
+ * is defined and cpusupport_arm_pmull() returns nonzero.
+ */
+void
+crypto_aesgcm_arm_init(const uint8_t H[16], uint8_t Htab[64])
+{
+	uint8x16_t h, hpow;
+	int i;
+
+	/* Compute H, H^2, H^3, and H^4. */
+	h = bswap(vld1q_u8(H));
+	hpow = h;
+	for (i = 0; i < 4; i++) {
+		vst1q_u8(&Htab[16 * i], hpow);
+		hpow = ghash1(vdupq_n_u8(0), hpow, h);
+	}
+}
+
+/**
+ * crypto_aesgcm_arm_ghash(Htab, Y, buf, nblocks):
+ * Absorb ${nblocks} 16-byte blocks from ${buf} into the GHASH value ${Y},
+ * using the table ${Htab}.  This implementation uses ARM PMULL instructions,
+ * and should only be used if CPUSUPPORT_ARM_PMULL is defined and
+ * cpusupport_arm_pmull() returns nonzero.
+ */
+void
+crypto_aesgcm_arm_ghash(const uint8_t Htab[64], uint8_t Y[16],
+    const uint8_t * buf, size_t nblocks)
+{
+	uint8x16_t h[4];
+	uint8x16_t x[4];
+	uint8x16_t y;
+	int i;
+
+	/* Load the powers of H and the current GHASH value. */
+	for (i = 0; i < 4; i++)
+		h[i] = vld1q_u8(&Htab[16 * i]);
+	y = bswap(vld1q_u8(Y));
+
+	/* Absorb four blocks at once. */
+	for (; nblocks >= 4; nblocks -= 4) {
+		for (i = 0; i < 4; i++)
+			x[i] = bswap(vld1q_u8(&buf[16 * i]));
+		y = ghash4(y, x, h);
+		buf += 64;
+	}
+
+	/* Absorb any remaining blocks one at a time. */
+	for (; nblocks > 0; nblocks--) {
+		y = ghash1(y, bswap(vld1q_u8(buf)), h[0]);
+		buf += 16;
+	}
+
+	/* Store the updated GHASH value. */
+	vst1q_u8(Y, bswap(y));
+}
+
+/**
+ * crypto_aesgcm_arm_blocks(key, Htab, ctr, Y, inbuf, outbuf, nblocks,
+ *     decrypt):
+ * Encrypt (or decrypt, if ${decrypt} is nonzero) ${nblocks} 16-byte blocks
+ * from ${inbuf} into ${outbuf} with the expanded AES key ${key} and the
+ * counter block ${ctr}, and absorb the ciphertext into the GHASH value ${Y}
+ * using the table ${Htab}.  Update ${ctr} to the next unused counter block.
+ * If the buffers ${inbuf} and ${outbuf} overlap, they must be identical.
+ * This implementation uses ARM AES and PMULL instructions, and should only be
+ * used if CPUSUPPORT_ARM_AES and _PMULL are defined, cpusupport_arm_pmull()
+ * returns nonzero, and crypto_aes_can_use_intrinsics() returns 2.
+ */
+void
+crypto_aesgcm_arm_blocks(const struct crypto_aes_key * key,
+    const uint8_t Htab[64], uint8_t ctr[16], uint8_t Y[16],
+    const uint8_t * inbuf, uint8_t * outbuf, size_t nblocks, int decrypt)
+{
+	uint8x16_t h[4];
+	uint8x16_t x[4];
+	uint8x16_t y;
+	uint8x16_t in, out;
+	uint8_t cblk[16];
+	uint32_t ctr32;
+	int i;
+
+	/* Load the powers of H and the current GHASH value. */
+	for (i = 0; i < 4; i++)
+		h[i] = vld1q_u8(&Htab[16 * i]);
+	y = bswap(vld1q_u8(Y));
+
+	/* Load the counter block; GCM increments the final 32 bits. */
+	memcpy(cblk, ctr, 16);
+	ctr32 = be32dec(&cblk[12]);
+
+	/* Process four blocks at once. */
+	for (; nblocks >= 4; nblocks -= 4) {
+		for (i = 0; i < 4; i++) {
+			/* Encrypt the counter to get a cipherblock. */
+			be32enc(&cblk[12], ctr32++);
+			out = crypto_aes_encrypt_block_arm_u8(vld1q_u8(cblk),
+			    key);
+
+			/* Encrypt or decrypt the block. */
+			in = vld1q_u8(inbuf);
+			out = veorq_u8(in, out);
+			vst1q_u8(outbuf, out);
+
+			/* Remember the ciphertext for GHASH. */
+			x[i] = bswap(decrypt ? in : out);
+
+			/* Move to the next block. */
+			inbuf += 16;
+			outbuf += 16;
+		}
+
+		/* Absorb the four ciphertext blocks. */
+		y = ghash4(y, x, h);
+	}
+
+	/* Process any remaining blocks one at a time. */
+	for (; nblocks > 0; nblocks--) {
+		be32enc(&cblk[12], ctr32++);
+		out = crypto_aes_encrypt_block_arm_u8(vld1q_u8(cblk), key);
+		in = vld1q_u8(inbuf);
+		out = veorq_u8(in, out);
+		vst1q_u8(outbuf, out);
+		y = ghash1(y, bswap(decrypt ? in : out), h[0]);
+		inbuf += 16;
+		outbuf += 16;
+	}
+
+	/* Store the updated counter and GHASH value. */
+	be32enc(&ctr[12], ctr32);
+	vst1q_u8(Y, bswap(y));
+}
+
+#endif /* CPUSUPPORT_ARM_AES && CPUSUPPORT_ARM_PMULL */
@@ -0,0 +1,263 @@
+#include "cpusupport.h"
+#if defined(CPUSUPPORT_X86_AESNI) && defined(CPUSUPPORT_X86_PCLMUL) &&	\
+    defined(CPUSUPPORT_X86_SSSE3)
+/**
+ * CPUSUPPORT CFLAGS: X86_AESNI X86_PCLMUL X86_SSSE3
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <emmintrin.h>
+#include <tmmintrin.h>
+#include <wmmintrin.h>
+
+#include "crypto_aes.h"
+#include "crypto_aes_aesni_m128i.h"
+
+#include "crypto_aesgcm_pclmul.h"
+
+/**
+ * GHASH treats the first bit of each block as the coefficient of x^0 in a
+ * polynomial over GF(2); this is the reverse of the order in which PCLMULQDQ
+ * interprets bits.  Following Intel's "Carry-Less Multiplication Instruction
+ * and its Usage for Computing the GCM Mode" white paper, we byte-reverse each
+ * block when loading it, which leaves the bits within each byte reflected;
+ * this is corrected by shifting each 256-bit product left by one bit before
+ * reducing it modulo x^128 + x^7 + x^2 + x + 1.
+ *
+ * Since this shift and the reduction are both linear, we can also add
+ * together several unreduced products and perform a single reduction; we do
+ * this to absorb four blocks at once using precomputed powers of H.
+ */
+
+/* Reverse the order of the bytes in ${x}. */
+static inline __m128i
+bswap(__m128i x)
+{
+	const __m128i mask = _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7,
+	    8, 9, 10, 11, 12, 13, 14, 15);
+
+	return (_mm_shuffle_epi8(x, mask));
+}
+
+/* Multiply ${a} by ${b}, adding the 256-bit product to (${lo}, ${hi}). */
+static inline void
+clmul_acc(__m128i a, __m128i b, __m128i * lo, __m128i * hi)
+{
+	__m128i t0, t1, t2, t3;
+
+	/* Schoolbook multiplication of 64-bit halves. */
+	t0 = _mm_clmulepi64_si128(a, b, 0x00);
+	t1 = _mm_clmulepi64_si128(a, b, 0x10);
+	t2 = _mm_clmulepi64_si128(a, b, 0x01);
+	t3 = _mm_clmulepi64_si128(a, b, 0x11);
+
+	/* Combine the middle terms and add them into place. */
+	t1 = _mm_xor_si128(t1, t2);
+	*lo = _mm_xor_si128(*lo, _mm_xor_si128(t0, _mm_slli_si128(t1, 8)));
+	*hi = _mm_xor_si128(*hi, _mm_xor_si128(t3, _mm_srli_si128(t1, 8)));
+}
+
+/* Shift the 256-bit product (${lo}, ${hi}) left one bit and reduce it. */
+static inline __m128i
+reduce(__m128i lo, __m128i hi)
+{
+	__m128i t0, t1, t2;
+
+	/* Shift (lo, hi) left by one bit, carrying between 32-bit lanes. */
+	t0 = _mm_srli_epi32(lo, 31);
+	t1 = _mm_srli_epi32(hi, 31);
+	lo = _mm_slli_epi32(lo, 1);
+	hi = _mm_slli_epi32(hi, 1);
+	t2 = _mm_srli_si128(t0, 12);
+	t0 = _mm_slli_si128(t0, 4);
+	t1 = _mm_slli_si128(t1, 4);
+	lo = _mm_or_si128(lo, t0);
+	hi = _mm_or_si128(hi, _mm_or_si128(t1, t2));
+
+	/* First phase of the reduction. */
+	t0 = _mm_xor_si128(_mm_slli_epi32(lo, 31), _mm_slli_epi32(lo, 30));
+	t0 = _mm_xor_si128(t0, _mm_slli_epi32(lo, 25));
+	t1 = _mm_srli_si128(t0, 4);
+	lo = _mm_xor_si128(lo, _mm_slli_si128(t0, 12));
+
+	/* Second phase of the reduction. */
+	t0 = _mm_xor_si128(_mm_srli_epi32(lo, 1), _mm_srli_epi32(lo, 2));
+	t0 = _mm_xor_si128(t0, _mm_srli_epi32(lo, 7));
+	t0 = _mm_xor_si128(t0, t1);
+	lo = _mm_xor_si128(lo, t0);
+
+	return (_mm_xor_si128(hi, lo));
+}
+
+/* Return (${y} + ${x}) * ${h}, with all values byte-reversed. */
+static inline __m128i
+ghash1(__m128i y, __m128i x, __m128i h)
+{
+	__m128i lo = _mm_setzero_si128();
+	__m128i hi = _mm_setzero_si128();
+
+	clmul_acc(_mm_xor_si128(y, x), h, &lo, &hi);
+	return (reduce(lo, hi));
+}
+
+/* Absorb the four byte-reversed blocks ${x}[0 .. 3] into ${y}. */
+static inline __m128i
+ghash4(__m128i y, const __m128i x[4], const __m128i h[4])
+{
+	__m128i lo = _mm_setzero_si128();
+	__m128i hi = _mm_setzero_si128();
+
+	clmul_acc(_mm_xor_si128(y, x[0]), h[3], &lo, &hi);
+	clmul_acc(x[1], h[2], &lo, &hi);
+	clmul_acc(x[2], h[1], &lo, &hi);
+	clmul_acc(x[3], h[0], &lo, &hi);
+	return (reduce(lo, hi));
+}
+
+/**
+ * crypto_aesgcm_pclmul_init(H, Htab):
+ * Fill the 64-byte table ${Htab} with the powers of the GHASH key ${H} which
+ * are used by crypto_aesgcm_pclmul_ghash() and _blocks().  This
+ * implementation uses x86 PCLMUL and SSSE3 instructions, and should only be
+ * used if CPUSUPPORT_X86_PCLMUL and _SSSE3 are defined and
+ * cpusupport_x86_pclmul() and _ssse3() return nonzero.
+ */
+void
+crypto_aesgcm_pclmul_init(const uint8_t H[16], uint8_t Htab[64])
+{
+	__m128i h, hpow;
+	int i;
+
+	/* Compute H, H^2, H^3, and H^4. */
+	h = bswap(_mm_loadu_si128((const __m128i *)H));
+	hpow = h;
+	for (i = 0; i < 4; i++) {
+		_mm_storeu_si128((__m128i *)&Htab[16 * i], hpow);
+		hpow = ghash1(_mm_setzero_si128(), hpow, h);
+	}
+}
+
+/**
+ * crypto_aesgcm_pclmul_ghash(Htab, Y, buf, nblocks):
+ * Absorb ${nblocks} 16-byte blocks from ${buf} into the GHASH value ${Y},
+ * using the table ${Htab}.  This implementation uses x86 PCLMUL and SSSE3
+ * instructions, and should only be used if CPUSUPPORT_X86_PCLMUL and _SSSE3
+ * are defined and cpusupport_x86_pclmul() and _ssse3() return nonzero.
+ */
+void
+crypto_aesgcm_pclmul_ghash(const uint8_t Htab[64], uint8_t Y[16],
+    const uint8_t * buf, size_t nblocks)
+{
+	__m128i h[4];
+	__m128i x[4];
+	__m128i y;
+	int i;
+
+	/* Load the powers of H and the current GHASH value. */
+	for (i = 0; i < 4; i++)
+		h[i] = _mm_loadu_si128((const __m128i *)&Htab[16 * i]);
+	y = bswap(_mm_loadu_si128((const __m128i *)Y));
+
+	/* Absorb four blocks at once. */
+	for (; nblocks >= 4; nblocks -= 4) {
+		for (i = 0; i < 4; i++)
+			x[i] = bswap(_mm_loadu_si128(
+			    (const __m128i *)&buf[16 * i]));
+		y = ghash4(y, x, h);
+		buf += 64;
+	}
+
+	/* Absorb any remaining blocks one at a time. */
+	for (; nblocks > 0; nblocks--) {
+		y = ghash1(y, bswap(_mm_loadu_si128((const __m128i *)buf)),
+		    h[0]);
+		buf += 16;
+	}
+
+	/* Store the updated GHASH value. */
+	_mm_storeu_si128((__m128i *)Y, bswap(y));
+}
+
+/**
+ * crypto_aesgcm_pclmul_blocks(key, Htab, ctr, Y, inbuf, outbuf, nblocks,
+ *     decrypt):
+ * Encrypt (or decrypt, if ${decrypt} is nonzero) ${nblocks} 16-byte blocks
+ * from ${inbuf} into ${outbuf} with the expanded AES key ${key} and the
+ * counter block ${ctr}, and absorb the ciphertext into the GHASH value ${Y}
+ * using the table ${Htab}.  Update ${ctr} to the next unused counter block.
+ * If the buffers ${inbuf} and ${outbuf} overlap, they must be identical.
+ * This implementation uses x86 AESNI, PCLMUL, and SSSE3 instructions, and
+ * should only be used if CPUSUPPORT_X86_AESNI, _PCLMUL, and _SSSE3 are
+ * defined, cpusupport_x86_pclmul() and _ssse3() return nonzero, and
+ * crypto_aes_can_use_intrinsics() returns 1.
+ */
+void
+crypto_aesgcm_pclmul_blocks(const struct crypto_aes_key * key,
+    const uint8_t Htab[64], uint8_t ctr[16], uint8_t Y[16],
+    const uint8_t * inbuf, uint8_t * outbuf, size_t nblocks, int decrypt)
+{
+	const __m128i one = _mm_set_epi32(0, 0, 0, 1);
+	__m128i h[4];
+	__m128i x[4];
+	__m128i ctr_r;
+	__m128i y;
+	__m128i in, out;
+	int i;
+
+	/* Load the powers of H and the current GHASH value. */
+	for (i = 0; i < 4; i++)
+		h[i] = _mm_loadu_si128((const __m128i *)&Htab[16 * i]);
+	y = bswap(_mm_loadu_si128((const __m128i *)Y));
+
+	/*
+	 * Byte-reverse the counter block; the 32-bit counter which GCM
+	 * increments then lives in the lowest 32-bit lane, where it can be
+	 * incremented (modulo 2^32) with a single addition.
+	 */
+	ctr_r = bswap(_mm_loadu_si128((const __m128i *)ctr));
+
+	/* Process four blocks at once. */
+	for (; nblocks >= 4; nblocks -= 4) {
+		for (i = 0; i < 4; i++) {
+			/* Encrypt the counter to get a cipherblock. */
+			out = crypto_aes_encrypt_block_aesni_m128i(
+			    bswap(ctr_r), key);
+			ctr_r = _mm_add_epi32(ctr_r, one);
+
+			/* Encrypt or decrypt the block. */
+			in = _mm_loadu_si128((const __m128i *)inbuf);
+			out = _mm_xor_si128(in, out);
+			_mm_storeu_si128((__m128i *)outbuf, out);
+
+			/* Remember the ciphertext for GHASH. */
+			x[i] = bswap(decrypt ? in : out);
+
+			/* Move to the next block. */
+			inbuf += 16;
+			outbuf += 16;
+		}
+
+		/* Absorb the four ciphertext blocks. */
+		y = ghash4(y, x, h);
+	}
+
+	/* Process any remaining blocks one at a time. */
+	for (; nblocks > 0; nblocks--) {
+		out = crypto_aes_encrypt_block_aesni_m128i(bswap(ctr_r), key);
+		ctr_r = _mm_add_epi32(ctr_r, one);
+		in = _mm_loadu_si128((const __m128i *)inbuf);
+		out = _mm_xor_si128(in, out);
+		_mm_storeu_si128((__m128i *)outbuf, out);
+		y = ghash1(y, bswap(decrypt ? in : out), h[0]);
+		inbuf += 16;
+		outbuf += 16;
+	}
+
+	/* Store the updated counter and GHASH value. */
+	_mm_storeu_si128((__m128i *)ctr, bswap(ctr_r));
+	_mm_storeu_si128((__m128i *)Y, bswap(y));
+}
+
+#endif /* CPUSUPPORT_X86_AESNI && _PCLMUL && _SSSE3 */
@@ -0,0 +1,47 @@
+#ifndef _CRYPTO_AESGCM_PCLMUL_H_
+#define _CRYPTO_AESGCM_PCLMUL_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* Opaque type. */
+struct crypto_aes_key;
+
+/**
+ * crypto_aesgcm_pclmul_init(H, Htab):
+ * Fill the 64-byte table ${Htab} with the powers of the GHASH key ${H} which
+ * are used by crypto_aesgcm_pclmul_ghash() and _blocks().  This
+ * implementation uses x86 PCLMUL and SSSE3 instructions, and should only be
+ * used if CPUSUPPORT_X86_PCLMUL and _SSSE3 are defined and
+ * cpusupport_x86_pclmul() and _ssse3() return nonzero.
+ */
+void crypto_aesgcm_pclmul_init(const uint8_t[16], uint8_t[64]);
+
+/**
+ * crypto_aesgcm_pclmul_ghash(Htab, Y, buf, nblocks):
+ * Absorb ${nblocks} 16-byte blocks from ${buf} into the GHASH value ${Y},
+ * using the table ${Htab}.  This implementation uses x86 PCLMUL and SSSE3
+ * instructions, and should only be used if CPUSUPPORT_X86_PCLMUL and _SSSE3
+ * are defined and cpusupport_x86_pclmul() and _ssse3() return nonzero.
+ */
+void crypto_aesgcm_pclmul_ghash(const uint8_t[64], uint8_t[16],
+    const uint8_t *, size_t);
+
+/**
+ * crypto_aesgcm_pclmul_blocks(key, Htab, ctr, Y, inbuf, outbuf, nblocks,
+ *     decrypt):
+ * Encrypt (or decrypt, if ${decrypt} is nonzero) ${nblocks} 16-byte blocks
+ * from ${inbuf} into ${outbuf} with the expanded AES key ${key} and the
+ * counter block ${ctr}, and absorb the ciphertext into the GHASH value ${Y}
+ * using the table ${Htab}.  Update ${ctr} to the next unused counter block.
+ * If the buffers ${inbuf} and ${outbuf} overlap, they must be identical.
+ * This implementation uses x86 AESNI, PCLMUL, and SSSE3 instructions, and
+ * should only be used if CPUSUPPORT_X86_AESNI, _PCLMUL, and _SSSE3 are
+ * defined, cpusupport_x86_pclmul() and _ssse3() return nonzero, and
+ * crypto_aes_can_use_intrinsics() returns 1.
+ */
+void crypto_aesgcm_pclmul_blocks(const struct crypto_aes_key *,
+    const uint8_t[64], uint8_t[16], uint8_t[16], const uint8_t *, uint8_t *,
+    size_t, int);
+
+#endif /* !_CRYPTO_AESGCM_PCLMUL_H_ */
@@ -0,0 +1,385 @@
+#include <assert.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "cpusupport.h"
+#include "crypto_chacha20_arm.h"
+#include "crypto_chacha20_avx2.h"
+#include "crypto_chacha20_sse2.h"
+#include "hwaccel.h"
+#include "insecure_memzero.h"
+#include "sysendian.h"
+#include "warnp.h"
+
+#include "crypto_chacha20.h"
+
+#if defined(CPUSUPPORT_X86_AVX2) || defined(CPUSUPPORT_X86_SSE2) ||	\
+    defined(CPUSUPPORT_ARM_NEON)
+#define HWACCEL
+
+static enum {
+	HW_SOFTWARE = 0,
+#if defined(CPUSUPPORT_X86_AVX2)
+	HW_X86_AVX2,
+#endif
+#if defined(CPUSUPPORT_X86_SSE2)
+	HW_X86_SSE2,
+#endif
+#if defined(CPUSUPPORT_ARM_NEON)
+	HW_ARM_NEON,
+#endif
+	HW_UNSET
+} hwaccel = HW_UNSET;
+#endif
+
+/* ChaCha20 state. */
+struct crypto_chacha20 {
+	uint32_t state[16];
+	uint8_t buf[64];	/* Current block of cipherstream. */
+	size_t bufpos;		/* Bytes of buf which have been used. */
+};
+
+/* The constant words "expand 32-byte k". */
+static const uint32_t sigma[4] = {
+	0x61707865, 0x3320646e, 0x79622d32, 0x6b206574
+};
+
+/* Rotate ${x} left by ${n} bits. */
+#define ROTL(x, n)	(((x) << (n)) | ((x) >> (32 - (n))))
+
+/* The ChaCha quarter-round, applied to words ${a}, ${b}, ${c}, and ${d}. */
+#define QR(a, b, c, d) do {						\
+	x[a] += x[b]; x[d] = ROTL(x[d] ^ x[a], 16);			\
+	x[c] += x[d]; x[b] = ROTL(x[b] ^ x[c], 12);			\
+	x[a] += x[b]; x[d] = ROTL(x[d] ^ x[a], 8);			\
+	x[c] += x[d]; x[b] = ROTL(x[b] ^ x[c], 7);			\
+} while (0)
+
+/* Software version of crypto_chacha20_*_blocks(); works for any ${nblocks}. */
+static void
+crypto_chacha20_soft_blocks(uint32_t state[16], const uint8_t * inbuf,
+    uint8_t * outbuf, size_t nblocks)
+{
+	uint32_t x[16];
+	int i;
+
+	for (; nblocks > 0; nblocks--) {
+		/* Apply the 20 rounds. */
+		memcpy(x, state, sizeof(x));
+		for (i = 0; i < 10; i++) {
+			QR(0, 4, 8, 12);
+			QR(1, 5, 9, 13);
+			QR(2, 6, 10, 14);
+			QR(3, 7, 11, 15);
+			QR(0, 5, 10, 15);
+			QR(1, 6, 11, 12);
+			QR(2, 7, 8, 13);
+			QR(3, 4, 9, 14);
+		}
+
+		/* Add the input words and XOR the result into place. */
+		for (i = 0; i < 16; i++)
+			le32enc(&outbuf[4 * i], le32dec(&inbuf[4 * i]) ^
+			    (x[i] + state[i]));
+
+		/* Move to the next block. */
+		state[12]++;
+		inbuf += 64;
+		outbuf += 64;
+	}
+
+	/* Clean up. */
+	insecure_memzero(x, sizeof(x));
+}
+
+#ifdef HWACCEL
+/*
+ * Test whether software and hardware extensions code produce the same
+ * results.  Must be called with (hwaccel == HW_SOFTWARE).
+ */
+static int
+hwtest(void (* func)(uint32_t[16], const uint8_t *, uint8_t *, size_t))
+{
+	uint32_t state_sw[16];
+	uint32_t state_hw[16];
+	uint8_t buf[1024];
+	uint8_t out_sw[1024];
+	uint8_t out_hw[1024];
+	size_t i;
+
+	/* Test case: Counter 0xfffffffa (so that it wraps), all else i. */
+	for (i = 0; i < 16; i++)
+		state_sw[i] = (uint32_t)i;
+	state_sw[12] = 0xfffffffa;
+	memcpy(state_hw, state_sw, sizeof(state_hw));
+	for (i = 0; i < 1024; i++)
+		buf[i] = (uint8_t)i;
+
+	/* Encrypt 16 blocks, and check that the results match. */
+	crypto_chacha20_soft_blocks(state_sw, buf, out_sw, 16);
+	func(state_hw, buf, out_hw, 16);
+	if (memcmp(out_sw, out_hw, 1024) || memcmp(state_sw, state_hw,
+	    sizeof(state_sw)))
+		goto err0;
+
+	/* Success! */
+	return (0);
+
+err0:
+	/* Failure! */
+	return (-1);
+}
+
+/* Time encryption using the implementation ${id}; defined below. */
+static void hwbench(int);
+
+/* Which type of hardware acceleration should we use, if any? */
+static void
+hwaccel_init(void)
+{
+	struct hwaccel_choice C;
+
+	/* If we've already set hwaccel, we're finished. */
+	if (hwaccel != HW_UNSET)
+		return;
+
+	/* Use software while we test the alternatives. */
+	hwaccel = HW_SOFTWARE;
+	hwaccel_begin(&C, "chacha20");
+
+#if defined(CPUSUPPORT_X86_AVX2)
+	HWACCEL_OFFER(&C, HW_X86_AVX2, "x86-avx2", cpusupport_x86_avx2(),
+	    hwtest(crypto_chacha20_avx2_blocks));
+#endif
+#if defined(CPUSUPPORT_X86_SSE2)
+	HWACCEL_OFFER(&C, HW_X86_SSE2, "x86-sse2", cpusupport_x86_sse2(),
+	    hwtest(crypto_chacha20_sse2_blocks));
+#endif
+#if defined(CPUSUPPORT_ARM_NEON)
+	HWACCEL_OFFER(&C, HW_ARM_NEON, "arm-neon", cpusupport_arm_neon(),
+	    hwtest(crypto_chacha20_arm_blocks));
+#endif
+	hwaccel_offer(&C, HW_SOFTWARE, "software");
+
+	/* Pick one. */
+	hwaccel = hwaccel_choose(&C, hwbench);
+}
+#endif /* HWACCEL */
+
+/* Encrypt or decrypt ${nblocks} whole blocks. */
+static void
+crypto_chacha20_blocks(uint32_t state[16], const uint8_t * inbuf,
+    uint8_t * outbuf, size_t nblocks)
+{
+	size_t n = 0;
+
+	/* Process as many blocks as possible using hardware acceleration. */
+#ifdef HWACCEL
+	switch (hwaccel) {
+#if defined(CPUSUPPORT_X86_AVX2)
+	case HW_X86_AVX2:
+		n = nblocks & ~(size_t)7;
+		crypto_chacha20_avx2_blocks(state, inbuf, outbuf, n);
+		break;
+#endif
+#if defined(CPUSUPPORT_X86_SSE2)
+	case HW_X86_SSE2:
+		n = nblocks & ~(size_t)3;
+		crypto_chacha20_sse2_blocks(state, inbuf, outbuf, n);
+		break;
+#endif
+#if defined(CPUSUPPORT_ARM_NEON)
+	case HW_ARM_NEON:
+		n = nblocks & ~(size_t)3;
+		crypto_chacha20_arm_blocks(state, inbuf, outbuf, n);
+		break;
+#endif
+	case HW_SOFTWARE:
+	case HW_UNSET:
+		break;
+	}
+#endif /* HWACCEL */
+
+	/* Process any remaining blocks in software. */
+	crypto_chacha20_soft_blocks(state, &inbuf[64 * n], &outbuf[64 * n],
+	    nblocks - n);
+}
+
+/**
+ * crypto_chacha20_alloc(void):
+ * Allocate an object for performing ChaCha20 encryption.  This must be
+ * followed by calling _init2().
+ */
+struct crypto_chacha20 *
+crypto_chacha20_alloc(void)
+{
+	struct crypto_chacha20 * stream;
+
+	/* Allocate memory. */
+	if ((stream = malloc(sizeof(struct crypto_chacha20))) == NULL)
+		goto err0;
+
+	/* Success! */
+	return (stream);
+
+err0:
+	/* Failure! */
+	return (NULL);
+}
+
+/**
+ * crypto_chacha20_init2(stream, key, nonce, counter):
+ * Reset the ChaCha20 stream ${stream}, using the ${key}, ${nonce}, and
+ * initial block ${counter}.  If ${key} is NULL, retain the previous key.
+ */
+void
+crypto_chacha20_init2(struct crypto_chacha20 * stream, const uint8_t key[32],
+    const uint8_t nonce[12], uint32_t counter)
+{
+	int i;
+
+#ifdef HWACCEL
+	hwaccel_init();
+#endif
+
+	/* Load the constants and key, if provided. */
+	if (key != NULL) {
+		for (i = 0; i < 4; i++)
+			stream->state[i] = sigma[i];
+		for (i = 0; i < 8; i++)
+			stream->state[4 + i] = le32dec(&key[4 * i]);
+	}
+
+	/* Load the counter and nonce. */
+	stream->state[12] = counter;
+	for (i = 0; i < 3; i++)
+		stream->state[13 + i] = le32dec(&nonce[4 * i]);
+
+	/* We have no cipherstream buffered. */
+	stream->bufpos = 64;
+}
+
+/**
+ * crypto_chacha20_init(key, nonce, counter):
+ * Prepare to encrypt/decrypt data with the ChaCha20 stream cipher (as
+ * specified in RFC 8439), using the 256-bit ${key}, 96-bit ${nonce}, and
+ * initial block ${counter}.  This is the same as calling _alloc() followed by
+ * _init2().
+ */
+struct crypto_chacha20 *
+crypto_chacha20_init(const uint8_t key[32], const uint8_t nonce[12],
+    uint32_t counter)
+{
+	struct crypto_chacha20 * stream;
+
+	/* Sanity check. */
+	assert(key != NULL);
+
+	/* Allocate memory. */
+	if ((stream = crypto_chacha20_alloc()) == NULL)
+		goto err0;
+
+	/* Initialize values. */
+	crypto_chacha20_init2(stream, key, nonce, counter);
+
+	/* Success! */
+	return (stream);
+
+err0:
+	/* Failure! */
+	return (NULL);
+}
+
+/**
+ * crypto_chacha20_stream(stream, inbuf, outbuf, buflen):
+ * Generate the next ${buflen} bytes of the ChaCha20 stream ${stream} and xor
+ * them with bytes from ${inbuf}, writing the result into ${outbuf}.  If the
+ * buffers ${inbuf} and ${outbuf} overlap, they must be identical.
+ */
+void
+crypto_chacha20_stream(struct crypto_chacha20 * stream, const uint8_t * inbuf,
+    uint8_t * outbuf, size_t buflen)
+{
+	size_t nblocks;
+
+	/* Use up any cipherstream left over from a previous call. */
+	for (; (stream->bufpos < 64) && (buflen > 0); buflen--)
+		*outbuf++ = *inbuf++ ^ stream->buf[stream->bufpos++];
+
+	/* Process whole blocks of 64 bytes. */
+	if (buflen >= 64) {
+		nblocks = buflen / 64;
+		crypto_chacha20_blocks(stream->state, inbuf, outbuf, nblocks);
+		inbuf += 64 * nblocks;
+		outbuf += 64 * nblocks;
+		buflen -= 64 * nblocks;
+	}
+
+	/* Process any final bytes; we need a new block of cipherstream. */
+	if (buflen > 0) {
+		memset(stream->buf, 0, 64);
+		crypto_chacha20_blocks(stream->state, stream->buf,
+		    stream->buf, 1);
+		for (stream->bufpos = 0; buflen > 0; buflen--)
+			*outbuf++ = *inbuf++ ^ stream->buf[stream->bufpos++];
+	}
+}
+
+/**
+ * crypto_chacha20_free(stream):
+ * Free the ChaCha20 stream ${stream}.
+ */
+void
+crypto_chacha20_free(struct crypto_chacha20 * stream)
+{
+
+	/* Behave consistently with free(NULL). */
+	if (stream == NULL)
+		return;
+
+	/* Zero potentially sensitive information. */
+	insecure_memzero(stream, sizeof(struct crypto_chacha20));
+
+	/* Free the stream. */
+	free(stream);
+}
+
+/**
+ * crypto_chacha20_buf(key, nonce, counter, inbuf, outbuf, buflen):
+ * Equivalent to _init(key, nonce, counter); _stream(inbuf, outbuf, buflen);
+ * _free().
+ */
+void
+crypto_chacha20_buf(const uint8_t key[32], const uint8_t nonce[12],
+    uint32_t counter, const uint8_t * inbuf, uint8_t * outbuf, size_t buflen)
+{
+	struct crypto_chacha20 stream_rec;
+	struct crypto_chacha20 * stream = &stream_rec;
+
+	/* Sanity check. */
+	assert(key != NULL);
+
+	/* Initialize values. */
+	crypto_chacha20_init2(stream, key, nonce, counter);
+
+	/* Perform the encryption. */
+	crypto_chacha20_stream(stream, inbuf, outbuf, buflen);
+
+	/* Zero potentially sensitive information. */
+	insecure_memzero(stream, sizeof(struct crypto_chacha20));
+}
+
+#ifdef HWACCEL
+/* Time encryption using the implementation ${id}. */
+static void
+hwbench(int id)
+{
+	static const uint8_t key[32];
+	static const uint8_t nonce[12];
+	static uint8_t buf[4096];
+
+	hwaccel = id;
+	crypto_chacha20_buf(key, nonce, 0, buf, buf, sizeof(buf));
+}
+#endif
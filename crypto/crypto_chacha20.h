@@ -0,0 +1,58 @@
+#ifndef _CRYPTO_CHACHA20_H_
+#define _CRYPTO_CHACHA20_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* Opaque type. */
+struct crypto_chacha20;
+
+/**
+ * crypto_chacha20_init(key, nonce, counter):
+ * Prepare to encrypt/decrypt data with the ChaCha20 stream cipher (as
+ * specified in RFC 8439), using the 256-bit ${key}, 96-bit ${nonce}, and
+ * initial block ${counter}.  This is the same as calling _alloc() followed by
+ * _init2().
+ */
+struct crypto_chacha20 * crypto_chacha20_init(const uint8_t[32],
+    const uint8_t[12], uint32_t);
+
+/**
+ * crypto_chacha20_alloc(void):
+ * Allocate an object for performing ChaCha20 encryption.  This must be
+ * followed by calling _init2().
+ */
+struct crypto_chacha20 * crypto_chacha20_alloc(void);
+
+/**
+ * crypto_chacha20_init2(stream, key, nonce, counter):
+ * Reset the ChaCha20 stream ${stream}, using the ${key}, ${nonce}, and
+ * initial block ${counter}.  If ${key} is NULL, retain the previous key.
+ */
+void crypto_chacha20_init2(struct crypto_chacha20 *, const uint8_t[32],
+    const uint8_t[12], uint32_t);
+
+/**
+ * crypto_chacha20_stream(stream, inbuf, outbuf, buflen):
+ * Generate the next ${buflen} bytes of the ChaCha20 stream ${stream} and xor
+ * them with bytes from ${inbuf}, writing the result into ${outbuf}.  If the
+ * buffers ${inbuf} and ${outbuf} overlap, they must be identical.
+ */
+void crypto_chacha20_stream(struct crypto_chacha20 *, const uint8_t *,
+    uint8_t *, size_t);
+
+/**
+ * crypto_chacha20_free(stream):
+ * Free the ChaCha20 stream ${stream}.
+ */
+void crypto_chacha20_free(struct crypto_chacha20 *);
+
+/**
+ * crypto_chacha20_buf(key, nonce, counter, inbuf, outbuf, buflen):
+ * Equivalent to _init(key, nonce, counter); _stream(inbuf, outbuf, buflen);
+ * _free().
+ */
+void crypto_chacha20_buf(const uint8_t[32], const uint8_t[12], uint32_t,
+    const uint8_t *, uint8_t *, size_t);
+
+#endif /* !_CRYPTO_CHACHA20_H_ */
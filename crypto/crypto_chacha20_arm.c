@@ -0,0 +1,117 @@
+#include "cpusupport.h"
+#ifdef CPUSUPPORT_ARM_NEON
+/**
+ * CPUSUPPORT CFLAGS: ARM_NEON
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __ARM_NEON
+#include <arm_neon.h>
+#endif
+
+#include "crypto_chacha20_arm.h"
+
+/**
+ * As in crypto_chacha20_sse2.c, we compute four blocks at once, holding word
+ * i of all four blocks in vector x[i].
+ */
+
+/* Rotate each 32-bit lane of ${x} left by ${n} bits. */
+#define ROTL(x, n)	vsriq_n_u32(vshlq_n_u32((x), (n)), (x), 32 - (n))
+
+/* Rotate each 32-bit lane of ${x} by 16 bits. */
+#define ROTL16(x)							\
+	vreinterpretq_u32_u16(vrev32q_u16(vreinterpretq_u16_u32(x)))
+
+/* The ChaCha quarter-round, applied to words ${a}, ${b}, ${c}, and ${d}. */
+#define QR(a, b, c, d) do {						\
+	x[a] = vaddq_u32(x[a], x[b]);					\
+	x[d] = ROTL16(veorq_u32(x[d], x[a]));				\
+	x[c] = vaddq_u32(x[c], x[d]);					\
+	x[b] = ROTL(veorq_u32(x[b], x[c]), 12);				\
+	x[a] = vaddq_u32(x[a], x[b]);					\
+	x[d] = ROTL(veorq_u32(x[d], x[a]), 8);				\
+	x[c] = vaddq_u32(x[c], x[d]);					\
+	x[b] = ROTL(veorq_u32(x[b], x[c]), 7);				\
+} while (0)
+
+/* XOR the 16 bytes at ${in} with ${k}, and write them to ${out}. */
+static inline void
+xor_store(const uint8_t * in, uint8_t * out, uint32x4_t k)
+{
+
+	vst1q_u8(out, veorq_u8(vld1q_u8(in), vreinterpretq_u8_u32(k)));
+}
+
+/**
+ * crypto_chacha20_arm_blocks(state, inbuf, outbuf, nblocks):
+ * Encrypt or decrypt ${nblocks} 64-byte blocks from ${inbuf} into ${outbuf}
+ * using the ChaCha20 state ${state}, and advance the block counter in ${state}
+ * by ${nblocks}; ${nblocks} must be a multiple of 4.  If the buffers ${inbuf}
+ * and ${outbuf} overlap, they must be identical.  This implementation uses ARM
+ * NEON instructions, and should only be used if CPUSUPPORT_ARM_NEON is defined
+ * and cpusupport_arm_neon() returns nonzero.
+ */
+void
+crypto_chacha20_arm_blocks(uint32_t state[16], const uint8_t * inbuf,
+    uint8_t * outbuf, size_t nblocks)
+{
+	const uint32_t ctr_offsets[4] = {0, 1, 2, 3};
+	uint32x4_t s[16];
+	uint32x4_t x[16];
+	uint32x4x2_t t0, t1;
+	int i;
+
+	/* Broadcast each word of the state. */
+	for (i = 0; i < 16; i++)
+		s[i] = vdupq_n_u32(state[i]);
+
+	/* The four blocks use consecutive counter values. */
+	s[12] = vaddq_u32(s[12], vld1q_u32(ctr_offsets));
+
+	for (; nblocks >= 4; nblocks -= 4) {
+		/* Apply the 20 rounds. */
+		for (i = 0; i < 16; i++)
+			x[i] = s[i];
+		for (i = 0; i < 10; i++) {
+			QR(0, 4, 8, 12);
+			QR(1, 5, 9, 13);
+			QR(2, 6, 10, 14);
+			QR(3, 7, 11, 15);
+			QR(0, 5, 10, 15);
+			QR(1, 6, 11, 12);
+			QR(2, 7, 8, 13);
+			QR(3, 4, 9, 14);
+		}
+		for (i = 0; i < 16; i++)
+			x[i] = vaddq_u32(x[i], s[i]);
+
+		/* Transpose each group of four words and XOR into place. */
+		for (i = 0; i < 16; i += 4) {
+			t0 = vtrnq_u32(x[i], x[i + 1]);
+			t1 = vtrnq_u32(x[i + 2], x[i + 3]);
+			xor_store(&inbuf[4 * i], &outbuf[4 * i],
+			    vcombine_u32(vget_low_u32(t0.val[0]),
+			    vget_low_u32(t1.val[0])));
+			xor_store(&inbuf[64 + 4 * i], &outbuf[64 + 4 * i],
+			    vcombine_u32(vget_low_u32(t0.val[1]),
+			    vget_low_u32(t1.val[1])));
+			xor_store(&inbuf[128 + 4 * i], &outbuf[128 + 4 * i],
+			    vcombine_u32(vget_high_u32(t0.val[0]),
+			    vget_high_u32(t1.val[0])));
+			xor_store(&inbuf[192 + 4 * i], &outbuf[192 + 4 * i],
+			    vcombine_u32(vget_high_u32(t0.val[1]),
+			    vget_high_u32(t1.val[1])));
+		}
+
+		/* Advance to the next four blocks. */
+		s[12] = vaddq_u32(s[12], vdupq_n_u32(4));
+		state[12] += 4;
+		inbuf += 256;
+		outbuf += 256;
+	}
+}
+
+#endif /* CPUSUPPORT_ARM_NEON */
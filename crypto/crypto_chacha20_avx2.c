@@ -0,0 +1,130 @@
+#include "cpusupport.h"
+#ifdef CPUSUPPORT_X86_AVX2
+/**
+ * CPUSUPPORT CFLAGS: X86_AVX2
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <immintrin.h>
+
+#include "crypto_chacha20_avx2.h"
+
+/**
+ * As in crypto_chacha20_sse2.c, we hold word i of several blocks in vector
+ * x[i]; here we compute eight blocks at once, with blocks 0-3 in the low
+ * 128-bit lanes and blocks 4-7 in the high lanes.  The 16- and 8-bit
+ * rotations are performed with byte shuffles.
+ */
+
+/* Rotate each 32-bit lane of ${x} left by ${n} bits. */
+#define ROTL(x, n)							\
+	_mm256_or_si256(_mm256_slli_epi32((x), (n)),			\
+	    _mm256_srli_epi32((x), 32 - (n)))
+
+/* The ChaCha quarter-round, applied to words ${a}, ${b}, ${c}, and ${d}. */
+#define QR(a, b, c, d) do {						\
+	x[a] = _mm256_add_epi32(x[a], x[b]);				\
+	x[d] = _mm256_shuffle_epi8(_mm256_xor_si256(x[d], x[a]), rot16);\
+	x[c] = _mm256_add_epi32(x[c], x[d]);				\
+	x[b] = ROTL(_mm256_xor_si256(x[b], x[c]), 12);			\
+	x[a] = _mm256_add_epi32(x[a], x[b]);				\
+	x[d] = _mm256_shuffle_epi8(_mm256_xor_si256(x[d], x[a]), rot8);	\
+	x[c] = _mm256_add_epi32(x[c], x[d]);				\
+	x[b] = ROTL(_mm256_xor_si256(x[b], x[c]), 7);			\
+} while (0)
+
+/* XOR the 16 bytes at ${in} with ${k}, and write them to ${out}. */
+static inline void
+xor_store(const uint8_t * in, uint8_t * out, __m128i k)
+{
+	__m128i t;
+
+	t = _mm_loadu_si128((const __m128i *)in);
+	_mm_storeu_si128((__m128i *)out, _mm_xor_si128(t, k));
+}
+
+/**
+ * crypto_chacha20_avx2_blocks(state, inbuf, outbuf, nblocks):
+ * Encrypt or decrypt ${nblocks} 64-byte blocks from ${inbuf} into ${outbuf}
+ * using the ChaCha20 state ${state}, and advance the block counter in ${state}
+ * by ${nblocks}; ${nblocks} must be a multiple of 8.  If the buffers ${inbuf}
+ * and ${outbuf} overlap, they must be identical.  This implementation uses x86
+ * AVX2 instructions, and should only be used if CPUSUPPORT_X86_AVX2 is defined
+ * and cpusupport_x86_avx2() returns nonzero.
+ */
+void
+crypto_chacha20_avx2_blocks(uint32_t state[16], const uint8_t * inbuf,
+    uint8_t * outbuf, size_t nblocks)
+{
+	const __m256i rot16 = _mm256_set_epi8(
+	    13, 12, 15, 14, 9, 8, 11, 10, 5, 4, 7, 6, 1, 0, 3, 2,
+	    13, 12, 15, 14, 9, 8, 11, 10, 5, 4, 7, 6, 1, 0, 3, 2);
+	const __m256i rot8 = _mm256_set_epi8(
+	    14, 13, 12, 15, 10, 9, 8, 11, 6, 5, 4, 7, 2, 1, 0, 3,
+	    14, 13, 12, 15, 10, 9, 8, 11, 6, 5, 4, 7, 2, 1, 0, 3);
+	__m256i s[16];
+	__m256i x[16];
+	__m256i t0, t1, t2, t3;
+	__m256i b[4];
+	int i, j;
+
+	/* Broadcast each word of the state. */
+	for (i = 0; i < 16; i++)
+		s[i] = _mm256_set1_epi32((int)state[i]);
+
+	/* The eight blocks use consecutive counter values. */
+	s[12] = _mm256_add_epi32(s[12], _mm256_set_epi32(7, 6, 5, 4,
+	    3, 2, 1, 0));
+
+	for (; nblocks >= 8; nblocks -= 8) {
+		/* Apply the 20 rounds. */
+		for (i = 0; i < 16; i++)
+			x[i] = s[i];
+		for (i = 0; i < 10; i++) {
+			QR(0, 4, 8, 12);
+			QR(1, 5, 9, 13);
+			QR(2, 6, 10, 14);
+			QR(3, 7, 11, 15);
+			QR(0, 5, 10, 15);
+			QR(1, 6, 11, 12);
+			QR(2, 7, 8, 13);
+			QR(3, 4, 9, 14);
+		}
+		for (i = 0; i < 16; i++)
+			x[i] = _mm256_add_epi32(x[i], s[i]);
+
+		/*
+		 * Transpose each group of four words; this operates within
+		 * 128-bit lanes, so b[j] then holds words i .. i + 3 of block
+		 * j in its low lane and of block j + 4 in its high lane.
+		 */
+		for (i = 0; i < 16; i += 4) {
+			t0 = _mm256_unpacklo_epi32(x[i], x[i + 1]);
+			t1 = _mm256_unpacklo_epi32(x[i + 2], x[i + 3]);
+			t2 = _mm256_unpackhi_epi32(x[i], x[i + 1]);
+			t3 = _mm256_unpackhi_epi32(x[i + 2], x[i + 3]);
+			b[0] = _mm256_unpacklo_epi64(t0, t1);
+			b[1] = _mm256_unpackhi_epi64(t0, t1);
+			b[2] = _mm256_unpacklo_epi64(t2, t3);
+			b[3] = _mm256_unpackhi_epi64(t2, t3);
+			for (j = 0; j < 4; j++) {
+				xor_store(&inbuf[64 * j + 4 * i],
+				    &outbuf[64 * j + 4 * i],
+				    _mm256_castsi256_si128(b[j]));
+				xor_store(&inbuf[64 * (j + 4) + 4 * i],
+				    &outbuf[64 * (j + 4) + 4 * i],
+				    _mm256_extracti128_si256(b[j], 1));
+			}
+		}
+
+		/* Advance to the next eight blocks. */
+		s[12] = _mm256_add_epi32(s[12], _mm256_set1_epi32(8));
+		state[12] += 8;
+		inbuf += 512;
+		outbuf += 512;
+	}
+}
+
+#endif /* CPUSUPPORT_X86_AVX2 */
@@ -0,0 +1,19 @@
+#ifndef _CRYPTO_CHACHA20_AVX2_H_
+#define _CRYPTO_CHACHA20_AVX2_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * crypto_chacha20_avx2_blocks(state, inbuf, outbuf, nblocks):
+ * Encrypt or decrypt ${nblocks} 64-byte blocks from ${inbuf} into ${outbuf}
+ * using the ChaCha20 state ${state}, and advance the block counter in ${state}
+ * by ${nblocks}; ${nblocks} must be a multiple of 8.  If the buffers ${inbuf}
+ * and ${outbuf} overlap, they must be identical.  This implementation uses x86
+ * AVX2 instructions, and should only be used if CPUSUPPORT_X86_AVX2 is defined
+ * and cpusupport_x86_avx2() returns nonzero.
+ */
+void crypto_chacha20_avx2_blocks(uint32_t[16], const uint8_t *, uint8_t *,
+    size_t);
+
+#endif /* !_CRYPTO_CHACHA20_AVX2_H_ */
@@ -0,0 +1,112 @@
+#include "cpusupport.h"
+#ifdef CPUSUPPORT_X86_SSE2
+/**
+ * CPUSUPPORT CFLAGS: X86_SSE2
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <emmintrin.h>
+
+#include "crypto_chacha20_sse2.h"
+
+/**
+ * We compute four blocks at once, holding word i of all four blocks in
+ * vector x[i]; the quarter-rounds then operate on whole vectors without any
+ * shuffling, and the words are transposed back into blocks at the end.
+ */
+
+/* Rotate each 32-bit lane of ${x} left by ${n} bits. */
+#define ROTL(x, n)							\
+	_mm_or_si128(_mm_slli_epi32((x), (n)), _mm_srli_epi32((x), 32 - (n)))
+
+/* The ChaCha quarter-round, applied to words ${a}, ${b}, ${c}, and ${d}. */
+#define QR(a, b, c, d) do {						\
+	x[a] = _mm_add_epi32(x[a], x[b]);				\
+	x[d] = ROTL(_mm_xor_si128(x[d], x[a]), 16);			\
+	x[c] = _mm_add_epi32(x[c], x[d]);				\
+	x[b] = ROTL(_mm_xor_si128(x[b], x[c]), 12);			\
+	x[a] = _mm_add_epi32(x[a], x[b]);				\
+	x[d] = ROTL(_mm_xor_si128(x[d], x[a]), 8);			\
+	x[c] = _mm_add_epi32(x[c], x[d]);				\
+	x[b] = ROTL(_mm_xor_si128(x[b], x[c]), 7);			\
+} while (0)
+
+/* XOR the 16 bytes at ${in} with ${k}, and write them to ${out}. */
+static inline void
+xor_store(const uint8_t * in, uint8_t * out, __m128i k)
+{
+	__m128i t;
+
+	t = _mm_loadu_si128((const __m128i *)in);
+	_mm_storeu_si128((__m128i *)out, _mm_xor_si128(t, k));
+}
+
+/**
+ * crypto_chacha20_sse2_blocks(state, inbuf, outbuf, nblocks):
+ * Encrypt or decrypt ${nblocks} 64-byte blocks from ${inbuf} into ${outbuf}
+ * using the ChaCha20 state ${state}, and advance the block counter in ${state}
+ * by ${nblocks}; ${nblocks} must be a multiple of 4.  If the buffers ${inbuf}
+ * and ${outbuf} overlap, they must be identical.  This implementation uses x86
+ * SSE2 instructions, and should only be used if CPUSUPPORT_X86_SSE2 is defined
+ * and cpusupport_x86_sse2() returns nonzero.
+ */
+void
+crypto_chacha20_sse2_blocks(uint32_t state[16], const uint8_t * inbuf,
+    uint8_t * outbuf, size_t nblocks)
+{
+	__m128i s[16];
+	__m128i x[16];
+	__m128i t0, t1, t2, t3;
+	int i;
+
+	/* Broadcast each word of the state. */
+	for (i = 0; i < 16; i++)
+		s[i] = _mm_set1_epi32((int)state[i]);
+
+	/* The four blocks use consecutive counter values. */
+	s[12] = _mm_add_epi32(s[12], _mm_set_epi32(3, 2, 1, 0));
+
+	for (; nblocks >= 4; nblocks -= 4) {
+		/* Apply the 20 rounds. */
+		for (i = 0; i < 16; i++)
+			x[i] = s[i];
+		for (i = 0; i < 10; i++) {
+			QR(0, 4, 8, 12);
+			QR(1, 5, 9, 13);
+			QR(2, 6, 10, 14);
+			QR(3, 7, 11, 15);
+			QR(0, 5, 10, 15);
+			QR(1, 6, 11, 12);
+			QR(2, 7, 8, 13);
+			QR(3, 4, 9, 14);
+		}
+		for (i = 0; i < 16; i++)
+			x[i] = _mm_add_epi32(x[i], s[i]);
+
+		/* Transpose each group of four words and XOR into place. */
+		for (i = 0; i < 16; i += 4) {
+			t0 = _mm_unpacklo_epi32(x[i], x[i + 1]);
+			t1 = _mm_unpacklo_epi32(x[i + 2], x[i + 3]);
+			t2 = _mm_unpackhi_epi32(x[i], x[i + 1]);
+			t3 = _mm_unpackhi_epi32(x[i + 2], x[i + 3]);
+			xor_store(&inbuf[4 * i], &outbuf[4 * i],
+			    _mm_unpacklo_epi64(t0, t1));
+			xor_store(&inbuf[64 + 4 * i], &outbuf[64 + 4 * i],
+			    _mm_unpackhi_epi64(t0, t1));
+			xor_store(&inbuf[128 + 4 * i], &outbuf[128 + 4 * i],
+			    _mm_unpacklo_epi64(t2, t3));
+			xor_store(&inbuf[192 + 4 * i], &outbuf[192 + 4 * i],
+			    _mm_unpackhi_epi64(t2, t3));
+		}
+
+		/* Advance to the next four blocks. */
+		s[12] = _mm_add_epi32(s[12], _mm_set1_epi32(4));
+		state[12] += 4;
+		inbuf += 256;
+		outbuf += 256;
+	}
+}
+
+#endif /* CPUSUPPORT_X86_SSE2 */
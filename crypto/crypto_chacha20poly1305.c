@@ -0,0 +1,149 @@
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "crypto_chacha20.h"
+#include "crypto_poly1305.h"
+#include "crypto_verify_bytes.h"
+#include "insecure_memzero.h"
+#include "sysendian.h"
+#include "warnp.h"
+
+#include "crypto_chacha20poly1305.h"
+
+/*
+ * When encrypting, data is processed in chunks which are small enough to
+ * remain in the L1 cache between being encrypted and being authenticated.
+ * This must be a multiple of the 64-byte ChaCha20 block size.
+ */
+#define CHUNKLEN 4096
+
+/* Don't let the block counter wrap around. */
+static void
+checklen(size_t buflen)
+{
+
+	if (buflen > CRYPTO_CHACHA20POLY1305_MAXLEN) {
+		warn0("Too much data for one ChaCha20-Poly1305 message");
+		abort();
+	}
+}
+
+/* Derive the one-time Poly1305 key and absorb the additional data. */
+static void
+poly_start(struct crypto_poly1305_ctx * ctx, const uint8_t key[32],
+    const uint8_t nonce[12], const uint8_t * aad, size_t aadlen)
+{
+	static const uint8_t zeros[16] = {0};
+	uint8_t polykey[32] = {0};
+
+	/* The Poly1305 key is the first 32 bytes of block 0. */
+	crypto_chacha20_buf(key, nonce, 0, polykey, polykey, 32);
+	crypto_poly1305_init(ctx, polykey);
+	insecure_memzero(polykey, 32);
+
+	/* Absorb the additional data, padded to a multiple of 16 bytes. */
+	crypto_poly1305_update(ctx, aad, aadlen);
+	if (aadlen % 16)
+		crypto_poly1305_update(ctx, zeros, 16 - aadlen % 16);
+}
+
+/* Pad the ciphertext, absorb the lengths, and compute the tag. */
+static void
+poly_finish(struct crypto_poly1305_ctx * ctx, size_t aadlen, size_t buflen,
+    uint8_t tag[16])
+{
+	static const uint8_t zeros[16] = {0};
+	uint8_t lens[16];
+
+	/* Pad the ciphertext to a multiple of 16 bytes. */
+	if (buflen % 16)
+		crypto_poly1305_update(ctx, zeros, 16 - buflen % 16);
+
+	/* Absorb the lengths of the additional data and ciphertext. */
+	le64enc(&lens[0], (uint64_t)aadlen);
+	le64enc(&lens[8], (uint64_t)buflen);
+	crypto_poly1305_update(ctx, lens, 16);
+
+	/* Compute the tag. */
+	crypto_poly1305_final(ctx, tag);
+}
+
+/**
+ * crypto_chacha20poly1305_encrypt_buf(key, nonce, aad, aadlen, inbuf, outbuf,
+ *     buflen, tag):
+ * Encrypt ${buflen} bytes from ${inbuf} into ${outbuf} with the
+ * ChaCha20-Poly1305 AEAD construction of RFC 8439, using the 256-bit ${key}
+ * and 96-bit ${nonce}, and write the 16-byte authentication tag covering the
+ * ciphertext and the ${aadlen} bytes of additional data ${aad} into ${tag}.
+ * If the buffers ${inbuf} and ${outbuf} overlap, they must be identical.
+ * Attempting to encrypt more than CRYPTO_CHACHA20POLY1305_MAXLEN bytes is a
+ * fatal error.
+ */
+void
+crypto_chacha20poly1305_encrypt_buf(const uint8_t key[32],
+    const uint8_t nonce[12], const uint8_t * aad, size_t aadlen,
+    const uint8_t * inbuf, uint8_t * outbuf, size_t buflen, uint8_t tag[16])
+{
+	struct crypto_poly1305_ctx ctx;
+	size_t pos;
+	size_t len;
+
+	/* Sanity check. */
+	checklen(buflen);
+
+	/* Start the authenticator. */
+	poly_start(&ctx, key, nonce, aad, aadlen);
+
+	/* Encrypt, starting from block 1, and authenticate the ciphertext. */
+	for (pos = 0; pos < buflen; pos += len) {
+		len = (buflen - pos > CHUNKLEN) ? CHUNKLEN : buflen - pos;
+		crypto_chacha20_buf(key, nonce, (uint32_t)(1 + pos / 64),
+		    &inbuf[pos], &outbuf[pos], len);
+		crypto_poly1305_update(&ctx, &outbuf[pos], len);
+	}
+
+	/* Finish the authenticator. */
+	poly_finish(&ctx, aadlen, buflen, tag);
+}
+
+/**
+ * crypto_chacha20poly1305_decrypt_buf(key, nonce, aad, aadlen, inbuf, outbuf,
+ *     buflen, tag):
+ * Verify the authentication ${tag} of ${buflen} bytes of ciphertext from
+ * ${inbuf} and the ${aadlen} bytes of additional data ${aad}, and if it is
+ * valid, decrypt the ciphertext into ${outbuf}.  Return 0 on success, or -1
+ * (without writing to ${outbuf}) if the tag does not match.  If the buffers
+ * ${inbuf} and ${outbuf} overlap, they must be identical.  Attempting to
+ * decrypt more than CRYPTO_CHACHA20POLY1305_MAXLEN bytes is a fatal error.
+ */
+int
+crypto_chacha20poly1305_decrypt_buf(const uint8_t key[32],
+    const uint8_t nonce[12], const uint8_t * aad, size_t aadlen,
+    const uint8_t * inbuf, uint8_t * outbuf, size_t buflen,
+    const uint8_t tag[16])
+{
+	struct crypto_poly1305_ctx ctx;
+	uint8_t tag_actual[16];
+
+	/* Sanity check. */
+	checklen(buflen);
+
+	/* Authenticate the additional data and ciphertext. */
+	poly_start(&ctx, key, nonce, aad, aadlen);
+	crypto_poly1305_update(&ctx, inbuf, buflen);
+	poly_finish(&ctx, aadlen, buflen, tag_actual);
+
+	/* Don't decrypt anything which isn't authentic. */
+	if (crypto_verify_bytes(tag_actual, tag, 16))
+		goto err0;
+
+	/* Decrypt, starting from block 1. */
+	crypto_chacha20_buf(key, nonce, 1, inbuf, outbuf, buflen);
+
+	/* Success! */
+	return (0);
+
+err0:
+	/* Failure! */
+	return (-1);
+}
@@ -0,0 +1,42 @@
+#ifndef _CRYPTO_CHACHA20POLY1305_H_
+#define _CRYPTO_CHACHA20POLY1305_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * Maximum number of bytes which can be encrypted or decrypted with one nonce:
+ * after 2^32 - 1 blocks, the 32-bit block counter would wrap around to the
+ * block used for the Poly1305 key.
+ */
+#define CRYPTO_CHACHA20POLY1305_MAXLEN 274877906880ULL
+
+/**
+ * crypto_chacha20poly1305_encrypt_buf(key, nonce, aad, aadlen, inbuf, outbuf,
+ *     buflen, tag):
+ * Encrypt ${buflen} bytes from ${inbuf} into ${outbuf} with the
+ * ChaCha20-Poly1305 AEAD construction of RFC 8439, using the 256-bit ${key}
+ * and 96-bit ${nonce}, and write the 16-byte authentication tag covering the
+ * ciphertext and the ${aadlen} bytes of additional data ${aad} into ${tag}.
+ * If the buffers ${inbuf} and ${outbuf} overlap, they must be identical.
+ * Attempting to encrypt more than CRYPTO_CHACHA20POLY1305_MAXLEN bytes is a
+ * fatal error.
+ */
+void crypto_chacha20poly1305_encrypt_buf(const uint8_t[32], const uint8_t[12],
+    const uint8_t *, size_t, const uint8_t *, uint8_t *, size_t, uint8_t[16]);
+
+/**
+ * crypto_chacha20poly1305_decrypt_buf(key, nonce, aad, aadlen, inbuf, outbuf,
+ *     buflen, tag):
+ * Verify the authentication ${tag} of ${buflen} bytes of ciphertext from
+ * ${inbuf} and the ${aadlen} bytes of additional data ${aad}, and if it is
+ * valid, decrypt the ciphertext into ${outbuf}.  Return 0 on success, or -1
+ * (without writing to ${outbuf}) if the tag does not match.  If the buffers
+ * ${inbuf} and ${outbuf} overlap, they must be identical.  Attempting to
+ * decrypt more than CRYPTO_CHACHA20POLY1305_MAXLEN bytes is a fatal error.
+ */
+int crypto_chacha20poly1305_decrypt_buf(const uint8_t[32], const uint8_t[12],
+    const uint8_t *, size_t, const uint8_t *, uint8_t *, size_t,
+    const uint8_t[16]);
+
+#endif /* !_CRYPTO_CHACHA20POLY1305_H_ */
@@ -1,18 +1,55 @@
 #include <stdint.h>
+#include <stdlib.h>
 #include <string.h>
 
 #include <openssl/bn.h>
 #include <openssl/err.h>
 
-#include "warnp.h"
-
+#include "cpusupport.h"
+#include "crypto_chacha20.h"
+#include "crypto_dh_adx.h"
 #include "crypto_dh_group14.h"
+#include "crypto_dh_group14_comb.h"
 #include "crypto_entropy.h"
+#include "insecure_memzero.h"
+#include "sysendian.h"
+#include "warnp.h"
 
 #include "crypto_dh.h"
 
-static int blinded_modexp(uint8_t r[CRYPTO_DH_PUBLEN], BIGNUM * a,
-    const uint8_t priv[CRYPTO_DH_PRIVLEN]);
+#if defined(CPUSUPPORT_X86_ADX)
+#define HWACCEL
+
+static enum {
+	HW_SOFTWARE = 0,
+	HW_X86_ADX,
+	HW_UNSET
+} hwaccel = HW_UNSET;
+#endif
+
+/* Number of 64-bit limbs in a value modulo p. */
+#define NLIMBS 32
+
+/* Window size for variable-base exponentiation. */
+#define WBITS 5
+
+/* Diffie-Hellman context. */
+struct crypto_dh_ctx {
+	/* Scratch space for the native implementation. */
+	uint64_t table[1 << WBITS][NLIMBS];
+	uint64_t acc[NLIMBS];
+	uint64_t t[NLIMBS];
+
+	/* Values used by the OpenSSL implementation. */
+	BN_CTX * bnctx;
+	BIGNUM * m_bn;
+	BIGNUM * two_exp_256_bn;
+	BIGNUM * two;
+
+	/* Blinding exponents are the ChaCha20 stream of this key. */
+	uint8_t blind_key[32];
+	uint64_t blind_count;
+};
 
 /* Big-endian representation of 2^256. */
 static uint8_t two_exp_256[] = {
@@ -28,112 +65,99 @@ static uint8_t two_exp_256[] = {
 };
 
 /**
- * blinded_modexp(r, a, priv):
+ * blinded_modexp(ctx, r, a, priv):
  * Compute ${r} = ${a}^(2^258 + ${priv}), where ${r} and ${priv} are treated
  * as big-endian integers; and avoid leaking timing data in this process.
  */
 static int
-blinded_modexp(uint8_t r[CRYPTO_DH_PUBLEN], BIGNUM * a,
-    const uint8_t priv[CRYPTO_DH_PRIVLEN])
+blinded_modexp(struct crypto_dh_ctx * ctx, uint8_t r[CRYPTO_DH_PUBLEN],
+    BIGNUM * a, const uint8_t priv[CRYPTO_DH_PRIVLEN])
 {
-	BIGNUM * two_exp_256_bn;
 	BIGNUM * priv_bn;
 	uint8_t blinding[CRYPTO_DH_PRIVLEN];
+	uint8_t nonce[12];
 	BIGNUM * blinding_bn;
 	BIGNUM * priv_blinded;
-	BIGNUM * m_bn;
-	BN_CTX * ctx;
 	BIGNUM * r1;
 	BIGNUM * r2;
 	int rlen;
 
-	/* Construct 2^256 in BN representation. */
-	if ((two_exp_256_bn = BN_bin2bn(two_exp_256, 33, NULL)) == NULL) {
-		warn0("%s", ERR_error_string(ERR_get_error(), NULL));
-		goto err0;
-	}
-
 	/* Construct 2^258 + ${priv} in BN representation. */
 	if ((priv_bn = BN_bin2bn(priv, CRYPTO_DH_PRIVLEN, NULL)) == NULL) {
 		warn0("%s", ERR_error_string(ERR_get_error(), NULL));
-		goto err1;
+		goto err0;
 	}
-	if ((!BN_add(priv_bn, priv_bn, two_exp_256_bn)) ||
-	    (!BN_add(priv_bn, priv_bn, two_exp_256_bn)) ||
-	    (!BN_add(priv_bn, priv_bn, two_exp_256_bn)) ||
-	    (!BN_add(priv_bn, priv_bn, two_exp_256_bn))) {
+	if ((!BN_add(priv_bn, priv_bn, ctx->two_exp_256_bn)) ||
+	    (!BN_add(priv_bn, priv_bn, ctx->two_exp_256_bn)) ||
+	    (!BN_add(priv_bn, priv_bn, ctx->two_exp_256_bn)) ||
+	    (!BN_add(priv_bn, priv_bn, ctx->two_exp_256_bn))) {
 		warn0("%s", ERR_error_string(ERR_get_error(), NULL));
-		goto err2;
+		goto err1;
 	}
 
-	/* Generate blinding exponent. */
-	if (crypto_entropy_read(blinding, CRYPTO_DH_PRIVLEN))
-		goto err2;
-	if ((blinding_bn = BN_bin2bn(blinding,
-	    CRYPTO_DH_PRIVLEN, NULL)) == NULL) {
+	/*
+	 * Generate blinding exponent.  Each operation uses a new nonce, so
+	 * this never repeats and never needs to consult the entropy source.
+	 */
+	memset(nonce, 0, 12);
+	le64enc(nonce, ctx->blind_count++);
+	memset(blinding, 0, CRYPTO_DH_PRIVLEN);
+	crypto_chacha20_buf(ctx->blind_key, nonce, 0, blinding, blinding,
+	    CRYPTO_DH_PRIVLEN);
+	blinding_bn = BN_bin2bn(blinding, CRYPTO_DH_PRIVLEN, NULL);
+	insecure_memzero(blinding, CRYPTO_DH_PRIVLEN);
+	if (blinding_bn == NULL) {
 		warn0("%s", ERR_error_string(ERR_get_error(), NULL));
-		goto err2;
+		goto err1;
 	}
-	if (!BN_add(blinding_bn, blinding_bn, two_exp_256_bn)) {
+	if (!BN_add(blinding_bn, blinding_bn, ctx->two_exp_256_bn)) {
 		warn0("%s", ERR_error_string(ERR_get_error(), NULL));
-		goto err3;
+		goto err2;
 	}
 
 	/* Generate blinded exponent. */
 	if ((priv_blinded = BN_new()) == NULL) {
 		warn0("%s", ERR_error_string(ERR_get_error(), NULL));
-		goto err3;
+		goto err2;
 	}
 	if (!BN_sub(priv_blinded, priv_bn, blinding_bn)) {
 		warn0("%s", ERR_error_string(ERR_get_error(), NULL));
-		goto err4;
-	}
-
-	/* Construct group #14 modulus in BN representation. */
-	if ((m_bn = BN_bin2bn(crypto_dh_group14, 256, NULL)) == NULL) {
-		warn0("%s", ERR_error_string(ERR_get_error(), NULL));
-		goto err4;
-	}
-
-	/* Allocate BN context. */
-	if ((ctx = BN_CTX_new()) == NULL) {
-		warn0("%s", ERR_error_string(ERR_get_error(), NULL));
-		goto err5;
+		goto err3;
 	}
 
 	/* Allocate space for storing results of exponentiations. */
 	if ((r1 = BN_new()) == NULL) {
 		warn0("%s", ERR_error_string(ERR_get_error(), NULL));
-		goto err6;
+		goto err3;
 	}
 	if ((r2 = BN_new()) == NULL) {
 		warn0("%s", ERR_error_string(ERR_get_error(), NULL));
-		goto err7;
+		goto err4;
 	}
 
 	/* Perform modular exponentiations. */
-	if (!BN_mod_exp(r1, a, blinding_bn, m_bn, ctx)) {
+	if (!BN_mod_exp(r1, a, blinding_bn, ctx->m_bn, ctx->bnctx)) {
 		warn0("%s", ERR_error_string(ERR_get_error(), NULL));
-		goto err8;
+		goto err5;
 	}
-	if (!BN_mod_exp(r2, a, priv_blinded, m_bn, ctx)) {
+	if (!BN_mod_exp(r2, a, priv_blinded, ctx->m_bn, ctx->bnctx)) {
 		warn0("%s", ERR_error_string(ERR_get_error(), NULL));
-		goto err8;
+		goto err5;
 	}
 
 	/* Compute final result and export to big-endian integer format. */
-	if (!BN_mod_mul(r1, r1, r2, m_bn, ctx)) {
+	if (!BN_mod_mul(r1, r1, r2, ctx->m_bn, ctx->bnctx)) {
 		warn0("%s", ERR_error_string(ERR_get_error(), NULL));
-		goto err8;
+		goto err5;
 	}
 	rlen = BN_num_bytes(r1);
 	if (rlen < 0) {
 		warn0("Unexpected error in OpenSSL");
-		goto err8;
+		goto err5;
 	}
 	if (rlen > CRYPTO_DH_PUBLEN) {
 		warn0("Exponent result too large!");
-		goto err8;
+		goto err5;
 	}
 	memset(r, 0, CRYPTO_DH_PUBLEN - (size_t)rlen);
 	BN_bn2bin(r1, &r[CRYPTO_DH_PUBLEN - (size_t)rlen]);
@@ -141,82 +165,485 @@ blinded_modexp(uint8_t r[CRYPTO_DH_PUBLEN], BIGNUM * a,
 	/* Free space allocated by BN_new. */
 	BN_clear_free(r2);
 	BN_clear_free(r1);
-
-	/* Free context allocated by BN_CTX_new. */
-	BN_CTX_free(ctx);
-
-	/* Free space allocated by BN_bin2bn. */
-	BN_free(m_bn);
-
-	/* Free space allocated by BN_new. */
 	BN_clear_free(priv_blinded);
 
 	/* Free space allocated by BN_bin2bn. */
 	BN_clear_free(blinding_bn);
 	BN_clear_free(priv_bn);
-	BN_free(two_exp_256_bn);
 
 	/* Success! */
 	return (0);
 
-err8:
-	BN_clear_free(r2);
-err7:
-	BN_clear_free(r1);
-err6:
-	BN_CTX_free(ctx);
 err5:
-	BN_free(m_bn);
+	BN_clear_free(r2);
 err4:
-	BN_clear_free(priv_blinded);
+	BN_clear_free(r1);
 err3:
-	BN_clear_free(blinding_bn);
+	BN_clear_free(priv_blinded);
 err2:
-	BN_clear_free(priv_bn);
+	BN_clear_free(blinding_bn);
 err1:
-	BN_free(two_exp_256_bn);
+	BN_clear_free(priv_bn);
 err0:
 	/* Failure! */
 	return (-1);
 }
 
+#ifdef HWACCEL
 /**
- * crypto_dh_generate_pub(pub, priv):
- * Compute ${pub} equal to 2^(2^258 + ${priv}) in Diffie-Hellman group #14.
+ * If the CPU supports it, we use a native implementation of group #14
+ * arithmetic rather than OpenSSL.  Integers modulo p are held as 32
+ * little-endian 64-bit limbs, and are multiplied using Montgomery
+ * multiplication with R = 2^2048.  Powers of the generator are computed using
+ * precomputed comb tables, and powers of other values using a fixed window.
+ * Exponentiations use a fixed sequence of multiplications and look up table
+ * entries by scanning the entire table, so no operations depend on secret
+ * data in their timing and there is no need to blind the exponent.
  */
-int
-crypto_dh_generate_pub(uint8_t pub[CRYPTO_DH_PUBLEN],
+
+/* The integer 1, which is R in Montgomery form. */
+static const uint64_t one[NLIMBS] = {1};
+
+/*
+ * Test whether the hardware extensions code produces correct results.  Must
+ * be called with (hwaccel == HW_SOFTWARE).
+ */
+static int
+hwtest(void (* func)(uint64_t[NLIMBS], const uint64_t[NLIMBS],
+    const uint64_t[NLIMBS], const uint64_t[NLIMBS]))
+{
+	uint64_t x[NLIMBS];
+	uint64_t r[NLIMBS];
+	size_t j;
+
+	/* Entries in each comb table multiply according to their indices. */
+	for (j = 0; j < 4; j++) {
+		func(r, crypto_dh_group14_comb[16 * j + 5],
+		    crypto_dh_group14_comb[16 * j + 10], crypto_dh_group14_p);
+		if (memcmp(r, crypto_dh_group14_comb[16 * j + 15], sizeof(r)))
+			goto err0;
+	}
+
+	/* Converting p - 1 into and out of Montgomery form is a no-op. */
+	memcpy(x, crypto_dh_group14_p, sizeof(x));
+	x[0] -= 1;
+	func(r, x, crypto_dh_group14_rr, crypto_dh_group14_p);
+	func(r, r, one, crypto_dh_group14_p);
+	if (memcmp(r, x, sizeof(r)))
+		goto err0;
+
+	/* Success! */
+	return (0);
+
+err0:
+	/* Failure! */
+	return (-1);
+}
+
+/* Which type of hardware acceleration should we use, if any? */
+static void
+hwaccel_init(void)
+{
+
+	/* If we've already set hwaccel, we're finished. */
+	if (hwaccel != HW_UNSET)
+		return;
+
+	/* Default to software. */
+	hwaccel = HW_SOFTWARE;
+
+#if defined(CPUSUPPORT_X86_ADX)
+	CPUSUPPORT_VALIDATE(hwaccel, HW_X86_ADX, cpusupport_x86_adx(),
+	    hwtest(crypto_dh_adx_montmul));
+#endif
+}
+
+/* Compute ${r} = ${a} * ${b} / R mod p. */
+static inline void
+montmul(uint64_t r[NLIMBS], const uint64_t a[NLIMBS], const uint64_t b[NLIMBS])
+{
+
+	crypto_dh_adx_montmul(r, a, b, crypto_dh_group14_p);
+}
+
+/* Copy entry ${idx} of the ${n}-entry table ${tab} into ${r}. */
+static void
+ct_select(uint64_t r[NLIMBS], const uint64_t (* tab)[NLIMBS], size_t n,
+    size_t idx)
+{
+	uint64_t d, mask;
+	size_t i, j;
+
+	/* Read every entry, so the access pattern is independent of idx. */
+	memset(r, 0, NLIMBS * sizeof(uint64_t));
+	for (i = 0; i < n; i++) {
+		d = (uint64_t)(i ^ idx);
+		mask = ((d | ((uint64_t)0 - d)) >> 63) - 1;
+		for (j = 0; j < NLIMBS; j++)
+			r[j] |= tab[i][j] & mask;
+	}
+}
+
+/* Return ${nbits} bits of the little-endian ${e}, starting at bit ${pos}. */
+static inline size_t
+ebits(const uint8_t * e, size_t pos, size_t nbits)
+{
+	uint32_t x;
+
+	x = (uint32_t)e[pos / 8] | ((uint32_t)e[pos / 8 + 1] << 8);
+	return ((x >> (pos % 8)) & ((1U << nbits) - 1));
+}
+
+/* Convert the big-endian ${in} into limbs ${r}, reducing modulo p. */
+static void
+import(uint64_t r[NLIMBS], const uint8_t in[CRYPTO_DH_PUBLEN])
+{
+	uint64_t u[NLIMBS];
+	uint64_t s, borrow, mask;
+	size_t i;
+
+	/* Parse the integer. */
+	for (i = 0; i < NLIMBS; i++)
+		r[i] = be64dec(&in[CRYPTO_DH_PUBLEN - 8 - 8 * i]);
+
+	/* Since p > 2^2047, we need to subtract p at most once. */
+	borrow = 0;
+	for (i = 0; i < NLIMBS; i++) {
+		s = r[i] - crypto_dh_group14_p[i];
+		u[i] = s - borrow;
+		borrow = (uint64_t)(r[i] < crypto_dh_group14_p[i]) |
+		    (uint64_t)(s < borrow);
+	}
+	mask = borrow - 1;
+	for (i = 0; i < NLIMBS; i++)
+		r[i] = (u[i] & mask) | (r[i] & ~mask);
+}
+
+/* Convert the limbs ${a} into the big-endian ${out}. */
+static void
+export(uint8_t out[CRYPTO_DH_PUBLEN], const uint64_t a[NLIMBS])
+{
+	size_t i;
+
+	for (i = 0; i < NLIMBS; i++)
+		be64enc(&out[CRYPTO_DH_PUBLEN - 8 - 8 * i], a[i]);
+}
+
+/* Compute ${pub} = 2^(2^258 + ${priv}) using the context ${ctx}. */
+static void
+generate_pub_native(struct crypto_dh_ctx * ctx,
+    uint8_t pub[CRYPTO_DH_PUBLEN], const uint8_t priv[CRYPTO_DH_PRIVLEN])
+{
+	uint8_t e[CRYPTO_DH_PRIVLEN + 1];
+	size_t i, j, k;
+	size_t u;
+
+	/* Convert the exponent to little-endian. */
+	for (i = 0; i < CRYPTO_DH_PRIVLEN; i++)
+		e[i] = priv[CRYPTO_DH_PRIVLEN - 1 - i];
+	e[CRYPTO_DH_PRIVLEN] = 0;
+
+	/*
+	 * Compute 2^priv using the comb tables: bit k of column j in each of
+	 * the 4 rows (i.e., bits 64i + 16j + k) selects an entry from table j.
+	 */
+	memcpy(ctx->acc, crypto_dh_group14_comb[0], sizeof(ctx->acc));
+	for (k = 16; k-- > 0; ) {
+		if (k < 15)
+			montmul(ctx->acc, ctx->acc, ctx->acc);
+		for (j = 0; j < 4; j++) {
+			u = 0;
+			for (i = 0; i < 4; i++)
+				u |= ebits(e, 64 * i + 16 * j + k, 1) << i;
+			ct_select(ctx->t, &crypto_dh_group14_comb[16 * j], 16,
+			    u);
+			montmul(ctx->acc, ctx->acc, ctx->t);
+		}
+	}
+
+	/*
+	 * Multiply by 2^(2^258); since that constant is not in Montgomery
+	 * form, this also converts the result out of Montgomery form.
+	 */
+	montmul(ctx->acc, ctx->acc, crypto_dh_group14_c258);
+	export(pub, ctx->acc);
+
+	/* Clean up. */
+	insecure_memzero(e, sizeof(e));
+	insecure_memzero(ctx->acc, sizeof(ctx->acc));
+	insecure_memzero(ctx->t, sizeof(ctx->t));
+}
+
+/* Compute ${key} = ${pub}^(2^258 + ${priv}) using the context ${ctx}. */
+static void
+compute_native(struct crypto_dh_ctx * ctx,
+    const uint8_t pub[CRYPTO_DH_PUBLEN], const uint8_t priv[CRYPTO_DH_PRIVLEN],
+    uint8_t key[CRYPTO_DH_KEYLEN])
+{
+	uint8_t e[CRYPTO_DH_PRIVLEN + 2];
+	size_t i, k;
+
+	/* Convert the exponent 2^258 + priv to little-endian. */
+	for (i = 0; i < CRYPTO_DH_PRIVLEN; i++)
+		e[i] = priv[CRYPTO_DH_PRIVLEN - 1 - i];
+	e[CRYPTO_DH_PRIVLEN] = 0x04;
+	e[CRYPTO_DH_PRIVLEN + 1] = 0;
+
+	/* Compute pub^k * R for k = 0 ... 2^WBITS - 1. */
+	import(ctx->t, pub);
+	montmul(ctx->table[1], ctx->t, crypto_dh_group14_rr);
+	montmul(ctx->table[0], one, crypto_dh_group14_rr);
+	for (k = 2; k < (1 << WBITS); k++)
+		montmul(ctx->table[k], ctx->table[k - 1], ctx->table[1]);
+
+	/* Fixed-window exponentiation, over 260 = 52 * WBITS bits. */
+	ct_select(ctx->acc, ctx->table, 1 << WBITS, ebits(e, 255, WBITS));
+	for (k = 51; k-- > 0; ) {
+		for (i = 0; i < WBITS; i++)
+			montmul(ctx->acc, ctx->acc, ctx->acc);
+		ct_select(ctx->t, ctx->table, 1 << WBITS,
+		    ebits(e, WBITS * k, WBITS));
+		montmul(ctx->acc, ctx->acc, ctx->t);
+	}
+
+	/* Convert out of Montgomery form. */
+	montmul(ctx->acc, ctx->acc, one);
+	export(key, ctx->acc);
+
+	/* Clean up. */
+	insecure_memzero(e, sizeof(e));
+	insecure_memzero(ctx->table, sizeof(ctx->table));
+	insecure_memzero(ctx->acc, sizeof(ctx->acc));
+	insecure_memzero(ctx->t, sizeof(ctx->t));
+}
+#endif /* HWACCEL */
+
+/* Compute ${pub} = 2^(2^258 + ${priv}) using OpenSSL. */
+static int
+generate_pub_bn(struct crypto_dh_ctx * ctx, uint8_t pub[CRYPTO_DH_PUBLEN],
     const uint8_t priv[CRYPTO_DH_PRIVLEN])
 {
-	BIGNUM * two;
 
-	/* Generate BN representation for 2. */
-	if ((two = BN_new()) == NULL) {
+	/* Compute pub = two^(2^258 + priv). */
+	return (blinded_modexp(ctx, pub, ctx->two, priv));
+}
+
+/* Compute ${key} = ${pub}^(2^258 + ${priv}) using OpenSSL. */
+static int
+compute_bn(struct crypto_dh_ctx * ctx, const uint8_t pub[CRYPTO_DH_PUBLEN],
+    const uint8_t priv[CRYPTO_DH_PRIVLEN], uint8_t key[CRYPTO_DH_KEYLEN])
+{
+	BIGNUM * a;
+
+	/* Convert ${pub} into BN representation. */
+	if ((a = BN_bin2bn(pub, CRYPTO_DH_PUBLEN, NULL)) == NULL) {
 		warn0("%s", ERR_error_string(ERR_get_error(), NULL));
 		goto err0;
 	}
-	if (!BN_set_word(two, 2)) {
+
+	/* Compute key = pub^(2^258 + priv). */
+	if (blinded_modexp(ctx, key, a, priv))
+		goto err1;
+
+	/* Free storage allocated by BN_bin2bn. */
+	BN_free(a);
+
+	/* Success! */
+	return (0);
+
+err1:
+	BN_free(a);
+err0:
+	/* Failure! */
+	return (-1);
+}
+
+/* Prepare the context ${ctx} for use. */
+static int
+ctx_init(struct crypto_dh_ctx * ctx)
+{
+
+	/* Nothing allocated yet. */
+	ctx->bnctx = NULL;
+	ctx->m_bn = NULL;
+	ctx->two_exp_256_bn = NULL;
+	ctx->two = NULL;
+
+#ifdef HWACCEL
+	/* The native implementation needs nothing more. */
+	hwaccel_init();
+	if (hwaccel == HW_X86_ADX)
+		return (0);
+#endif
+
+	/* Construct 2^256, 2, and the group #14 modulus. */
+	if ((ctx->two_exp_256_bn = BN_bin2bn(two_exp_256, 33, NULL)) == NULL) {
+		warn0("%s", ERR_error_string(ERR_get_error(), NULL));
+		goto err1;
+	}
+	if ((ctx->two = BN_new()) == NULL) {
+		warn0("%s", ERR_error_string(ERR_get_error(), NULL));
+		goto err1;
+	}
+	if (!BN_set_word(ctx->two, 2)) {
+		warn0("%s", ERR_error_string(ERR_get_error(), NULL));
+		goto err1;
+	}
+	if ((ctx->m_bn = BN_bin2bn(crypto_dh_group14, 256, NULL)) == NULL) {
 		warn0("%s", ERR_error_string(ERR_get_error(), NULL));
 		goto err1;
 	}
 
-	/* Compute pub = two^(2^258 + priv). */
-	if (blinded_modexp(pub, two, priv))
+	/* Allocate BN context. */
+	if ((ctx->bnctx = BN_CTX_new()) == NULL) {
+		warn0("%s", ERR_error_string(ERR_get_error(), NULL));
 		goto err1;
+	}
 
-	/* Free storage allocated by BN_new. */
-	BN_free(two);
+	/* Generate the key for blinding exponents. */
+	if (crypto_entropy_read(ctx->blind_key, 32))
+		goto err1;
+	ctx->blind_count = 0;
 
 	/* Success! */
 	return (0);
 
 err1:
-	BN_free(two);
-err0:
+	BN_CTX_free(ctx->bnctx);
+	BN_free(ctx->m_bn);
+	BN_free(ctx->two);
+	BN_free(ctx->two_exp_256_bn);
+
 	/* Failure! */
 	return (-1);
 }
 
+/* Free anything allocated by ctx_init() and clear the context ${ctx}. */
+static void
+ctx_cleanup(struct crypto_dh_ctx * ctx)
+{
+
+	/* Free OpenSSL values (BN_free and BN_CTX_free accept NULL). */
+	BN_CTX_free(ctx->bnctx);
+	BN_free(ctx->m_bn);
+	BN_free(ctx->two);
+	BN_free(ctx->two_exp_256_bn);
+
+	/* Clear the blinding key. */
+	insecure_memzero(ctx->blind_key, 32);
+}
+
+/**
+ * crypto_dh_ctx_alloc(void):
+ * Allocate a context for performing Diffie-Hellman group #14 operations.  A
+ * context may be used for any number of operations, but must not be used by
+ * more than one thread at once.  Operations on a context do not access the
+ * entropy source, so separate contexts may be used in separate threads.
+ */
+struct crypto_dh_ctx *
+crypto_dh_ctx_alloc(void)
+{
+	struct crypto_dh_ctx * ctx;
+
+	/* Allocate the context. */
+	if ((ctx = malloc(sizeof(struct crypto_dh_ctx))) == NULL)
+		goto err0;
+
+	/* Set up the context. */
+	if (ctx_init(ctx))
+		goto err1;
+
+	/* Success! */
+	return (ctx);
+
+err1:
+	free(ctx);
+err0:
+	/* Failure! */
+	return (NULL);
+}
+
+/**
+ * crypto_dh_generate_pub_ctx(ctx, pub, priv):
+ * Compute ${pub} equal to 2^(2^258 + ${priv}) in Diffie-Hellman group #14,
+ * using the context ${ctx}.
+ */
+int
+crypto_dh_generate_pub_ctx(struct crypto_dh_ctx * ctx,
+    uint8_t pub[CRYPTO_DH_PUBLEN], const uint8_t priv[CRYPTO_DH_PRIVLEN])
+{
+
+#ifdef HWACCEL
+	if (hwaccel == HW_X86_ADX) {
+		generate_pub_native(ctx, pub, priv);
+		return (0);
+	}
+#endif
+
+	/* Fall back to OpenSSL. */
+	return (generate_pub_bn(ctx, pub, priv));
+}
+
+/**
+ * crypto_dh_compute_ctx(ctx, pub, priv, key):
+ * In the Diffie-Hellman group #14, compute ${pub}^(2^258 + ${priv}) and
+ * write the result into ${key}, using the context ${ctx}.
+ */
+int
+crypto_dh_compute_ctx(struct crypto_dh_ctx * ctx,
+    const uint8_t pub[CRYPTO_DH_PUBLEN], const uint8_t priv[CRYPTO_DH_PRIVLEN],
+    uint8_t key[CRYPTO_DH_KEYLEN])
+{
+
+#ifdef HWACCEL
+	if (hwaccel == HW_X86_ADX) {
+		compute_native(ctx, pub, priv, key);
+		return (0);
+	}
+#endif
+
+	/* Fall back to OpenSSL. */
+	return (compute_bn(ctx, pub, priv, key));
+}
+
+/**
+ * crypto_dh_ctx_free(ctx):
+ * Free the Diffie-Hellman context ${ctx}.
+ */
+void
+crypto_dh_ctx_free(struct crypto_dh_ctx * ctx)
+{
+
+	/* Behave consistently with free(NULL). */
+	if (ctx == NULL)
+		return;
+
+	/* Free the context. */
+	ctx_cleanup(ctx);
+	free(ctx);
+}
+
+/**
+ * crypto_dh_generate_pub(pub, priv):
+ * Compute ${pub} equal to 2^(2^258 + ${priv}) in Diffie-Hellman group #14.
+ */
+int
+crypto_dh_generate_pub(uint8_t pub[CRYPTO_DH_PUBLEN],
+    const uint8_t priv[CRYPTO_DH_PRIVLEN])
+{
+	struct crypto_dh_ctx ctx;
+	int rc;
+
+	/* Compute pub = two^(2^258 + priv). */
+	if (ctx_init(&ctx))
+		return (-1);
+	rc = crypto_dh_generate_pub_ctx(&ctx, pub, priv);
+	ctx_cleanup(&ctx);
+
+	/* Return status code. */
+	return (rc);
+}
+
 /**
  * crypto_dh_generate(pub, priv):
  * Generate a 256-bit private key ${priv}, and compute ${pub} equal to
@@ -255,29 +682,17 @@ int
 crypto_dh_compute(const uint8_t pub[CRYPTO_DH_PUBLEN],
     const uint8_t priv[CRYPTO_DH_PRIVLEN], uint8_t key[CRYPTO_DH_KEYLEN])
 {
-	BIGNUM * a;
-
-	/* Convert ${pub} into BN representation. */
-	if ((a = BN_bin2bn(pub, CRYPTO_DH_PUBLEN, NULL)) == NULL) {
-		warn0("%s", ERR_error_string(ERR_get_error(), NULL));
-		goto err0;
-	}
+	struct crypto_dh_ctx ctx;
+	int rc;
 
 	/* Compute key = pub^(2^258 + priv). */
-	if (blinded_modexp(key, a, priv))
-		goto err1;
-
-	/* Free storage allocated by BN_bin2bn. */
-	BN_free(a);
-
-	/* Success! */
-	return (0);
+	if (ctx_init(&ctx))
+		return (-1);
+	rc = crypto_dh_compute_ctx(&ctx, pub, priv, key);
+	ctx_cleanup(&ctx);
 
-err1:
-	BN_free(a);
-err0:
-	/* Failure! */
-	return (-1);
+	/* Return status code. */
+	return (rc);
 }
 
 /**
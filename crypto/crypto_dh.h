@@ -8,6 +8,41 @@
 #define CRYPTO_DH_PUBLEN	256
 #define CRYPTO_DH_KEYLEN	256
 
+/* Opaque type. */
+struct crypto_dh_ctx;
+
+/**
+ * crypto_dh_ctx_alloc(void):
+ * Allocate a context for performing Diffie-Hellman group #14 operations.  A
+ * context may be used for any number of operations, but must not be used by
+ * more than one thread at once.  Operations on a context do not access the
+ * entropy source, so separate contexts may be used in separate threads.
+ */
+struct crypto_dh_ctx * crypto_dh_ctx_alloc(void);
+
+/**
+ * crypto_dh_generate_pub_ctx(ctx, pub, priv):
+ * Compute ${pub} equal to 2^(2^258 + ${priv}) in Diffie-Hellman group #14,
+ * using the context ${ctx}.
+ */
+int crypto_dh_generate_pub_ctx(struct crypto_dh_ctx *,
+    uint8_t[CRYPTO_DH_PUBLEN], const uint8_t[CRYPTO_DH_PRIVLEN]);
+
+/**
+ * crypto_dh_compute_ctx(ctx, pub, priv, key):
+ * In the Diffie-Hellman group #14, compute ${pub}^(2^258 + ${priv}) and
+ * write the result into ${key}, using the context ${ctx}.
+ */
+int crypto_dh_compute_ctx(struct crypto_dh_ctx *,
+    const uint8_t[CRYPTO_DH_PUBLEN], const uint8_t[CRYPTO_DH_PRIVLEN],
+    uint8_t[CRYPTO_DH_KEYLEN]);
+
+/**
+ * crypto_dh_ctx_free(ctx):
+ * Free the Diffie-Hellman context ${ctx}.
+ */
+void crypto_dh_ctx_free(struct crypto_dh_ctx *);
+
 /**
  * crypto_dh_generate_pub(pub, priv):
  * Compute ${pub} equal to 2^(2^258 + ${priv}) in Diffie-Hellman group #14.
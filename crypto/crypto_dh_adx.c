@@ -0,0 +1,122 @@
+#include "cpusupport.h"
+#ifdef CPUSUPPORT_X86_ADX
+/**
+ * CPUSUPPORT CFLAGS: X86_ADX
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "insecure_memzero.h"
+
+#include "crypto_dh_adx.h"
+
+#define NLIMBS 32
+
+/**
+ * Montgomery multiplication using the "coarsely integrated operand scanning"
+ * method.  Each row of partial products is accumulated using two independent
+ * carry chains, one for the low halves and one for the high halves of the
+ * products, which the ADCX and ADOX instructions allow to be interleaved.
+ * Compilers do not generate these instructions (even from the _addcarryx_u64
+ * intrinsic), so the row computation is written using inline assembly.
+ */
+
+/* Accumulate x * y[j] into t[j], with the high half of x * y[j-1]. */
+#define STEP(j, lo, hi, prevhi)						\
+	"mulx	8*" #j "(%[y]), %%" lo ", %%" hi "\n\t"			\
+	"adcx	8*" #j "(%[t]), %%" lo "\n\t"				\
+	"adox	%%" prevhi ", %%" lo "\n\t"				\
+	"movq	%%" lo ", 8*" #j "(%[t])\n\t"
+
+/* Two steps, alternating registers. */
+#define STEP2(j0, j1)							\
+	STEP(j0, "r8", "r9", "r11")					\
+	STEP(j1, "r10", "r11", "r9")
+
+/* t[0 ... NLIMBS + 1] += x * y[0 ... NLIMBS - 1]. */
+static inline void
+muladd_row(uint64_t * t, uint64_t x, const uint64_t * y)
+{
+
+	__asm__ __volatile__ (
+	    /* Clear CF, OF, and the "previous high half". */
+	    "xorl	%%eax, %%eax\n\t"
+	    "xorl	%%r11d, %%r11d\n\t"
+	    STEP2(0, 1) STEP2(2, 3) STEP2(4, 5) STEP2(6, 7)
+	    STEP2(8, 9) STEP2(10, 11) STEP2(12, 13) STEP2(14, 15)
+	    STEP2(16, 17) STEP2(18, 19) STEP2(20, 21) STEP2(22, 23)
+	    STEP2(24, 25) STEP2(26, 27) STEP2(28, 29) STEP2(30, 31)
+	    /* Add the final high half and both carries into t[32 ... 33]. */
+	    "movq	8*32(%[t]), %%r8\n\t"
+	    "adcx	%%rax, %%r8\n\t"
+	    "adox	%%r11, %%r8\n\t"
+	    "movq	%%r8, 8*32(%[t])\n\t"
+	    "movq	8*33(%[t]), %%r8\n\t"
+	    "adcx	%%rax, %%r8\n\t"
+	    "adox	%%rax, %%r8\n\t"
+	    "movq	%%r8, 8*33(%[t])\n\t"
+	    : "+d" (x)
+	    : [t] "r" (t), [y] "r" (y)
+	    : "rax", "r8", "r9", "r10", "r11", "cc", "memory");
+}
+
+/**
+ * crypto_dh_adx_montmul(r, a, b, p):
+ * Compute ${r} = ${a} * ${b} / 2^2048 mod ${p}, where ${p} is a 2048-bit
+ * modulus with ${p} = -1 mod 2^64, ${a} and ${b} are less than ${p}, and all
+ * values are held as 32 little-endian 64-bit limbs.  The output ${r} may be
+ * the same as one of the inputs.  This implementation uses x86 ADX and BMI2
+ * instructions, and should only be used if CPUSUPPORT_X86_ADX is defined and
+ * cpusupport_x86_adx() returns nonzero.
+ */
+void
+crypto_dh_adx_montmul(uint64_t r[32], const uint64_t a[32],
+    const uint64_t b[32], const uint64_t p[32])
+{
+	uint64_t tt[2 * NLIMBS + 2];
+	uint64_t u[NLIMBS];
+	uint64_t * t;
+	uint64_t s, borrow, mask;
+	size_t i, j;
+
+	/* Start with t = 0. */
+	memset(tt, 0, sizeof(tt));
+
+	/*
+	 * Rather than shifting t down by one limb after each reduction step,
+	 * we move t up through the (zero-initialized) buffer tt.
+	 */
+	for (i = 0; i < NLIMBS; i++) {
+		t = &tt[i];
+
+		/* t += a * b[i]. */
+		muladd_row(t, b[i], a);
+
+		/*
+		 * t += m * p, where m = t * (-p^(-1)) mod 2^64; since p = -1
+		 * mod 2^64, this is simply m = t[0], and makes t[0] zero.
+		 */
+		muladd_row(t, t[0], p);
+	}
+	t = &tt[NLIMBS];
+
+	/* We now have t < 2p; compute u = t - p. */
+	borrow = 0;
+	for (j = 0; j < NLIMBS; j++) {
+		s = t[j] - p[j];
+		u[j] = s - borrow;
+		borrow = (uint64_t)(t[j] < p[j]) | (uint64_t)(s < borrow);
+	}
+
+	/* Output u if it is non-negative, or t otherwise. */
+	mask = 0 - (t[NLIMBS] | (borrow ^ 1));
+	for (j = 0; j < NLIMBS; j++)
+		r[j] = (u[j] & mask) | (t[j] & ~mask);
+
+	/* Clean up. */
+	insecure_memzero(tt, sizeof(tt));
+	insecure_memzero(u, sizeof(u));
+}
+#endif /* CPUSUPPORT_X86_ADX */
@@ -0,0 +1,18 @@
+#ifndef _CRYPTO_DH_ADX_H_
+#define _CRYPTO_DH_ADX_H_
+
+#include <stdint.h>
+
+/**
+ * crypto_dh_adx_montmul(r, a, b, p):
+ * Compute ${r} = ${a} * ${b} / 2^2048 mod ${p}, where ${p} is a 2048-bit
+ * modulus with ${p} = -1 mod 2^64, ${a} and ${b} are less than ${p}, and all
+ * values are held as 32 little-endian 64-bit limbs.  The output ${r} may be
+ * the same as one of the inputs.  This implementation uses x86 ADX and BMI2
+ * instructions, and should only be used if CPUSUPPORT_X86_ADX is defined and
+ * cpusupport_x86_adx() returns nonzero.
+ */
+void crypto_dh_adx_montmul(uint64_t[32], const uint64_t[32],
+    const uint64_t[32], const uint64_t[32]);
+
+#endif /* !_CRYPTO_DH_ADX_H_ */
@@ -0,0 +1,199 @@
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "crypto_dh.h"
+#include "crypto_entropy.h"
+#include "warnp.h"
+#include "workshare.h"
+
+#include "crypto_dh_batch.h"
+
+/**
+ * Each thread gets its own Diffie-Hellman context, which is allocated (and
+ * thus keyed from the entropy source) by the calling thread before any
+ * worker threads are started; the contexts themselves never touch the
+ * entropy source or any other shared state.
+ */
+
+/* A share of the work in a batch. */
+struct batch_share {
+	struct crypto_dh_ctx * ctx;
+	const uint8_t * pub;		/* NULL when generating public keys. */
+	const uint8_t * priv;
+	uint8_t * out;
+	size_t outlen;			/* Bytes of output per operation. */
+	size_t n;
+	int rc;
+};
+
+/* Perform the operations in a share of the work. */
+static void *
+workthread(void * cookie)
+{
+	struct batch_share * S = cookie;
+	size_t i;
+
+	/* Assume failure until we finish. */
+	S->rc = -1;
+
+	for (i = 0; i < S->n; i++) {
+		if (S->pub == NULL) {
+			if (crypto_dh_generate_pub_ctx(S->ctx,
+			    &S->out[i * S->outlen],
+			    &S->priv[i * CRYPTO_DH_PRIVLEN]))
+				goto done;
+		} else {
+			if (crypto_dh_compute_ctx(S->ctx,
+			    &S->pub[i * CRYPTO_DH_PUBLEN],
+			    &S->priv[i * CRYPTO_DH_PRIVLEN],
+			    &S->out[i * S->outlen]))
+				goto done;
+		}
+	}
+
+	/* Success! */
+	S->rc = 0;
+
+done:
+	return (NULL);
+}
+
+/*
+ * Perform ${n} operations, each writing ${outlen} bytes to ${out}, using up
+ * to ${nthreads} threads.
+ */
+static int
+batch(const uint8_t * pub, const uint8_t * priv, uint8_t * out,
+    size_t outlen, size_t n, size_t nthreads)
+{
+	struct batch_share * shares;
+	size_t i, pos;
+
+	/* Nothing to do? */
+	if (n == 0)
+		return (0);
+
+	/* There's no point having more threads than operations. */
+	if (nthreads > n)
+		nthreads = n;
+	if (nthreads == 0)
+		nthreads = 1;
+
+	/* Allocate and divide up the work. */
+	if ((shares = calloc(nthreads, sizeof(struct batch_share))) == NULL) {
+		warnp("calloc");
+		goto err0;
+	}
+	for (i = pos = 0; i < nthreads; i++) {
+		shares[i].pub = (pub != NULL) ? &pub[pos * CRYPTO_DH_PUBLEN] :
+		    NULL;
+		shares[i].priv = &priv[pos * CRYPTO_DH_PRIVLEN];
+		shares[i].out = &out[pos * outlen];
+		shares[i].outlen = outlen;
+		shares[i].n = workshare_len(n, nthreads, i);
+		pos += shares[i].n;
+	}
+
+	/* Set up a context for each share of the work. */
+	for (i = 0; i < nthreads; i++) {
+		if ((shares[i].ctx = crypto_dh_ctx_alloc()) == NULL)
+			goto err1;
+	}
+
+	/*
+	 * Perform the operations in each share; if this fails, threads might
+	 * still be running, so leak their state.
+	 */
+	if (workshare_run(workthread, shares, sizeof(struct batch_share),
+	    nthreads))
+		goto err0;
+
+	/* Check whether all the work succeeded. */
+	for (i = 0; i < nthreads; i++) {
+		if (shares[i].rc)
+			goto err1;
+	}
+
+	/* Clean up. */
+	for (i = 0; i < nthreads; i++)
+		crypto_dh_ctx_free(shares[i].ctx);
+	free(shares);
+
+	/* Success! */
+	return (0);
+
+err1:
+	for (i = 0; i < nthreads; i++)
+		crypto_dh_ctx_free(shares[i].ctx);
+	free(shares);
+err0:
+	/* Failure! */
+	return (-1);
+}
+
+/**
+ * crypto_dh_generate_batch(pub, priv, n, nthreads):
+ * Generate ${n} 256-bit private keys, and the corresponding Diffie-Hellman
+ * group #14 public keys, into the buffers ${priv} and ${pub}, which must hold
+ * ${n} * CRYPTO_DH_PRIVLEN and ${n} * CRYPTO_DH_PUBLEN bytes respectively.
+ * This is equivalent to ${n} calls to crypto_dh_generate(), but reads from
+ * the entropy source once and spreads the work across up to ${nthreads}
+ * threads (including the calling thread).
+ */
+int
+crypto_dh_generate_batch(uint8_t * pub, uint8_t * priv, size_t n,
+    size_t nthreads)
+{
+
+	/* Sanity check. */
+	if (n > SIZE_MAX / CRYPTO_DH_PUBLEN) {
+		warn0("Batch too large");
+		goto err0;
+	}
+
+	/* Generate all the private keys at once. */
+	if (crypto_entropy_read(priv, n * CRYPTO_DH_PRIVLEN))
+		goto err0;
+
+	/* Compute the public keys. */
+	if (batch(NULL, priv, pub, CRYPTO_DH_PUBLEN, n, nthreads))
+		goto err0;
+
+	/* Success! */
+	return (0);
+
+err0:
+	/* Failure! */
+	return (-1);
+}
+
+/**
+ * crypto_dh_compute_batch(pub, priv, key, n, nthreads):
+ * For each i < ${n}, compute the i-th CRYPTO_DH_KEYLEN bytes of ${key} from
+ * the i-th CRYPTO_DH_PUBLEN bytes of ${pub} and the i-th CRYPTO_DH_PRIVLEN
+ * bytes of ${priv} as crypto_dh_compute() would, spreading the work across
+ * up to ${nthreads} threads (including the calling thread).
+ */
+int
+crypto_dh_compute_batch(const uint8_t * pub, const uint8_t * priv,
+    uint8_t * key, size_t n, size_t nthreads)
+{
+
+	/* Sanity check. */
+	if (n > SIZE_MAX / CRYPTO_DH_PUBLEN) {
+		warn0("Batch too large");
+		goto err0;
+	}
+
+	/* Compute the shared keys. */
+	if (batch(pub, priv, key, CRYPTO_DH_KEYLEN, n, nthreads))
+		goto err0;
+
+	/* Success! */
+	return (0);
+
+err0:
+	/* Failure! */
+	return (-1);
+}
@@ -0,0 +1,28 @@
+#ifndef _CRYPTO_DH_BATCH_H_
+#define _CRYPTO_DH_BATCH_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * crypto_dh_generate_batch(pub, priv, n, nthreads):
+ * Generate ${n} 256-bit private keys, and the corresponding Diffie-Hellman
+ * group #14 public keys, into the buffers ${priv} and ${pub}, which must hold
+ * ${n} * CRYPTO_DH_PRIVLEN and ${n} * CRYPTO_DH_PUBLEN bytes respectively.
+ * This is equivalent to ${n} calls to crypto_dh_generate(), but reads from
+ * the entropy source once and spreads the work across up to ${nthreads}
+ * threads (including the calling thread).
+ */
+int crypto_dh_generate_batch(uint8_t *, uint8_t *, size_t, size_t);
+
+/**
+ * crypto_dh_compute_batch(pub, priv, key, n, nthreads):
+ * For each i < ${n}, compute the i-th CRYPTO_DH_KEYLEN bytes of ${key} from
+ * the i-th CRYPTO_DH_PUBLEN bytes of ${pub} and the i-th CRYPTO_DH_PRIVLEN
+ * bytes of ${priv} as crypto_dh_compute() would, spreading the work across
+ * up to ${nthreads} threads (including the calling thread).
+ */
+int crypto_dh_compute_batch(const uint8_t *, const uint8_t *, uint8_t *,
+    size_t, size_t);
+
+#endif /* !_CRYPTO_DH_BATCH_H_ */
@@ -0,0 +1,895 @@
+#include <stdint.h>
+
+#include "crypto_dh_group14_comb.h"
+
+/**
+ * The constants in this file were generated from the group #14 modulus p
+ * and are stored as little-endian arrays of 32 64-bit limbs.  Values in
+ * "Montgomery form" are multiplied by R = 2^2048 modulo p.
+ */
+
+/* The group #14 modulus p. */
+const uint64_t crypto_dh_group14_p[32] = {
+	0xffffffffffffffff, 0x15728e5a8aacaa68, 0x15d2261898fa0510,
+	0x3995497cea956ae5, 0xde2bcbf695581718, 0xb5c55df06f4c52c9,
+	0x9b2783a2ec07a28f, 0xe39e772c180e8603, 0x32905e462e36ce3b,
+	0xf1746c08ca18217c, 0x670c354e4abc9804, 0x9ed529077096966d,
+	0x1c62f356208552bb, 0x83655d23dca3ad96, 0x69163fa8fd24cf5f,
+	0x98da48361c55d39a, 0xc2007cb8a163bf05, 0x49286651ece45b3d,
+	0xae9f24117c4b1fe6, 0xee386bfb5a899fa5, 0x0bff5cb6f406b7ed,
+	0xf44c42e9a637ed6b, 0xe485b576625e7ec6, 0x4fe1356d6d51c245,
+	0x302b0a6df25f1437, 0xef9519b3cd3a431b, 0x514a08798e3404dd,
+	0x020bbea63b139b22, 0x29024e088a67cc74, 0xc4c6628b80dc1cd1,
+	0xc90fdaa22168c234, 0xffffffffffffffff
+};
+
+/* R^2 mod p, used for converting values into Montgomery form. */
+const uint64_t crypto_dh_group14_rr[32] = {
+	0x477122ce125fb664, 0xb03548fb9b38d313, 0x4c2153ff6fd412c1,
+	0x2a092b50873f9bc6, 0xbbc71629fcb7f5f9, 0x4bec06e136bd84e7,
+	0x27ba725a6b020cb1, 0xf8115426ed939eeb, 0x4bc1b1878a0e30d9,
+	0x5620820e258633ff, 0x074ed6ab785a3071, 0xf228105f81f1cb61,
+	0x570e436f4e2e6f7f, 0x5ca52ff7d7450bd9, 0x552272d275f10a7e,
+	0xac2b7925739c7978, 0xa2f88257325b54d0, 0xbc821c9de8d72bd5,
+	0xdbd442b3866d2986, 0x9478951b70c4b2ce, 0x5d998fb394910c76,
+	0xf273b2937e300867, 0x8c106bbe38569f92, 0xf83c92cb14e992c5,
+	0xd85d6e7eed6880dd, 0xeb5b276fbe06a1df, 0x2a492090fa11e105,
+	0x63bdd96d19ea00be, 0x272382970a1698ab, 0x8a3a686c9240c974,
+	0x3ed8570366613000, 0x0cd37a33628b3197
+};
+
+/* 2^(2^258) mod p, the part of the generator power not covered by the comb. */
+const uint64_t crypto_dh_group14_c258[32] = {
+	0xe9248557602203d5, 0x203b2c3525a5609b, 0xe16000be91f2112a,
+	0x13ce3ac43659e9ae, 0xcb598fc74462074f, 0x48e246afadf6c70c,
+	0xd5602aaf2e83ac7b, 0x97472d579efa4679, 0x71c443c408e59b12,
+	0x21844a0d99d7e2cf, 0xffed6b94e9f69103, 0x5a1df3b768fff33f,
+	0xcc1577c4e57cc0fa, 0x26b07a4275f34d68, 0xcf1c93ca9b4d2987,
+	0xf4fb6c3276bd7391, 0x6e7b4e755270ad2c, 0x952576c5704252c9,
+	0xd46a0d4b34198f06, 0xd0192362142d042c, 0xc6a27dbad914c5d3,
+	0x4cacf419e2f711f7, 0x70caa63a013d9041, 0xe7586e87962aa14c,
+	0x50f1deed6f91e5d2, 0x964105f3b0260a70, 0x3f8eb8ee7cead40f,
+	0x757887e1617c7e87, 0x7f68c296f94a852d, 0x42461fca618e9c5a,
+	0x2c74923bef3f83a3, 0x759606e0090721c2
+};
+
+/**
+ * Lim-Lee comb tables for the generator 2, in Montgomery form.  A 256-bit
+ * exponent is split into 4 rows of 64 bits and each row into 4 columns of
+ * 16 bits; entry [16j + u] is the product over the bits i set in u of
+ * 2^(2^(64i + 16j)) mod p.
+ */
+const uint64_t crypto_dh_group14_comb[64][32] = {
+	{
+		0x0000000000000001, 0xea8d71a575535597, 0xea2dd9e76705faef,
+		0xc66ab683156a951a, 0x21d434096aa7e8e7, 0x4a3aa20f90b3ad36,
+		0x64d87c5d13f85d70, 0x1c6188d3e7f179fc, 0xcd6fa1b9d1c931c4,
+		0x0e8b93f735e7de83, 0x98f3cab1b54367fb, 0x612ad6f88f696992,
+		0xe39d0ca9df7aad44, 0x7c9aa2dc235c5269, 0x96e9c05702db30a0,
+		0x6725b7c9e3aa2c65, 0x3dff83475e9c40fa, 0xb6d799ae131ba4c2,
+		0x5160dbee83b4e019, 0x11c79404a576605a, 0xf400a3490bf94812,
+		0x0bb3bd1659c81294, 0x1b7a4a899da18139, 0xb01eca9292ae3dba,
+		0xcfd4f5920da0ebc8, 0x106ae64c32c5bce4, 0xaeb5f78671cbfb22,
+		0xfdf44159c4ec64dd, 0xd6fdb1f77598338b, 0x3b399d747f23e32e,
+		0x36f0255dde973dcb, 0x0000000000000000
+	},
+	{
+		0x0000000000000002, 0xd51ae34aeaa6ab2e, 0xd45bb3cece0bf5df,
+		0x8cd56d062ad52a35, 0x43a86812d54fd1cf, 0x9475441f21675a6c,
+		0xc9b0f8ba27f0bae0, 0x38c311a7cfe2f3f8, 0x9adf4373a3926388,
+		0x1d1727ee6bcfbd07, 0x31e795636a86cff6, 0xc255adf11ed2d325,
+		0xc73a1953bef55a88, 0xf93545b846b8a4d3, 0x2dd380ae05b66140,
+		0xce4b6f93c75458cb, 0x7bff068ebd3881f4, 0x6daf335c26374984,
+		0xa2c1b7dd0769c033, 0x238f28094aecc0b4, 0xe801469217f29024,
+		0x17677a2cb3902529, 0x36f495133b430272, 0x603d9525255c7b74,
+		0x9fa9eb241b41d791, 0x20d5cc98658b79c9, 0x5d6bef0ce397f644,
+		0xfbe882b389d8c9bb, 0xadfb63eeeb306717, 0x76733ae8fe47c65d,
+		0x6de04abbbd2e7b96, 0x0000000000000000
+	},
+	{
+		0xc15a53d4b9d2f52c, 0x2d344348b3be5e95, 0x9edcedcb55d89aaa,
+		0x02c8357fc8aebac1, 0xe09dedf96d9e7402, 0x3e03dae33d6f55d3,
+		0xb51958658f82d3ab, 0xf3d0db473449511f, 0x95460c68ad78555a,
+		0x7d0b7cef49a4bb3b, 0xc82bc0febbca7fa4, 0x9583e4323fdc23b3,
+		0x87d72a46bd6608dd, 0xd602b1b6ded256e2, 0x5b4d201ad48dff1d,
+		0x836c3fbd2c4e7ce7, 0x658c9a1e66a1a129, 0x4bc76d3f25ece854,
+		0x51202a94344f68a1, 0x5e5447650c320423, 0x1ad99a27b9a844db,
+		0x3673e5e642036ae7, 0xb57926fcfa6b81aa, 0x12cd73c90b9d3e27,
+		0xdd38551a08fba71b, 0xf4d0d93d9828246b, 0x33522ed70d5e5b4c,
+		0xbdb95c83a1dfe25c, 0x4afe987fbc37f7f3, 0x85788f5b234bfe36,
+		0x2b7958e9ddd89f79, 0x38226b79c67db6da
+	},
+	{
+		0x82b4a7a973a5ea58, 0x5a688691677cbd2b, 0x3db9db96abb13554,
+		0x05906aff915d7583, 0xc13bdbf2db3ce804, 0x7c07b5c67adeaba7,
+		0x6a32b0cb1f05a756, 0xe7a1b68e6892a23f, 0x2a8c18d15af0aab5,
+		0xfa16f9de93497677, 0x905781fd7794ff48, 0x2b07c8647fb84767,
+		0x0fae548d7acc11bb, 0xac05636dbda4adc5, 0xb69a4035a91bfe3b,
+		0x06d87f7a589cf9ce, 0xcb19343ccd434253, 0x978eda7e4bd9d0a8,
+		0xa2405528689ed142, 0xbca88eca18640846, 0x35b3344f735089b6,
+		0x6ce7cbcc8406d5ce, 0x6af24df9f4d70354, 0x259ae792173a7c4f,
+		0xba70aa3411f74e36, 0xe9a1b27b305048d7, 0x66a45dae1abcb699,
+		0x7b72b90743bfc4b8, 0x95fd30ff786fefe7, 0x0af11eb64697fc6c,
+		0x56f2b1d3bbb13ef3, 0x7044d6f38cfb6db4
+	},
+	{
+		0xca4a4983b10f8bcd, 0xbe803d9871d4d42b, 0x1e4c9c654d5aed4b,
+		0xf47e4f40262c9db6, 0x3090974349727e27, 0xd8f81eb7de50dbf8,
+		0x27de3c53761b6193, 0x6d76dd1a949e9f9d, 0x99fd41b761b818eb,
+		0x265d5c7b540c45fc, 0xb2aa4b8738a01631, 0x29eb40f208c1092d,
+		0x8da242837bed4ad8, 0x4ac2a8449374afc6, 0xe66774e8ac6ddd5a,
+		0x367bd95bb37a1ee1, 0x364d968ed215c7bf, 0xecca7edf65712473,
+		0x18c89c9e17079d6d, 0x8646e630752bcaca, 0x82192c1664ffde4d,
+		0x75aef05807e680b9, 0xb9a04cf310343ef8, 0x946b90242926e213,
+		0xcc9dc501c903fd5b, 0x60e5f2529781a415, 0x2344cc50bc1024d8,
+		0xb822e04a38e0760a, 0x37ef46f8c3686818, 0x6da9bb6d3e17f59d,
+		0x6e6ca2e2820e30e7, 0x03d657f56acc3e12
+	},
+	{
+		0x94949307621f179a, 0x7d007b30e3a9a857, 0x3c9938ca9ab5da97,
+		0xe8fc9e804c593b6c, 0x61212e8692e4fc4f, 0xb1f03d6fbca1b7f0,
+		0x4fbc78a6ec36c327, 0xdaedba35293d3f3a, 0x33fa836ec37031d6,
+		0x4cbab8f6a8188bf9, 0x6554970e71402c62, 0x53d681e41182125b,
+		0x1b448506f7da95b0, 0x9585508926e95f8d, 0xcccee9d158dbbab4,
+		0x6cf7b2b766f43dc3, 0x6c9b2d1da42b8f7e, 0xd994fdbecae248e6,
+		0x3191393c2e0f3adb, 0x0c8dcc60ea579594, 0x0432582cc9ffbc9b,
+		0xeb5de0b00fcd0173, 0x734099e620687df0, 0x28d72048524dc427,
+		0x993b8a039207fab7, 0xc1cbe4a52f03482b, 0x468998a1782049b0,
+		0x7045c09471c0ec14, 0x6fde8df186d0d031, 0xdb5376da7c2feb3a,
+		0xdcd945c5041c61ce, 0x07acafead5987c24
+	},
+	{
+		0x19d4367091490a92, 0xf8b944fc63cb234c, 0x35374f39781c7187,
+		0x5bb942c6ec82cf96, 0x1f1bb6e344d4726f, 0xd96584122be9b907,
+		0xcb242d81b1207e44, 0x10d596fb36520f76, 0x27ab602fa4127542,
+		0xfbee84ef518063a4, 0x5da2a489654a3786, 0xc6b162af29c9a9ba,
+		0xde9d593e628ba410, 0x8a3f8769f9fcfb9b, 0x6fc210bd79f06da6,
+		0x75dc3ea78ef284c7, 0xf944fe7dc9351549, 0x8bf3e87b72fe1d1f,
+		0x6e9cd67540876209, 0x9307a452fc2a43ea, 0x979bbc074629d77d,
+		0xe9c683e4f7658fbc, 0x522a4afef2da751a, 0x7452982a199a3c2a,
+		0x77cb951b71be2fc9, 0x883750b13585c82d, 0x755c32759bc260b0,
+		0x9bc4ef8a04ab9c31, 0x613ec9a6ba3c4256, 0x8abdaaef6623012f,
+		0x4b0638cd30af6b82, 0x0feb8553a86c2c34
+	},
+	{
+		0x33a86ce122921524, 0xf17289f8c7964698, 0x6a6e9e72f038e30f,
+		0xb772858dd9059f2c, 0x3e376dc689a8e4de, 0xb2cb082457d3720e,
+		0x96485b036240fc89, 0x21ab2df66ca41eed, 0x4f56c05f4824ea84,
+		0xf7dd09dea300c748, 0xbb454912ca946f0d, 0x8d62c55e53935374,
+		0xbd3ab27cc5174821, 0x147f0ed3f3f9f737, 0xdf84217af3e0db4d,
+		0xebb87d4f1de5098e, 0xf289fcfb926a2a92, 0x17e7d0f6e5fc3a3f,
+		0xdd39acea810ec413, 0x260f48a5f85487d4, 0x2f37780e8c53aefb,
+		0xd38d07c9eecb1f79, 0xa45495fde5b4ea35, 0xe8a5305433347854,
+		0xef972a36e37c5f92, 0x106ea1626b0b905a, 0xeab864eb3784c161,
+		0x3789df1409573862, 0xc27d934d747884ad, 0x157b55decc46025e,
+		0x960c719a615ed705, 0x1fd70aa750d85868
+	},
+	{
+		0xb36c7f7ba215913f, 0x2b68fe948ad8edbb, 0x691ae5771d066e27,
+		0xc55fa479aae485e8, 0x5f42ae2338b338f4, 0xcec56d0f2eae8b8f,
+		0x37b0782106dae90a, 0xba0dc0816d2496d6, 0xd956740bc4561821,
+		0x583f2bc568bec894, 0x745e104d1c427de4, 0x37e81b848e4e9c54,
+		0x86b07f78ce13464a, 0xdd2e6f05027ac6e2, 0x225ba37cd614d9f9,
+		0x23908ad67faefaed, 0xc610c74c60ce8b57, 0x4fb9f0f5b36bb600,
+		0x54c97e9dd0d7ba88, 0xa740115d932706f3, 0xbca89f0918840384,
+		0xfd4e3fc719e145d0, 0x8dd7b8755084e49a, 0xeabde7c7b735b5ba,
+		0x173d7339d9f9680c, 0x70bf81e4eecc55a5, 0xca9fe1033f70410f,
+		0x7794107bc13bbc4f, 0x7b8cd51db2ca245d, 0x1bb57dde71cc692b,
+		0x6aec1f20526ec704, 0xab3dc7e48412220d
+	},
+	{
+		0x66d8fef7442b227f, 0x415f6ece8b05310e, 0xbc63a4d5a112d73e,
+		0x5129ff766b33a0eb, 0xe059904fdc0e5ad1, 0xe7c57c2dee10c454,
+		0xd4396c9f21ae2f85, 0x907d09d6c23aa7a8, 0x801c89d15a756207,
+		0xbf09eb8207656fad, 0x81afeb4bedc863c3, 0xd0fb0e01ac06a23b,
+		0xf0fe0b9b7ba139d8, 0x36f780e62851e02e, 0xdba10750af04e494,
+		0xae46cd76e308223f, 0xca2111e0203957a8, 0x564b7b9979f310c3,
+		0xfaf3d92a2564552a, 0x6047b6bfcbc46e40, 0x6d51e15b3d014f1b,
+		0x06503ca48d8a9e36, 0x3729bb743eab4a6f, 0x859a9a220119a92f,
+		0xfe4fdc05c193bbe2, 0xf1e9ea16105e682e, 0x43f5b98cf0ac7d40,
+		0xed1c62514763dd7d, 0xce175c32db2c7c46, 0x72a4993162bcb585,
+		0x0cc8639e8374cbd3, 0x567b8fc90824441b
+	},
+	{
+		0xe3eade7ee16c3afb, 0xf28f5ee1eb3488f1, 0x0118df1c3af5b972,
+		0xed06aa5278acea03, 0xa535af0196579abd, 0xd55c37aaf5ac1288,
+		0xf67e7ff2f0b4ca94, 0x1c9f06e138cd7d03, 0x96c3fc3c4335ff76,
+		0x2aead25e1abc7ad2, 0xd20ce87cebce958e, 0x71484c328dc17da6,
+		0xd63c847e81cf16b7, 0xe3aaee012ce8c6da, 0xe9297778731ebbe8,
+		0x27cdd168bb56f452, 0xff8b124578ad82d2, 0xe3e7c7105b044113,
+		0xec6bcfb3ee5ea8c0, 0x2d2628dc00584b6b, 0xd375553e67ff3bc2,
+		0x7c7429b2dc54696d, 0x35d4f8a8566607ce, 0x667ab46b718a24bd,
+		0xf3ca9763bebf9e93, 0xfeb65be13139d6b6, 0x7a41c1c170076c0f,
+		0xbaa98991aca3f28a, 0x790e7a7e1031393e, 0xb72b73ad0355c6d6,
+		0x59ac7fd07839c0ec, 0x8a541e222842e49c
+	},
+	{
+		0xc7d5bcfdc2d875f7, 0xcfac2f694bbc677a, 0xec5f981fdcf16dd5,
+		0xa0780b2806c46920, 0x6c3f920c97571e63, 0xf4f311657c0bd247,
+		0x51d57c42f561f299, 0x559f9696598c7404, 0xfaf79a32583530b0,
+		0x646138b36b60d428, 0x3d0d9bab8ce09317, 0x43bb6f5daaec64e0,
+		0x901615a6e318dab3, 0x43f07ede7d2de01f, 0x693caf47e918a872,
+		0xb6c15a9b5a58150b, 0x3d15a7d24ff7469e, 0x7ea727cec92426ea,
+		0x2a387b566072319b, 0x6c13e5bca626f732, 0x9aeb4dc5dbf7bf96,
+		0x049c107c1270e570, 0x87243bda4a6d90d6, 0x7d14336975c28734,
+		0xb76a24598b2028ef, 0x0dd79e0e95396a52, 0xa3397b0951dad342,
+		0x7347547d1e3449f2, 0xc91aa6f395faa609, 0xa99084ce85cf70db,
+		0xea4924fecf0abfa4, 0x14a83c445085c938
+	},
+	{
+		0x8fe42ba88595b589, 0x8109506acd6f9725, 0x36b489e839cc11b1,
+		0x3d9775fd0e2020c0, 0x4a359cb5bba86a45, 0xa0594f6a2cf2593b,
+		0x4c53874e43556aed, 0xf2baec53b54815b6, 0xcc7aab7e579106b3,
+		0xdb7c6ec7b66eff78, 0x89580ee0441dfaee, 0xe3aed2667ae9cf16,
+		0x23afe3750505185f, 0xf7ee0700ae12ae91, 0x7cfc12aba8904018,
+		0x1cf6c552eb4ad4a9, 0xd19ea3957166b3ff, 0x7c21f4a584d45d5c,
+		0x70004bdca5de249f, 0x34b014f79ff77d11, 0x54dcbe80849a3e03,
+		0x4698d6f116ab2d43, 0x0edd13d6cdbba621, 0x904f361b7c112567,
+		0x6547d701e6e866f2, 0x133722f39735d155, 0xacabaaa0fe6a51a1,
+		0x24e54ebad37651d0, 0x130c36f672ccc8d2, 0xb5809ab2fe63c964,
+		0x8426eac622d9a83e, 0x5038ac7fe9e94e64
+	},
+	{
+		0x1fc857510b2b6b12, 0x0212a0d59adf2e4b, 0x6d6913d073982363,
+		0x7b2eebfa1c404180, 0x946b396b7750d48a, 0x40b29ed459e4b276,
+		0x98a70e9c86aad5db, 0xe575d8a76a902b6c, 0x98f556fcaf220d67,
+		0xb6f8dd8f6cddfef1, 0x12b01dc0883bf5dd, 0xc75da4ccf5d39e2d,
+		0x475fc6ea0a0a30bf, 0xefdc0e015c255d22, 0xf9f8255751208031,
+		0x39ed8aa5d695a952, 0xa33d472ae2cd67fe, 0xf843e94b09a8bab9,
+		0xe00097b94bbc493e, 0x696029ef3feefa22, 0xa9b97d0109347c06,
+		0x8d31ade22d565a86, 0x1dba27ad9b774c42, 0x209e6c36f8224ace,
+		0xca8fae03cdd0cde5, 0x266e45e72e6ba2aa, 0x59575541fcd4a342,
+		0x49ca9d75a6eca3a1, 0x26186dece59991a4, 0x6b013565fcc792c8,
+		0x084dd58c45b3507d, 0xa07158ffd3d29cc9
+	},
+	{
+		0xc0857045f37eb8b9, 0xf31177b615545da9, 0x1d16c1f296649484,
+		0xfefd3a7d209ab3ef, 0x2ff19c3cdc398adb, 0xaca315067c5163c0,
+		0x3a5b172899f24219, 0x135abfe57aa5baa7, 0x7052e21c3a3aaf18,
+		0x501504f18026f220, 0xeef9b418b312b62e, 0x73b58cff01e33d5f,
+		0xc6e88122160c40b5, 0xba7a4cc6559078fe, 0x2ff395679a48c8f8,
+		0x880941aaa2a7a2ad, 0x2efe3d0fd1352f32, 0x29eb016b1a6488c6,
+		0xd6dbee2205ebecca, 0xa63291b3ed1dc94e, 0x1853744017d4267a,
+		0xb4e6c31c92d1359e, 0xdd2aeeadc4eb8b30, 0xb5a12ed30260b630,
+		0x66b63bd67a1a7a7b, 0xa37f492265dbb32d, 0x758662a3225e6b4e,
+		0xe903b3e4c590473c, 0x08c27fa1145e7dd1, 0x47bf3b1d58a0bdbc,
+		0x78dafad441ff531e, 0x1c97fc633421674c
+	},
+	{
+		0x810ae08be6fd7172, 0xe622ef6c2aa8bb53, 0x3a2d83e52cc92909,
+		0xfdfa74fa413567de, 0x5fe33879b87315b7, 0x59462a0cf8a2c780,
+		0x74b62e5133e48433, 0x26b57fcaf54b754e, 0xe0a5c43874755e30,
+		0xa02a09e3004de440, 0xddf3683166256c5c, 0xe76b19fe03c67abf,
+		0x8dd102442c18816a, 0x74f4998cab20f1fd, 0x5fe72acf349191f1,
+		0x10128355454f455a, 0x5dfc7a1fa26a5e65, 0x53d602d634c9118c,
+		0xadb7dc440bd7d994, 0x4c652367da3b929d, 0x30a6e8802fa84cf5,
+		0x69cd863925a26b3c, 0xba55dd5b89d71661, 0x6b425da604c16c61,
+		0xcd6c77acf434f4f7, 0x46fe9244cbb7665a, 0xeb0cc54644bcd69d,
+		0xd20767c98b208e78, 0x1184ff4228bcfba3, 0x8f7e763ab1417b78,
+		0xf1b5f5a883fea63c, 0x392ff8c66842ce98
+	},
+	{
+		0x0000000000000001, 0xea8d71a575535597, 0xea2dd9e76705faef,
+		0xc66ab683156a951a, 0x21d434096aa7e8e7, 0x4a3aa20f90b3ad36,
+		0x64d87c5d13f85d70, 0x1c6188d3e7f179fc, 0xcd6fa1b9d1c931c4,
+		0x0e8b93f735e7de83, 0x98f3cab1b54367fb, 0x612ad6f88f696992,
+		0xe39d0ca9df7aad44, 0x7c9aa2dc235c5269, 0x96e9c05702db30a0,
+		0x6725b7c9e3aa2c65, 0x3dff83475e9c40fa, 0xb6d799ae131ba4c2,
+		0x5160dbee83b4e019, 0x11c79404a576605a, 0xf400a3490bf94812,
+		0x0bb3bd1659c81294, 0x1b7a4a899da18139, 0xb01eca9292ae3dba,
+		0xcfd4f5920da0ebc8, 0x106ae64c32c5bce4, 0xaeb5f78671cbfb22,
+		0xfdf44159c4ec64dd, 0xd6fdb1f77598338b, 0x3b399d747f23e32e,
+		0x36f0255dde973dcb, 0x0000000000000000
+	},
+	{
+		0xc7bf0bba9738d4b8, 0x46048b33f84c458d, 0x7a2cc20f37195d89,
+		0x93d1d5520cbe7723, 0x4f7a3b322f8c7cd0, 0x43a74244c17bff4b,
+		0x053f72c8294a152e, 0x74dc3254325d3df2, 0x3a2ac7a851b80171,
+		0xc01a0b31cf1af441, 0x40152767a44a53df, 0xe791b7f72ed49b1d,
+		0xf110bcac6355d0f4, 0x5e5d4c2bea464998, 0x291a417a6c8e8869,
+		0x5c7e5f2319f2914b, 0xc5c714a78d4eacfe, 0x5b308dd337b1ffeb,
+		0x7b2ce9241665b8d3, 0x749c11640b3a7b31, 0xd841e2e56b98b15b,
+		0x4a152deecd89c953, 0x59f6497a6a0f59ed, 0xbde0c90bd87bcdb9,
+		0x28b0c06b57bd2cb0, 0xbd649d3144d887da, 0x25fca73f2e29cd92,
+		0x8d4a16cc9477feb3, 0x39c1eb155edab85e, 0x276c76f23468b7e5,
+		0xfca696084ed029f9, 0x5f5966a556277452
+	},
+	{
+		0x11362c49dfc234ae, 0x579795adf1b99942, 0x00d77040f7afc757,
+		0xdc54f56bc06e5050, 0xe270c22a584a236b, 0x34a0fa652e631ea3,
+		0xbc21aa6c76a26b96, 0x71d1f0bce8626498, 0xb68b92f4132ef0df,
+		0x259e3131a282b4b9, 0x617cd9211c6bee0c, 0x08a4f7164b53feb8,
+		0xdb78c92c88275520, 0x0e3a4e2569d31770, 0x1a660b133d0002f2,
+		0x7c8abf0a1b347003, 0xd1178009e88f3415, 0x8191463473593ae9,
+		0x74adff27eeb847f5, 0xec3326d4dd254b61, 0x179b6763955e4b33,
+		0x86e448ad19001af5, 0x662fcdc06d0ad93d, 0xc23643415ac5a1a7,
+		0xee8cc0842bea8e78, 0x5364354646d6a18e, 0xaa0509830b0cbbd4,
+		0xa3d0662af9cebf2f, 0x2cfc83b12de5f8b8, 0xffa1a152a83dc49d,
+		0x104954baa2fa017f, 0x2ea4e188a4249071
+	},
+	{
+		0x8705db232b8556a9, 0xec789f679baa6223, 0x9b71114a725008b3,
+		0xf6ab465a82a871a7, 0x21d769409031fe6e, 0xd9722b7bc3bbc9e0,
+		0x430fcc02c5625ed1, 0x3dc4dd56f8ac517f, 0xae1c027c2783d639,
+		0xc436298aa365d26a, 0x630d1d329f3c3763, 0x5d4735e1bbc4c495,
+		0x12b6b5f8e619ef97, 0x52a857d4f1624acb, 0x249b1b30f5ac677e,
+		0x89ebc5c4cbd4239a, 0x23418ece587e9bfb, 0xc077d3b387dbb17e,
+		0xe8a9b16c549d37fd, 0x21eed291030b936a, 0x59e3f11499447801,
+		0x4a05b9318c4ddc4b, 0xe44d196a58bd7259, 0x44b36f3e873f343e,
+		0x34f5004944b4cdba, 0x74eebb1bdae330e0, 0x72fcfdfe3a680e80,
+		0x081f5f9c7c298399, 0x3f65131e5f405c99, 0x66ca8a918e4a5650,
+		0x050d74d7d468c151, 0xa6114d164ac10d6d
+	},
+	{
+		0x78978eab2ffd552e, 0x70f2b087d58bbe36, 0x115de70f666c3034,
+		0xc8338c71bd00c8aa, 0x56db4842ea8ba887, 0x16c1a792fe843298,
+		0x5a02c8fbc733bcba, 0xd2987f35cbd8e779, 0xb2d6e9a88fce89b2,
+		0xe69f8c0fad400c5f, 0x42e142ea68042c46, 0xdedbe82ba4c017aa,
+		0x0418905dff46d5d7, 0x2b429fa1a6af687e, 0x3612fd94df098fd7,
+		0x30b0e9d48187bfa3, 0xd2d496ff477a26f7, 0x28ebe4b14d87e446,
+		0xb80ef4ce75630264, 0x6f3120c3702af5a3, 0x74b1e7cfd16b614e,
+		0x7fea63152af9c7d6, 0xf7cc2bdbf0b25af9, 0x32a53be0681fc38c,
+		0xbab84178ba100d4e, 0xdd306db9e01a7294, 0x8ab8a4824947c382,
+		0xfec3ad4bd6dcc8aa, 0x94e75c6de0a9f32e, 0x21731b0f00bac6f5,
+		0xecc061b884ed81a6, 0xc55dd746c157816f
+	},
+	{
+		0x855e984fb3ea3645, 0xb1d2153b376e7963, 0x30eb46bcf2443d1f,
+		0x209dbe137fc353f0, 0xba9f039ff325bcd3, 0x4ab06de0f7f2f6d4,
+		0x2a3a21a3ff8db979, 0xc236d5037069efc7, 0x7518c8aac3f968fa,
+		0x8f36a4570cff3a25, 0x3f458c56cd30d463, 0xd18875a75477cdd5,
+		0x20a4e3a7c74b7863, 0x2a666d064ed8d6ce, 0x22e48e8efb70e56f,
+		0xa229ebc28acc74c5, 0xe07e246a0c2a14ff, 0xbe5a446ba189a621,
+		0xe84bf112ffb4d5b2, 0x3d1d13862b075a59, 0x980023f190a44d08,
+		0x8c724b8022d7c5e5, 0x2f99a57a7e62edbc, 0x559074e0640e1864,
+		0xdd96c7c956d088c4, 0x378736f8fb833287, 0x97b2111115e3262e,
+		0xdc490a8433389ca5, 0x378ce4be49cc3f43, 0xe1f6c5af89513fb6,
+		0x33a6b078fb2a4a51, 0xca37d1ee00d813cb
+	},
+	{
+		0xd1958e47fb512bb8, 0x052200f966a85d19, 0xecb155b8039bc0bf,
+		0x1892f39baaa2a86a, 0x9bd32df11aed3ea2, 0x8733e4e720d2cc10,
+		0x27d62cb1db68fc1d, 0x224e227539cbf6c6, 0x3917a6c253940f28,
+		0x4a0359e93e496d66, 0x024147713a3a4f68, 0xf628d31d77223a75,
+		0xf712584f112dc73c, 0xed847ac2425e9d81, 0xee3e875e23ab2c09,
+		0x91f409f39357c20c, 0xa7247fbec14b1828, 0x2a526133d05476fd,
+		0x169473f8e9df02ff, 0xed892c5fce0deb25, 0x41723841cba7581a,
+		0x7d8aaf9f729efee0, 0xbd7fa51a0da323e4, 0x7feafbcbd3a1af7e,
+		0x6ee636de29920a8c, 0x0f684a8b11e6f77c, 0xe7b3fcf3a123d3c4,
+		0x5cf0506800d72206, 0x0f05b79c366b3831, 0xbfd9d8fe4b9b53ce,
+		0x258f0fb940dff0fd, 0x95e68ed1eed8e356
+	},
+	{
+		0xde552a22dd838932, 0x48219fb66efded7a, 0xe3fada4f3fff0938,
+		0x48c9dd3ea3c83fff, 0xe14af5b644bfef03, 0xa2318b89e55a3cf9,
+		0x61f976a74fc896f8, 0x8133ccfa23f57c30, 0xd471a293a1d9c043,
+		0xb6a55d8f59143d52, 0xc1b096ad495497d8, 0x480f3174b330f797,
+		0x58593e8ef62905a8, 0x5e3f7fcd396e2289, 0x062699c97e3fca4f,
+		0x4ca4f01ea8d02924, 0x699e3007928f4a74, 0xb4bb87c336da2ede,
+		0xba07b48f9000a1c6, 0x550ea1d89792a7aa, 0xd3bb32a04f300fd7,
+		0x15109f9218855fe9, 0x066b50c603ab677c, 0xdcdcd80b8c20257a,
+		0x0f702cb690a9b6ef, 0xd7c9b579bf07e877, 0xed1efdd115515df4,
+		0xe1270e7aa2a54086, 0x2b1895a97838a44d, 0xac5e6e921ef65f8e,
+		0xf7e50b626a0af957, 0x57f5ca112c734add
+	},
+	{
+		0x488af72e68724744, 0x5b7d13b94bb5e2b8, 0x31005412a83a3b16,
+		0x0f27ab4a7f3f49ad, 0xa5ab860f60f7beba, 0x2ce9cfff23f9c3b8,
+		0x56ef7db814cc0584, 0x27c8d05d75556467, 0xfd94169f5ec8d1e9,
+		0x7b1023e9f40d9d6f, 0x37a9fc16a55de923, 0x122692893f0989e1,
+		0x2305b1f1a5d1fdcc, 0xa7357573681030ad, 0xa9f5cc04b187e612,
+		0xb8aa39f8f15e867b, 0x9e53df427b0f01da, 0xb95eed9f4fe55164,
+		0x81f6e6b58d807b9a, 0x54d9ee71e80fa3d0, 0x331ab86940c47cdf,
+		0x599b5050de075fea, 0x6107b747e822b359, 0x8ab191c25cb32a6c,
+		0xbda21d9effbf2178, 0x9ea0a49f49b5c222, 0xa73eaddd01a0493c,
+		0x225056e15c4f6289, 0xe967ced7efab9e6d, 0x6436d35459471a3a,
+		0x425ff83042177002, 0xa879aa97872c1fcf
+	},
+	{
+		0x85db9aaa85cba003, 0x848ff9365d0fa28c, 0xd675df043044e3a7,
+		0xa493f7fc1f22d009, 0xbc36034ec332e691, 0x102980f4af854314,
+		0xa8ca859ac11aef15, 0x9d098f210efa68da, 0xb06a6159343e291a,
+		0xb3e764472dfe799a, 0x7b27c3a6ade2b171, 0xbee3b50ef02f9bba,
+		0xb1c4c3f4c54d885b, 0x75a18b271ac5fedf, 0x6b3f0a01534d6115,
+		0x5d6a62b119aa0f08, 0x2968cca2846247f4, 0x699fde817cbb872d,
+		0x3cfe23782f4d546e, 0x398b7f7026d2d7aa, 0xaf8c0c61029b30b3,
+		0x9f0fd805db20e806, 0x2e29240133935ef1, 0x07dcbe615d592f8a,
+		0x6410decdb02ca3c9, 0x5001af8d9a81bebf, 0x39feedb472bb2a2e,
+		0x34ca41acce37b376, 0xd445bc6a7c21d970, 0x25505f33acbde35e,
+		0x5699299790bb97ca, 0xb8372c26d37a47d3
+	},
+	{
+		0x9e9cae29a7cffc09, 0x80339c72caa9ec9d, 0xc411a274d550de52,
+		0xe8ec9af5ffd8f8a0, 0xb1c2edf971e4bc27, 0x4d043c9e0cee5c50,
+		0x4a705148ff97a787, 0x65a4d6e1973e04f4, 0x4daea6449ce3faa4,
+		0xabcc141e78db83cb, 0x703bc6ebf1526888, 0x5205ff5d2375d29a,
+		0xdebdfa7316acfa91, 0x1ebd4d0b8a75a351, 0x1fca5228cea77d08,
+		0x53f3f4c4961f0ad7, 0x05da236c75570d8c, 0x0d4635e988c8227f,
+		0x76b2c3c0ac95bece, 0xa8962df7828a6949, 0x14cb03d27f833840,
+		0xca673cd26d194ee2, 0xdbabc98afb53b51d, 0x6e8c33534f7381f7,
+		0xa8d2396ef028715d, 0xaac0aac7bd8c10a4, 0x308d66b12e13340a,
+		0x8eda1515d1663c19, 0x4fd90f2504e4377b, 0xf8d97f3ca1ff61fe,
+		0xc631206ec386375f, 0xca047a6ba87639b7
+	},
+	{
+		0xb7bdc8333df6a748, 0x22fce0c8da6b91ca, 0x0a3b2dadbf950edf,
+		0x18c4871eef3505ed, 0xadf5648764e03338, 0xee6b2a60573b2df4,
+		0x609967908bcef073, 0x73b4b9fa2e9c739a, 0xf7999bd8421ff928,
+		0xf2f1c4c71bf6f845, 0x622810b4d47990c9, 0xbb747c071becbb30,
+		0x87d10b046911d18d, 0xf03eec29620e4ad6, 0x8bd6e3f43b4a38fa,
+		0x8342061c0481affe, 0xdefffef5ea4fbe97, 0x98b7a6fc185ac34f,
+		0xb111f35d3f74ce29, 0x07ee7719cb9552cf, 0xc1bcf9e94bfab39a,
+		0xe59f6f92dce58903, 0x84e499fa4622878f, 0x47d58817f712c6a7,
+		0xb52844adf1976ac9, 0x7d66309ddb52ded2, 0x62f73f9275981e76,
+		0x62ea69ee507373c2, 0x0eee2e76c98c85c4, 0x821bc2d467774d15,
+		0xf7cf96ea4613cbea, 0x85ac3d65d6c24e98
+	},
+	{
+		0x2ab4b6c6f3527610, 0x7ab8bd3434562a53, 0x9906a113b5eaee01,
+		0x1025b1a7f21edcdf, 0x8bc6350102afcd3e, 0x55ab37235ad99d00,
+		0xb29fb9983c937717, 0x16626006ada631d6, 0x21d92a4ee814cf35,
+		0xe6dd479187c62879, 0xda1b88bb0c24eea2, 0x1402cbadf8f03748,
+		0x2f13be813d05c24f, 0xcedfb9fe0a2fbfe1, 0x0e01c697bb4fcfb5,
+		0xd5e306cc7bc9447c, 0x80dc4069d8d0983a, 0x4115fc1744ab7777,
+		0xa86f3dbd81faf5cd, 0x7607419e2f69d7f7, 0xe8a6d9722c47496f,
+		0xc29b9d1eaab7aee8, 0x7ab0af37b671bd00, 0x07d89320642678e0,
+		0xf0c6cecc23283d5b, 0x4b18869fd642f032, 0x2c53b17496bf5d00,
+		0xdbefb8bfd4c17941, 0x333de724e0fb3191, 0xf5592a7268857dc6,
+		0x4f7da06a2d95eab4, 0x4abe90b593bbffc6
+	},
+	{
+		0x07ed82ef2d2d7a8f, 0xde3f9c62dd76d9e7, 0x9206b13c3715a20f,
+		0x75acbe1aa68d06f0, 0x192540f5aa6d218e, 0x25b4e33d13025c67,
+		0xfa6d8c3fced947d6, 0x512b5eb08b685087, 0xf9743c58ac0f5519,
+		0x3f1e836294e4d9e6, 0xb1b94079cd6d78df, 0xb28011b48785fa13,
+		0x47fd4cf42533d768, 0x525c7c38f6492542, 0xd15d7a0bd32ff5d2,
+		0x138b1256d6c34c8e, 0x662f457551204fb5, 0x7d315001f89c9341,
+		0xdf6e56def196d883, 0x206c225117dd7a56, 0xa0d9e1880410a609,
+		0x80677fe6981b1779, 0x3ac898c5fd528218, 0xbee4057600a341d9,
+		0x3af1c577a16c83b5, 0x03f8835acebb440e, 0xe92f76c5ec806690,
+		0x7d038e277c29ca09, 0x7f04650dce109769, 0x8e0d2ee09d71327d,
+		0x9e3b98e1968ea333, 0x40e5921756f4f13a
+	},
+	{
+		0x11dc928e9375f68a, 0xa12ee9296877d7b9, 0xcaa5a563596c6b89,
+		0x2a3d9980aebb0e02, 0x2c6e0aa3c1cbce56, 0x4e54219296be36f3,
+		0x44ab6058cfc20a9e, 0xbafb0a1fb58cfd21, 0x299f1c9aa8f0bf88,
+		0x05a3a9820106f75e, 0xa82d9ae8d5163a9d, 0x3547fb5be6741deb,
+		0x36714be2d127a050, 0xb4f76ab654e7633c, 0xdcbfad6aa25778cc,
+		0x4c4a6eed73511444, 0x51710beea0b000a8, 0x32d6d60d18e9751c,
+		0x7e2eee086bf73b7c, 0x8123d78bd03a6b7c, 0xd1c35bded35d71c4,
+		0xdb01bc7d83bd560e, 0x7e474c6978ef010b, 0xb1a1e84f0b915369,
+		0x248f5841c35e25eb, 0xa2f05df65c4988f2, 0x5619500371b2750e,
+		0xa3d5189311d5f507, 0xf0dbfbe08ca3903d, 0xe920971851eaa3be,
+		0x8d714a9be93968c8, 0x49810b5dc934f128
+	},
+	{
+		0x5e3a597c9c2ecad0, 0xa85d9227e3206977, 0xb1214f93a03b6154,
+		0x31d5d45a1a1ac6da, 0x3cc4a7c58acd7f03, 0xc2a35474c47eb08c,
+		0x2736f8b2ef750da5, 0x2d0c1e828a769cbf, 0x28ca089d2bdf103c,
+		0x91a46ee1a6611138, 0x161eef7e6190ab30, 0x61fb11d8420ec227,
+		0x310a778be589de15, 0x6fa58f17a20f23a4, 0xc1dd7e91546642dd,
+		0xaa9bc42f3c3604e7, 0xbea2d15bee71484a, 0xd60144ae46081aeb,
+		0xbfa177c5ce872f5e, 0xe3a3f46d962c1ab4, 0xac71e440f26f48bf,
+		0xf1f56b2e69c0bfa8, 0x79f3f42658de70d4, 0x4d5b0afc55d9c1e3,
+		0xb3b1d0c66da64e6e, 0xd8191db150f4a252, 0x8a579b2d84234163,
+		0x8ed895d05d4ff1eb, 0xeb89191c632bfe96, 0x599eda2b7156d525,
+		0x87ba093d0fe2226a, 0xc653e077850d2d24
+	},
+	{
+		0x0000000000000001, 0xea8d71a575535597, 0xea2dd9e76705faef,
+		0xc66ab683156a951a, 0x21d434096aa7e8e7, 0x4a3aa20f90b3ad36,
+		0x64d87c5d13f85d70, 0x1c6188d3e7f179fc, 0xcd6fa1b9d1c931c4,
+		0x0e8b93f735e7de83, 0x98f3cab1b54367fb, 0x612ad6f88f696992,
+		0xe39d0ca9df7aad44, 0x7c9aa2dc235c5269, 0x96e9c05702db30a0,
+		0x6725b7c9e3aa2c65, 0x3dff83475e9c40fa, 0xb6d799ae131ba4c2,
+		0x5160dbee83b4e019, 0x11c79404a576605a, 0xf400a3490bf94812,
+		0x0bb3bd1659c81294, 0x1b7a4a899da18139, 0xb01eca9292ae3dba,
+		0xcfd4f5920da0ebc8, 0x106ae64c32c5bce4, 0xaeb5f78671cbfb22,
+		0xfdf44159c4ec64dd, 0xd6fdb1f77598338b, 0x3b399d747f23e32e,
+		0x36f0255dde973dcb, 0x0000000000000000
+	},
+	{
+		0x0c77e940153c88e4, 0xdbf7325a4c763a84, 0x5ef495228f01df8b,
+		0x2d415f11fea10020, 0x0dc0b7dcc5e281e0, 0x2dae66fca66a866d,
+		0xa1d5280a795937cd, 0xbd1902a7156bb232, 0x8852e9731f0135cc,
+		0x89102814defa4719, 0x1e1263a5458fb584, 0xeabfaa9f2bda8a24,
+		0xb48e59cdf62945c1, 0xb9455470f1649376, 0x2fcfe779414a159e,
+		0xe3d625d9c33be6c4, 0x17c378f4bc3d0976, 0x35d2abdae9a9a399,
+		0x46ef262c04508b47, 0x2de5ce50dc0af79c, 0xbb56b16fc44ebefe,
+		0x3980fdb9a255f42f, 0x3e1dc93624775697, 0x72f2b32762d1616e,
+		0x4a264a0d409601ab, 0xeee861692a8d0d18, 0xeaf43786b7772d57,
+		0xd4f674bac91930ba, 0x501bd1bdb52592a7, 0xf4bf5762a42168c8,
+		0xeb4c38da482368fb, 0xe6a89a4a46c24d45
+	},
+	{
+		0xb1a7dbc29924c1c2, 0x27b7923bc740ef59, 0xb422787453d90e57,
+		0x25529d9551b82567, 0xede0ad6361902f00, 0x1ca6b1fc2dc88b7a,
+		0x99abd14fb8ba8946, 0xda8107c3d42a8307, 0x6918977ef98a1538,
+		0x171a777679eca688, 0x9c477762710137b0, 0x2b41aad24418990c,
+		0xe76b1a2955e4dbb1, 0x403c6abb52994734, 0x7b55072b3bc07cf2,
+		0x18d7917836e9321d, 0x029b7ea224c1b9a1, 0xb425d561b8b0c2fa,
+		0x40dac66ecb8f4a42, 0xf9d538cab6c67fa5, 0x94e39f8a6fa3bca2,
+		0x40a2e7889b9ef0e8, 0x11e7de90c864d9af, 0x27807398ceab0168,
+		0x9d520e20ae605cc7, 0xd38bc1fc1c7f6f76, 0x5f577649c94705a7,
+		0x88a2ce84dc874d0a, 0x85a4c52911f05c17, 0x7c8f826875828239,
+		0xcf15b4e06a8f9c2b, 0x0252466535dc3de8
+	},
+	{
+		0x0d12907baf552d66, 0x9f9d74e2cfc86df1, 0xc365dd361ea73717,
+		0x70122d75d0dc47cf, 0x901c09b718cae8ae, 0xf42ee78d6cf7c829,
+		0x315306fde11129cc, 0x104968f62f3a08e0, 0xcd2ef946089973c4,
+		0xfa6d8e46ae071ea7, 0xbd499471be6c1b4e, 0x834c8b0bafe0ab13,
+		0x54ab5c23fc40e1b9, 0x6f3078d73dbd0d6f, 0x9a85f9c1884b672d,
+		0xc6b7ac65b519877b, 0xcb83185dbc8cfe4d, 0x426912322a29e2d2,
+		0xef28f05fee65087c, 0x82c9f89fa824f230, 0xe9f169cd65dc6e7b,
+		0x19ce59f2b32d535d, 0x307cccb961b8835f, 0x2d8ec0f7883b89e5,
+		0xc6b37727be2595ab, 0xdd463094adaa8351, 0x3a36ce6a19d8bd75,
+		0x55b71d0b4a0b9176, 0x5542636c8b5d8eb2, 0x55e9af7a416d683e,
+		0xe277030c59f0d143, 0xdc5ec8af0af606b2
+	},
+	{
+		0x768a927bffeb039f, 0xc6a253a7a4c4530c, 0x130cd64f05d490bb,
+		0x2fbb168ec9b37d3b, 0x011e54a3959af135, 0x34cf9e3395f5896b,
+		0x9cb56ceae882a223, 0x28941c0057bf462f, 0xb7804bfa0a283416,
+		0x1a96e397a628a304, 0x5b4f19b724bee459, 0x15d5a643d1a6488d,
+		0x7689bade83f21980, 0x6b1cfcc3a034e3a1, 0xa43cfa35630f24af,
+		0x2ca013eebc5a2d83, 0x11217c230b4c78bc, 0xe286bc053a3611b9,
+		0xb93fbf612d73fe00, 0x0bcc559f09edb4e5, 0x79d1c4df2e17f576,
+		0x57dffb1f3d65c35c, 0x54e42972f41c73aa, 0x4f7654841ffbb515,
+		0x6a0fbb3ee371994e, 0xc0d0164ae17a1285, 0x02d3bdcf3858ed36,
+		0xc054c816f6e41a5c, 0x1a751f6139367d8b, 0x0e0da442b1cc6f55,
+		0x52530e59193db6db, 0x42e61cd5442b6cb0
+	},
+	{
+		0x2ca3b2eef76f20eb, 0x240fb3f7005f6adb, 0x04767742895ddd44,
+		0xd1f028148bb3fef7, 0x1be0a50189ae8cee, 0x7e28bce16f6e4772,
+		0x90038d4a77732897, 0x676f1f1bc87c0f65, 0xd2a555808c149f04,
+		0x99d47bb5ae7ac884, 0xbfcab13447bf2e9f, 0xba23a261ae55bd64,
+		0x26386c8351f37781, 0xe7342922d65e7737, 0x1873fc8489de16f5,
+		0x932046ad25424ba6, 0x985bb7777b587a6c, 0x24b8886102d3526c,
+		0x4bb473ec05447e04, 0x9818505f13a7485b, 0xe7039e635ec55e42,
+		0x441c8f64ba27eabd, 0x0a4cb0d2bff43536, 0xde6f59d84667ed4c,
+		0x2c393602e426ba63, 0xfc0ff8c55e354162, 0x19101ba8468b3df1,
+		0xd357ababad806286, 0x63c72a96c998fbec, 0x6579bd079530e109,
+		0x4b37d37bc7dae5f4, 0x0efe5f9463a36f85
+	},
+	{
+		0x25f01f7d90f72df4, 0x1651544c832fcba8, 0x4c0b9386553ebd3f,
+		0x2d24339d98a24796, 0xacf8e2bfe06e43bd, 0xdc1e298dd0999a33,
+		0x11bfd8fd14201342, 0x43c0d71f0154164c, 0xa0486833c863d36b,
+		0x04d6506f6ac98039, 0x4efb1a365ea9697d, 0x7d574aa98bb902f5,
+		0xd2bf78bd52e412ce, 0x0c90c0ab6229f8c7, 0xb3b34b284e990bae,
+		0x2c7ee83a29e5dca6, 0x7b4ea1de0fdbc508, 0xa4614e0398ea8d86,
+		0x5fbb7f3afc86c2dd, 0xff6b766cfeb38dce, 0xccf59e3c654a8cdb,
+		0x73a1523990ba4463, 0x910affaf1b6d1836, 0x3e1e7d4af27abd07,
+		0x7c891e4fb13fe118, 0x1fd4215f8b77162b, 0xf04fe901a5998d3f,
+		0x3eedd38002347e17, 0x28902babd31db335, 0x3ffcf1ed3484770a,
+		0x3bb1c1bfb55557cf, 0x9bd7a10b06e49349
+	},
+	{
+		0x1067a3ae36a60674, 0x9dcc723145575ccc, 0x7694b3bbc19c8877,
+		0xeea3158b522e6149, 0x229ce5255a516d0b, 0x6e64f64f0b60ff42,
+		0x185dc296772210a1, 0x426f4eac470e8150, 0xf83546b27ecd5342,
+		0xf9e266727d214f1a, 0x64876093339873d9, 0x9867a1ecfe066a3e,
+		0xf90428291adf44a6, 0x7f50d253e5b80e78, 0xc4af88a2ff519888,
+		0xa209c58cb337d60c, 0x2d5f51436bdf2cf5, 0xd8661abdecaf49a4,
+		0x12b26f5dd2b30686, 0xe87f8cd7a1154c49, 0x59b24dbec24c66a1,
+		0x024443b10ac0de94, 0x27bc04f014e69986, 0x31fad8e650e3b53a,
+		0xd5a1f98f57db8b5e, 0x7b6c27c513237596, 0x12744468c1b1580d,
+		0xe441ef000207a6bb, 0xc335bce1c27ffd27, 0xc97186019d949436,
+		0x8915130154ccdc35, 0xeb71de04cf0dea14
+	},
+	{
+		0xc1343b4b8b6eaf22, 0x8cc0fbc270a0c506, 0xa424b5d3b31de017,
+		0x890ab8288f6af552, 0xd2e3df9c1a8bea10, 0x0634967ce50396fe,
+		0x1b77f144049794ee, 0xd6196dbd0ca27fff, 0xb1e7e2eb2c418c9d,
+		0x6d02393b13fb3047, 0xdd71110b0e3ca48a, 0x6ea38592985d5fc9,
+		0x19b6455dd8071b67, 0xb55362ff169e27f9, 0x9a1a17f1bf461a40,
+		0xa1997f1dd7d26070, 0x866d6073bdad7269, 0x775e04b40ebad08d,
+		0x008c0b991d04dbfb, 0x0028ec0655d77531, 0xa6154d35f2086389,
+		0x26f6f9d1aaf84a35, 0x9a7fd707028f4c84, 0x564acc581c099dd0,
+		0xdadf5fd99e36e555, 0x45f45f04017b8307, 0x94081d1a520b18de,
+		0xedbda552a392b7a5, 0xcc9a447fafda1453, 0xd73df9bc3389c4c7,
+		0xe3432d8b53a56212, 0x56befffaee0d58da
+	},
+	{
+		0x43073ca2de775482, 0x7a70f92c3ff71f5e, 0x955845e9fd0a586c,
+		0x702ab41f5ab8d7b4, 0xe32155508374dc51, 0xe0286d45e4f22409,
+		0x5e0a7564b6afe744, 0x6e8aff8dc5bdb3a1, 0x9649ce6248013865,
+		0x5542885c5fc9b416, 0x79209ab0cfd15b8c, 0xa401e2f337d2ff0b,
+		0xe7ce547bb3922106, 0x7590e919f0451ed0, 0x1729e1ab712f0e2f,
+		0x72af6aeb0fca7749, 0xa91902771502573b, 0x02b403733f631f77,
+		0xdc0cc88de59cc127, 0x480903de8e77af5d, 0x5795076a6b6b8fd2,
+		0x55477dc33b3dcf8e, 0xcd960a3d2bc64b8d, 0xc5cc66a38c6878e6,
+		0x8f2e8e22577e5859, 0xa1aac4a3eb79a777, 0xf4003767078cbf8b,
+		0x1b9370f040939753, 0x9a8692503c3bce8a, 0xac33d0537cfffee1,
+		0xb8b9727ad7c946ff, 0x1021f43890e48d4f
+	},
+	{
+		0x157ebe34b35259e1, 0x6de040ffc989907a, 0x4184983b7c0911b4,
+		0xc04957bdf7eac14b, 0x2384b9a487e7db33, 0x41c6dc2f69c4e9ed,
+		0x87b526d635131246, 0xa06c1f7777641207, 0x4b453e8d9e0683b0,
+		0x01e03820453ce3a5, 0x2f4fb8d5bff258e0, 0x539cb5ee772ab93c,
+		0x8bd825369e548555, 0x6385fbe1d5a618cc, 0x13a7d3dcd73fc827,
+		0x8e12b702817e0622, 0x5a5117609eff4f7a, 0x7efbd4ebde7175ba,
+		0x66119a27a7653ad9, 0x4c91bc7023b53ef6, 0x5d3ffad61867a278,
+		0xe179094141a20557, 0x8e3e241275992d44, 0x46a064611b8db510,
+		0x76802dc504b446a7, 0x0721bc588d786726, 0xcf66b26aea483cbe,
+		0xfdf9905ed6128f72, 0xb887d315330fa0d9, 0x012854ccb294c0e9,
+		0x6ea01e121cf97140, 0x79ae23bee6927ada
+	},
+	{
+		0x64e53496edb49c37, 0x8a396b5c8b7b8a59, 0x7fad1eb97a712210,
+		0x9c9d9b3ed9f70a6b, 0x6785676f7fc23de4, 0x9100c6715a7378be,
+		0xfbf2910be15e880a, 0x1b782c7c24ac3e89, 0x0bec6bdec5cbdfbe,
+		0x917ed9089d757280, 0xae1515e62e0a23e2, 0xb170e57231000e48,
+		0xff557afde67573af, 0x26f6056f42531d17, 0xa3c187eb47ff345b,
+		0xfe93650c4d2edaae, 0xebb890370309ec6d, 0x34a7b7a1c8862f7e,
+		0xf0d0569b67990ae9, 0x85b802fa261ad510, 0x36dbc46407ef17e8,
+		0xaed261d8a799429b, 0xf15f6b3f2c739df5, 0x26a1afeb8c01026c,
+		0x7dcb8634fdede40c, 0x26296c44695f658d, 0x43bd246ee737df9a,
+		0xbeac648373aa9d44, 0x25f8e3792f47239e, 0xbe79c0999d21cc52,
+		0x16ed80e94d8c43f2, 0x3abdebf2163c92e8
+	},
+	{
+		0xe1293bbd98d4b646, 0x075565e359b57023, 0xdb24b31c57528aef,
+		0xcb89f2419fa74393, 0x0363565017ca5a98, 0xf1863a8a4cb4cf07,
+		0xbb605d4dfea7fe06, 0xf9a6410413cf5ab6, 0x60f3c6fd670fc281,
+		0xa151c7966e26336a, 0x45083707a21f964e, 0xc62f76f47acc2da1,
+		0xe48ebffe696fd6ed, 0x3a9113c244a74e72, 0xdd01692d7c1c4fc0,
+		0x58979b0c8f3e34a9, 0xab8b49501030bf3c, 0x6e5d166864fbdbf9,
+		0x65c04be708c9c5e5, 0x8652f07e40df4d1e, 0xdfaa966c85b79570,
+		0xecf2983515541112, 0x5e9aeabba67f44ad, 0xd5831a4158dde78d,
+		0x77240f2ebb5fda69, 0x6208a08e0aeef529, 0x9ce47a25653285b4,
+		0x84477662ffafaee0, 0x61e117fd4bb63138, 0x8e9d69c55727f752,
+		0xf5c014f2cde2ec7e, 0x0a85bffe5b5935a0
+	},
+	{
+		0x672e01077498fada, 0x20a21d62ebc2308f, 0xa42b67be4d44dbc1,
+		0x6ea0f38b53fdaac5, 0x455ca0acbc4c1c1c, 0x5eddaf3dded36c38,
+		0xb67ef4c68b301009, 0xf947fd540994a12a, 0xdcb32d5ae943d7ca,
+		0x6cb93968646279cc, 0xc4e69d9846bb423c, 0xc87421445fbff9e4,
+		0xe4ff8c9e4281f798, 0x19098a3211d405eb, 0x537badf4454a27bf,
+		0x61d3474d215a6b23, 0xc925f2d91feca70d, 0x904a5dcd7d4740ed,
+		0xb8f34f83e2fba7e2, 0x56b28fea6b616834, 0x58fff1000ad51160,
+		0x98d0add6830e38c5, 0xb34a95464e29106e, 0xaf2fa296a261de2a,
+		0x60e8fc890c81e76f, 0x65f5aae0d3fc223d, 0x94b96b8309740554,
+		0x7ec7e91177a6f47c, 0x0dba85d05faf9763, 0xa8c3069d36e50aa4,
+		0x5b5fdf51cb2b43e1, 0x83aa833f1335c4c4
+	},
+	{
+		0x43cf30d6a47cacd1, 0x6067a24d4d5211ab, 0xef9d72574df64e76,
+		0x23b2412db127340e, 0xa80750ec31717e6c, 0x483472e97e2f2f86,
+		0x444b0791aad7106b, 0xe108e96dda1a5586, 0xf70b8c5062d23c09,
+		0xe86b3d101de227fd, 0xabf1ff37f5233c32, 0x1f29566cb4bc8128,
+		0x12069b5c84be8789, 0x82d48a77ac26a7fe, 0xf00e9221636d766a,
+		0xc218d2ca6f76203e, 0x816224970b6ed825, 0x72059a86df45c5a0,
+		0x6acbc987ef32f807, 0x6b13ca9bec20836d, 0x057189e76b06dec1,
+		0x16ee1eadd2b3772c, 0x583c2c9e444aead4, 0x33b71d84952cef62,
+		0xba42f8bcef6741c1, 0x68237ca13120c389, 0xe530a370935c736f,
+		0x134e803ee72fbab4, 0x0123008140588670, 0x3711d29fb9f7debb,
+		0xb60d1dbb91b886fe, 0x86d7addf709685e8
+	},
+	{
+		0xa2dd7d3d109e2c7b, 0xea673629009678dd, 0x38bc4c23f1142104,
+		0x644b6b3e424ee995, 0x4b0554784d6eca8f, 0xddf522ecf48d66ef,
+		0xf4ad8bb77a2edcc0, 0x52912339e5f9560d, 0x0ccc1550616ed84a,
+		0x96ce776cfd0b93fb, 0x59b53fa0342993bd, 0x5f51130c34e01916,
+		0x224ec9fd954ce141, 0x42067c42dd86ba7a, 0xf38a2b98a8450efa,
+		0x828f26e5111e9cd9, 0xc77f3836e4030a3a, 0x4fa43da50c5327a5,
+		0xe5533cda83935053, 0x33361d2c0f1dc88a, 0x279c9a239b386869,
+		0x9a321c8a5bf1ce14, 0xe414438f09b32ae6, 0x3f46017a76d3aef2,
+		0x77369291333cb409, 0x2479198bfaa97a10, 0x34efb5b0c86be25a,
+		0x491a10d49abaf671, 0x6a607ebd65ace9da, 0xb23a6a6f03232a22,
+		0x5bdde56a9d19ba27, 0xcc5e4659cb5505d3
+	},
+	{
+		0x0000000000000001, 0xea8d71a575535597, 0xea2dd9e76705faef,
+		0xc66ab683156a951a, 0x21d434096aa7e8e7, 0x4a3aa20f90b3ad36,
+		0x64d87c5d13f85d70, 0x1c6188d3e7f179fc, 0xcd6fa1b9d1c931c4,
+		0x0e8b93f735e7de83, 0x98f3cab1b54367fb, 0x612ad6f88f696992,
+		0xe39d0ca9df7aad44, 0x7c9aa2dc235c5269, 0x96e9c05702db30a0,
+		0x6725b7c9e3aa2c65, 0x3dff83475e9c40fa, 0xb6d799ae131ba4c2,
+		0x5160dbee83b4e019, 0x11c79404a576605a, 0xf400a3490bf94812,
+		0x0bb3bd1659c81294, 0x1b7a4a899da18139, 0xb01eca9292ae3dba,
+		0xcfd4f5920da0ebc8, 0x106ae64c32c5bce4, 0xaeb5f78671cbfb22,
+		0xfdf44159c4ec64dd, 0xd6fdb1f77598338b, 0x3b399d747f23e32e,
+		0x36f0255dde973dcb, 0x0000000000000000
+	},
+	{
+		0x2567ec1a605f4f87, 0x03816e7ef66998a1, 0x24453852e3e0090a,
+		0xba6c85a70016eecb, 0x5514b577788d4a48, 0x6fc5dcd0502d1537,
+		0x88844eeabb1298ca, 0x134b0f40507e99d3, 0xf06358d9d4469677,
+		0xe89df8f189d2824b, 0x8fc466614919566b, 0xc3d15096923e96fd,
+		0x4bc54e75f73e8377, 0xa47e46f2b21211a1, 0xa840d6fb0d4a004f,
+		0xd549007160002d42, 0x86ea020abbc0c802, 0x0b8a2673dea5fc18,
+		0x86808a5b15c097ba, 0xf18c2500fb1691d4, 0x64371056cad88293,
+		0xccc8beb6dbab09c0, 0xcc2e01459a95b9f7, 0xfa14b8aec0c7416c,
+		0xde0d31c7e84f45a8, 0x694f3b94762eaf09, 0x02487c360b5d7d66,
+		0x4a6d05d68307eacd, 0xd88d7ba4aa465ffd, 0x21c15c5cbf818949,
+		0x2adef7165adaca5f, 0xe010f99a2f746b6b
+	},
+	{
+		0x880841833104bb85, 0x1797e5e15521f75d, 0x6344859524a727b9,
+		0xa3054690c6e29812, 0xc097ad62a201ecee, 0x14c086725e592f0c,
+		0xa3789a1488a80673, 0x31e1988e2f2fd381, 0xac23455a56705c6a,
+		0xa1d913adba3bed75, 0x78df70c7c647c6ab, 0x2aa114975979adba,
+		0x873836cac7e24418, 0x03e6c5a388f5006c, 0x742eba99a726044c,
+		0x749842cefb117de9, 0x35af0ca3b86619f1, 0x2ca2a9101e071afc,
+		0xeffa0fe566fe9bbc, 0x7306fe72b917b377, 0x7aba39acd2758f21,
+		0x9c7780ccc6309422, 0x085803812329a222, 0x6b129c5bb8a3f02b,
+		0x8e58d33c76a953ee, 0xb5249cfa4fd28abc, 0x97d301f561ad7f5d,
+		0xce7e11173c57b859, 0x218d5e9c7b3ac994, 0xa8ba6a9c13a9c95e,
+		0x54dd9813e1a8b83d, 0xa31f56cc7d5c83cb
+	},
+	{
+		0xabbd4b25c27c01ae, 0xa3d4e84c5acf2881, 0x9309585a4b60c164,
+		0x5f9578d0f61cd54a, 0x87fb8ad1e5268368, 0xa853cc83b3358c13,
+		0x56b54a1cabca256f, 0x0047b2a0c8771868, 0xbf37488dbb5b6299,
+		0xdc16c14f7491a48a, 0x81c224848078a08e, 0x0ebfcb1ae174d70a,
+		0x1dbb4c47582c97db, 0x308cd22099ca64d2, 0x23c9dae5836b0265,
+		0xeafe7a94d701ffef, 0xcd2042339b992867, 0xfa507fbe55cf316f,
+		0x4db76ced222b30a8, 0x9620f6be585a794d, 0x8be1cbf294d97b12,
+		0xca5cc0a4ace363ce, 0xe9c8de30a603ad33, 0x8aec3984abbd03c3,
+		0x9840a2d98f364b3e, 0x78fe2fbfdca35ae2, 0x7cd4e56f99128f35,
+		0x09aad104891aee25, 0xc9c18c052f66ea03, 0xef19cfd557217328,
+		0xcc548270fb202282, 0x6f2877cd4d6f19e1
+	},
+	{
+		0x1cce3b32b7afd352, 0xf3ad63fb66cb1a86, 0x44a6f1e26bb5add6,
+		0xfdc4391234a4b42f, 0x107c4a6e0737c258, 0x1f5ab165e3b07570,
+		0x6dbf584a9475fab1, 0x987812c8e3bbfded, 0xeb9418717730f14b,
+		0xb605dfced153d165, 0x37accddbc2a36203, 0xca208a8e42fa0163,
+		0x236483db5403ea89, 0xd3b856e46c16ec29, 0xe2953bcead52a6a9,
+		0xdb9384b25e64cf45, 0x1b2ce2d2e33188c4, 0x1251fa0f326b02a9,
+		0x7cde5a7d9830d09a, 0x24f1050bd9bdc31f, 0x8700746bf2ee5a75,
+		0x48aaaedfaa33771e, 0x8924cf45c4307235, 0xeb5381c7f91a97a4,
+		0xef35ca4ee767d19b, 0xbdfbf30ba6492c96, 0x4b02d1a9a7e146ac,
+		0xe498f6cb2b0fa38f, 0xfbf4a7c064023b88, 0xbb7a7f4d57baf7fc,
+		0x2cdfc3420fc7dd80, 0xc9f81478901ee978
+	},
+	{
+		0xb00487dae834c963, 0x7e085fe388ccd4d9, 0xbd2d96dcb6776986,
+		0x35783f30dcca256f, 0x6801045d53d4857c, 0x5f062de66dc4b6dc,
+		0x6cd23401c53e74f1, 0xdd302091051c6254, 0x11b18ee2a4ce9c01,
+		0xfe9cd4f2919f7f2a, 0x0b2138b274f85473, 0x412b8c58b2fd0d50,
+		0xeebc80fc51ce8ef6, 0xaeb425427171254d, 0x4e5dca0fc549ab8b,
+		0x7655ea0c3979f843, 0xe3befda59b5b7d38, 0xe2ee25e61da7f08f,
+		0x2af4d8abfd3b74a5, 0x555bdde131fc339e, 0xe413eb4bf76de885,
+		0x125ba10034d08069, 0x380edf686e45f6c4, 0x07f7fc50a63bdd03,
+		0xe3a8938b13425439, 0xe78fb4d3a813375c, 0xccc46a1c8eeace6a,
+		0xc2f8a2e05285a7f9, 0x1ce26e1247dca158, 0xa5730ba4f95ef0a0,
+		0xaa40e6c727e800fa, 0xa4fe4764590b69f2
+	},
+	{
+		0x3a4bc7d2784a8534, 0xd75aa62e9732977a, 0xa10d622bfb9dc0ff,
+		0xd47500ed4cee298c, 0xbb2c36d0199b87b2, 0x03616b06a366ce8d,
+		0x5f4eeaef44cf18f6, 0xa6ba96f812a722c6, 0x4394e33bba1703cc,
+		0xe3708cfd0d4f35a1, 0x5a12dbaa4e06da8c, 0x6819c839b9f74295,
+		0xe2d13b19f9b7bd82, 0xac6a7b51df3e9e2f, 0x8ea5e48c490b1200,
+		0x5d7d9d0bf0556e75, 0x1bfa65f9290f777b, 0x5d63d77d29fbad24,
+		0x52b7fd377acb48f2, 0x96c82da4ced73d5b, 0x8f9d2a65ccfc41f7,
+		0x3e2397b1291ffe3e, 0x53a2c5e6ee4a9e14, 0x39ffd6793366f733,
+		0x8a11835bc5241ffb, 0x941e1e8d70dbcd32, 0xdd28c7b0432441f0,
+		0xcde214fc1cddf0aa, 0x13272a374eaf2ec1, 0xf98fbb4fa1cba154,
+		0xdd758cf4cfa09e76, 0x51b1d7861c1323ef
+	},
+	{
+		0xe193f69fff0c0491, 0x1738c1ec01914830, 0x498fea7785fe20ee,
+		0xac45acdeaf1db1b2, 0x8a5e4a12fea74e29, 0x9418513e4153c73f,
+		0xea496108b4226c6b, 0x668eb83367dd0795, 0x9d1f3bb21afe69e7,
+		0x0dfeca25faa938f1, 0xb2906311c827d537, 0x18fa77cb761167c0,
+		0x9d356f1b9f51e27d, 0x9555401cdf6a9d11, 0x6b7d2696a2b887c4,
+		0x9b00a18d87dad054, 0xd2b277a05252ad34, 0xc24ca8b87d6c97ca,
+		0x521db8433787f188, 0x70cc06902073aacc, 0xe477f7e7caf188ae,
+		0x713d99753f1c625c, 0x86a473cb4751d1d7, 0x9ae1e1ed5692decf,
+		0x6f58bba7b2d9b6f1, 0xa228c51382867ac9, 0x782441d7afde67d9,
+		0x6b2256606f12fc3d, 0x8e7221956e1221c5, 0xe02da5b6038c0c43,
+		0x52ff14b21f7701ba, 0x8c15c2a0e2c37eeb
+	},
+	{
+		0xf9b0d2dfab5deee9, 0x8671e5c000874d50, 0x9f01c90e34e24b15,
+		0xe0ec9fa1402cd5e1, 0x554a4d40bc2d9bed, 0x2e59bf695a6086a9,
+		0x6481127796daac19, 0x6b44669799c36478, 0x64de75c956b070c1,
+		0xd32c18b963f80318, 0x09486b50e6a5f10a, 0xd567b35cd0db3994,
+		0x425ce8631ae07ea1, 0x0f3a7feee6dd71ca, 0xfb6586df15a4bbd9,
+		0xcf380855733f336a, 0x208cf4b1485044b1, 0xd68cb272b70606f2,
+		0x53725051bdae8824, 0x1df410579fa2e771, 0xa7f53d2c3b2ab673,
+		0x7775c68b9676455b, 0xc08f181e4f63e935, 0x0494ba55fa191d69,
+		0x2961b8ecf1e8e4b3, 0x2f2960270ba51cae, 0xd7aa72cfaeeaaf0d,
+		0x9cb5e95572afddc5, 0x350eb0f0f14b7286, 0x9e4ace21f4e90094,
+		0x98e83da0b4c908ee, 0xcdda1311373b3738
+	},
+	{
+		0xf9356a83e219547c, 0x3ae575c6fd867f88, 0x3694751ee16a4795,
+		0x699b58cf71117170, 0x2ec61a8c99d0f907, 0xb7bf064a7eed3da8,
+		0x17c95358fffc4974, 0x365102be891c5080, 0x8f1ae2d36789fe28,
+		0x2982064faabd790b, 0x3170742f3e0489d1, 0xea27c7eb97448ecd,
+		0xb2ea13065c7bc4c7, 0x508046638f5bf4ef, 0x83a6af527165f620,
+		0xff908715e7f7a5d2, 0x8fd6d5194c917391, 0xf36f7266f70b2963,
+		0x3a282ed610748882, 0x35ffa30e36031504, 0xe9828d9cb992170f,
+		0x8f176cc4a8d5030e, 0x022fde80d03837bb, 0xd24bb41d2548a864,
+		0xfffe29822390b1aa, 0x6112fa28e0a6d2c6, 0xa6bc1aeefa2c84bb,
+		0xdc75ee6545b23a52, 0x0425743d8b1a6649, 0x33a21b9148c5ad53,
+		0x9fc913147404bee2, 0xc0adf60d32509b69
+	},
+	{
+		0x840627982a5da5d0, 0xd5cde91ac7c336c2, 0xf83a893120fbb560,
+		0xb99bcb9554384017, 0x0e6d3031cf8632a7, 0xca3526e52ad85868,
+		0x51db2424227c097f, 0x1da4449920974327, 0xb417a88e42e4e62d,
+		0xee81669d55f6b14b, 0x63d775f574a43776, 0xb3c1901fd3dd8ab9,
+		0xaa6edfbc621531a5, 0x083524e0fbdf41e9, 0x483443c20b49f7f8,
+		0x8334d9b725ebe788, 0x1d5262b75a359af8, 0x82e69366a496a4b7,
+		0xdada0350c3a88aa2, 0xa2e67b5dfa086265, 0x579c82eaa66c6290,
+		0x5e58f96bcc000f8d, 0x0db59ad1f529c311, 0xa2307a1de84b5c2e,
+		0x104a8f4a8db7b514, 0x48b2ffb5f5db27d0, 0xb181445e2340c205,
+		0xcee7030d23b4a7f4, 0x5a0bd5d33bf77dc1, 0x2bed9dffc44a94dc,
+		0x622f64d19ff036c7, 0xa70bebedbe3f29be
+	},
+	{
+		0x8d4c2771914b7685, 0x802c4c6955942819, 0x4e28a7e2508bca17,
+		0xd75496e12cf00d39, 0x8f1acbede2527175, 0xec4dd085ebe3a3a8,
+		0x8be9f91dcc10a11d, 0x108a204abc830bb3, 0x36f4f48d3dcff20e,
+		0x5bdaf55e5c754d52, 0x0f4b25afcf5aeef5, 0x25eac43127f88274,
+		0x1ea00816c5f65019, 0xaed1dc8d981df117, 0x9f8e0f3673ff2f9d,
+		0xf348cd4e1a7f79c4, 0xa9f1fe35cb6898fd, 0xcc87ac6fb30c8879,
+		0x6edba088450b4d0d, 0x1234538400e8df77, 0x2d480a84f3118e7d,
+		0xcb0fe578c013822b, 0x7216f9470c6ab4fc, 0x21e8e5f761eb2316,
+		0x5319485d3566ec8e, 0xb352a90050d370e6, 0x2f1942cfdf3628e2,
+		0xa9e7c2da37237e71, 0x3fde62f6cc96e5d8, 0xe44868253641c1ab,
+		0x19b53cd7d079d1cc, 0xc73ea7811d1dc356
+	},
+	{
+		0x2e15a495634d31c6, 0x1c1441fe40f24fc5, 0x846f826ad2425c98,
+		0x94f904ce31a1660f, 0xf848cf13dc5b0c21, 0x8d1e27a6e8132001,
+		0x74f782c6d9e4ddcf, 0xeab47910c11500da, 0xf3900a25748d2f26,
+		0xe5ec5a92517a20bf, 0x6eee5a975894011e, 0x466bf9865b9e453f,
+		0x38e896fa083fa2b1, 0x6fa9f88a68908ba6, 0x64c7ad582361bc29,
+		0x1870e69558cc2aa6, 0x14884652b57a5504, 0x8e6389d9f6faa3f1,
+		0x13e62a84c251f4f0, 0xfb9ec26d87ea744e, 0xfce928d938d243cd,
+		0xc1a52fbf883615c1, 0x0cad3795f5f03bb3, 0x2ec0bec59052e47d,
+		0xc6989477eeb3800b, 0xbfff82327e879657, 0x53dcec8bc81fc9fb,
+		0x7727ed470718ec84, 0x36f23e7120754261, 0x168f606f6603b153,
+		0x368e42c1b4e46f88, 0xa4ff420c7f093114
+	},
+	{
+		0xa6552401bdac2ef0, 0x0177c40e0db32c30, 0x597d8342a3a7e43e,
+		0xb09ac55683d46efe, 0x9ff9eaa8f512ad07, 0x7b599527d4e1372e,
+		0x47e818f054b66e4a, 0x30ccd2653c09c773, 0x05645cce3cb61ee7,
+		0x0453602cc9bb61f4, 0x5debe0f0be070449, 0x2e4e8ad89802c4ea,
+		0x20862c0d6df15dcc, 0x6b6f0d57cee039c2, 0xe158401e6c5f46ee,
+		0xfca3c3d2b101e33f, 0xd0fda90c1648c9f6, 0x8579760a9aa48a33,
+		0x375b6250c10259f1, 0x4bf1bc702e5b572e, 0x85c186bb39d60422,
+		0x5490c9ed3b03e4cc, 0x0c8a1642901cfda8, 0x332301559c722517,
+		0x75376a9a3fae08e7, 0x3856c2b457477f19, 0x346cfc4533df2d1b,
+		0x39e5ecd5779b000d, 0x7d7c62d645e8e4b9, 0x3ecabfbb2a64af1b,
+		0x86c815eef810766e, 0xd32c784b6d195b32
+	},
+	{
+		0x3b62dd715a6adb58, 0xac12ab08ade482f7, 0x603793877770786b,
+		0x05a71db0c97c0b15, 0x83984105e2b087d2, 0xebf7b52f01c9e43a,
+		0x8aca0b57a06f7091, 0xe19ff49521f80bec, 0xdb383321093689a4,
+		0x58c383c5228f4b4b, 0xc99515c61afb8d1a, 0xebd38a777ee3ef3b,
+		0x62d0f109f71ce60d, 0x5b5c51e286772f48, 0x745d537395a885ab,
+		0x64f7712bd90131d2, 0x8f5511a273c94700, 0xfb2d4a716d5b328c,
+		0x594e696cfe573ca8, 0xd14ccabda69b1a34, 0xfebda05a3db9aa0b,
+		0xdbab3e1fbb832e8e, 0x00a116889b797bb8, 0x7d5aad36975f8c0d,
+		0x786d04a1f0b6b87b, 0xafbcc23ec6cbbb75, 0x7072157b662d01c6,
+		0x405a6d032ed242bc, 0x65f49e8784fcb223, 0x6187faf752d02024,
+		0xc978f263829346e7, 0x424c7c4aa123a223
+	},
+	{
+		0xba2c4d3c6868f7f1, 0x64940d10cee53346, 0xd2824c2748b9a943,
+		0x120d3f967bd60a08, 0xbb172e3e9fa3892d, 0xee1d13fce0733ef8,
+		0x8b5fd955e76e0320, 0x7bcbddf54d8f8c94, 0x7506faa88f8089f5,
+		0x694c9ded1a77be74, 0x1d390ee7b0e4f02c, 0xb496d0a480ea0e4c,
+		0xedb14261895b82ce, 0x9bbf0eff2750f888, 0x8e35be5f7cf20281,
+		0xa483036d35ff07a2, 0xaa65ded4e015745a, 0x142e8d76f8ab6b47,
+		0xd57c85a73984fc27, 0x372d2373cf4c99dc, 0xe89fce96c5666a33,
+		0xae2f22ca978b4518, 0x23979d05d216fd08, 0x41c229645998eeb4,
+		0xd864c365565bd372, 0x727b5904b086aa4d, 0x1d9f39e58c58cfbd,
+		0xe9872fffbebc2d00, 0xfe12c2e49dd72ce4, 0xca102b64576122f0,
+		0xc55f222d7ccb1171, 0xe3a54fb5a9a25e25
+	}
+};
@@ -0,0 +1,18 @@
+#ifndef _CRYPTO_DH_GROUP14_COMB_H_
+#define _CRYPTO_DH_GROUP14_COMB_H_
+
+#include <stdint.h>
+
+/* The group #14 modulus p, as 32 little-endian 64-bit limbs. */
+extern const uint64_t crypto_dh_group14_p[32];
+
+/* R^2 mod p, where R = 2^2048. */
+extern const uint64_t crypto_dh_group14_rr[32];
+
+/* 2^(2^258) mod p. */
+extern const uint64_t crypto_dh_group14_c258[32];
+
+/* Fixed-base comb tables for the generator 2, in Montgomery form. */
+extern const uint64_t crypto_dh_group14_comb[64][32];
+
+#endif /* !_CRYPTO_DH_GROUP14_COMB_H_ */
@@ -1,4 +1,5 @@
 #include <assert.h>
+#include <pthread.h>
 #include <stdint.h>
 #include <string.h>
 
@@ -6,6 +7,7 @@
 #include "crypto_entropy_rdrand.h"
 #include "entropy.h"
 #include "insecure_memzero.h"
+#include "warnp.h"
 
 #include "sha256.h"
 
@@ -16,6 +18,15 @@
  * specified in section 10.1.2 of the NIST SP 800-90 standard.  In this
  * implementation, the optional personalization_string and additional_input
  * specified in the standard are not implemented.
+ *
+ * Alternatively, once crypto_entropy_set_generator() has been called (e.g.,
+ * by crypto_entropy_aesctr_use()), output is generated using the generator
+ * it provides; this is reseeded on the same schedule as the HMAC_DRBG would
+ * be.  Keeping that generator out of this file means that programs which
+ * only use HMAC_DRBG don't need to link in its dependencies.
+ *
+ * All access to the generator state happens while holding a lock, which is
+ * also held across fork() so that a child process never inherits it held.
  */
 
 /* Internal HMAC_DRBG state. */
@@ -28,6 +39,14 @@ static struct {
 /* Set to non-zero once the PRNG has been instantiated. */
 static int instantiated = 0;
 
+/* Alternative generator, if one is in use. */
+static void (* alt_reseed)(const uint8_t *, size_t) = NULL;
+static int (* alt_generate)(uint8_t *, size_t) = NULL;
+
+/* Lock protecting the generator state, and whether we've set up fork(). */
+static pthread_mutex_t mtx = PTHREAD_MUTEX_INITIALIZER;
+static int atfork_done = 0;
+
 /* Could be as high as 2^48 if we wanted... */
 #define RESEED_INTERVAL	256
 
@@ -35,9 +54,62 @@ static int instantiated = 0;
 #define GENERATE_MAXLEN	65536
 
 static int instantiate(void);
+static void mix(uint8_t *, size_t);
 static void update(uint8_t *, size_t);
 static int reseed(void);
-static void generate(uint8_t *, size_t);
+static int generate(uint8_t *, size_t);
+
+/* Hold the lock across fork(). */
+static void
+atfork_prepare(void)
+{
+
+	pthread_mutex_lock(&mtx);
+}
+
+static void
+atfork_release(void)
+{
+
+	pthread_mutex_unlock(&mtx);
+}
+
+/* Take the lock, and make sure it will be held across fork(). */
+static int
+lock(void)
+{
+	int rc;
+
+	if ((rc = pthread_mutex_lock(&mtx)) != 0) {
+		warn0("pthread_mutex_lock: %s", strerror(rc));
+		goto err0;
+	}
+	if (!atfork_done) {
+		if ((rc = pthread_atfork(atfork_prepare, atfork_release,
+		    atfork_release)) != 0) {
+			warn0("pthread_atfork: %s", strerror(rc));
+			goto err1;
+		}
+		atfork_done = 1;
+	}
+
+	/* Success! */
+	return (0);
+
+err1:
+	pthread_mutex_unlock(&mtx);
+err0:
+	/* Failure! */
+	return (-1);
+}
+
+/* Release the lock. */
+static void
+unlock(void)
+{
+
+	pthread_mutex_unlock(&mtx);
+}
 
 #ifdef CPUSUPPORT_X86_RDRAND
 static void
@@ -47,7 +119,7 @@ update_from_rdrand(void) {
 	/* This is only *extra* entropy, so it's ok if it fails. */
 	if (generate_seed_rdrand(buf, 8))
 		return;
-	update((uint8_t *)buf, sizeof(buf));
+	mix((uint8_t *)buf, sizeof(buf));
 
 	/* Clean up. */
 	insecure_memzero(buf, sizeof(buf));
@@ -88,6 +160,20 @@ instantiate(void)
 	return (0);
 }
 
+/**
+ * mix(data, datalen):
+ * Mix the provided data into the state of whichever generator is in use.
+ */
+static void
+mix(uint8_t * data, size_t datalen)
+{
+
+	if (alt_generate != NULL)
+		alt_reseed(data, datalen);
+	else
+		update(data, datalen);
+}
+
 /**
  * update(data, datalen):
  * Update the DRBG state using the provided data.  (Section 10.1.2.2)
@@ -149,7 +235,7 @@ reseed(void)
 		return (-1);
 
 	/* Mix the random seed into the state. */
-	update(seed_material, 32);
+	mix(seed_material, 32);
 
 #ifdef CPUSUPPORT_X86_RDRAND
 	/* Add output of RDRAND into the state. */
@@ -174,41 +260,57 @@ reseed(void)
  * reseed() as needed) and ${buflen} is less than 2^16 (the caller is
  * responsible for splitting up larger requests).  (Section 10.1.2.5)
  */
-static void
+static int
 generate(uint8_t * buf, size_t buflen)
 {
+	HMAC_SHA256_KEY hkey;
 	size_t bufpos;
 
 	assert(buflen <= GENERATE_MAXLEN);
 	assert(drbg.reseed_counter <= RESEED_INTERVAL);
 
+	/* Use the alternative generator if there is one. */
+	if (alt_generate != NULL) {
+		if (alt_generate(buf, buflen))
+			return (-1);
+		drbg.reseed_counter += 1;
+		return (0);
+	}
+
+	/* The key is the same for every block; precompute its pads. */
+	HMAC_SHA256_Key_Init(&hkey, drbg.Key, 32);
+
 	/* Iterate until we've filled the buffer. */
 	for (bufpos = 0; bufpos < buflen; bufpos += 32) {
-		HMAC_SHA256_Buf(drbg.Key, 32, drbg.V, 32, drbg.V);
+		HMAC_SHA256_Buf_prekeyed(&hkey, drbg.V, 32, drbg.V);
 		if (buflen - bufpos >= 32)
 			memcpy(&buf[bufpos], drbg.V, 32);
 		else
 			memcpy(&buf[bufpos], drbg.V, buflen - bufpos);
 	}
+	insecure_memzero(&hkey, sizeof(HMAC_SHA256_KEY));
 
 	/* Mix up state. */
 	update(NULL, 0);
 
 	/* We're one data-generation step closer to needing a reseed. */
 	drbg.reseed_counter += 1;
+
+	/* Success! */
+	return (0);
 }
 
 /**
- * crypto_entropy_read(buf, buflen):
- * Fill the buffer with unpredictable bits.
+ * read_locked(buf, buflen):
+ * Fill the buffer with unpredictable bits, while holding the lock.
  */
-int
-crypto_entropy_read(uint8_t * buf, size_t buflen)
+static int
+read_locked(uint8_t * buf, size_t buflen)
 {
 	size_t bytes_to_provide;
 
 	/* Instantiate if needed. */
-	if (instantiated == 0) {
+	if ((alt_generate == NULL) && (instantiated == 0)) {
 		/* Try to instantiate the PRNG. */
 		if (instantiate())
 			return (-1);
@@ -232,7 +334,8 @@ crypto_entropy_read(uint8_t * buf, size_t buflen)
 			bytes_to_provide = buflen;
 
 		/* Generate bytes. */
-		generate(buf, bytes_to_provide);
+		if (generate(buf, bytes_to_provide))
+			return (-1);
 
 		/* We've done part of the buffer. */
 		buf += bytes_to_provide;
@@ -242,3 +345,78 @@ crypto_entropy_read(uint8_t * buf, size_t buflen)
 	/* Success! */
 	return (0);
 }
+
+/**
+ * crypto_entropy_read(buf, buflen):
+ * Fill the buffer with unpredictable bits.  This may be called from several
+ * threads at once.
+ */
+int
+crypto_entropy_read(uint8_t * buf, size_t buflen)
+{
+	int rc;
+
+	/* Generate output while holding the lock. */
+	if (lock())
+		return (-1);
+	rc = read_locked(buf, buflen);
+	unlock();
+
+	return (rc);
+}
+
+/**
+ * crypto_entropy_set_generator(init, reseed_func, generate_func):
+ * Switch crypto_entropy_read() to generating output with an alternative
+ * generator instead of HMAC_DRBG: it is seeded by calling ${init}(seed,
+ * seedlen) with entropy from the operating system, produces output via
+ * ${generate_func}(buf, buflen), and has new entropy mixed in via
+ * ${reseed_func}(seed, seedlen) at the same interval as HMAC_DRBG.  If an
+ * alternative generator is already in use, do nothing.
+ */
+int
+crypto_entropy_set_generator(void (* init)(const uint8_t *, size_t),
+    void (* reseed_func)(const uint8_t *, size_t),
+    int (* generate_func)(uint8_t *, size_t))
+{
+	uint8_t seed_material[48];
+
+	/* Don't let anyone use the generator while we replace it. */
+	if (lock())
+		goto err0;
+
+	/* Nothing to do? */
+	if (alt_generate != NULL)
+		goto done;
+
+	/* Obtain random seed_material = (entropy_input || nonce). */
+	if (entropy_read(seed_material, 48))
+		goto err1;
+
+	/* Initialize the generator and start using it. */
+	init(seed_material, 48);
+	alt_reseed = reseed_func;
+	alt_generate = generate_func;
+	drbg.reseed_counter = 1;
+
+#ifdef CPUSUPPORT_X86_RDRAND
+	/* Add output of RDRAND into the state. */
+	if (cpusupport_x86_rdrand())
+		update_from_rdrand();
+#endif
+
+	/* Clean the stack. */
+	insecure_memzero(seed_material, 48);
+
+done:
+	unlock();
+
+	/* Success! */
+	return (0);
+
+err1:
+	unlock();
+err0:
+	/* Failure! */
+	return (-1);
+}
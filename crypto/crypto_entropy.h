@@ -4,10 +4,29 @@
 #include <stddef.h>
 #include <stdint.h>
 
+/*
+ * Access to the generator is serialized with a pthread mutex, so programs
+ * which use this module must be linked with -lpthread on platforms where the
+ * pthread functions are not part of libc.
+ */
+
 /**
  * crypto_entropy_read(buf, buflen):
- * Fill the buffer with unpredictable bits.
+ * Fill the buffer with unpredictable bits.  This may be called from several
+ * threads at once.
  */
 int crypto_entropy_read(uint8_t *, size_t);
 
+/**
+ * crypto_entropy_set_generator(init, reseed_func, generate_func):
+ * Switch crypto_entropy_read() to generating output with an alternative
+ * generator instead of HMAC_DRBG: it is seeded by calling ${init}(seed,
+ * seedlen) with entropy from the operating system, produces output via
+ * ${generate_func}(buf, buflen), and has new entropy mixed in via
+ * ${reseed_func}(seed, seedlen) at the same interval as HMAC_DRBG.  If an
+ * alternative generator is already in use, do nothing.
+ */
+int crypto_entropy_set_generator(void (*)(const uint8_t *, size_t),
+    void (*)(const uint8_t *, size_t), int (*)(uint8_t *, size_t));
+
 #endif /* !_CRYPTO_ENTROPY_H_ */
@@ -0,0 +1,192 @@
+#include <stdint.h>
+#include <string.h>
+
+#include "crypto_aes.h"
+#include "crypto_aesctr.h"
+#include "insecure_memzero.h"
+#include "sha256.h"
+
+#include "crypto_entropy.h"
+
+#include "crypto_entropy_aesctr.h"
+
+/**
+ * This is a "fast key erasure" generator: the AES-256-CTR keystream under the
+ * current key, with nonce 0, is used to produce a new key (the first 32
+ * bytes) followed by a buffer of output; the old key is overwritten by the
+ * new key and each byte of buffered output is erased as it is handed out.
+ * An attacker who obtains the state thus learns nothing about any output
+ * which has already been returned.  Requests larger than the buffer are
+ * served directly from the keystream with nonce 1, before rekeying.
+ */
+
+/* Generator used by crypto_entropy_read(), via crypto_entropy_aesctr_use(). */
+static struct crypto_entropy_aesctr global_gen;
+
+/* Replace the key and refill the buffer from the keystream with nonce 0. */
+static int
+refill(struct crypto_entropy_aesctr * ctx)
+{
+	struct crypto_aes_key * key;
+
+	/* Expand the current key. */
+	if ((key = crypto_aes_key_expand(ctx->block, 32)) == NULL)
+		goto err0;
+
+	/* Overwrite the key and buffer with keystream. */
+	memset(ctx->block, 0, sizeof(ctx->block));
+	crypto_aesctr_buf(key, 0, ctx->block, ctx->block, sizeof(ctx->block));
+	ctx->bufpos = 0;
+
+	/* Erase the old key. */
+	crypto_aes_key_free(key);
+
+	/* Success! */
+	return (0);
+
+err0:
+	/* Failure! */
+	return (-1);
+}
+
+/* Fill ${buf} directly from the keystream with nonce 1, then rekey. */
+static int
+bulk(struct crypto_entropy_aesctr * ctx, uint8_t * buf, size_t buflen)
+{
+	struct crypto_aes_key * key;
+
+	/* Expand the current key. */
+	if ((key = crypto_aes_key_expand(ctx->block, 32)) == NULL)
+		goto err0;
+
+	/* Generate the output. */
+	memset(buf, 0, buflen);
+	crypto_aesctr_buf(key, 1, buf, buf, buflen);
+	crypto_aes_key_free(key);
+
+	/* Replace the key which we just used. */
+	if (refill(ctx))
+		goto err0;
+
+	/* Success! */
+	return (0);
+
+err0:
+	/* Failure! */
+	return (-1);
+}
+
+/**
+ * crypto_entropy_aesctr_init(ctx, seed, seedlen):
+ * Initialize the AES-CTR generator ${ctx} from the ${seedlen} bytes of
+ * ${seed}, which should contain at least 256 bits of entropy.
+ */
+void
+crypto_entropy_aesctr_init(struct crypto_entropy_aesctr * ctx,
+    const uint8_t * seed, size_t seedlen)
+{
+
+	/* The key is the hash of the seed; no output is buffered. */
+	SHA256_Buf(seed, seedlen, ctx->block);
+	insecure_memzero(&ctx->block[32], CRYPTO_ENTROPY_AESCTR_BUFLEN);
+	ctx->bufpos = CRYPTO_ENTROPY_AESCTR_BUFLEN;
+}
+
+/**
+ * crypto_entropy_aesctr_reseed(ctx, seed, seedlen):
+ * Mix the ${seedlen} bytes of ${seed} into the state of the AES-CTR
+ * generator ${ctx}, discarding any buffered output.
+ */
+void
+crypto_entropy_aesctr_reseed(struct crypto_entropy_aesctr * ctx,
+    const uint8_t * seed, size_t seedlen)
+{
+	SHA256_CTX hctx;
+
+	/* The new key is the hash of the old key and the seed. */
+	SHA256_Init(&hctx);
+	SHA256_Update(&hctx, ctx->block, 32);
+	SHA256_Update(&hctx, seed, seedlen);
+	SHA256_Final(ctx->block, &hctx);
+
+	/* Discard buffered output. */
+	insecure_memzero(&ctx->block[32], CRYPTO_ENTROPY_AESCTR_BUFLEN);
+	ctx->bufpos = CRYPTO_ENTROPY_AESCTR_BUFLEN;
+}
+
+/**
+ * crypto_entropy_aesctr_generate(ctx, buf, buflen):
+ * Fill ${buf} with ${buflen} bytes of output from the AES-CTR generator
+ * ${ctx}.  No state remains from which the output can be reconstructed.
+ */
+int
+crypto_entropy_aesctr_generate(struct crypto_entropy_aesctr * ctx,
+    uint8_t * buf, size_t buflen)
+{
+	uint8_t * p;
+	size_t len;
+
+	/* Large requests bypass the buffer. */
+	if (buflen > CRYPTO_ENTROPY_AESCTR_BUFLEN)
+		return (bulk(ctx, buf, buflen));
+
+	/* Hand out buffered output, erasing it as we go. */
+	while (buflen > 0) {
+		if ((ctx->bufpos == CRYPTO_ENTROPY_AESCTR_BUFLEN) &&
+		    refill(ctx))
+			goto err0;
+		len = CRYPTO_ENTROPY_AESCTR_BUFLEN - ctx->bufpos;
+		if (len > buflen)
+			len = buflen;
+		p = &ctx->block[32 + ctx->bufpos];
+		memcpy(buf, p, len);
+		insecure_memzero(p, len);
+		ctx->bufpos += len;
+		buf += len;
+		buflen -= len;
+	}
+
+	/* Success! */
+	return (0);
+
+err0:
+	/* Failure! */
+	return (-1);
+}
+
+/* Wrappers for using ${global_gen} via crypto_entropy_set_generator(). */
+static void
+global_init(const uint8_t * seed, size_t seedlen)
+{
+
+	crypto_entropy_aesctr_init(&global_gen, seed, seedlen);
+}
+
+static void
+global_reseed(const uint8_t * seed, size_t seedlen)
+{
+
+	crypto_entropy_aesctr_reseed(&global_gen, seed, seedlen);
+}
+
+static int
+global_generate(uint8_t * buf, size_t buflen)
+{
+
+	return (crypto_entropy_aesctr_generate(&global_gen, buf, buflen));
+}
+
+/**
+ * crypto_entropy_aesctr_use(void):
+ * Switch crypto_entropy_read() to generating output with a fast-key-erasure
+ * AES-256-CTR generator, freshly seeded from the operating system, instead
+ * of HMAC_DRBG.  The generator is reseeded at the same interval as HMAC_DRBG,
+ * and no state is retained from which past output can be reconstructed.
+ */
+int
+crypto_entropy_aesctr_use(void)
+{
+
+	return (crypto_entropy_set_generator(global_init, global_reseed,
+	    global_generate));
+}
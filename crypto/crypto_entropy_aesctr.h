@@ -0,0 +1,49 @@
+#ifndef _CRYPTO_ENTROPY_AESCTR_H_
+#define _CRYPTO_ENTROPY_AESCTR_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* Number of bytes of output buffered by the generator. */
+#define CRYPTO_ENTROPY_AESCTR_BUFLEN	736
+
+/* Generator state; the first 32 bytes of ${block} are the current key. */
+struct crypto_entropy_aesctr {
+	uint8_t block[32 + CRYPTO_ENTROPY_AESCTR_BUFLEN];
+	size_t bufpos;
+};
+
+/**
+ * crypto_entropy_aesctr_init(ctx, seed, seedlen):
+ * Initialize the AES-CTR generator ${ctx} from the ${seedlen} bytes of
+ * ${seed}, which should contain at least 256 bits of entropy.
+ */
+void crypto_entropy_aesctr_init(struct crypto_entropy_aesctr *,
+    const uint8_t *, size_t);
+
+/**
+ * crypto_entropy_aesctr_reseed(ctx, seed, seedlen):
+ * Mix the ${seedlen} bytes of ${seed} into the state of the AES-CTR
+ * generator ${ctx}, discarding any buffered output.
+ */
+void crypto_entropy_aesctr_reseed(struct crypto_entropy_aesctr *,
+    const uint8_t *, size_t);
+
+/**
+ * crypto_entropy_aesctr_generate(ctx, buf, buflen):
+ * Fill ${buf} with ${buflen} bytes of output from the AES-CTR generator
+ * ${ctx}.  No state remains from which the output can be reconstructed.
+ */
+int crypto_entropy_aesctr_generate(struct crypto_entropy_aesctr *, uint8_t *,
+    size_t);
+
+/**
+ * crypto_entropy_aesctr_use(void):
+ * Switch crypto_entropy_read() to generating output with a fast-key-erasure
+ * AES-256-CTR generator, freshly seeded from the operating system, instead
+ * of HMAC_DRBG.  The generator is reseeded at the same interval as HMAC_DRBG,
+ * and no state is retained from which past output can be reconstructed.
+ */
+int crypto_entropy_aesctr_use(void);
+
+#endif /* !_CRYPTO_ENTROPY_AESCTR_H_ */
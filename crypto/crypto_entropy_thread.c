@@ -0,0 +1,240 @@
+#include <pthread.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "crypto_entropy_aesctr.h"
+#include "entropy.h"
+#include "insecure_memzero.h"
+#include "warnp.h"
+
+#include "crypto_entropy.h"
+
+#include "crypto_entropy_thread.h"
+
+/**
+ * Each thread has a fast-key-erasure AES-CTR generator, stored in
+ * thread-specific data, which is seeded from crypto_entropy_read() and then
+ * generates output without taking any locks until it needs to be reseeded.
+ * A thread which starts running in a child process after fork() notices that
+ * the fork generation number has changed, and mixes new entropy from the
+ * operating system into its generator (and into a fresh seed taken from
+ * crypto_entropy_read(), whose state the child shares with its parent)
+ * before producing any output.
+ */
+
+/* Same values as in crypto_entropy.c. */
+#define RESEED_INTERVAL	256
+#define GENERATE_MAXLEN	65536
+
+/* Per-thread state. */
+struct thread_state {
+	struct crypto_entropy_aesctr gen;
+	uint32_t reseed_counter;
+	unsigned int forkgen;
+};
+
+/* Thread-specific data key, and whether it was successfully created. */
+static pthread_once_t key_once = PTHREAD_ONCE_INIT;
+static pthread_key_t key;
+static int key_ok = 0;
+
+/* Incremented in child processes after fork(). */
+static unsigned int forkgen = 0;
+
+/* Note that we're in a new child process. */
+static void
+atfork_child(void)
+{
+
+	forkgen++;
+}
+
+/* Free the state ${cookie} of an exiting thread. */
+static void
+destroy(void * cookie)
+{
+	struct thread_state * st = cookie;
+
+	insecure_memzero(st, sizeof(struct thread_state));
+	free(st);
+}
+
+/* Create the thread-specific data key and register fork handlers. */
+static void
+key_init(void)
+{
+	int rc;
+
+	if ((rc = pthread_key_create(&key, destroy)) != 0) {
+		warn0("pthread_key_create: %s", strerror(rc));
+		return;
+	}
+	if ((rc = pthread_atfork(NULL, NULL, atfork_child)) != 0) {
+		warn0("pthread_atfork: %s", strerror(rc));
+		return;
+	}
+	key_ok = 1;
+}
+
+/**
+ * seed(st, init):
+ * Seed (if ${init} is non-zero) or reseed the generator in ${st} from
+ * crypto_entropy_read(), and from the operating system if the process has
+ * forked since the generator was last seeded.
+ */
+static int
+seed(struct thread_state * st, int init)
+{
+	uint8_t seed_material[80];
+	size_t len = 48;
+
+	/* Take seed material from the global generator. */
+	if (crypto_entropy_read(seed_material, 48))
+		goto err0;
+
+	/* After a fork, add entropy which our parent cannot know. */
+	if (st->forkgen != forkgen) {
+		if (entropy_read(&seed_material[48], 32))
+			goto err0;
+		len += 32;
+	}
+
+	/* Seed or reseed the generator. */
+	if (init)
+		crypto_entropy_aesctr_init(&st->gen, seed_material, len);
+	else
+		crypto_entropy_aesctr_reseed(&st->gen, seed_material, len);
+	st->reseed_counter = 1;
+	st->forkgen = forkgen;
+
+	/* Clean the stack. */
+	insecure_memzero(seed_material, 80);
+
+	/* Success! */
+	return (0);
+
+err0:
+	insecure_memzero(seed_material, 80);
+
+	/* Failure! */
+	return (-1);
+}
+
+/* Return the state for this thread, creating it if necessary. */
+static struct thread_state *
+getstate(void)
+{
+	struct thread_state * st;
+	int rc;
+
+	/* Make sure we have a thread-specific data key. */
+	if ((rc = pthread_once(&key_once, key_init)) != 0) {
+		warn0("pthread_once: %s", strerror(rc));
+		goto err0;
+	}
+	if (!key_ok)
+		goto err0;
+
+	/* Do we already have state? */
+	if ((st = pthread_getspecific(key)) != NULL)
+		return (st);
+
+	/* Allocate and seed new state. */
+	if ((st = malloc(sizeof(struct thread_state))) == NULL) {
+		warnp("malloc");
+		goto err0;
+	}
+	st->forkgen = forkgen;
+	if (seed(st, 1))
+		goto err1;
+
+	/* Attach it to this thread. */
+	if ((rc = pthread_setspecific(key, st)) != 0) {
+		warn0("pthread_setspecific: %s", strerror(rc));
+		goto err1;
+	}
+
+	/* Success! */
+	return (st);
+
+err1:
+	destroy(st);
+err0:
+	/* Failure! */
+	return (NULL);
+}
+
+/**
+ * crypto_entropy_thread_read(buf, buflen):
+ * Fill the buffer with unpredictable bits.  Like crypto_entropy_read(), this
+ * may be called from several threads at once; but rather than taking a lock
+ * for every request, each thread has its own generator, which is seeded from
+ * crypto_entropy_read() and is never shared with other threads or with child
+ * processes.
+ */
+int
+crypto_entropy_thread_read(uint8_t * buf, size_t buflen)
+{
+	struct thread_state * st;
+	size_t bytes_to_provide;
+
+	/* Get this thread's state. */
+	if ((st = getstate()) == NULL)
+		goto err0;
+
+	/* Never produce output which our parent might also produce. */
+	if ((st->forkgen != forkgen) && seed(st, 0))
+		goto err0;
+
+	/* Loop until we've filled the buffer. */
+	while (buflen > 0) {
+		/* Do we need to reseed? */
+		if ((st->reseed_counter > RESEED_INTERVAL) && seed(st, 0))
+			goto err0;
+
+		/* How much data are we generating in this step? */
+		if (buflen > GENERATE_MAXLEN)
+			bytes_to_provide = GENERATE_MAXLEN;
+		else
+			bytes_to_provide = buflen;
+
+		/* Generate bytes. */
+		if (crypto_entropy_aesctr_generate(&st->gen, buf,
+		    bytes_to_provide))
+			goto err0;
+		st->reseed_counter += 1;
+
+		/* We've done part of the buffer. */
+		buf += bytes_to_provide;
+		buflen -= bytes_to_provide;
+	}
+
+	/* Success! */
+	return (0);
+
+err0:
+	/* Failure! */
+	return (-1);
+}
+
+/**
+ * crypto_entropy_thread_free(void):
+ * Free the generator belonging to the calling thread, if any.  This happens
+ * automatically when a thread exits, but not when the process exits.
+ */
+void
+crypto_entropy_thread_free(void)
+{
+	struct thread_state * st;
+
+	/* Nothing to do if we can't have any state. */
+	if (pthread_once(&key_once, key_init) || !key_ok)
+		return;
+	if ((st = pthread_getspecific(key)) == NULL)
+		return;
+
+	/* Detach and free the state. */
+	(void)pthread_setspecific(key, NULL);
+	destroy(st);
+}
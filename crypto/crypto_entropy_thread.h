@@ -0,0 +1,24 @@
+#ifndef _CRYPTO_ENTROPY_THREAD_H_
+#define _CRYPTO_ENTROPY_THREAD_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * crypto_entropy_thread_read(buf, buflen):
+ * Fill the buffer with unpredictable bits.  Like crypto_entropy_read(), this
+ * may be called from several threads at once; but rather than taking a lock
+ * for every request, each thread has its own generator, which is seeded from
+ * crypto_entropy_read() and is never shared with other threads or with child
+ * processes.
+ */
+int crypto_entropy_thread_read(uint8_t *, size_t);
+
+/**
+ * crypto_entropy_thread_free(void):
+ * Free the generator belonging to the calling thread, if any.  This happens
+ * automatically when a thread exits, but not when the process exits.
+ */
+void crypto_entropy_thread_free(void);
+
+#endif /* !_CRYPTO_ENTROPY_THREAD_H_ */
@@ -0,0 +1,251 @@
+#include <stdint.h>
+#include <string.h>
+
+#include "insecure_memzero.h"
+#include "sysendian.h"
+
+#include "crypto_poly1305.h"
+
+/**
+ * Values modulo 2^130 - 5 are held as five 26-bit limbs, so that products of
+ * limbs fit comfortably into 64 bits and the reduction (multiplying the part
+ * above 2^130 by 5) can be folded into the multiplication.  No operations
+ * depend on secret data in their timing.
+ */
+
+#define MASK26 0x3ffffff
+
+/* Absorb ${nblocks} 16-byte blocks, adding ${hibit} at bit 128 of each. */
+static void
+poly1305_blocks(struct crypto_poly1305_ctx * ctx, const uint8_t * buf,
+    size_t nblocks, uint32_t hibit)
+{
+	uint32_t r0 = ctx->r[0], r1 = ctx->r[1], r2 = ctx->r[2];
+	uint32_t r3 = ctx->r[3], r4 = ctx->r[4];
+	uint32_t s1 = r1 * 5, s2 = r2 * 5, s3 = r3 * 5, s4 = r4 * 5;
+	uint32_t h0 = ctx->h[0], h1 = ctx->h[1], h2 = ctx->h[2];
+	uint32_t h3 = ctx->h[3], h4 = ctx->h[4];
+	uint64_t d0, d1, d2, d3, d4;
+	uint32_t c;
+
+	for (; nblocks > 0; nblocks--) {
+		/* h += m. */
+		h0 += le32dec(&buf[0]) & MASK26;
+		h1 += (le32dec(&buf[3]) >> 2) & MASK26;
+		h2 += (le32dec(&buf[6]) >> 4) & MASK26;
+		h3 += (le32dec(&buf[9]) >> 6) & MASK26;
+		h4 += (le32dec(&buf[12]) >> 8) | hibit;
+
+		/* h *= r, with partial reduction. */
+		d0 = (uint64_t)h0 * r0 + (uint64_t)h1 * s4 +
+		    (uint64_t)h2 * s3 + (uint64_t)h3 * s2 + (uint64_t)h4 * s1;
+		d1 = (uint64_t)h0 * r1 + (uint64_t)h1 * r0 +
+		    (uint64_t)h2 * s4 + (uint64_t)h3 * s3 + (uint64_t)h4 * s2;
+		d2 = (uint64_t)h0 * r2 + (uint64_t)h1 * r1 +
+		    (uint64_t)h2 * r0 + (uint64_t)h3 * s4 + (uint64_t)h4 * s3;
+		d3 = (uint64_t)h0 * r3 + (uint64_t)h1 * r2 +
+		    (uint64_t)h2 * r1 + (uint64_t)h3 * r0 + (uint64_t)h4 * s4;
+		d4 = (uint64_t)h0 * r4 + (uint64_t)h1 * r3 +
+		    (uint64_t)h2 * r2 + (uint64_t)h3 * r1 + (uint64_t)h4 * r0;
+
+		/* Carry back into 26-bit limbs. */
+		c = (uint32_t)(d0 >> 26);
+		h0 = (uint32_t)d0 & MASK26;
+		d1 += c;
+		c = (uint32_t)(d1 >> 26);
+		h1 = (uint32_t)d1 & MASK26;
+		d2 += c;
+		c = (uint32_t)(d2 >> 26);
+		h2 = (uint32_t)d2 & MASK26;
+		d3 += c;
+		c = (uint32_t)(d3 >> 26);
+		h3 = (uint32_t)d3 & MASK26;
+		d4 += c;
+		c = (uint32_t)(d4 >> 26);
+		h4 = (uint32_t)d4 & MASK26;
+		h0 += c * 5;
+		c = h0 >> 26;
+		h0 &= MASK26;
+		h1 += c;
+
+		/* Move to the next block. */
+		buf += 16;
+	}
+
+	/* Save the accumulator. */
+	ctx->h[0] = h0;
+	ctx->h[1] = h1;
+	ctx->h[2] = h2;
+	ctx->h[3] = h3;
+	ctx->h[4] = h4;
+}
+
+/**
+ * crypto_poly1305_init(ctx, key):
+ * Initialize the Poly1305 context ${ctx} with the 32-byte one-time ${key}.
+ */
+void
+crypto_poly1305_init(struct crypto_poly1305_ctx * ctx, const uint8_t key[32])
+{
+	int i;
+
+	/* r = key[0..15], with some bits cleared ("clamped"). */
+	ctx->r[0] = le32dec(&key[0]) & 0x3ffffff;
+	ctx->r[1] = (le32dec(&key[3]) >> 2) & 0x3ffff03;
+	ctx->r[2] = (le32dec(&key[6]) >> 4) & 0x3ffc0ff;
+	ctx->r[3] = (le32dec(&key[9]) >> 6) & 0x3f03fff;
+	ctx->r[4] = (le32dec(&key[12]) >> 8) & 0x00fffff;
+
+	/* The accumulator starts at zero. */
+	for (i = 0; i < 5; i++)
+		ctx->h[i] = 0;
+
+	/* s = key[16..31] is added at the end. */
+	for (i = 0; i < 4; i++)
+		ctx->pad[i] = le32dec(&key[16 + 4 * i]);
+
+	/* No data buffered yet. */
+	ctx->buflen = 0;
+}
+
+/**
+ * crypto_poly1305_update(ctx, buf, buflen):
+ * Input ${buflen} bytes from ${buf} into the Poly1305 context ${ctx}.
+ */
+void
+crypto_poly1305_update(struct crypto_poly1305_ctx * ctx, const uint8_t * buf,
+    size_t buflen)
+{
+	size_t nbytes;
+
+	/* Nothing to do? */
+	if (buflen == 0)
+		return;
+
+	/* Fill any partial block first. */
+	if (ctx->buflen > 0) {
+		nbytes = 16 - ctx->buflen;
+		if (nbytes > buflen)
+			nbytes = buflen;
+		memcpy(&ctx->buf[ctx->buflen], buf, nbytes);
+		ctx->buflen += nbytes;
+		buf += nbytes;
+		buflen -= nbytes;
+
+		/* Absorb the block if it is complete. */
+		if (ctx->buflen < 16)
+			return;
+		poly1305_blocks(ctx, ctx->buf, 1, 1 << 24);
+		ctx->buflen = 0;
+	}
+
+	/* Absorb whole blocks. */
+	poly1305_blocks(ctx, buf, buflen / 16, 1 << 24);
+	buf += buflen & ~(size_t)15;
+	buflen &= 15;
+
+	/* Save any remaining bytes. */
+	memcpy(ctx->buf, buf, buflen);
+	ctx->buflen = buflen;
+}
+
+/**
+ * crypto_poly1305_final(ctx, tag):
+ * Output the Poly1305 authenticator of the data input to the context ${ctx}
+ * into the buffer ${tag}, and clear the context state.
+ */
+void
+crypto_poly1305_final(struct crypto_poly1305_ctx * ctx, uint8_t tag[16])
+{
+	uint32_t h0, h1, h2, h3, h4;
+	uint32_t g0, g1, g2, g3, g4;
+	uint32_t c, mask;
+	uint64_t f;
+
+	/* Absorb any final partial block, padded with 0x01 0x00 ... */
+	if (ctx->buflen > 0) {
+		ctx->buf[ctx->buflen] = 1;
+		memset(&ctx->buf[ctx->buflen + 1], 0, 15 - ctx->buflen);
+		poly1305_blocks(ctx, ctx->buf, 1, 0);
+	}
+
+	/* Fully carry h. */
+	h0 = ctx->h[0];
+	h1 = ctx->h[1];
+	h2 = ctx->h[2];
+	h3 = ctx->h[3];
+	h4 = ctx->h[4];
+	c = h1 >> 26;
+	h1 &= MASK26;
+	h2 += c;
+	c = h2 >> 26;
+	h2 &= MASK26;
+	h3 += c;
+	c = h3 >> 26;
+	h3 &= MASK26;
+	h4 += c;
+	c = h4 >> 26;
+	h4 &= MASK26;
+	h0 += c * 5;
+	c = h0 >> 26;
+	h0 &= MASK26;
+	h1 += c;
+
+	/* Compute g = h - (2^130 - 5) = h + 5 - 2^130. */
+	g0 = h0 + 5;
+	c = g0 >> 26;
+	g0 &= MASK26;
+	g1 = h1 + c;
+	c = g1 >> 26;
+	g1 &= MASK26;
+	g2 = h2 + c;
+	c = g2 >> 26;
+	g2 &= MASK26;
+	g3 = h3 + c;
+	c = g3 >> 26;
+	g3 &= MASK26;
+	g4 = h4 + c - (1 << 26);
+
+	/* Select h if g is negative (i.e., h < p), or g otherwise. */
+	mask = (g4 >> 31) - 1;
+	h0 = (h0 & ~mask) | (g0 & mask);
+	h1 = (h1 & ~mask) | (g1 & mask);
+	h2 = (h2 & ~mask) | (g2 & mask);
+	h3 = (h3 & ~mask) | (g3 & mask);
+	h4 = (h4 & ~mask) | (g4 & mask);
+
+	/* Convert h to four 32-bit words, modulo 2^128. */
+	h0 = h0 | (h1 << 26);
+	h1 = (h1 >> 6) | (h2 << 20);
+	h2 = (h2 >> 12) | (h3 << 14);
+	h3 = (h3 >> 18) | (h4 << 8);
+
+	/* tag = h + s, modulo 2^128. */
+	f = (uint64_t)h0 + ctx->pad[0];
+	le32enc(&tag[0], (uint32_t)f);
+	f = (uint64_t)h1 + ctx->pad[1] + (f >> 32);
+	le32enc(&tag[4], (uint32_t)f);
+	f = (uint64_t)h2 + ctx->pad[2] + (f >> 32);
+	le32enc(&tag[8], (uint32_t)f);
+	f = (uint64_t)h3 + ctx->pad[3] + (f >> 32);
+	le32enc(&tag[12], (uint32_t)f);
+
+	/* Clear the context state. */
+	insecure_memzero(ctx, sizeof(struct crypto_poly1305_ctx));
+}
+
+/**
+ * crypto_poly1305_buf(key, buf, buflen, tag):
+ * Compute the Poly1305 authenticator of ${buflen} bytes from ${buf} using the
+ * one-time ${key}, and write it to ${tag}.
+ */
+void
+crypto_poly1305_buf(const uint8_t key[32], const uint8_t * buf, size_t buflen,
+    uint8_t tag[16])
+{
+	struct crypto_poly1305_ctx ctx;
+
+	crypto_poly1305_init(&ctx, key);
+	crypto_poly1305_update(&ctx, buf, buflen);
+	crypto_poly1305_final(&ctx, tag);
+}
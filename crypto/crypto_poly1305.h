@@ -0,0 +1,44 @@
+#ifndef _CRYPTO_POLY1305_H_
+#define _CRYPTO_POLY1305_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* Context structure for Poly1305 operations. */
+struct crypto_poly1305_ctx {
+	uint32_t r[5];
+	uint32_t h[5];
+	uint32_t pad[4];
+	uint8_t buf[16];
+	size_t buflen;
+};
+
+/**
+ * crypto_poly1305_init(ctx, key):
+ * Initialize the Poly1305 context ${ctx} with the 32-byte one-time ${key}.
+ */
+void crypto_poly1305_init(struct crypto_poly1305_ctx *, const uint8_t[32]);
+
+/**
+ * crypto_poly1305_update(ctx, buf, buflen):
+ * Input ${buflen} bytes from ${buf} into the Poly1305 context ${ctx}.
+ */
+void crypto_poly1305_update(struct crypto_poly1305_ctx *, const uint8_t *,
+    size_t);
+
+/**
+ * crypto_poly1305_final(ctx, tag):
+ * Output the Poly1305 authenticator of the data input to the context ${ctx}
+ * into the buffer ${tag}, and clear the context state.
+ */
+void crypto_poly1305_final(struct crypto_poly1305_ctx *, uint8_t[16]);
+
+/**
+ * crypto_poly1305_buf(key, buf, buflen, tag):
+ * Compute the Poly1305 authenticator of ${buflen} bytes from ${buf} using the
+ * one-time ${key}, and write it to ${tag}.
+ */
+void crypto_poly1305_buf(const uint8_t[32], const uint8_t *, size_t,
+    uint8_t[16]);
+
+#endif /* !_CRYPTO_POLY1305_H_ */
@@ -1,8 +1,62 @@
 #include <stddef.h>
 #include <stdint.h>
+#include <string.h>
 
 #include "crypto_verify_bytes.h"
 
+/**
+ * Buffers are compared a 64-bit word at a time, accumulating the XOR of
+ * corresponding words; only at the end is the accumulator folded down into a
+ * single byte.  No branches or memory accesses depend on the buffer contents,
+ * and there is no state, so this is safe to call from any thread.
+ */
+
+/* Accumulate the differences between ${nwords} 8-byte words. */
+static uint64_t
+verify_words(const uint8_t * buf0, const uint8_t * buf1, size_t nwords)
+{
+	uint64_t acc = 0;
+	uint64_t w0, w1;
+	size_t i;
+
+	for (i = 0; i < nwords; i++) {
+		memcpy(&w0, &buf0[8 * i], 8);
+		memcpy(&w1, &buf1[8 * i], 8);
+		acc |= w0 ^ w1;
+	}
+
+	return (acc);
+}
+
+/* Accumulate the differences between the buffers. */
+static uint64_t
+verify(const uint8_t * buf0, const uint8_t * buf1, size_t len)
+{
+	uint64_t acc;
+	size_t pos;
+
+	/* Process whole words. */
+	acc = verify_words(buf0, buf1, len / 8);
+	pos = len & ~(size_t)7;
+
+	/* Process any remaining bytes. */
+	for (; pos < len; pos++)
+		acc |= (uint64_t)(buf0[pos] ^ buf1[pos]);
+
+	return (acc);
+}
+
+/* Fold ${acc} into a byte which is zero if and only if ${acc} is zero. */
+static uint8_t
+fold(uint64_t acc)
+{
+
+	acc |= acc >> 32;
+	acc |= acc >> 16;
+	acc |= acc >> 8;
+	return ((uint8_t)acc);
+}
+
 /**
  * crypto_verify_bytes(buf0, buf1, len):
  * Return zero if and only if ${buf0[0 .. len - 1]} and ${buf1[0 .. len - 1]}
@@ -11,11 +65,33 @@
 uint8_t
 crypto_verify_bytes(const uint8_t * buf0, const uint8_t * buf1, size_t len)
 {
-	uint8_t rc = 0;
+
+	return (fold(verify(buf0, buf1, len)));
+}
+
+/**
+ * crypto_verify_bytes_batch(bufs0, bufs1, len, n, results):
+ * For each i < ${n}, compare the ${len} bytes at ${bufs0[i]} and ${bufs1[i]}
+ * as crypto_verify_bytes() would, and if ${results} is not NULL, store the
+ * result in ${results[i]}.  Return zero if and only if all ${n} pairs are
+ * identical.  Do not leak any information via timing side channels, other
+ * than via the per-pair ${results}.
+ */
+uint8_t
+crypto_verify_bytes_batch(const uint8_t * const * bufs0,
+    const uint8_t * const * bufs1, size_t len, size_t n, uint8_t * results)
+{
+	uint64_t acc = 0;
+	uint8_t rc;
 	size_t i;
 
-	for (i = 0; i < len; i++)
-		rc = rc | (buf0[i] ^ buf1[i]);
+	/* Compare each pair, keeping the combined result. */
+	for (i = 0; i < n; i++) {
+		rc = fold(verify(bufs0[i], bufs1[i], len));
+		if (results != NULL)
+			results[i] = rc;
+		acc |= rc;
+	}
 
-	return (rc);
+	return ((uint8_t)acc);
 }
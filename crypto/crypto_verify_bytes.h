@@ -11,4 +11,15 @@
  */
 uint8_t crypto_verify_bytes(const uint8_t *, const uint8_t *, size_t);
 
+/**
+ * crypto_verify_bytes_batch(bufs0, bufs1, len, n, results):
+ * For each i < ${n}, compare the ${len} bytes at ${bufs0[i]} and ${bufs1[i]}
+ * as crypto_verify_bytes() would, and if ${results} is not NULL, store the
+ * result in ${results[i]}.  Return zero if and only if all ${n} pairs are
+ * identical.  Do not leak any information via timing side channels, other
+ * than via the per-pair ${results}.
+ */
+uint8_t crypto_verify_bytes_batch(const uint8_t * const *,
+    const uint8_t * const *, size_t, size_t, uint8_t *);
+
 #endif /* !_CRYPTO_VERIFY_BYTES_H_ */
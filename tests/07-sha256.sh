@@ -3,6 +3,7 @@
 ### Constants
 c_valgrind_min=1
 test_output="${s_basename}-stdout.txt"
+first_output="${s_basename}-first-stdout.txt"
 
 ### Actual command
 scenario_cmd() {
@@ -12,4 +13,10 @@ scenario_cmd() {
 	${c_valgrind_cmd}			\
 	    ./test_sha256 -x 1> ${test_output}
 	echo "$?" > ${c_exitfile}
+
+	# Check threaded PBKDF2 when it makes the first use of SHA256.
+	setup_check_variables "test_sha256 -p"
+	${c_valgrind_cmd}			\
+	    ./test_sha256 -p 1> ${first_output}
+	echo "$?" > ${c_exitfile}
 }
@@ -3,6 +3,7 @@
 ### Constants
 c_valgrind_min=1
 test_output="${s_basename}-stdout.txt"
+forced_output="${s_basename}-forced-stdout.txt"
 
 ### Actual command
 scenario_cmd() {
@@ -12,4 +13,10 @@ scenario_cmd() {
 	${c_valgrind_cmd}			\
 	    ./test_crypto_aes -x 1> ${test_output}
 	echo "$?" > ${c_exitfile}
+
+	# Check the software implementation even if we have hardware AES.
+	setup_check_variables "test_crypto_aes -f openssl"
+	${c_valgrind_cmd}			\
+	    ./test_crypto_aes -f openssl 1> ${forced_output}
+	echo "$?" > ${c_exitfile}
 }
@@ -0,0 +1,15 @@
+#!/bin/sh
+
+### Constants
+c_valgrind_min=1
+test_output="${s_basename}-stdout.txt"
+
+### Actual command
+scenario_cmd() {
+	cd ${scriptdir}/crypto_dh || exit
+
+	setup_check_variables "test_crypto_dh"
+	${c_valgrind_cmd}			\
+	    ./test_crypto_dh -x 1> ${test_output}
+	echo "$?" > ${c_exitfile}
+}
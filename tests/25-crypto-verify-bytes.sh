@@ -0,0 +1,15 @@
+#!/bin/sh
+
+### Constants
+c_valgrind_min=1
+test_output="${s_basename}-stdout.txt"
+
+### Actual command
+scenario_cmd() {
+	cd ${scriptdir}/crypto_verify_bytes || exit
+
+	setup_check_variables "test_crypto_verify_bytes"
+	${c_valgrind_cmd}			\
+	    ./test_crypto_verify_bytes -x 1> ${test_output}
+	echo "$?" > ${c_exitfile}
+}
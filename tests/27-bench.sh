@@ -0,0 +1,15 @@
+#!/bin/sh
+
+### Constants
+c_valgrind_min=1
+test_output="${s_basename}-stdout.txt"
+
+### Actual command
+scenario_cmd() {
+	cd ${scriptdir}/bench || exit
+
+	setup_check_variables "test_bench"
+	${c_valgrind_cmd}			\
+	    ./test_bench -q 1> ${test_output}
+	echo "$?" > ${c_exitfile}
+}
@@ -0,0 +1,524 @@
+#include <sys/time.h>
+#include <sys/wait.h>
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "crc32c.h"
+#include "crypto_aes.h"
+#include "crypto_aesctr.h"
+#include "crypto_aesgcm.h"
+#include "crypto_chacha20.h"
+#include "crypto_chacha20poly1305.h"
+#include "crypto_poly1305.h"
+#include "getopt.h"
+#include "hwaccel.h"
+#include "md5.h"
+#include "monoclock.h"
+#include "parsenum.h"
+#include "sha1.h"
+#include "sha256.h"
+#include "warnp.h"
+
+/* Message sizes for measuring latency, and for measuring throughput. */
+static const size_t smallsizes[] = {16, 64, 256, 1024};
+#define LARGESIZE 1048576
+
+/* Keys and nonces; their values don't matter. */
+static uint8_t key32[32];
+static uint8_t nonce12[12];
+static struct crypto_aes_key * aes128;
+static struct crypto_aes_key * aes256;
+static HMAC_SHA256_KEY hmac_key;
+
+/* Process ${len} bytes from ${in}, writing output (if any) to ${out}. */
+typedef void bench_func(const uint8_t *, uint8_t *, size_t);
+
+static void
+bench_sha256(const uint8_t * in, uint8_t * out, size_t len)
+{
+
+	SHA256_Buf(in, len, out);
+}
+
+static void
+bench_sha256_public(const uint8_t * in, uint8_t * out, size_t len)
+{
+
+	SHA256_Buf_public(in, len, out);
+}
+
+static void
+bench_hmac_sha256(const uint8_t * in, uint8_t * out, size_t len)
+{
+
+	HMAC_SHA256_Buf(key32, 32, in, len, out);
+}
+
+static void
+bench_hmac_sha256_prekeyed(const uint8_t * in, uint8_t * out, size_t len)
+{
+
+	HMAC_SHA256_Buf_prekeyed(&hmac_key, in, len, out);
+}
+
+static void
+bench_sha1(const uint8_t * in, uint8_t * out, size_t len)
+{
+
+	SHA1_Buf(in, len, out);
+}
+
+static void
+bench_md5(const uint8_t * in, uint8_t * out, size_t len)
+{
+
+	MD5_Buf(in, len, out);
+}
+
+static void
+bench_crc32c(const uint8_t * in, uint8_t * out, size_t len)
+{
+	CRC32C_CTX ctx;
+
+	CRC32C_Init(&ctx);
+	CRC32C_Update(&ctx, in, len);
+	CRC32C_Final(out, &ctx);
+}
+
+static void
+bench_poly1305(const uint8_t * in, uint8_t * out, size_t len)
+{
+
+	crypto_poly1305_buf(key32, in, len, out);
+}
+
+static void
+bench_aes128(const uint8_t * in, uint8_t * out, size_t len)
+{
+	size_t i;
+
+	for (i = 0; i + 16 <= len; i += 16)
+		crypto_aes_encrypt_block(&in[i], &out[i], aes128);
+}
+
+static void
+bench_aes256(const uint8_t * in, uint8_t * out, size_t len)
+{
+	size_t i;
+
+	for (i = 0; i + 16 <= len; i += 16)
+		crypto_aes_encrypt_block(&in[i], &out[i], aes256);
+}
+
+static void
+bench_aes256_ctr(const uint8_t * in, uint8_t * out, size_t len)
+{
+
+	crypto_aesctr_buf(aes256, 0, in, out, len);
+}
+
+static void
+bench_aes256_gcm(const uint8_t * in, uint8_t * out, size_t len)
+{
+
+	crypto_aesgcm_encrypt_buf(aes256, nonce12, NULL, 0, in, out, len,
+	    &out[len]);
+}
+
+static void
+bench_chacha20(const uint8_t * in, uint8_t * out, size_t len)
+{
+
+	crypto_chacha20_buf(key32, nonce12, 0, in, out, len);
+}
+
+static void
+bench_chacha20poly1305(const uint8_t * in, uint8_t * out, size_t len)
+{
+
+	crypto_chacha20poly1305_encrypt_buf(key32, nonce12, NULL, 0, in, out,
+	    len, &out[len]);
+}
+
+/*
+ * The primitives to benchmark, and the hwaccel primitive (if any) whose
+ * implementation choice they depend upon.  Those without one (md5 and
+ * poly1305) only have a software implementation.
+ */
+static const struct bench {
+	const char * name;
+	bench_func * func;
+	const char * hwprim;
+} benches[] = {
+	{"sha256", bench_sha256, "sha256"},
+	{"sha256-public", bench_sha256_public, "sha256"},
+	{"hmac-sha256", bench_hmac_sha256, "sha256"},
+	{"hmac-sha256-prekeyed", bench_hmac_sha256_prekeyed, "sha256"},
+	{"sha1", bench_sha1, "sha1"},
+	{"md5", bench_md5, NULL},
+	{"crc32c", bench_crc32c, "crc32c"},
+	{"poly1305", bench_poly1305, NULL},
+	{"aes128", bench_aes128, "aes"},
+	{"aes256", bench_aes256, "aes"},
+	{"aes256-ctr", bench_aes256_ctr, "aesctr"},
+	{"aes256-gcm", bench_aes256_gcm, "aesgcm"},
+	{"chacha20", bench_chacha20, "chacha20"},
+	{"chacha20-poly1305", bench_chacha20poly1305, "chacha20"}
+};
+
+/*
+ * Read a cycle counter, or return 0 if we don't have one.  On x86 this is
+ * the time-stamp counter, which ticks at the nominal clock rate regardless
+ * of the rate the CPU is actually running at.
+ */
+static uint64_t
+cycles(void)
+{
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+	return (__builtin_ia32_rdtsc());
+#else
+	return (0);
+#endif
+}
+
+/*
+ * Time ${func} on ${len}-byte messages from ${in}, repeating it until at
+ * least ${mintime} seconds have elapsed.  Return the time and cycles taken
+ * per message via ${ns} and ${cyc}.
+ */
+static int
+measure(bench_func * func, const uint8_t * in, uint8_t * out, size_t len,
+    double mintime, double * ns, double * cyc)
+{
+	struct timeval begin, end;
+	uint64_t c0, c1;
+	double t;
+	size_t n, i;
+
+	for (n = 1; ; n *= 2) {
+		if (monoclock_get(&begin)) {
+			warnp("monoclock_get()");
+			goto err0;
+		}
+		c0 = cycles();
+		for (i = 0; i < n; i++)
+			func(in, out, len);
+		c1 = cycles();
+		if (monoclock_get(&end)) {
+			warnp("monoclock_get()");
+			goto err0;
+		}
+		if ((t = timeval_diff(begin, end)) >= mintime)
+			break;
+	}
+
+	/* Report the cost of one message. */
+	*ns = t * 1e9 / (double)n;
+	*cyc = (double)(c1 - c0) / (double)n;
+
+	/* Success! */
+	return (0);
+
+err0:
+	/* Failure! */
+	return (-1);
+}
+
+/* Print a row of the results table. */
+static void
+print_row(const char * name, const char * backend, size_t len, double ns,
+    double cyc, double mhz)
+{
+
+	printf("%s\t%s\t%zu\t%.1f\t%.1f\t", name, backend, len, ns,
+	    (double)len * 1e3 / ns);
+	if (mhz > 0)
+		printf("%.2f\n", ns * mhz / 1e3 / (double)len);
+	else if (cyc > 0)
+		printf("%.2f\n", cyc / (double)len);
+	else
+		printf("-\n");
+}
+
+/* Benchmark ${B} on small and large messages. */
+static int
+runbench(const struct bench * B, const uint8_t * in, uint8_t * out,
+    double mintime, double mhz)
+{
+	const char * backend = NULL;
+	double ns, cyc;
+	size_t i;
+
+	/* Warm up. */
+	if (measure(B->func, in, out, LARGESIZE, mintime / 2, &ns, &cyc))
+		goto err0;
+
+	/* Which implementation did we end up using? */
+	if (B->hwprim != NULL)
+		backend = hwaccel_selected(B->hwprim);
+	if (backend == NULL)
+		backend = "auto";
+
+	/* Small-message latency. */
+	for (i = 0; i < sizeof(smallsizes) / sizeof(smallsizes[0]); i++) {
+		if (measure(B->func, in, out, smallsizes[i], mintime, &ns,
+		    &cyc))
+			goto err0;
+		print_row(B->name, backend, smallsizes[i], ns, cyc, mhz);
+	}
+
+	/* Large-buffer throughput. */
+	if (measure(B->func, in, out, LARGESIZE, mintime, &ns, &cyc))
+		goto err0;
+	print_row(B->name, backend, LARGESIZE, ns, cyc, mhz);
+
+	/* Success! */
+	return (0);
+
+err0:
+	/* Failure! */
+	return (-1);
+}
+
+/*
+ * Benchmark ${B} once with each usable implementation of its hwaccel
+ * primitive, by running ${argv0} again with the implementation forced.  The
+ * choice can't be changed within this process, since (e.g.) the format of
+ * expanded AES keys depends upon it.
+ */
+static int
+runbench_impls(const struct bench * B, const char * argv0, double mintime,
+    double mhz)
+{
+	char hwspec[64];
+	char mtime[32];
+	char clock[32];
+	const char * args[8];
+	const char * impl;
+	size_t i, j;
+	pid_t pid;
+	int status;
+
+	for (i = 0; (impl = hwaccel_candidate(B->hwprim, i)) != NULL; i++) {
+		/* Construct the command line. */
+		snprintf(hwspec, sizeof(hwspec), "%s=%s", B->hwprim, impl);
+		snprintf(mtime, sizeof(mtime), "%.17g", mintime);
+		snprintf(clock, sizeof(clock), "%.17g", mhz);
+		j = 0;
+		args[j++] = argv0;
+		args[j++] = "-H";
+		args[j++] = "-m";
+		args[j++] = mtime;
+		if (mhz > 0) {
+			args[j++] = "-c";
+			args[j++] = clock;
+		}
+		args[j++] = B->name;
+		args[j] = NULL;
+
+		/* Don't let the child repeat our buffered output. */
+		fflush(stdout);
+
+		/* Run the benchmark with this implementation. */
+		if ((pid = fork()) == -1) {
+			warnp("fork");
+			goto err0;
+		}
+		if (pid == 0) {
+			if (setenv("LIBCPERCIVA_HWACCEL", hwspec, 1)) {
+				warnp("setenv");
+				_exit(1);
+			}
+			/* Safe: exec does not modify its arguments. */
+			execvp(argv0, (char * const *)(uintptr_t)args);
+			warnp("execvp(%s)", argv0);
+			_exit(1);
+		}
+
+		/* Wait for it to finish. */
+		if (waitpid(pid, &status, 0) == -1) {
+			warnp("waitpid");
+			goto err0;
+		}
+		if (!WIFEXITED(status) || (WEXITSTATUS(status) != 0)) {
+			warn0("Benchmark of %s using %s failed", B->name, impl);
+			goto err0;
+		}
+	}
+
+	/* Success! */
+	return (0);
+
+err0:
+	/* Failure! */
+	return (-1);
+}
+
+static void
+usage(void)
+{
+
+	fprintf(stderr, "usage: test_bench [-c MHz] [-m mintime] [-q]"
+	    " [primitive ...]\n");
+	exit(1);
+}
+
+/*
+ * Run the benchmarks for the ${argc} primitives listed in ${argv}, or all of
+ * them if ${argc} is zero.  This is separate from main() so that none of its
+ * variables are live across the setjmp() in GETOPT.
+ */
+static int
+runbenches(const char * argv0, int argc, char * argv[], double mintime,
+    double mhz, int header)
+{
+	uint8_t * in;
+	uint8_t * out;
+	int allimpls;
+	size_t i;
+	int j;
+
+	/* Check that we know about all the requested primitives. */
+	for (j = 0; j < argc; j++) {
+		for (i = 0; i < sizeof(benches) / sizeof(benches[0]); i++) {
+			if (strcmp(argv[j], benches[i].name) == 0)
+				break;
+		}
+		if (i == sizeof(benches) / sizeof(benches[0])) {
+			warn0("Unknown primitive: %s", argv[j]);
+			usage();
+		}
+	}
+
+	/* Allocate buffers, with space for authentication tags. */
+	if ((in = calloc(LARGESIZE, 1)) == NULL) {
+		warnp("calloc");
+		goto err0;
+	}
+	if ((out = malloc(LARGESIZE + 32)) == NULL) {
+		warnp("malloc");
+		goto err1;
+	}
+
+	/* Set up keys. */
+	if ((aes128 = crypto_aes_key_expand(key32, 16)) == NULL) {
+		warn0("crypto_aes_key_expand");
+		goto err2;
+	}
+	if ((aes256 = crypto_aes_key_expand(key32, 32)) == NULL) {
+		warn0("crypto_aes_key_expand");
+		goto err3;
+	}
+	HMAC_SHA256_Key_Init(&hmac_key, key32, 32);
+
+	/*
+	 * Benchmark every implementation of each primitive, unless we're
+	 * benchmarking a single implementation or the implementation choice
+	 * has been overridden.
+	 */
+	allimpls = header && (getenv("LIBCPERCIVA_HWACCEL") == NULL) &&
+	    (getenv("LIBCPERCIVA_HWACCEL_MEASURE") == NULL);
+
+	/* Run the benchmarks. */
+	if (header)
+		printf("# primitive\tbackend\tsize\tns/op\tMB/s\tcycles/B\n");
+	for (i = 0; i < sizeof(benches) / sizeof(benches[0]); i++) {
+		/* Skip primitives we weren't asked to benchmark. */
+		for (j = 0; j < argc; j++) {
+			if (strcmp(argv[j], benches[i].name) == 0)
+				break;
+		}
+		if ((argc > 0) && (j == argc))
+			continue;
+
+		/* Benchmark the default implementation... */
+		if ((benches[i].hwprim == NULL) || !allimpls) {
+			if (runbench(&benches[i], in, out, mintime, mhz))
+				goto err4;
+			continue;
+		}
+
+		/* ... or make sure one is chosen, then try all of them. */
+		benches[i].func(in, out, 16);
+		if (runbench_impls(&benches[i], argv0, mintime, mhz))
+			goto err4;
+	}
+
+	/* Clean up. */
+	crypto_aes_key_free(aes256);
+	crypto_aes_key_free(aes128);
+	free(out);
+	free(in);
+
+	/* Success! */
+	return (0);
+
+err4:
+	crypto_aes_key_free(aes256);
+err3:
+	crypto_aes_key_free(aes128);
+err2:
+	free(out);
+err1:
+	free(in);
+err0:
+	/* Failure! */
+	return (-1);
+}
+
+int
+main(int argc, char * argv[])
+{
+	const char * ch;
+
+	/* These are static so the setjmp() in GETOPT can't clobber them. */
+	static double mintime = 0.1;
+	static double mhz = 0;
+	static int header = 1;
+
+	WARNP_INIT;
+
+	/* Process arguments. */
+	while ((ch = GETOPT(argc, argv)) != NULL) {
+		GETOPT_SWITCH(ch) {
+		GETOPT_OPTARG("-c"):
+			if (PARSENUM(&mhz, optarg, 1, 1e6)) {
+				warnp("Invalid clock rate: %s", optarg);
+				exit(1);
+			}
+			break;
+		GETOPT_OPTARG("-m"):
+			if (PARSENUM(&mintime, optarg, 0, 1e3)) {
+				warnp("Invalid time: %s", optarg);
+				exit(1);
+			}
+			break;
+		GETOPT_OPT("-H"):
+			/* Undocumented: Benchmark one implementation. */
+			header = 0;
+			break;
+		GETOPT_OPT("-q"):
+			mintime = 0;
+			break;
+		GETOPT_MISSING_ARG:
+			warn0("Missing argument to %s", ch);
+			usage();
+		GETOPT_DEFAULT:
+			usage();
+		}
+	}
+
+	/* Run the benchmarks. */
+	if (runbenches(argv[0], argc - optind, &argv[optind], mintime, mhz,
+	    header))
+		exit(1);
+
+	/* Success! */
+	exit(0);
+}
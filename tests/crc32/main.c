@@ -12,9 +12,12 @@
 #include "warnp.h"
 
 #include "crc32c.h"
+#include "crc32c_parallel.h"
 
 #define LARGE_BUFSIZE 65536
 #define MAX_CHUNK 256
+#define PARALLEL_BUFSIZE (1 << 22)
+#define PARALLEL_NTHREADS 5
 
 static struct testcase {
 	const char * s;
@@ -48,6 +51,17 @@ print_hardware(const char * str)
 
 	/* ... and whether we're using hardware acceleration or not. */
 #if defined(CPUSUPPORT_CONFIG_FILE)
+#if defined(CPUSUPPORT_X86_PCLMUL) && defined(CPUSUPPORT_X86_SSE42_64)
+#if defined(CPUSUPPORT_X86_VPCLMUL)
+	if (cpusupport_x86_vpclmul() && cpusupport_x86_pclmul() &&
+	    cpusupport_x86_sse42())
+		printf(" using hardware VPCLMULQDQ folding.\n");
+	else
+#endif
+	if (cpusupport_x86_pclmul() && cpusupport_x86_sse42())
+		printf(" using hardware PCLMULQDQ folding.\n");
+	else
+#endif
 #if defined(CPUSUPPORT_X86_SSE42_64)
 	if (cpusupport_x86_sse42())
 		printf(" using hardware CRC32 64-bit.\n");
@@ -58,6 +72,11 @@ print_hardware(const char * str)
 		printf(" using hardware CRC32 32-bit.\n");
 	else
 #endif
+#if defined(CPUSUPPORT_ARM_PMULL) && defined(CPUSUPPORT_ARM_CRC32_64)
+	if (cpusupport_arm_pmull() && cpusupport_arm_crc32_64())
+		printf(" using hardware PMULL folding.\n");
+	else
+#endif
 #if defined(CPUSUPPORT_ARM_CRC32_64)
 	if (cpusupport_arm_crc32_64())
 		printf(" using hardware CRC32.\n");
@@ -137,6 +156,7 @@ selftest(void)
 	size_t bytes_processed;
 	size_t new_chunk;
 	uint8_t alt_buf[4];
+	uint8_t cbuf_b[4];
 
 	/* Run regular test cases. */
 	for (i = 0; i < sizeof(tests) / sizeof(tests[0]); i++) {
@@ -163,10 +183,14 @@ selftest(void)
 	/* Test with a large buffer and unaligned access. */
 	printf("Computing CRC32C of a large buffer two different ways...");
 
-	/* Prepare a large buffer with repeating 01010101_2 = 85. */
+	/*
+	 * Prepare a large buffer with a non-repeating pattern, so that the
+	 * order in which pieces of it are processed matters.
+	 */
 	if ((largebuf = malloc(LARGE_BUFSIZE)) == NULL)
 		goto err0;
-	memset(largebuf, 85, LARGE_BUFSIZE);
+	for (i = 0; i < LARGE_BUFSIZE; i++)
+		largebuf[i] = (char)((i * i + (i >> 8)) & 0xff);
 
 	/* Compute checksum with one call. */
 	CRC32C_Init(&ctx);
@@ -197,6 +221,55 @@ selftest(void)
 	} else
 		printf(" PASSED!\n");
 
+	/* Combine the checksums of two pieces of the buffer. */
+	printf("Combining CRC32Cs of pieces of a large buffer...");
+	for (i = 0; i <= LARGE_BUFSIZE; i += (i < 16) ? 1 : 4093) {
+		CRC32C_Init(&ctx);
+		CRC32C_Update(&ctx, (const uint8_t *)largebuf, i);
+		CRC32C_Final(alt_buf, &ctx);
+		CRC32C_Init(&ctx);
+		CRC32C_Update(&ctx, (const uint8_t *)&largebuf[i],
+		    LARGE_BUFSIZE - i);
+		CRC32C_Final(cbuf_b, &ctx);
+		CRC32C_Combine(alt_buf, cbuf_b, LARGE_BUFSIZE - i, alt_buf);
+		if (memcmp(cbuf, alt_buf, 4))
+			break;
+	}
+	if (i <= LARGE_BUFSIZE) {
+		printf(" FAILED!\n");
+		failures++;
+	} else
+		printf(" PASSED!\n");
+
+	/* Clean up. */
+	free(largebuf);
+
+	/*
+	 * Compute the checksum of a larger buffer using varying numbers of
+	 * threads, and compare it to the single-threaded checksum.
+	 */
+	printf("Computing CRC32C of a large buffer in parallel...");
+	if ((largebuf = malloc(PARALLEL_BUFSIZE)) == NULL)
+		goto err0;
+	for (i = 0; i < PARALLEL_BUFSIZE; i++)
+		largebuf[i] = (char)((i * i + (i >> 8)) & 0xff);
+	for (i = 0; i <= PARALLEL_NTHREADS; i++) {
+		if (CRC32C_Buf_parallel((const uint8_t *)&largebuf[i],
+		    PARALLEL_BUFSIZE - i * i, alt_buf, i))
+			goto err1;
+		CRC32C_Init(&ctx);
+		CRC32C_Update(&ctx, (const uint8_t *)&largebuf[i],
+		    PARALLEL_BUFSIZE - i * i);
+		CRC32C_Final(cbuf_b, &ctx);
+		if (memcmp(cbuf_b, alt_buf, 4))
+			break;
+	}
+	if (i <= PARALLEL_NTHREADS) {
+		printf(" FAILED!\n");
+		failures++;
+	} else
+		printf(" PASSED!\n");
+
 	/* Clean up. */
 	free(largebuf);
 
@@ -206,6 +279,8 @@ selftest(void)
 	else
 		return (0);
 
+err1:
+	free(largebuf);
 err0:
 	/* Failure! */
 	return (1);
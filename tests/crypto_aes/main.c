@@ -11,6 +11,7 @@
 #include "crypto_aes.h"
 #include "getopt.h"
 #include "hexify.h"
+#include "hwaccel.h"
 #include "insecure_memzero.h"
 #include "perftest.h"
 #include "warnp.h"
@@ -274,8 +275,9 @@ err0:
 	return (1);
 }
 
+/* Check the test vectors using the implementation which has been chosen. */
 static int
-selftest(void)
+selftest_vectors(void)
 {
 	struct crypto_aes_key * key_exp;
 	uint8_t plaintext_arr[MAX_PLAINTEXT_LENGTH];
@@ -292,19 +294,6 @@ selftest(void)
 	uint8x16_t bufarm;
 #endif
 
-	/* Sanity check. */
-#ifdef CPUSUPPORT_X86_AESNI
-	if (cpusupport_x86_aesni()) {
-		if (crypto_aes_can_use_intrinsics() != 1) {
-			warn0("Unexpected error with AESNI");
-			goto err0;
-		}
-	}
-#endif
-
-	/* Inform user about the hardware optimization status. */
-	print_hardware("Checking test vectors of AES");
-
 	/* Run regular test cases. */
 	for (i = 0; i < num_tests; i++) {
 		/* Prepare for the test case. */
@@ -361,12 +350,65 @@ err0:
 	return (1);
 }
 
+static int
+selftest(void)
+{
+
+	/* Sanity check. */
+#ifdef CPUSUPPORT_X86_AESNI
+	if (cpusupport_x86_aesni()) {
+		if (crypto_aes_can_use_intrinsics() != 1) {
+			warn0("Unexpected error with AESNI");
+			goto err0;
+		}
+	}
+#endif
+
+	/* Inform user about the hardware optimization status. */
+	print_hardware("Checking test vectors of AES");
+
+	/* Run the test cases. */
+	return (selftest_vectors());
+
+err0:
+	/* Failure! */
+	return (1);
+}
+
+static int
+selftest_forced(const char * impl)
+{
+	const char * selected;
+
+	/* Force the implementation before AES is first used. */
+	if (hwaccel_force("aes", impl))
+		goto err0;
+
+	/* Make sure we got the implementation we asked for. */
+	(void)crypto_aes_can_use_intrinsics();
+	if (((selected = hwaccel_selected("aes")) == NULL) ||
+	    strcmp(selected, impl)) {
+		warn0("Could not force AES implementation %s", impl);
+		goto err0;
+	}
+	printf("Checking test vectors of AES using the %s implementation.\n",
+	    selected);
+
+	/* Run the test cases. */
+	return (selftest_vectors());
+
+err0:
+	/* Failure! */
+	return (1);
+}
+
 static void
 usage(void)
 {
 
 	fprintf(stderr, "usage: test_crypto_aes -t\n");
 	fprintf(stderr, "       test_crypto_aes -x\n");
+	fprintf(stderr, "       test_crypto_aes -f implementation\n");
 	exit(1);
 }
 
@@ -384,6 +426,11 @@ main(int argc, char * argv[])
 			exit(perftest());
 		GETOPT_OPT("-x"):
 			exit(selftest());
+		GETOPT_OPTARG("-f"):
+			exit(selftest_forced(optarg));
+		GETOPT_MISSING_ARG:
+			warn0("Missing argument to %s", ch);
+			usage();
 		GETOPT_DEFAULT:
 			usage();
 		}
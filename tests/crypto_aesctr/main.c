@@ -10,11 +10,13 @@
 #include "cpusupport.h"
 #include "crypto_aes.h"
 #include "crypto_aesctr.h"
+#include "crypto_aesctr_hmac.h"
 #include "getopt.h"
 #include "hexify.h"
 #include "insecure_memzero.h"
 #include "monoclock.h"
 #include "perftest.h"
+#include "sha256.h"
 #include "warnp.h"
 
 #define MAX_PLAINTEXT_LENGTH 32
@@ -404,6 +406,224 @@ err0:
 	return (1);
 }
 
+static size_t
+selftest_seek(size_t keylen)
+{
+	struct crypto_aesctr * aesctr;
+	struct crypto_aes_key * key_exp;
+	uint8_t key[32];
+	uint8_t * largebuf;
+	uint8_t * largebuf_out1;
+	uint8_t * largebuf_out2;
+	size_t i;
+	size_t offset;
+	size_t new_chunk;
+	size_t failures = 0;
+
+	/* Prepare a large buffer with repeating 01010101_2 = 85. */
+	if ((largebuf = malloc(LARGE_BUFSIZE)) == NULL)
+		goto err0;
+	memset(largebuf, 85, LARGE_BUFSIZE);
+
+	/* Prepare the key: 00010203... */
+	for (i = 0; i < keylen; i++)
+		key[i] = (uint8_t)i;
+	if ((key_exp = crypto_aes_key_expand(key, keylen)) == NULL)
+		goto err1;
+
+	/* Test random access into a large buffer. */
+	printf("Computing %zu-bit AES-CTR of a large buffer with random "
+	    "seeks...", keylen * 8);
+
+	/* Prepare output buffers. */
+	if ((largebuf_out1 = malloc(LARGE_BUFSIZE)) == NULL)
+		goto err2;
+	if ((largebuf_out2 = malloc(LARGE_BUFSIZE)) == NULL)
+		goto err3;
+
+	/* Encrypt with one call. */
+	crypto_aesctr_buf(key_exp, 0xfedcba9876543210, largebuf,
+	    largebuf_out1, LARGE_BUFSIZE);
+
+	/* Ensure we have a repeatable pattern of random values. */
+	srandom(0);
+
+	/* Encrypt random chunks, seeking to each one first. */
+	if ((aesctr = crypto_aesctr_init(key_exp, 0xfedcba9876543210)) == NULL)
+		goto err4;
+	memset(largebuf_out2, 0, LARGE_BUFSIZE);
+	for (i = 0; i < 1000; i++) {
+		offset = ((unsigned long int)random()) %
+		    (LARGE_BUFSIZE - MAX_CHUNK);
+		new_chunk = ((unsigned long int)random()) % MAX_CHUNK;
+		crypto_aesctr_seek(aesctr, offset);
+		crypto_aesctr_stream(aesctr, &largebuf[offset],
+		    &largebuf_out2[offset], new_chunk);
+
+		/* Compare ciphertexts. */
+		if (memcmp(&largebuf_out1[offset], &largebuf_out2[offset],
+		    new_chunk)) {
+			failures++;
+			break;
+		}
+	}
+	crypto_aesctr_free(aesctr);
+
+	/* Report result. */
+	if (failures)
+		printf(" FAILED!\n");
+	else
+		printf(" PASSED!\n");
+
+	/* Clean up. */
+	free(largebuf_out2);
+	free(largebuf_out1);
+	crypto_aes_key_free(key_exp);
+	free(largebuf);
+
+	return (failures);
+
+err4:
+	free(largebuf_out2);
+err3:
+	free(largebuf_out1);
+err2:
+	crypto_aes_key_free(key_exp);
+err1:
+	free(largebuf);
+err0:
+	/* Failure! */
+	return (1);
+}
+
+static size_t
+selftest_hmac(size_t keylen)
+{
+	struct crypto_aesctr_hmac * stream;
+	struct crypto_aesctr * aesctr;
+	struct crypto_aes_key * key_exp;
+	HMAC_SHA256_CTX hctx;
+	uint8_t key[32];
+	uint8_t hkey[32];
+	uint8_t mac1[32];
+	uint8_t mac2[32];
+	uint8_t * largebuf;
+	uint8_t * largebuf_out1;
+	uint8_t * largebuf_out2;
+	size_t i;
+	size_t bytes_processed;
+	size_t new_chunk;
+	size_t failures = 0;
+
+	/* Prepare a large buffer with repeating 01010101_2 = 85. */
+	if ((largebuf = malloc(LARGE_BUFSIZE)) == NULL)
+		goto err0;
+	memset(largebuf, 85, LARGE_BUFSIZE);
+
+	/* Prepare the keys: 00010203... and 20212223... */
+	for (i = 0; i < 32; i++) {
+		key[i] = (uint8_t)i;
+		hkey[i] = (uint8_t)(i + 32);
+	}
+	if ((key_exp = crypto_aes_key_expand(key, keylen)) == NULL)
+		goto err1;
+
+	/* Test against separate encryption and HMAC passes. */
+	printf("Computing %zu-bit AES-CTR + HMAC-SHA256 of a large buffer two "
+	    "different ways...", keylen * 8);
+
+	/* Prepare output buffers. */
+	if ((largebuf_out1 = malloc(LARGE_BUFSIZE)) == NULL)
+		goto err2;
+	if ((largebuf_out2 = malloc(LARGE_BUFSIZE)) == NULL)
+		goto err3;
+
+	/* Encrypt, then compute the HMAC of the ciphertext. */
+	if ((aesctr = crypto_aesctr_init(key_exp, 0xfedcba9876543210)) == NULL)
+		goto err4;
+	crypto_aesctr_stream(aesctr, largebuf, largebuf_out1, LARGE_BUFSIZE);
+	crypto_aesctr_free(aesctr);
+	HMAC_SHA256_Init(&hctx, hkey, 32);
+	HMAC_SHA256_Update(&hctx, largebuf_out1, LARGE_BUFSIZE);
+	HMAC_SHA256_Final(mac1, &hctx);
+
+	/* Ensure we have a repeatable pattern of random values. */
+	srandom(0);
+
+	/* Encrypt and authenticate in one pass, with multiple calls. */
+	if ((stream = crypto_aesctr_hmac_init(key_exp, 0xfedcba9876543210,
+	    hkey, 32)) == NULL)
+		goto err4;
+	bytes_processed = 0;
+	while (bytes_processed < LARGE_BUFSIZE - 4 * MAX_CHUNK) {
+		new_chunk = ((unsigned long int)random()) % (4 * MAX_CHUNK);
+		crypto_aesctr_hmac_encrypt(stream, &largebuf[bytes_processed],
+		    &largebuf_out2[bytes_processed], new_chunk);
+		bytes_processed += new_chunk;
+	}
+	new_chunk = LARGE_BUFSIZE - bytes_processed;
+	crypto_aesctr_hmac_encrypt(stream, &largebuf[bytes_processed],
+	    &largebuf_out2[bytes_processed], new_chunk);
+	crypto_aesctr_hmac_final(stream, mac2);
+	crypto_aesctr_hmac_free(stream);
+
+	/* Compare ciphertexts and HMACs. */
+	if (memcmp(largebuf_out1, largebuf_out2, LARGE_BUFSIZE) ||
+	    memcmp(mac1, mac2, 32)) {
+		failures++;
+		goto done;
+	}
+
+	/* Decrypt in place in a single call, and verify the HMAC. */
+	if ((stream = crypto_aesctr_hmac_init(key_exp, 0xfedcba9876543210,
+	    hkey, 32)) == NULL)
+		goto err4;
+	crypto_aesctr_hmac_decrypt(stream, largebuf_out2, largebuf_out2,
+	    LARGE_BUFSIZE);
+	if (crypto_aesctr_hmac_verify(stream, mac1) ||
+	    memcmp(largebuf, largebuf_out2, LARGE_BUFSIZE))
+		failures++;
+	crypto_aesctr_hmac_free(stream);
+
+	/* A modified ciphertext should be rejected. */
+	largebuf_out1[LARGE_BUFSIZE / 2] ^= 0x80;
+	if ((stream = crypto_aesctr_hmac_init(key_exp, 0xfedcba9876543210,
+	    hkey, 32)) == NULL)
+		goto err4;
+	crypto_aesctr_hmac_decrypt(stream, largebuf_out1, largebuf_out2,
+	    LARGE_BUFSIZE);
+	if (crypto_aesctr_hmac_verify(stream, mac1) == 0)
+		failures++;
+	crypto_aesctr_hmac_free(stream);
+
+done:
+	/* Report result. */
+	if (failures)
+		printf(" FAILED!\n");
+	else
+		printf(" PASSED!\n");
+
+	/* Clean up. */
+	free(largebuf_out2);
+	free(largebuf_out1);
+	crypto_aes_key_free(key_exp);
+	free(largebuf);
+
+	return (failures);
+
+err4:
+	free(largebuf_out2);
+err3:
+	free(largebuf_out1);
+err2:
+	crypto_aes_key_free(key_exp);
+err1:
+	free(largebuf);
+err0:
+	/* Failure! */
+	return (1);
+}
+
 static size_t
 selftest_cases(const struct testcase * tests, size_t num_tests, uint64_t nonce)
 {
@@ -590,6 +810,18 @@ selftest(void)
 	if (selftest_unaligned_access(32))
 		failures++;
 
+	/* Test seeking. */
+	if (selftest_seek(16))
+		failures++;
+	if (selftest_seek(32))
+		failures++;
+
+	/* Test encrypt-then-MAC. */
+	if (selftest_hmac(16))
+		failures++;
+	if (selftest_hmac(32))
+		failures++;
+
 	/* Report overall success to exit code. */
 	if (failures)
 		return (1);
@@ -0,0 +1,575 @@
+#include <sys/wait.h>
+
+#include <assert.h>
+#include <signal.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "cpusupport.h"
+#include "crypto_aes.h"
+#include "crypto_aesgcm.h"
+#include "getopt.h"
+#include "hexify.h"
+#include "perftest.h"
+#include "warnp.h"
+
+#define MAX_LENGTH 64
+
+#define LARGE_BUFSIZE 65536
+#define MAX_CHUNK 256
+
+struct testcase {
+	const char * key_hex;
+	const char * iv_hex;
+	const char * aad_hex;
+	const char * plaintext_hex;
+	const char * ciphertext_hex;
+	const char * tag_hex;
+};
+
+/* Test vectors from the GCM specification (McGrew & Viega). */
+static const struct testcase tests[] = {
+	{"00000000000000000000000000000000",
+	    "000000000000000000000000",
+	    "",
+	    "",
+	    "",
+	    "58e2fccefa7e3061367f1d57a4e7455a"},
+	{"00000000000000000000000000000000",
+	    "000000000000000000000000",
+	    "",
+	    "00000000000000000000000000000000",
+	    "0388dace60b6a392f328c2b971b2fe78",
+	    "ab6e47d42cec13bdf53a67b21257bddf"},
+	{"feffe9928665731c6d6a8f9467308308",
+	    "cafebabefacedbaddecaf888",
+	    "",
+	    "d9313225f88406e5a55909c5aff5269a86a7a9531534f7da2e4c303d8a318a72"
+	    "1c3c0c95956809532fcf0e2449a6b525b16aedf5aa0de657ba637b391aafd255",
+	    "42831ec2217774244b7221b784d0d49ce3aa212f2c02a4e035c17e2329aca12e"
+	    "21d514b25466931c7d8f6a5aac84aa051ba30b396a0aac973d58e091473f5985",
+	    "4d5c2af327cd64a62cf35abd2ba6fab4"},
+	{"feffe9928665731c6d6a8f9467308308",
+	    "cafebabefacedbaddecaf888",
+	    "feedfacedeadbeeffeedfacedeadbeefabaddad2",
+	    "d9313225f88406e5a55909c5aff5269a86a7a9531534f7da2e4c303d8a318a72"
+	    "1c3c0c95956809532fcf0e2449a6b525b16aedf5aa0de657ba637b39",
+	    "42831ec2217774244b7221b784d0d49ce3aa212f2c02a4e035c17e2329aca12e"
+	    "21d514b25466931c7d8f6a5aac84aa051ba30b396a0aac973d58e091",
+	    "5bc94fbc3221a5db94fae95ae7121a47"},
+	{"0000000000000000000000000000000000000000000000000000000000000000",
+	    "000000000000000000000000",
+	    "",
+	    "",
+	    "",
+	    "530f8afbc74536b9a963b4f1c4cb738b"},
+	{"0000000000000000000000000000000000000000000000000000000000000000",
+	    "000000000000000000000000",
+	    "",
+	    "00000000000000000000000000000000",
+	    "cea7403d4d606b6e074ec5d3baf39d18",
+	    "d0d1c8a799996bf0265b98b5d48ab919"},
+	{"feffe9928665731c6d6a8f9467308308feffe9928665731c6d6a8f9467308308",
+	    "cafebabefacedbaddecaf888",
+	    "",
+	    "d9313225f88406e5a55909c5aff5269a86a7a9531534f7da2e4c303d8a318a72"
+	    "1c3c0c95956809532fcf0e2449a6b525b16aedf5aa0de657ba637b391aafd255",
+	    "522dc1f099567d07f47f37a32a84427d643a8cdcbfe5c0c97598a2bd2555d1aa"
+	    "8cb08e48590dbb3da7b08b1056828838c5f61e6393ba7a0abcc9f662898015ad",
+	    "b094dac5d93471bdec1a502270e3cc6c"},
+	{"feffe9928665731c6d6a8f9467308308feffe9928665731c6d6a8f9467308308",
+	    "cafebabefacedbaddecaf888",
+	    "feedfacedeadbeeffeedfacedeadbeefabaddad2",
+	    "d9313225f88406e5a55909c5aff5269a86a7a9531534f7da2e4c303d8a318a72"
+	    "1c3c0c95956809532fcf0e2449a6b525b16aedf5aa0de657ba637b39",
+	    "522dc1f099567d07f47f37a32a84427d643a8cdcbfe5c0c97598a2bd2555d1aa"
+	    "8cb08e48590dbb3da7b08b1056828838c5f61e6393ba7a0abcc9f662",
+	    "76fc6ece0f4e1768cddf8853bb2d551b"}
+};
+
+/* Performance tests. */
+static const size_t perfsizes[] = {16, 64, 256, 1024, 4096, 16384};
+static const size_t num_perf = sizeof(perfsizes) / sizeof(perfsizes[0]);
+static const size_t nbytes_perftest = 1 << 25;		/* approx 34 MB */
+static const size_t nbytes_warmup = 1024 * 10000;	/* approx 10 MB */
+
+/* Print a name, then an array in hex. */
+static void
+print_arr(const char * name, const uint8_t * arr, size_t len)
+{
+	size_t i;
+
+	printf("%s", name);
+	for (i = 0; i < len; i++)
+		printf("%02x", arr[i]);
+	printf("\n");
+}
+
+/* Print a string, then whether or not we're using hardware acceleration. */
+static void
+print_hardware(const char * str)
+{
+
+	/* Inform the user of the general topic... */
+	printf("%s", str);
+
+	/* ... and whether we're using hardware acceleration or not. */
+#if defined(CPUSUPPORT_CONFIG_FILE)
+#if defined(CPUSUPPORT_X86_AESNI) && defined(CPUSUPPORT_X86_PCLMUL)
+	if (cpusupport_x86_aesni() && cpusupport_x86_pclmul())
+		printf(" using hardware AESNI and PCLMUL.\n");
+	else
+#endif
+#if defined(CPUSUPPORT_ARM_AES) && defined(CPUSUPPORT_ARM_PMULL)
+	if (cpusupport_arm_aes() && cpusupport_arm_pmull())
+		printf(" using hardware ARM-AES and PMULL.\n");
+	else
+#endif
+		printf(" using software GHASH.\n");
+#else
+	printf(" with unknown hardware acceleration status.\n");
+#endif /* CPUSUPPORT_CONFIG_FILE */
+}
+
+/* Decode the hex string ${hex} into ${buf}, and record its length. */
+static int
+unhexify_len(const char * hex, uint8_t buf[static MAX_LENGTH],
+    size_t * len_p)
+{
+
+	/* Sanity check. */
+	assert(strlen(hex) <= 2 * MAX_LENGTH);
+
+	*len_p = strlen(hex) / 2;
+	if (unhexify(hex, buf, *len_p)) {
+		warn0("unhexify(%s)", hex);
+		return (1);
+	}
+
+	return (0);
+}
+
+static int
+perftest_init(void * cookie, uint8_t * buf, size_t buflen)
+{
+	struct crypto_aesgcm * aesgcm = cookie;
+	const uint8_t iv[12] = {0};
+
+	/* Clear buffer. */
+	memset(buf, 0, buflen);
+
+	/* Reset object. */
+	crypto_aesgcm_init2(aesgcm, NULL, iv);
+
+	/* Success! */
+	return (0);
+}
+
+static int
+perftest_func(void * cookie, uint8_t * buf, size_t buflen, size_t nreps)
+{
+	struct crypto_aesgcm * aesgcm = cookie;
+	size_t i;
+
+	/* Do the encryption. */
+	for (i = 0; i < nreps; i++)
+		crypto_aesgcm_encrypt(aesgcm, buf, buf, buflen);
+
+	/* Success! */
+	return (0);
+}
+
+static int
+perftest(void)
+{
+	struct crypto_aesgcm * aesgcm;
+	struct crypto_aes_key * key_exp;
+	uint8_t key[32];
+	const uint8_t iv[12] = {0};
+	size_t i;
+
+	/* Inform user about the hardware optimization status. */
+	print_hardware("Performance test of AES-GCM");
+	fflush(stdout);
+
+	/* Prepare the key.  We're only performance-testing 256-bit keys. */
+	for (i = 0; i < 32; i++)
+		key[i] = (uint8_t)i;
+	if ((key_exp = crypto_aes_key_expand(key, 32)) == NULL)
+		goto err0;
+
+	/* Prepare the aesgcm object. */
+	if ((aesgcm = crypto_aesgcm_init(key_exp, iv)) == NULL)
+		goto err1;
+
+	/* Time the function. */
+	if (perftest_buffers(nbytes_perftest, perfsizes, num_perf,
+	    nbytes_warmup, 1, perftest_init, perftest_func, NULL, aesgcm)) {
+		warn0("perftest_buffers");
+		goto err2;
+	}
+
+	/* Clean up. */
+	crypto_aesgcm_free(aesgcm);
+	crypto_aes_key_free(key_exp);
+
+	/* Success! */
+	return (0);
+
+err2:
+	crypto_aesgcm_free(aesgcm);
+err1:
+	crypto_aes_key_free(key_exp);
+err0:
+	/* Failure! */
+	return (1);
+}
+
+static size_t
+selftest_cases(void)
+{
+	struct crypto_aes_key * key_exp;
+	uint8_t key[32];
+	uint8_t iv[MAX_LENGTH];
+	uint8_t aad[MAX_LENGTH];
+	uint8_t plaintext[MAX_LENGTH];
+	uint8_t ciphertext[MAX_LENGTH];
+	uint8_t tag[MAX_LENGTH];
+	uint8_t cbuf[MAX_LENGTH];
+	uint8_t pbuf[MAX_LENGTH];
+	uint8_t tbuf[16];
+	size_t keylen, ivlen, aadlen, len, taglen;
+	size_t i;
+	size_t failures = 0;
+
+	/* Inform user about the hardware optimization status. */
+	print_hardware("Checking test vectors of AES-GCM");
+
+	for (i = 0; i < sizeof(tests) / sizeof(tests[0]); i++) {
+		/* Parse the test case. */
+		keylen = strlen(tests[i].key_hex) / 2;
+		assert((keylen == 16) || (keylen == 32));
+		if (unhexify(tests[i].key_hex, key, keylen) ||
+		    unhexify_len(tests[i].iv_hex, iv, &ivlen) ||
+		    unhexify_len(tests[i].aad_hex, aad, &aadlen) ||
+		    unhexify_len(tests[i].plaintext_hex, plaintext, &len) ||
+		    unhexify_len(tests[i].ciphertext_hex, ciphertext, &len) ||
+		    unhexify_len(tests[i].tag_hex, tag, &taglen))
+			goto err0;
+		assert((ivlen == 12) && (taglen == 16));
+		if ((key_exp = crypto_aes_key_expand(key, keylen)) == NULL) {
+			warn0("crypto_aes_key_expand");
+			goto err0;
+		}
+		printf("Computing %zu-bit AES-GCM of %zu bytes with %zu bytes"
+		    " of AAD...", keylen * 8, len, aadlen);
+
+		/* Encrypt and compute the tag. */
+		crypto_aesgcm_encrypt_buf(key_exp, iv, aad, aadlen, plaintext,
+		    cbuf, len, tbuf);
+		if (memcmp(cbuf, ciphertext, len) || memcmp(tbuf, tag, 16)) {
+			printf(" FAILED!\n");
+			print_arr("Computed ciphertext:\t", cbuf, len);
+			print_arr("Correct ciphertext:\t", ciphertext, len);
+			print_arr("Computed tag:\t", tbuf, 16);
+			print_arr("Correct tag:\t", tag, 16);
+			failures++;
+			goto done;
+		}
+
+		/* Decrypt and verify the tag. */
+		if (crypto_aesgcm_decrypt_buf(key_exp, iv, aad, aadlen,
+		    ciphertext, pbuf, len, tag) ||
+		    memcmp(pbuf, plaintext, len)) {
+			printf(" FAILED!\n");
+			printf("Decryption did not round-trip.\n");
+			failures++;
+			goto done;
+		}
+
+		/* Tampering with the tag should be detected. */
+		tag[15] ^= 1;
+		if (crypto_aesgcm_decrypt_buf(key_exp, iv, aad, aadlen,
+		    ciphertext, pbuf, len, tag) == 0) {
+			printf(" FAILED!\n");
+			printf("Modified tag was accepted.\n");
+			failures++;
+			goto done;
+		}
+
+		printf(" PASSED!\n");
+done:
+		/* Clean up. */
+		crypto_aes_key_free(key_exp);
+	}
+
+	return (failures);
+
+err0:
+	/* Failure! */
+	return (1);
+}
+
+static size_t
+selftest_stream(size_t keylen)
+{
+	struct crypto_aesgcm * aesgcm;
+	struct crypto_aes_key * key_exp;
+	uint8_t key[32];
+	const uint8_t iv[12] = {0xca, 0xfe, 0xba, 0xbe, 0xfa, 0xce,
+	    0xdb, 0xad, 0xde, 0xca, 0xf8, 0x88};
+	uint8_t aad[MAX_CHUNK];
+	uint8_t tag1[16];
+	uint8_t tag2[16];
+	uint8_t * largebuf;
+	uint8_t * largebuf_out1;
+	uint8_t * largebuf_out2;
+	size_t i;
+	size_t bytes_processed;
+	size_t new_chunk;
+	size_t failures = 0;
+
+	/* Prepare a large buffer with repeating 01010101_2 = 85. */
+	if ((largebuf = malloc(LARGE_BUFSIZE)) == NULL)
+		goto err0;
+	memset(largebuf, 85, LARGE_BUFSIZE);
+
+	/* Prepare the key and additional data: 00010203... */
+	for (i = 0; i < keylen; i++)
+		key[i] = (uint8_t)i;
+	for (i = 0; i < MAX_CHUNK; i++)
+		aad[i] = (uint8_t)i;
+	if ((key_exp = crypto_aes_key_expand(key, keylen)) == NULL)
+		goto err1;
+
+	/* Test with a large buffer and unaligned access. */
+	printf("Computing %zu-bit AES-GCM of a large buffer two "
+	    "different ways...", keylen * 8);
+
+	/* Prepare output buffers. */
+	if ((largebuf_out1 = malloc(LARGE_BUFSIZE)) == NULL)
+		goto err2;
+	if ((largebuf_out2 = malloc(LARGE_BUFSIZE)) == NULL)
+		goto err3;
+
+	/* Encrypt with one call. */
+	crypto_aesgcm_encrypt_buf(key_exp, iv, aad, MAX_CHUNK, largebuf,
+	    largebuf_out1, LARGE_BUFSIZE, tag1);
+
+	/* Ensure we have a repeatable pattern of random values. */
+	srandom(0);
+
+	/* Encrypt with multiple calls. */
+	if ((aesgcm = crypto_aesgcm_init(key_exp, iv)) == NULL)
+		goto err4;
+	bytes_processed = 0;
+	while (bytes_processed < MAX_CHUNK) {
+		new_chunk = ((unsigned long int)random()) % 32;
+		if (new_chunk > MAX_CHUNK - bytes_processed)
+			new_chunk = MAX_CHUNK - bytes_processed;
+		crypto_aesgcm_aad(aesgcm, &aad[bytes_processed], new_chunk);
+		bytes_processed += new_chunk;
+	}
+	bytes_processed = 0;
+	while (bytes_processed < LARGE_BUFSIZE - MAX_CHUNK) {
+		new_chunk = ((unsigned long int)random()) % MAX_CHUNK;
+		crypto_aesgcm_encrypt(aesgcm, &largebuf[bytes_processed],
+		    &largebuf_out2[bytes_processed], new_chunk);
+		bytes_processed += new_chunk;
+	}
+	new_chunk = LARGE_BUFSIZE - bytes_processed;
+	crypto_aesgcm_encrypt(aesgcm, &largebuf[bytes_processed],
+	    &largebuf_out2[bytes_processed], new_chunk);
+	crypto_aesgcm_tag(aesgcm, tag2);
+
+	/* Compare ciphertexts and tags. */
+	if (memcmp(largebuf_out1, largebuf_out2, LARGE_BUFSIZE) ||
+	    memcmp(tag1, tag2, 16)) {
+		failures++;
+		goto done;
+	}
+
+	/* Decrypt in place with multiple calls, reusing the object. */
+	crypto_aesgcm_init2(aesgcm, NULL, iv);
+	crypto_aesgcm_aad(aesgcm, aad, MAX_CHUNK);
+	bytes_processed = 0;
+	while (bytes_processed < LARGE_BUFSIZE - MAX_CHUNK) {
+		new_chunk = ((unsigned long int)random()) % MAX_CHUNK;
+		crypto_aesgcm_decrypt(aesgcm, &largebuf_out2[bytes_processed],
+		    &largebuf_out2[bytes_processed], new_chunk);
+		bytes_processed += new_chunk;
+	}
+	new_chunk = LARGE_BUFSIZE - bytes_processed;
+	crypto_aesgcm_decrypt(aesgcm, &largebuf_out2[bytes_processed],
+	    &largebuf_out2[bytes_processed], new_chunk);
+	if (crypto_aesgcm_verify(aesgcm, tag1) ||
+	    memcmp(largebuf, largebuf_out2, LARGE_BUFSIZE)) {
+		failures++;
+		goto done;
+	}
+
+	/* A modified ciphertext should be rejected. */
+	largebuf_out1[LARGE_BUFSIZE / 2] ^= 0x80;
+	if (crypto_aesgcm_decrypt_buf(key_exp, iv, aad, MAX_CHUNK,
+	    largebuf_out1, largebuf_out2, LARGE_BUFSIZE, tag1) == 0)
+		failures++;
+
+done:
+	crypto_aesgcm_free(aesgcm);
+
+	/* Report result. */
+	if (failures)
+		printf(" FAILED!\n");
+	else
+		printf(" PASSED!\n");
+
+	/* Clean up. */
+	free(largebuf_out2);
+	free(largebuf_out1);
+	crypto_aes_key_free(key_exp);
+	free(largebuf);
+
+	return (failures);
+
+err4:
+	free(largebuf_out2);
+err3:
+	free(largebuf_out1);
+err2:
+	crypto_aes_key_free(key_exp);
+err1:
+	free(largebuf);
+err0:
+	/* Failure! */
+	return (1);
+}
+
+#if SIZE_MAX > CRYPTO_AESGCM_MAXLEN
+static int
+selftest_limit(void)
+{
+	struct crypto_aesgcm * aesgcm;
+	struct crypto_aes_key * key_exp;
+	const uint8_t key[16] = {0};
+	const uint8_t iv[12] = {0};
+	uint8_t buf[16] = {0};
+	pid_t pid;
+	int status;
+	int failures = 0;
+
+	printf("Checking that AES-GCM refuses to process too much data...");
+
+	/* Prepare a stream which has processed one block. */
+	if ((key_exp = crypto_aes_key_expand(key, 16)) == NULL)
+		goto err0;
+	if ((aesgcm = crypto_aesgcm_init(key_exp, iv)) == NULL)
+		goto err1;
+	crypto_aesgcm_encrypt(aesgcm, buf, buf, 16);
+
+	/* Don't let the child repeat our buffered output. */
+	fflush(stdout);
+
+	/* Going over the limit must abort before touching the buffers. */
+	if ((pid = fork()) == -1) {
+		warnp("fork");
+		goto err2;
+	}
+	if (pid == 0) {
+		/* We expect a warning; don't clutter the test output. */
+		if (freopen("/dev/null", "w", stderr) == NULL)
+			_exit(1);
+		crypto_aesgcm_encrypt(aesgcm, buf, buf,
+		    CRYPTO_AESGCM_MAXLEN - 15);
+		_exit(0);
+	}
+	if (waitpid(pid, &status, 0) != pid) {
+		warnp("waitpid");
+		goto err2;
+	}
+	if (!WIFSIGNALED(status) || (WTERMSIG(status) != SIGABRT))
+		failures++;
+
+	/* Report result. */
+	if (failures)
+		printf(" FAILED!\n");
+	else
+		printf(" PASSED!\n");
+
+	/* Clean up. */
+	crypto_aesgcm_free(aesgcm);
+	crypto_aes_key_free(key_exp);
+
+	return (failures);
+
+err2:
+	crypto_aesgcm_free(aesgcm);
+err1:
+	crypto_aes_key_free(key_exp);
+err0:
+	/* Failure! */
+	return (1);
+}
+#endif
+
+static int
+selftest(void)
+{
+	int failures = 0;
+
+	/* Test vectors. */
+	if (selftest_cases())
+		failures++;
+
+	/* Test streaming, in-place decryption, and forgery detection. */
+	if (selftest_stream(16))
+		failures++;
+	if (selftest_stream(32))
+		failures++;
+
+#if SIZE_MAX > CRYPTO_AESGCM_MAXLEN
+	/* Test that the per-IV data limit is enforced. */
+	if (selftest_limit())
+		failures++;
+#endif
+
+	/* Report overall success to exit code. */
+	if (failures)
+		return (1);
+	else
+		return (0);
+}
+
+static void
+usage(void)
+{
+
+	fprintf(stderr, "usage: test_crypto_aesgcm -t\n");
+	fprintf(stderr, "       test_crypto_aesgcm -x\n");
+	exit(1);
+}
+
+int
+main(int argc, char * argv[])
+{
+	const char * ch;
+
+	WARNP_INIT;
+
+	/* Process arguments. */
+	while ((ch = GETOPT(argc, argv)) != NULL) {
+		GETOPT_SWITCH(ch) {
+		GETOPT_OPT("-t"):
+			exit(perftest());
+		GETOPT_OPT("-x"):
+			exit(selftest());
+		GETOPT_DEFAULT:
+			usage();
+		}
+	}
+
+	usage();
+}
@@ -0,0 +1,500 @@
+#include <sys/wait.h>
+
+#include <signal.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "cpusupport.h"
+#include "crypto_chacha20.h"
+#include "crypto_chacha20poly1305.h"
+#include "crypto_poly1305.h"
+#include "getopt.h"
+#include "hexify.h"
+#include "perftest.h"
+#include "warnp.h"
+
+#define LARGE_BUFSIZE 65536
+#define MAX_CHUNK 256
+
+/* Test vectors from RFC 8439. */
+static const char * plaintext_str = "Ladies and Gentlemen of the class of "
+    "'99: If I could offer you only one tip for the future, sunscreen would "
+    "be it.";
+
+/* Section 2.4.2: ChaCha20 encryption. */
+static const char * chacha20_key_hex =
+    "000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f";
+static const char * chacha20_nonce_hex = "000000000000004a00000000";
+static const char * chacha20_ciphertext_hex =
+    "6e2e359a2568f98041ba0728dd0d6981e97e7aec1d4360c20a27afccfd9fae0b"
+    "f91b65c5524733ab8f593dabcd62b3571639d624e65152ab8f530c359f0861d8"
+    "07ca0dbf500d6a6156a38e088a22b65e52bc514d16ccf806818ce91ab7793736"
+    "5af90bbf74a35be6b40b8eedf2785e42874d";
+
+/* Section 2.5.2: Poly1305. */
+static const char * poly1305_key_hex =
+    "85d6be7857556d337f4452fe42d506a80103808afb0db2fd4abff6af4149f51b";
+static const char * poly1305_msg_str = "Cryptographic Forum Research Group";
+static const char * poly1305_tag_hex = "a8061dc1305136c6c22b8baf0c0127a9";
+
+/* Section 2.8.2: ChaCha20-Poly1305 AEAD. */
+static const char * aead_key_hex =
+    "808182838485868788898a8b8c8d8e8f909192939495969798999a9b9c9d9e9f";
+static const char * aead_nonce_hex = "070000004041424344454647";
+static const char * aead_aad_hex = "50515253c0c1c2c3c4c5c6c7";
+static const char * aead_ciphertext_hex =
+    "d31a8d34648e60db7b86afbc53ef7ec2a4aded51296e08fea9e2b5a736ee62d6"
+    "3dbea45e8ca9671282fafb69da92728b1a71de0a9e060b2905d6a5b67ecd3b36"
+    "92ddbd7f2d778b8c9803aee328091b58fab324e4fad675945585808b4831d7bc"
+    "3ff4def08e4b7a9de576d26586cec64b6116";
+static const char * aead_tag_hex = "1ae10b594f09e26a7e902ecbd0600691";
+
+/* Performance tests. */
+static const size_t perfsizes[] = {16, 64, 256, 1024, 4096, 16384};
+static const size_t num_perf = sizeof(perfsizes) / sizeof(perfsizes[0]);
+static const size_t nbytes_perftest = 1 << 25;		/* approx 34 MB */
+static const size_t nbytes_warmup = 1024 * 10000;	/* approx 10 MB */
+
+/* Print a name, then an array in hex. */
+static void
+print_arr(const char * name, const uint8_t * arr, size_t len)
+{
+	size_t i;
+
+	printf("%s", name);
+	for (i = 0; i < len; i++)
+		printf("%02x", arr[i]);
+	printf("\n");
+}
+
+/* Print a string, then whether or not we're using hardware acceleration. */
+static void
+print_hardware(const char * str)
+{
+
+	/* Inform the user of the general topic... */
+	printf("%s", str);
+
+	/* ... and whether we're using hardware acceleration or not. */
+#if defined(CPUSUPPORT_CONFIG_FILE)
+#if defined(CPUSUPPORT_X86_AVX2)
+	if (cpusupport_x86_avx2())
+		printf(" using hardware AVX2.\n");
+	else
+#endif
+#if defined(CPUSUPPORT_X86_SSE2)
+	if (cpusupport_x86_sse2())
+		printf(" using hardware SSE2.\n");
+	else
+#endif
+#if defined(CPUSUPPORT_ARM_NEON)
+	if (cpusupport_arm_neon())
+		printf(" using hardware NEON.\n");
+	else
+#endif
+		printf(" using software ChaCha20.\n");
+#else
+	printf(" with unknown hardware acceleration status.\n");
+#endif /* CPUSUPPORT_CONFIG_FILE */
+}
+
+/* Report whether ${computed} matches the ${len} bytes of ${correct_hex}. */
+static int
+check(const char * name, const uint8_t * computed, const char * correct_hex,
+    size_t len)
+{
+	uint8_t correct[128];
+
+	/* Decode the correct value. */
+	if (unhexify(correct_hex, correct, len)) {
+		warn0("unhexify(%s)", correct_hex);
+		return (1);
+	}
+
+	/* Compare. */
+	if (memcmp(computed, correct, len)) {
+		printf(" FAILED!\n");
+		printf("Computed %s:\t", name);
+		print_arr("", computed, len);
+		printf("Correct %s:\t", name);
+		print_arr("", correct, len);
+		return (1);
+	}
+
+	return (0);
+}
+
+static int
+perftest_init(void * cookie, uint8_t * buf, size_t buflen)
+{
+	struct crypto_chacha20 * chacha = cookie;
+	const uint8_t nonce[12] = {0};
+
+	/* Clear buffer. */
+	memset(buf, 0, buflen);
+
+	/* Reset object. */
+	crypto_chacha20_init2(chacha, NULL, nonce, 0);
+
+	/* Success! */
+	return (0);
+}
+
+static int
+perftest_func(void * cookie, uint8_t * buf, size_t buflen, size_t nreps)
+{
+	struct crypto_chacha20 * chacha = cookie;
+	size_t i;
+
+	/* Do the encryption. */
+	for (i = 0; i < nreps; i++)
+		crypto_chacha20_stream(chacha, buf, buf, buflen);
+
+	/* Success! */
+	return (0);
+}
+
+static int
+perftest(void)
+{
+	struct crypto_chacha20 * chacha;
+	uint8_t key[32];
+	const uint8_t nonce[12] = {0};
+	size_t i;
+
+	/* Inform user about the hardware optimization status. */
+	print_hardware("Performance test of ChaCha20");
+	fflush(stdout);
+
+	/* Prepare the key. */
+	for (i = 0; i < 32; i++)
+		key[i] = (uint8_t)i;
+
+	/* Prepare the chacha20 object. */
+	if ((chacha = crypto_chacha20_init(key, nonce, 0)) == NULL)
+		goto err0;
+
+	/* Time the function. */
+	if (perftest_buffers(nbytes_perftest, perfsizes, num_perf,
+	    nbytes_warmup, 1, perftest_init, perftest_func, NULL, chacha)) {
+		warn0("perftest_buffers");
+		goto err1;
+	}
+
+	/* Clean up. */
+	crypto_chacha20_free(chacha);
+
+	/* Success! */
+	return (0);
+
+err1:
+	crypto_chacha20_free(chacha);
+err0:
+	/* Failure! */
+	return (1);
+}
+
+static size_t
+selftest_vectors(void)
+{
+	uint8_t key[32];
+	uint8_t nonce[12];
+	uint8_t aad[12];
+	uint8_t buf[128];
+	uint8_t tag[16];
+	size_t len = strlen(plaintext_str);
+	size_t failures = 0;
+
+	/* Inform user about the hardware optimization status. */
+	print_hardware("Checking test vectors of ChaCha20-Poly1305");
+
+	/* ChaCha20. */
+	printf("Computing ChaCha20 of \"%.20s...\"...", plaintext_str);
+	if (unhexify(chacha20_key_hex, key, 32) ||
+	    unhexify(chacha20_nonce_hex, nonce, 12))
+		goto err0;
+	crypto_chacha20_buf(key, nonce, 1, (const uint8_t *)plaintext_str,
+	    buf, len);
+	if (check("ciphertext", buf, chacha20_ciphertext_hex, len))
+		failures++;
+	else
+		printf(" PASSED!\n");
+
+	/* Poly1305. */
+	printf("Computing Poly1305 of \"%s\"...", poly1305_msg_str);
+	if (unhexify(poly1305_key_hex, key, 32))
+		goto err0;
+	crypto_poly1305_buf(key, (const uint8_t *)poly1305_msg_str,
+	    strlen(poly1305_msg_str), tag);
+	if (check("tag", tag, poly1305_tag_hex, 16))
+		failures++;
+	else
+		printf(" PASSED!\n");
+
+	/* ChaCha20-Poly1305 encryption. */
+	printf("Computing ChaCha20-Poly1305 of \"%.20s...\"...", plaintext_str);
+	if (unhexify(aead_key_hex, key, 32) ||
+	    unhexify(aead_nonce_hex, nonce, 12) ||
+	    unhexify(aead_aad_hex, aad, 12))
+		goto err0;
+	crypto_chacha20poly1305_encrypt_buf(key, nonce, aad, 12,
+	    (const uint8_t *)plaintext_str, buf, len, tag);
+	if (check("ciphertext", buf, aead_ciphertext_hex, len) ||
+	    check("tag", tag, aead_tag_hex, 16)) {
+		failures++;
+		goto done;
+	}
+
+	/* ChaCha20-Poly1305 decryption, in place. */
+	if (crypto_chacha20poly1305_decrypt_buf(key, nonce, aad, 12, buf, buf,
+	    len, tag) || memcmp(buf, plaintext_str, len)) {
+		printf(" FAILED!\n");
+		printf("Decryption did not round-trip.\n");
+		failures++;
+		goto done;
+	}
+
+	/* Modified additional data should be rejected. */
+	aad[0] ^= 1;
+	if (crypto_chacha20poly1305_decrypt_buf(key, nonce, aad, 12, buf, buf,
+	    len, tag) == 0) {
+		printf(" FAILED!\n");
+		printf("Modified additional data was accepted.\n");
+		failures++;
+		goto done;
+	}
+	printf(" PASSED!\n");
+
+done:
+	return (failures);
+
+err0:
+	/* Failure! */
+	return (1);
+}
+
+static size_t
+selftest_stream(void)
+{
+	struct crypto_chacha20 * chacha;
+	struct crypto_poly1305_ctx ctx;
+	uint8_t key[32];
+	uint8_t nonce[12];
+	uint8_t tag1[16];
+	uint8_t tag2[16];
+	uint8_t * largebuf;
+	uint8_t * largebuf_out1;
+	uint8_t * largebuf_out2;
+	size_t i;
+	size_t bytes_processed;
+	size_t new_chunk;
+	size_t failures = 0;
+
+	/* Prepare a large buffer with repeating 01010101_2 = 85. */
+	if ((largebuf = malloc(LARGE_BUFSIZE)) == NULL)
+		goto err0;
+	memset(largebuf, 85, LARGE_BUFSIZE);
+
+	/* Prepare the key and nonce: 00010203... */
+	for (i = 0; i < 32; i++)
+		key[i] = (uint8_t)i;
+	for (i = 0; i < 12; i++)
+		nonce[i] = (uint8_t)i;
+
+	/* Test with a large buffer and unaligned access. */
+	printf("Computing ChaCha20 and Poly1305 of a large buffer two "
+	    "different ways...");
+
+	/* Prepare output buffers. */
+	if ((largebuf_out1 = malloc(LARGE_BUFSIZE)) == NULL)
+		goto err1;
+	if ((largebuf_out2 = malloc(LARGE_BUFSIZE)) == NULL)
+		goto err2;
+
+	/* Encrypt and authenticate with one call each. */
+	crypto_chacha20_buf(key, nonce, 0xfffffff0, largebuf, largebuf_out1,
+	    LARGE_BUFSIZE);
+	crypto_poly1305_buf(key, largebuf_out1, LARGE_BUFSIZE, tag1);
+
+	/* Ensure we have a repeatable pattern of random values. */
+	srandom(0);
+
+	/* Encrypt and authenticate with multiple calls. */
+	if ((chacha = crypto_chacha20_init(key, nonce, 0xfffffff0)) == NULL)
+		goto err3;
+	crypto_poly1305_init(&ctx, key);
+	bytes_processed = 0;
+	while (bytes_processed < LARGE_BUFSIZE - MAX_CHUNK) {
+		new_chunk = ((unsigned long int)random()) % MAX_CHUNK;
+		crypto_chacha20_stream(chacha, &largebuf[bytes_processed],
+		    &largebuf_out2[bytes_processed], new_chunk);
+		crypto_poly1305_update(&ctx, &largebuf_out2[bytes_processed],
+		    new_chunk);
+		bytes_processed += new_chunk;
+	}
+	new_chunk = LARGE_BUFSIZE - bytes_processed;
+	crypto_chacha20_stream(chacha, &largebuf[bytes_processed],
+	    &largebuf_out2[bytes_processed], new_chunk);
+	crypto_poly1305_update(&ctx, &largebuf_out2[bytes_processed],
+	    new_chunk);
+	crypto_poly1305_final(&ctx, tag2);
+	crypto_chacha20_free(chacha);
+
+	/* Compare ciphertexts and tags. */
+	if (memcmp(largebuf_out1, largebuf_out2, LARGE_BUFSIZE) ||
+	    memcmp(tag1, tag2, 16)) {
+		printf(" FAILED!\n");
+		failures++;
+	} else
+		printf(" PASSED!\n");
+
+	/* Clean up. */
+	free(largebuf_out2);
+	free(largebuf_out1);
+	free(largebuf);
+
+	return (failures);
+
+err3:
+	free(largebuf_out2);
+err2:
+	free(largebuf_out1);
+err1:
+	free(largebuf);
+err0:
+	/* Failure! */
+	return (1);
+}
+
+#if SIZE_MAX > CRYPTO_CHACHA20POLY1305_MAXLEN
+/*
+ * Check that processing ${len} bytes aborts (if ${decrypt} is zero, via
+ * encryption; otherwise via decryption) before touching the buffers.
+ */
+static int
+limit_aborts(size_t len, int decrypt)
+{
+	const uint8_t key[32] = {0};
+	const uint8_t nonce[12] = {0};
+	uint8_t buf[16] = {0};
+	uint8_t tag[16] = {0};
+	pid_t pid;
+	int status;
+
+	/* Don't let the child repeat our buffered output. */
+	fflush(stdout);
+
+	/* Try to process too much data in a child process. */
+	if ((pid = fork()) == -1) {
+		warnp("fork");
+		goto err0;
+	}
+	if (pid == 0) {
+		/* We expect a warning; don't clutter the test output. */
+		if (freopen("/dev/null", "w", stderr) == NULL)
+			_exit(1);
+		if (decrypt)
+			(void)crypto_chacha20poly1305_decrypt_buf(key, nonce,
+			    NULL, 0, buf, buf, len, tag);
+		else
+			crypto_chacha20poly1305_encrypt_buf(key, nonce,
+			    NULL, 0, buf, buf, len, tag);
+		_exit(0);
+	}
+	if (waitpid(pid, &status, 0) != pid) {
+		warnp("waitpid");
+		goto err0;
+	}
+
+	/* The child must have aborted. */
+	return (WIFSIGNALED(status) && (WTERMSIG(status) == SIGABRT));
+
+err0:
+	/* Failure! */
+	return (0);
+}
+
+static int
+selftest_limit(void)
+{
+	int failures = 0;
+
+	printf("Checking that ChaCha20-Poly1305 refuses to process too much"
+	    " data...");
+
+	/* Both directions must enforce the limit. */
+	if (!limit_aborts(CRYPTO_CHACHA20POLY1305_MAXLEN + 1, 0))
+		failures++;
+	if (!limit_aborts(CRYPTO_CHACHA20POLY1305_MAXLEN + 1, 1))
+		failures++;
+
+	/* Report result. */
+	if (failures)
+		printf(" FAILED!\n");
+	else
+		printf(" PASSED!\n");
+
+	return (failures);
+}
+#endif
+
+static int
+selftest(void)
+{
+	int failures = 0;
+
+	/* Test vectors. */
+	if (selftest_vectors())
+		failures++;
+
+	/* Test streaming and unaligned access. */
+	if (selftest_stream())
+		failures++;
+
+#if SIZE_MAX > CRYPTO_CHACHA20POLY1305_MAXLEN
+	/* Test that the per-nonce data limit is enforced. */
+	if (selftest_limit())
+		failures++;
+#endif
+
+	/* Report overall success to exit code. */
+	if (failures)
+		return (1);
+	else
+		return (0);
+}
+
+static void
+usage(void)
+{
+
+	fprintf(stderr, "usage: test_crypto_chacha20 -t\n");
+	fprintf(stderr, "       test_crypto_chacha20 -x\n");
+	exit(1);
+}
+
+int
+main(int argc, char * argv[])
+{
+	const char * ch;
+
+	WARNP_INIT;
+
+	/* Process arguments. */
+	while ((ch = GETOPT(argc, argv)) != NULL) {
+		GETOPT_SWITCH(ch) {
+		GETOPT_OPT("-t"):
+			exit(perftest());
+		GETOPT_OPT("-x"):
+			exit(selftest());
+		GETOPT_DEFAULT:
+			usage();
+		}
+	}
+
+	usage();
+}
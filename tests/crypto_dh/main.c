@@ -0,0 +1,397 @@
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "cpusupport.h"
+#include "crypto_dh.h"
+#include "crypto_dh_batch.h"
+#include "crypto_dh_group14.h"
+#include "getopt.h"
+#include "hexify.h"
+#include "monoclock.h"
+#include "warnp.h"
+
+/* Number of operations to time in each performance test. */
+#define PERF_NOPS 200
+
+/* Batch size and number of threads for batch tests. */
+#define BATCH_N 7
+#define BATCH_NTHREADS 3
+
+/*
+ * Test vectors: the public key for the private key 000102...1f, and the
+ * shared key between that and the private key ffff...ff.
+ */
+static const char * pub_a_hex =
+    "b04ffbb369a4075167697d86082273244b3cfa4971e47c86a31fd3b6767a75c7"
+    "0451b879f228820ee15573bc75814760f31db96866341c55708ecaa4efc4ce4f"
+    "5029c68bf3040e7d66fb3052b33aa1d0c80109667003677107e536bb331532a8"
+    "fdd91c78eea315db1af1ed1cc5dad0382fab797441f1006150ba7a205d400c97"
+    "0b638052765fdd2a0bbb72c8b4be4faaa9c96d7ca484ded9cd9d35a2df4405f8"
+    "f26fa1674b7eac2b615e0dc3917423248af729cbb4432a89245806cbbb6c5fab"
+    "0dfcc51fb6e610b3664c73ab0d225d673d1f137fff020868d08dc2ae2d66fce5"
+    "28e543209db734f2021cf9319123cc40fe3ab3ef25962ea39f517e803655272d";
+static const char * key_hex =
+    "8325e09114f0b4356dd87779be07877ad3e71e40286d7aba9cbc04d284c2f831"
+    "c630d92c5a598378d25079653e1e8970445273bc1962867e20a747b90d9053eb"
+    "387f5b6bca88bd8df3c8db5a40b42ba56a7aa5801f1042c369a3eeb12e39fbfc"
+    "e987ff8640912b920c8ef93a07314858a62d320750d15b7bd782a92a3ba35376"
+    "628c60f706b27c698068d7f9dd1331ff03b85e80d240a46d03243dcc793e7c72"
+    "b3aad1d2418c659ea4fb41e6236b889ed24ad0096e5b27b72f17b62a2a2b2275"
+    "69bb363b98ea7c4c6d1d89b4893ff9ed5769f799e4145e5210a34b23a1bfab5d"
+    "355b119c9e949b6583b984177a35a9fac5d2b033abffb1aa425ccab55042fe29";
+
+/* Print a string, then whether or not we're using hardware acceleration. */
+static void
+print_hardware(const char * str)
+{
+
+	/* Inform the user of the general topic... */
+	printf("%s", str);
+
+	/* ... and whether we're using hardware acceleration or not. */
+#if defined(CPUSUPPORT_CONFIG_FILE)
+#if defined(CPUSUPPORT_X86_ADX)
+	if (cpusupport_x86_adx())
+		printf(" using hardware ADX.\n");
+	else
+#endif
+		printf(" using OpenSSL.\n");
+#else
+	printf(" with unknown hardware acceleration status.\n");
+#endif /* CPUSUPPORT_CONFIG_FILE */
+}
+
+/* Report whether ${computed} matches ${correct}. */
+static int
+check(const char * name, const uint8_t computed[CRYPTO_DH_PUBLEN],
+    const uint8_t correct[CRYPTO_DH_PUBLEN])
+{
+	char hexbuf[2 * CRYPTO_DH_PUBLEN + 1];
+
+	if (memcmp(computed, correct, CRYPTO_DH_PUBLEN)) {
+		printf(" FAILED!\n");
+		hexify(computed, hexbuf, CRYPTO_DH_PUBLEN);
+		printf("Computed %s:\t%s\n", name, hexbuf);
+		hexify(correct, hexbuf, CRYPTO_DH_PUBLEN);
+		printf("Correct %s:\t%s\n", name, hexbuf);
+		return (1);
+	}
+
+	return (0);
+}
+
+static size_t
+selftest_vectors(void)
+{
+	struct crypto_dh_ctx * ctx;
+	uint8_t priv_a[CRYPTO_DH_PRIVLEN];
+	uint8_t priv_b[CRYPTO_DH_PRIVLEN];
+	uint8_t pub_a[CRYPTO_DH_PUBLEN];
+	uint8_t pub_b[CRYPTO_DH_PUBLEN];
+	uint8_t key[CRYPTO_DH_KEYLEN];
+	uint8_t correct[CRYPTO_DH_PUBLEN];
+	size_t i;
+	size_t failures = 0;
+
+	/* Inform user about the hardware optimization status. */
+	print_hardware("Checking Diffie-Hellman test vectors");
+
+	/* Prepare the private keys. */
+	for (i = 0; i < CRYPTO_DH_PRIVLEN; i++) {
+		priv_a[i] = (uint8_t)i;
+		priv_b[i] = 0xff;
+	}
+
+	/* Public key generation. */
+	printf("Computing public key...");
+	if (unhexify(pub_a_hex, correct, CRYPTO_DH_PUBLEN))
+		goto err0;
+	if (crypto_dh_generate_pub(pub_a, priv_a))
+		goto err0;
+	if (check("pub", pub_a, correct))
+		failures++;
+	else
+		printf(" PASSED!\n");
+
+	/* Key exchange, in both directions, with and without a context. */
+	printf("Computing shared key...");
+	if (unhexify(key_hex, correct, CRYPTO_DH_KEYLEN))
+		goto err0;
+	if ((ctx = crypto_dh_ctx_alloc()) == NULL)
+		goto err0;
+	if (crypto_dh_generate_pub_ctx(ctx, pub_b, priv_b) ||
+	    crypto_dh_compute_ctx(ctx, pub_b, priv_a, key))
+		goto err1;
+	if (check("key", key, correct)) {
+		failures++;
+		goto done;
+	}
+	if (crypto_dh_compute(pub_a, priv_b, key))
+		goto err1;
+	if (check("key", key, correct))
+		failures++;
+	else
+		printf(" PASSED!\n");
+
+done:
+	/* Clean up. */
+	crypto_dh_ctx_free(ctx);
+
+	return (failures);
+
+err1:
+	crypto_dh_ctx_free(ctx);
+err0:
+	/* Failure! */
+	return (1);
+}
+
+static size_t
+selftest_bases(void)
+{
+	uint8_t priv[CRYPTO_DH_PRIVLEN];
+	uint8_t pub[CRYPTO_DH_PUBLEN];
+	uint8_t base[CRYPTO_DH_PUBLEN];
+	uint8_t key[CRYPTO_DH_KEYLEN];
+	unsigned int carry;
+	size_t i;
+	size_t failures = 0;
+
+	/* Prepare an odd private key. */
+	for (i = 0; i < CRYPTO_DH_PRIVLEN; i++)
+		priv[i] = (uint8_t)(i * 37 + 2);
+	if (crypto_dh_generate_pub(pub, priv))
+		goto err0;
+
+	/* The generator, as a variable base. */
+	printf("Computing powers of special bases...");
+	memset(base, 0, CRYPTO_DH_PUBLEN);
+	base[CRYPTO_DH_PUBLEN - 1] = 2;
+	if (crypto_dh_compute(base, priv, key))
+		goto err0;
+	if (check("2^x", key, pub)) {
+		failures++;
+		goto done;
+	}
+
+	/* The generator plus p, which is unreduced but less than 2^2048. */
+	carry = 2;
+	for (i = CRYPTO_DH_PUBLEN; i-- > 0; ) {
+		carry += crypto_dh_group14[i];
+		base[i] = (uint8_t)carry;
+		carry >>= 8;
+	}
+	if (crypto_dh_compute(base, priv, key))
+		goto err0;
+	if (check("(p+2)^x", key, pub)) {
+		failures++;
+		goto done;
+	}
+
+	/* Since the exponent is odd, (p-1)^x = p-1. */
+	memcpy(base, crypto_dh_group14, CRYPTO_DH_PUBLEN);
+	base[CRYPTO_DH_PUBLEN - 1] -= 1;
+	if (crypto_dh_compute(base, priv, key))
+		goto err0;
+	if (check("(p-1)^x", key, base))
+		failures++;
+	else
+		printf(" PASSED!\n");
+
+done:
+	return (failures);
+
+err0:
+	/* Failure! */
+	return (1);
+}
+
+static size_t
+selftest_batch(void)
+{
+	uint8_t priv[BATCH_N * CRYPTO_DH_PRIVLEN];
+	uint8_t pub[BATCH_N * CRYPTO_DH_PUBLEN];
+	uint8_t key[BATCH_N * CRYPTO_DH_KEYLEN];
+	uint8_t correct[CRYPTO_DH_PUBLEN];
+	size_t i;
+
+	/* Generate a batch of key pairs. */
+	printf("Computing batches of keys...");
+	if (crypto_dh_generate_batch(pub, priv, BATCH_N, BATCH_NTHREADS))
+		goto err0;
+
+	/* Check each public key individually. */
+	for (i = 0; i < BATCH_N; i++) {
+		if (crypto_dh_generate_pub(correct,
+		    &priv[i * CRYPTO_DH_PRIVLEN]))
+			goto err0;
+		if (check("pub", &pub[i * CRYPTO_DH_PUBLEN], correct))
+			return (1);
+	}
+
+	/* Compute keys from the public keys rotated by one position. */
+	if (crypto_dh_compute_batch(&pub[CRYPTO_DH_PUBLEN], priv, key,
+	    BATCH_N - 1, BATCH_NTHREADS))
+		goto err0;
+	for (i = 0; i < BATCH_N - 1; i++) {
+		if (crypto_dh_compute(&pub[(i + 1) * CRYPTO_DH_PUBLEN],
+		    &priv[i * CRYPTO_DH_PRIVLEN], correct))
+			goto err0;
+		if (check("key", &key[i * CRYPTO_DH_KEYLEN], correct))
+			return (1);
+	}
+
+	/* An empty batch, and more threads than operations. */
+	if (crypto_dh_compute_batch(pub, priv, key, 0, BATCH_NTHREADS) ||
+	    crypto_dh_compute_batch(pub, priv, key, 1, BATCH_N))
+		goto err0;
+	if (crypto_dh_compute(pub, priv, correct))
+		goto err0;
+	if (check("key", key, correct))
+		return (1);
+
+	/* Success! */
+	printf(" PASSED!\n");
+	return (0);
+
+err0:
+	/* Failure! */
+	return (1);
+}
+
+static int
+perftest(void)
+{
+	struct crypto_dh_ctx * ctx;
+	struct timeval begin, end;
+	uint8_t priv[CRYPTO_DH_PRIVLEN];
+	uint8_t pub[CRYPTO_DH_PUBLEN];
+	uint8_t key[CRYPTO_DH_KEYLEN];
+	uint8_t privs[BATCH_N * CRYPTO_DH_PRIVLEN];
+	uint8_t pubs[BATCH_N * CRYPTO_DH_PUBLEN];
+	uint8_t keys[BATCH_N * CRYPTO_DH_KEYLEN];
+	double delta;
+	size_t i;
+
+	/* Inform user about the hardware optimization status. */
+	print_hardware("Performance test of Diffie-Hellman");
+	fflush(stdout);
+
+	/* Prepare a private key and context. */
+	for (i = 0; i < CRYPTO_DH_PRIVLEN; i++)
+		priv[i] = (uint8_t)i;
+	if ((ctx = crypto_dh_ctx_alloc()) == NULL)
+		goto err0;
+
+	/* Time public key generation. */
+	if (monoclock_get(&begin))
+		goto err1;
+	for (i = 0; i < PERF_NOPS; i++) {
+		if (crypto_dh_generate_pub_ctx(ctx, pub, priv))
+			goto err1;
+	}
+	if (monoclock_get(&end))
+		goto err1;
+	delta = timeval_diff(begin, end);
+	printf("generate_pub:\t%.1f us per operation\n",
+	    1000000.0 * delta / PERF_NOPS);
+
+	/* Time shared key computation. */
+	if (monoclock_get(&begin))
+		goto err1;
+	for (i = 0; i < PERF_NOPS; i++) {
+		if (crypto_dh_compute_ctx(ctx, pub, priv, key))
+			goto err1;
+	}
+	if (monoclock_get(&end))
+		goto err1;
+	delta = timeval_diff(begin, end);
+	printf("compute:\t%.1f us per operation\n",
+	    1000000.0 * delta / PERF_NOPS);
+
+	/* Time batched shared key computation. */
+	if (crypto_dh_generate_batch(pubs, privs, BATCH_N, 1))
+		goto err1;
+	if (monoclock_get(&begin))
+		goto err1;
+	for (i = 0; i < PERF_NOPS; i += BATCH_N) {
+		if (crypto_dh_compute_batch(pubs, privs, keys, BATCH_N,
+		    BATCH_NTHREADS))
+			goto err1;
+	}
+	if (monoclock_get(&end))
+		goto err1;
+	delta = timeval_diff(begin, end);
+	printf("compute_batch:\t%.1f us per operation (%d threads)\n",
+	    1000000.0 * delta / (double)i, BATCH_NTHREADS);
+
+	/* Clean up. */
+	crypto_dh_ctx_free(ctx);
+
+	/* Success! */
+	return (0);
+
+err1:
+	crypto_dh_ctx_free(ctx);
+err0:
+	/* Failure! */
+	return (1);
+}
+
+static int
+selftest(void)
+{
+	int failures = 0;
+
+	/* Test vectors. */
+	if (selftest_vectors())
+		failures++;
+
+	/* Test special bases. */
+	if (selftest_bases())
+		failures++;
+
+	/* Test batch operations. */
+	if (selftest_batch())
+		failures++;
+
+	/* Report overall success to exit code. */
+	if (failures)
+		return (1);
+	else
+		return (0);
+}
+
+static void
+usage(void)
+{
+
+	fprintf(stderr, "usage: test_crypto_dh -t\n");
+	fprintf(stderr, "       test_crypto_dh -x\n");
+	exit(1);
+}
+
+int
+main(int argc, char * argv[])
+{
+	const char * ch;
+
+	WARNP_INIT;
+
+	/* Process arguments. */
+	while ((ch = GETOPT(argc, argv)) != NULL) {
+		GETOPT_SWITCH(ch) {
+		GETOPT_OPT("-t"):
+			exit(perftest());
+		GETOPT_OPT("-x"):
+			exit(selftest());
+		GETOPT_DEFAULT:
+			usage();
+		}
+	}
+
+	usage();
+}
@@ -1,7 +1,17 @@
+#include <sys/wait.h>
+
+#include <pthread.h>
 #include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
 
+#include "crypto_aes.h"
+#include "crypto_aesctr.h"
+#include "crypto_entropy_aesctr.h"
+#include "crypto_entropy_thread.h"
+#include "sha256.h"
 #include "warnp.h"
 
 #include "crypto_entropy.h"
@@ -9,16 +19,22 @@
 /* This must match the value in crypto/crypto_entropy.c! */
 #define RESEED_INTERVAL 256
 
-int
-main(int argc, char * argv[])
+/* Number of threads to use for the thread-safety test. */
+#define NTHREADS 4
+
+/* Get entropy enough times to trigger a reseed, and print the final value. */
+static int
+readmany(void)
 {
+	static uint8_t big[100000];
 	uint8_t buf[32];
 	size_t i;
 
-	WARNP_INIT;
-
-	(void)argc;
-	(void)argv;
+	/* Get a large amount of entropy at once. */
+	if (crypto_entropy_read(big, sizeof(big))) {
+		warn0("crypto_entropy_read(): internal error.");
+		goto err0;
+	}
 
 	/* Get entropy enough times to trigger a reseed. */
 	for (i = 0; i < RESEED_INTERVAL + 1; i++) {
@@ -34,6 +50,195 @@ main(int argc, char * argv[])
 	}
 	printf("\n");
 
+	/* Success! */
+	return (0);
+
+err0:
+	/* Failure! */
+	return (-1);
+}
+
+/* Check the AES-CTR generator against a direct computation. */
+static int
+check_aesctr(void)
+{
+	struct crypto_entropy_aesctr ctx;
+	struct crypto_aes_key * key;
+	uint8_t seed[32];
+	uint8_t k[32];
+	uint8_t out[1000];
+	uint8_t expected[32 + CRYPTO_ENTROPY_AESCTR_BUFLEN];
+
+	/* Generate output in small and then large pieces. */
+	memset(seed, 0x5a, 32);
+	crypto_entropy_aesctr_init(&ctx, seed, 32);
+	if (crypto_entropy_aesctr_generate(&ctx, out, 10) ||
+	    crypto_entropy_aesctr_generate(&ctx, &out[10], 600))
+		goto err0;
+
+	/* The key is the hash of the seed, and output follows the new key. */
+	SHA256_Buf(seed, 32, k);
+	if ((key = crypto_aes_key_expand(k, 32)) == NULL)
+		goto err0;
+	memset(expected, 0, sizeof(expected));
+	crypto_aesctr_buf(key, 0, expected, expected, sizeof(expected));
+	crypto_aes_key_free(key);
+	if (memcmp(out, &expected[32], 610)) {
+		warn0("AES-CTR generator output is incorrect");
+		goto err0;
+	}
+
+	/* Output must not repeat after the buffer is exhausted. */
+	if (crypto_entropy_aesctr_generate(&ctx, &out[610], 390))
+		goto err0;
+	if (memcmp(&out[610], &expected[32 + 610], 126)) {
+		warn0("AES-CTR generator output is incorrect");
+		goto err0;
+	}
+	if (memcmp(&out[736], &expected[32], 264) == 0) {
+		warn0("AES-CTR generator output repeated");
+		goto err0;
+	}
+
+	/* Success! */
+	return (0);
+
+err0:
+	/* Failure! */
+	return (-1);
+}
+
+/*
+ * Read from the per-thread generator until it reseeds, and from the global
+ * generator at the same time as other threads.
+ */
+static void *
+threadmain(void * cookie)
+{
+	uint8_t * buf = cookie;
+	uint8_t scratch[32];
+	size_t i;
+
+	for (i = 0; i < RESEED_INTERVAL + 1; i++) {
+		if (crypto_entropy_thread_read(buf, 32) ||
+		    crypto_entropy_read(scratch, 32)) {
+			/* Report failure as an all-zero output. */
+			memset(buf, 0, 32);
+			break;
+		}
+	}
+
+	/* Free our generator. */
+	crypto_entropy_thread_free();
+
+	return (NULL);
+}
+
+/* Check that threads and child processes get distinct output. */
+static int
+check_threads(void)
+{
+	pthread_t thr[NTHREADS];
+	uint8_t out[NTHREADS + 2][32];
+	int fd[2];
+	pid_t pid;
+	size_t i, j;
+	int rc;
+	int status;
+
+	/* Read in several threads at once, including this one. */
+	for (i = 0; i < NTHREADS; i++) {
+		if ((rc = pthread_create(&thr[i], NULL, threadmain,
+		    out[i])) != 0) {
+			warn0("pthread_create: %s", strerror(rc));
+			goto err0;
+		}
+	}
+	if (crypto_entropy_thread_read(out[NTHREADS], 32))
+		goto err0;
+	for (i = 0; i < NTHREADS; i++) {
+		if ((rc = pthread_join(thr[i], NULL)) != 0) {
+			warn0("pthread_join: %s", strerror(rc));
+			goto err0;
+		}
+	}
+
+	/* Read in a child process, and again in this process. */
+	if (pipe(fd)) {
+		warnp("pipe");
+		goto err0;
+	}
+	if ((pid = fork()) == -1) {
+		warnp("fork");
+		goto err0;
+	}
+	if (pid == 0) {
+		if (crypto_entropy_thread_read(out[0], 32) ||
+		    (write(fd[1], out[0], 32) != 32))
+			_exit(1);
+		_exit(0);
+	}
+	if (crypto_entropy_thread_read(out[NTHREADS + 1], 32))
+		goto err0;
+	if (read(fd[0], out[NTHREADS], 32) != 32) {
+		warn0("Child process did not produce output");
+		goto err0;
+	}
+	if ((waitpid(pid, &status, 0) != pid) || (status != 0)) {
+		warn0("Child process failed");
+		goto err0;
+	}
+	close(fd[0]);
+	close(fd[1]);
+
+	/* All outputs must be different. */
+	for (i = 0; i < NTHREADS + 2; i++) {
+		for (j = 0; j < i; j++) {
+			if (memcmp(out[i], out[j], 32) == 0) {
+				warn0("Entropy output repeated");
+				goto err0;
+			}
+		}
+	}
+
+	/* Free this thread's generator. */
+	crypto_entropy_thread_free();
+
+	/* Success! */
+	return (0);
+
+err0:
+	/* Failure! */
+	return (-1);
+}
+
+int
+main(int argc, char * argv[])
+{
+
+	WARNP_INIT;
+
+	(void)argc;
+	(void)argv;
+
+	/* Exercise the default HMAC_DRBG. */
+	if (readmany())
+		goto err0;
+
+	/* Check the AES-CTR generator, and switch to using it. */
+	if (check_aesctr())
+		goto err0;
+	if (crypto_entropy_aesctr_use()) {
+		warn0("crypto_entropy_aesctr_use(): internal error.");
+		goto err0;
+	}
+	if (readmany())
+		goto err0;
+
+	/* Check the thread-safe front end. */
+	if (check_threads())
+		goto err0;
+
 	/* Success! */
 	exit(0);
 
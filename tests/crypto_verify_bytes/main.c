@@ -0,0 +1,438 @@
+#include <math.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "crypto_verify_bytes.h"
+#include "getopt.h"
+#include "perftest.h"
+#include "warnp.h"
+
+/* Largest buffer length to check in the self-test. */
+#define MAXLEN 100
+
+/* Number of pairs in the batch tests. */
+#define BATCH_N 5
+
+/* Performance tests. */
+static const size_t perfsizes[] = {16, 32, 64, 256, 1024, 4096};
+static const size_t num_perf = sizeof(perfsizes) / sizeof(perfsizes[0]);
+static const size_t nbytes_perftest = 1 << 25;		/* approx 34 MB */
+static const size_t nbytes_warmup = 1024 * 10000;	/* approx 10 MB */
+
+/* Timing test: number of measurements, and calls per measurement. */
+#define CT_NMEAS 200000
+#define CT_INNER 16
+#define CT_LEN 32
+
+/*
+ * Timing test: |t| statistic above which we conclude that a function's
+ * timing depends on its input (the "definitely not constant time" threshold
+ * used by dudect).
+ */
+#define CT_THRESHOLD 10.0
+
+static int
+perftest_init(void * cookie, uint8_t * buf, size_t buflen)
+{
+	uint8_t * buf1 = cookie;
+
+	/* Make the buffers identical, so every byte must be compared. */
+	memset(buf, 0, buflen);
+	memset(buf1, 0, buflen);
+
+	/* Success! */
+	return (0);
+}
+
+static int
+perftest_func(void * cookie, uint8_t * buf, size_t buflen, size_t nreps)
+{
+	uint8_t * buf1 = cookie;
+	size_t i;
+
+	/* Do the comparisons. */
+	for (i = 0; i < nreps; i++) {
+		if (crypto_verify_bytes(buf, buf1, buflen))
+			goto err0;
+	}
+
+	/* Success! */
+	return (0);
+
+err0:
+	/* Failure! */
+	return (1);
+}
+
+static int
+perftest(void)
+{
+	uint8_t * buf1;
+
+	printf("Performance test of crypto_verify_bytes\n");
+	fflush(stdout);
+
+	/* Allocate the second buffer. */
+	if ((buf1 = malloc(perfsizes[num_perf - 1])) == NULL) {
+		warnp("malloc");
+		goto err0;
+	}
+
+	/* Time the function. */
+	if (perftest_buffers(nbytes_perftest, perfsizes, num_perf,
+	    nbytes_warmup, 1, perftest_init, perftest_func, NULL, buf1)) {
+		warn0("perftest_buffers");
+		goto err1;
+	}
+
+	/* Clean up. */
+	free(buf1);
+
+	/* Success! */
+	return (0);
+
+err1:
+	free(buf1);
+err0:
+	/* Failure! */
+	return (1);
+}
+
+/* A comparison which returns as soon as it finds a difference. */
+static uint8_t
+verify_earlyexit(const uint8_t * buf0, const uint8_t * buf1, size_t len)
+{
+	size_t i;
+
+	for (i = 0; i < len; i++) {
+		if (buf0[i] != buf1[i])
+			return (1);
+	}
+
+	return (0);
+}
+
+/* Call comparison functions via a pointer, to prevent inlining. */
+static uint8_t (* volatile verify_func)(const uint8_t *, const uint8_t *,
+    size_t);
+
+/* Return the time in nanoseconds. */
+static uint64_t
+getns(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ((uint64_t)ts.tv_sec * 1000000000 + (uint64_t)ts.tv_nsec);
+}
+
+static int
+cmp_u64(const void * a, const void * b)
+{
+	uint64_t x = *(const uint64_t *)a;
+	uint64_t y = *(const uint64_t *)b;
+
+	return ((x > y) - (x < y));
+}
+
+/**
+ * Measure the time taken by ${func} to compare a fixed secret with inputs
+ * which are either equal to it (class 0) or random (class 1), and return the
+ * Welch's t statistic of the two classes of measurements, after discarding
+ * measurements above the 90th percentile (which are dominated by interrupts
+ * and other noise).  This is the method of dudect (Reparaz, Balasch, and
+ * Verbauwhede, "Dude, is my code constant time?").
+ */
+static int
+ct_measure(uint8_t (* func)(const uint8_t *, const uint8_t *, size_t),
+    double * t)
+{
+	uint8_t secret[CT_LEN];
+	uint8_t * inputs;
+	uint8_t * classes;
+	uint64_t * times;
+	uint64_t * sorted;
+	uint64_t cutoff;
+	uint64_t t0;
+	uint32_t x = 1;
+	double n[2] = {0, 0}, mean[2] = {0, 0}, m2[2] = {0, 0};
+	double delta;
+	size_t i, j;
+	int c;
+
+	/* Allocate space. */
+	if ((inputs = malloc(CT_NMEAS * CT_LEN)) == NULL)
+		goto err0;
+	if ((classes = malloc(CT_NMEAS)) == NULL)
+		goto err1;
+	if ((times = malloc(CT_NMEAS * sizeof(uint64_t))) == NULL)
+		goto err2;
+	if ((sorted = malloc(CT_NMEAS * sizeof(uint64_t))) == NULL)
+		goto err3;
+
+	/* Prepare the inputs using a simple xorshift generator. */
+	for (i = 0; i < CT_LEN; i++) {
+		x ^= x << 13, x ^= x >> 17, x ^= x << 5;
+		secret[i] = (uint8_t)x;
+	}
+	for (i = 0; i < CT_NMEAS; i++) {
+		x ^= x << 13, x ^= x >> 17, x ^= x << 5;
+		classes[i] = x & 1;
+		for (j = 0; j < CT_LEN; j++) {
+			x ^= x << 13, x ^= x >> 17, x ^= x << 5;
+			inputs[i * CT_LEN + j] = classes[i] ? (uint8_t)x :
+			    secret[j];
+		}
+	}
+
+	/* Take the measurements. */
+	verify_func = func;
+	for (i = 0; i < CT_NMEAS; i++) {
+		t0 = getns();
+		for (j = 0; j < CT_INNER; j++)
+			verify_func(secret, &inputs[i * CT_LEN], CT_LEN);
+		times[i] = getns() - t0;
+	}
+
+	/* Find the cutoff. */
+	memcpy(sorted, times, CT_NMEAS * sizeof(uint64_t));
+	qsort(sorted, CT_NMEAS, sizeof(uint64_t), cmp_u64);
+	cutoff = sorted[CT_NMEAS / 10 * 9];
+
+	/* Compute means and variances using Welford's method. */
+	for (i = 0; i < CT_NMEAS; i++) {
+		if (times[i] > cutoff)
+			continue;
+		c = classes[i];
+		n[c] += 1;
+		delta = (double)times[i] - mean[c];
+		mean[c] += delta / n[c];
+		m2[c] += delta * ((double)times[i] - mean[c]);
+	}
+	if ((n[0] < 2) || (n[1] < 2)) {
+		warn0("Not enough measurements");
+		goto err4;
+	}
+
+	/* Welch's t statistic. */
+	*t = (mean[0] - mean[1]) / sqrt(m2[0] / (n[0] - 1) / n[0] +
+	    m2[1] / (n[1] - 1) / n[1]);
+
+	/* Clean up. */
+	free(sorted);
+	free(times);
+	free(classes);
+	free(inputs);
+
+	/* Success! */
+	return (0);
+
+err4:
+	free(sorted);
+err3:
+	free(times);
+err2:
+	free(classes);
+err1:
+	free(inputs);
+err0:
+	/* Failure! */
+	return (-1);
+}
+
+static int
+cttest(void)
+{
+	double t;
+	int failures = 0;
+
+	printf("Timing test of crypto_verify_bytes\n");
+	fflush(stdout);
+
+	/* The function under test must not leak. */
+	printf("crypto_verify_bytes:\t");
+	if (ct_measure(crypto_verify_bytes, &t))
+		goto err0;
+	if (fabs(t) > CT_THRESHOLD) {
+		printf("|t| = %.2f FAILED!\n", fabs(t));
+		failures++;
+	} else {
+		printf("|t| = %.2f PASSED!\n", fabs(t));
+	}
+
+	/* A control which leaks must be detected. */
+	printf("early-exit control:\t");
+	if (ct_measure(verify_earlyexit, &t))
+		goto err0;
+	if (fabs(t) <= CT_THRESHOLD) {
+		printf("|t| = %.2f FAILED (leak not detected)!\n", fabs(t));
+		failures++;
+	} else {
+		printf("|t| = %.2f PASSED!\n", fabs(t));
+	}
+
+	/* Report overall success to exit code. */
+	return (failures ? 1 : 0);
+
+err0:
+	/* Failure! */
+	return (1);
+}
+
+static size_t
+selftest_lengths(void)
+{
+	uint8_t buf0[MAXLEN];
+	uint8_t buf1[MAXLEN];
+	size_t len, i;
+
+	printf("Checking all lengths and positions...");
+
+	/* Fill the buffers. */
+	for (i = 0; i < MAXLEN; i++)
+		buf0[i] = buf1[i] = (uint8_t)(i * 7);
+
+	/* Check every length, with no difference and one at each position. */
+	for (len = 0; len <= MAXLEN; len++) {
+		if (crypto_verify_bytes(buf0, buf1, len) != 0)
+			goto fail;
+		for (i = 0; i < len; i++) {
+			buf1[i] ^= 0x80;
+			if (crypto_verify_bytes(buf0, buf1, len) == 0)
+				goto fail;
+			buf1[i] ^= 0x81;
+			if (crypto_verify_bytes(buf0, buf1, len) == 0)
+				goto fail;
+			buf1[i] ^= 0x01;
+		}
+
+		/* A difference beyond the end must be ignored. */
+		if (len < MAXLEN) {
+			buf1[len] ^= 0xff;
+			if (crypto_verify_bytes(buf0, buf1, len) != 0)
+				goto fail;
+			buf1[len] ^= 0xff;
+		}
+	}
+
+	/* Success! */
+	printf(" PASSED!\n");
+	return (0);
+
+fail:
+	printf(" FAILED!\n");
+	printf("Incorrect result for length %zu\n", len);
+	return (1);
+}
+
+static size_t
+selftest_batch(void)
+{
+	uint8_t tags[BATCH_N][32];
+	uint8_t expected[BATCH_N][32];
+	const uint8_t * bufs0[BATCH_N];
+	const uint8_t * bufs1[BATCH_N];
+	uint8_t results[BATCH_N];
+	size_t i;
+
+	printf("Checking batch verification...");
+
+	/* Prepare matching pairs. */
+	for (i = 0; i < BATCH_N; i++) {
+		memset(tags[i], (int)i, 32);
+		memset(expected[i], (int)i, 32);
+		bufs0[i] = tags[i];
+		bufs1[i] = expected[i];
+	}
+
+	/* All pairs match. */
+	if (crypto_verify_bytes_batch(bufs0, bufs1, 32, BATCH_N, results))
+		goto fail;
+	for (i = 0; i < BATCH_N; i++) {
+		if (results[i])
+			goto fail;
+	}
+
+	/* Change the last byte of one pair. */
+	expected[2][31] ^= 1;
+	if (crypto_verify_bytes_batch(bufs0, bufs1, 32, BATCH_N, results) == 0)
+		goto fail;
+	for (i = 0; i < BATCH_N; i++) {
+		if ((results[i] != 0) != (i == 2))
+			goto fail;
+	}
+	if (crypto_verify_bytes_batch(bufs0, bufs1, 32, BATCH_N, NULL) == 0)
+		goto fail;
+
+	/* An empty batch matches. */
+	if (crypto_verify_bytes_batch(bufs0, bufs1, 32, 0, NULL))
+		goto fail;
+
+	/* Success! */
+	printf(" PASSED!\n");
+	return (0);
+
+fail:
+	printf(" FAILED!\n");
+	return (1);
+}
+
+static int
+selftest(void)
+{
+	int failures = 0;
+
+	printf("Checking crypto_verify_bytes\n");
+
+	/* Test all lengths. */
+	if (selftest_lengths())
+		failures++;
+
+	/* Test batches. */
+	if (selftest_batch())
+		failures++;
+
+	/* Report overall success to exit code. */
+	if (failures)
+		return (1);
+	else
+		return (0);
+}
+
+static void
+usage(void)
+{
+
+	fprintf(stderr, "usage: test_crypto_verify_bytes -c\n");
+	fprintf(stderr, "       test_crypto_verify_bytes -t\n");
+	fprintf(stderr, "       test_crypto_verify_bytes -x\n");
+	exit(1);
+}
+
+int
+main(int argc, char * argv[])
+{
+	const char * ch;
+
+	WARNP_INIT;
+
+	/* Process arguments. */
+	while ((ch = GETOPT(argc, argv)) != NULL) {
+		GETOPT_SWITCH(ch) {
+		GETOPT_OPT("-c"):
+			exit(cttest());
+		GETOPT_OPT("-t"):
+			exit(perftest());
+		GETOPT_OPT("-x"):
+			exit(selftest());
+		GETOPT_DEFAULT:
+			usage();
+		}
+	}
+
+	usage();
+}
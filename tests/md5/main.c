@@ -8,6 +8,7 @@
 #include "getopt.h"
 #include "hexify.h"
 #include "md5.h"
+#include "md5_multi.h"
 #include "perftest.h"
 #include "warnp.h"
 
@@ -94,12 +95,89 @@ static struct testcase {
 	"3a6b65dc78a585d7aad5a284ea1a688c"}
 };
 
+/* Number of messages in the multi-buffer test: each test vector 3 times. */
+#define NTESTS (sizeof(tests) / sizeof(tests[0]))
+#define NMULTI (3 * NTESTS)
+
+/* Check multi-buffer hashing by hashing the test vectors all at once. */
+static size_t
+selftest_multi(void)
+{
+	const uint8_t * in[NMULTI];
+	size_t len[NMULTI];
+	uint8_t digests[NMULTI][16];
+	char hbuf_hex[33];
+	size_t i;
+	size_t failures = 0;
+
+	/* More messages than lanes, so that lanes move on to new messages. */
+	printf("Computing MD5 of %zu messages at once...", NMULTI);
+	for (i = 0; i < NMULTI; i++) {
+		in[i] = (const uint8_t *)tests[i % NTESTS].s;
+		len[i] = strlen(tests[i % NTESTS].s);
+	}
+	MD5_Buf_multi(in, len, digests, NMULTI);
+
+	/* Check each hash. */
+	for (i = 0; i < NMULTI; i++) {
+		hexify(digests[i], hbuf_hex, 16);
+		if (strcmp(hbuf_hex, tests[i % NTESTS].o))
+			failures++;
+	}
+	if (failures)
+		printf(" FAILED!\n");
+	else
+		printf(" PASSED!\n");
+
+	return (failures);
+}
+
+/* Number and size of parts in the multipart ETag test. */
+#define ETAG_NPARTS 143
+#define ETAG_PARTLEN 7000
+
+/* S3 multipart ETag digest of 1000000 bytes, in parts of 7000 bytes. */
+static const char * etagout = "a88b940539ab458415d1e8cb3706bfb2";
+
+/* Check the S3 multipart ETag digest computation. */
+static size_t
+selftest_etag(const uint8_t * buf)
+{
+	const uint8_t * parts[ETAG_NPARTS];
+	size_t lens[ETAG_NPARTS];
+	uint8_t hbuf[16];
+	char hbuf_hex[33];
+	size_t i;
+
+	/* Split the buffer into parts; the last part is shorter. */
+	printf("Computing multipart ETag of %d parts...", ETAG_NPARTS);
+	for (i = 0; i < ETAG_NPARTS; i++) {
+		parts[i] = &buf[i * ETAG_PARTLEN];
+		lens[i] = ETAG_PARTLEN;
+	}
+	lens[ETAG_NPARTS - 1] = 1000000 - (ETAG_NPARTS - 1) * ETAG_PARTLEN;
+	MD5_ETag_multipart(parts, lens, ETAG_NPARTS, hbuf);
+
+	/* Check the result. */
+	hexify(hbuf, hbuf_hex, 16);
+	if (strcmp(hbuf_hex, etagout)) {
+		printf(" FAILED!\n");
+		printf("Computed ETag MD5: %s\n", hbuf_hex);
+		printf("Correct ETag MD5:  %s\n", etagout);
+		return (1);
+	}
+	printf(" PASSED!\n");
+
+	return (0);
+}
+
 static int
 selftest(void)
 {
 	MD5_CTX ctx;
 	uint8_t hbuf[16];
 	char hbuf_hex[33];
+	uint8_t * buf;
 	size_t i;
 	size_t failures = 0;
 
@@ -120,6 +198,19 @@ selftest(void)
 		}
 	}
 
+	/* Multi-buffer hashing. */
+	failures += selftest_multi();
+
+	/* Multipart ETags. */
+	if ((buf = malloc(1000000)) == NULL) {
+		warnp("malloc");
+		return (1);
+	}
+	for (i = 0; i < 1000000; i++)
+		buf[i] = (uint8_t)(i & 0xff);
+	failures += selftest_etag(buf);
+	free(buf);
+
 	if (failures)
 		return (1);
 	else
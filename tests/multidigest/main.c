@@ -0,0 +1,245 @@
+#include <sys/time.h>
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "crc32c.h"
+#include "getopt.h"
+#include "md5.h"
+#include "monoclock.h"
+#include "sha256.h"
+#include "warnp.h"
+
+#include "multidigest.h"
+
+/* Big enough to need several threaded blocks, and not a multiple of them. */
+#define BUFLEN (3 * 1048576 + 12345)
+
+/* Lengths to test. */
+static const size_t lens[] = {0, 1, 63, 64, 16383, 16384, 100000, BUFLEN};
+
+/* Size of the buffer used for the performance test: larger than most LLCs. */
+#define PERF_BUFLEN (256 * 1048576)
+
+/* Compute the digests of ${buf} separately. */
+static void
+digests_separately(const uint8_t * buf, size_t len, uint8_t crc32c[4],
+    uint8_t md5[16], uint8_t sha256[32])
+{
+	CRC32C_CTX ctx;
+
+	CRC32C_Init(&ctx);
+	CRC32C_Update(&ctx, buf, len);
+	CRC32C_Final(crc32c, &ctx);
+	MD5_Buf(buf, len, md5);
+	SHA256_Buf(buf, len, sha256);
+}
+
+/* Check multidigest against separately computed digests. */
+static int
+selftest(void)
+{
+	uint8_t * buf;
+	uint8_t crc32c[4], md5[16], sha256[32];
+	uint8_t crc32c_m[4], md5_m[16], sha256_m[32];
+	struct multidigest * M;
+	size_t i, j, pos, n;
+	int algs;
+	int threaded;
+	int failures = 0;
+
+	/* Prepare a buffer. */
+	if ((buf = malloc(BUFLEN)) == NULL) {
+		warnp("malloc");
+		goto err0;
+	}
+	for (i = 0; i < BUFLEN; i++)
+		buf[i] = (uint8_t)((i * i + (i >> 9)) & 0xff);
+
+	for (i = 0; i < sizeof(lens) / sizeof(lens[0]); i++) {
+		printf("Computing digests of %zu bytes...", lens[i]);
+		digests_separately(buf, lens[i], crc32c, md5, sha256);
+
+		/* Try all combinations of digests, with and without threads. */
+		for (algs = 1; algs < 8; algs++) {
+			for (threaded = 0; threaded < 2; threaded++) {
+				memset(crc32c_m, 0, 4);
+				memset(md5_m, 0, 16);
+				memset(sha256_m, 0, 32);
+				if (multidigest_buf(algs, buf, lens[i],
+				    threaded, crc32c_m, md5_m, sha256_m))
+					goto err1;
+				if (((algs & MULTIDIGEST_CRC32C) &&
+				    memcmp(crc32c, crc32c_m, 4)) ||
+				    ((algs & MULTIDIGEST_MD5) &&
+				    memcmp(md5, md5_m, 16)) ||
+				    ((algs & MULTIDIGEST_SHA256) &&
+				    memcmp(sha256, sha256_m, 32)))
+					goto failed;
+			}
+		}
+
+		/* Feed the data in pieces of varying sizes. */
+		if ((M = multidigest_init(MULTIDIGEST_CRC32C | MULTIDIGEST_MD5 |
+		    MULTIDIGEST_SHA256, 1)) == NULL)
+			goto err1;
+		for (pos = 0, j = 0; pos < lens[i]; pos += n, j++) {
+			n = (j * j * 997) % 150000;
+			if (n > lens[i] - pos)
+				n = lens[i] - pos;
+			if (multidigest_update(M, &buf[pos], n)) {
+				multidigest_free(M);
+				goto err1;
+			}
+		}
+		if (multidigest_final(M, crc32c_m, md5_m, sha256_m))
+			goto err1;
+		if (memcmp(crc32c, crc32c_m, 4) || memcmp(md5, md5_m, 16) ||
+		    memcmp(sha256, sha256_m, 32))
+			goto failed;
+
+		printf(" PASSED!\n");
+		continue;
+failed:
+		printf(" FAILED!\n");
+		failures++;
+	}
+
+	/* An engine which is freed without being used must not leak. */
+	printf("Freeing an unused engine...");
+	if ((M = multidigest_init(MULTIDIGEST_MD5 | MULTIDIGEST_SHA256,
+	    1)) == NULL)
+		goto err1;
+	multidigest_free(M);
+	printf(" PASSED!\n");
+
+	/* Clean up. */
+	free(buf);
+
+	/* Report overall success to exit code. */
+	return (failures ? 1 : 0);
+
+err1:
+	free(buf);
+err0:
+	/* Failure! */
+	return (1);
+}
+
+/* Print the speed of processing PERF_BUFLEN bytes since ${begin}. */
+static int
+printspeed(const char * desc, struct timeval * begin)
+{
+	struct timeval end;
+	double t;
+
+	if (monoclock_get(&end)) {
+		warnp("monoclock_get");
+		goto err0;
+	}
+	t = timeval_diff((*begin), end);
+	printf("%s\t%.6f s\t%.6f MB/s\n", desc, t,
+	    (double)PERF_BUFLEN / 1e6 / t);
+
+	/* Success! */
+	return (0);
+
+err0:
+	/* Failure! */
+	return (-1);
+}
+
+/* Compare one pass with three passes over a buffer larger than the LLC. */
+static int
+perftest(void)
+{
+	uint8_t * buf;
+	uint8_t crc32c[4], md5[16], sha256[32];
+	struct timeval begin;
+
+	/* Prepare a buffer. */
+	if ((buf = malloc(PERF_BUFLEN)) == NULL) {
+		warnp("malloc");
+		goto err0;
+	}
+	memset(buf, 0, PERF_BUFLEN);
+
+	/* Inform user. */
+	printf("Computing CRC32C, MD5, and SHA256 of %d bytes.\n",
+	    PERF_BUFLEN);
+	fflush(stdout);
+
+	/* Separate passes. */
+	if (monoclock_get(&begin)) {
+		warnp("monoclock_get");
+		goto err1;
+	}
+	digests_separately(buf, PERF_BUFLEN, crc32c, md5, sha256);
+	if (printspeed("separate", &begin))
+		goto err1;
+
+	/* One pass, with and without threads. */
+	if (monoclock_get(&begin)) {
+		warnp("monoclock_get");
+		goto err1;
+	}
+	if (multidigest_buf(MULTIDIGEST_CRC32C | MULTIDIGEST_MD5 |
+	    MULTIDIGEST_SHA256, buf, PERF_BUFLEN, 0, crc32c, md5, sha256))
+		goto err1;
+	if (printspeed("multidigest", &begin))
+		goto err1;
+	if (monoclock_get(&begin)) {
+		warnp("monoclock_get");
+		goto err1;
+	}
+	if (multidigest_buf(MULTIDIGEST_CRC32C | MULTIDIGEST_MD5 |
+	    MULTIDIGEST_SHA256, buf, PERF_BUFLEN, 1, crc32c, md5, sha256))
+		goto err1;
+	if (printspeed("multidigest-threaded", &begin))
+		goto err1;
+
+	/* Clean up. */
+	free(buf);
+
+	/* Success! */
+	return (0);
+
+err1:
+	free(buf);
+err0:
+	/* Failure! */
+	return (1);
+}
+
+static void
+usage(void)
+{
+
+	fprintf(stderr, "usage: test_multidigest -t\n");
+	fprintf(stderr, "       test_multidigest -x\n");
+	exit(1);
+}
+
+int
+main(int argc, char * argv[])
+{
+	const char * ch;
+
+	WARNP_INIT;
+
+	/* Process arguments. */
+	while ((ch = GETOPT(argc, argv)) != NULL) {
+		GETOPT_SWITCH(ch) {
+		GETOPT_OPT("-t"):
+			exit(perftest());
+		GETOPT_OPT("-x"):
+			exit(selftest());
+		GETOPT_DEFAULT:
+			usage();
+		}
+	}
+
+	usage();
+}
@@ -95,13 +95,18 @@ static struct testcase {
 	"2ae087bc6f7e02c7e4d1b962639126c711bfd05f"}
 };
 
+/* SHA1 of one million 'a's. */
+static const char * millionaout = "34aa973cd4c4daa4f61eeb2bdbad27316534016f";
+
 static int
 selftest(void)
 {
 	SHA1_CTX ctx;
+	uint8_t mbuf[4096];
 	uint8_t hbuf[20];
 	char hbuf_hex[41];
 	size_t i;
+	size_t len;
 	size_t failures = 0;
 
 	for (i = 0; i < sizeof(tests) / sizeof(tests[0]); i++) {
@@ -121,6 +126,29 @@ selftest(void)
 		}
 	}
 
+	/* Hash one million 'a's, in chunks which straddle block boundaries. */
+	printf("Computing SHA1 of 1000000 'a's...");
+	memset(mbuf, 'a', sizeof(mbuf));
+	SHA1_Init(&ctx);
+	for (i = 0; i < 1000000; i += len) {
+		len = (i % 1000) + 1;
+		if (len > sizeof(mbuf))
+			len = sizeof(mbuf);
+		if (len > 1000000 - i)
+			len = 1000000 - i;
+		SHA1_Update(&ctx, mbuf, len);
+	}
+	SHA1_Final(hbuf, &ctx);
+	hexify(hbuf, hbuf_hex, 20);
+	if (strcmp(hbuf_hex, millionaout)) {
+		printf(" FAILED!\n");
+		printf("Computed SHA1: %s\n", hbuf_hex);
+		printf("Correct SHA1:  %s\n", millionaout);
+		failures++;
+	} else {
+		printf(" PASSED!\n");
+	}
+
 	if (failures)
 		return (1);
 	else
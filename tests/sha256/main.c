@@ -11,6 +11,9 @@
 #include "monoclock.h"
 #include "perftest.h"
 #include "sha256.h"
+#include "sha256_multi.h"
+#include "sha256_parallel.h"
+#include "sha256_tree.h"
 #include "warnp.h"
 
 /* Performance tests. */
@@ -131,12 +134,333 @@ static struct testcase {
 	"c1faed8b43f81861a508d9f4034acb854706597d3d4eea52f55bdd47debd3e70"}
 };
 
+/* SHA256 of one million repetitions of 'a'. */
+static const char * million_a_hex =
+    "cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0";
+
+static struct pbkdf2_testcase {
+	const char * P;
+	const char * S;
+	uint64_t c;
+	size_t dkLen;
+	const char * o;
+} pbkdf2_tests[] = {
+	{ "passwd", "salt", 1, 64,
+	    "55ac046e56e3089fec1691c22544b605f94185216dde0465e68b9d57c20dacbc"
+	    "49ca9cccf179b645991664b39d77ef317c71b845b1e30bd509112041d3a19783"
+	},
+	{ "password", "salt", 2, 32,
+	    "ae4d0c95af6b46d32d0adff928f06dd02a303f8ef3c251dfd6e2d85a95474c43"
+	},
+	{ "password", "salt", 4096, 40,
+	    "c5e478d59288c841aa530db6845c4c8d962893a001ce4e11a4963873aa98134a"
+	    "f7ad98c1b458ce3f"
+	},
+	{ "Password", "NaCl", 80000, 64,
+	    "4ddcd8f60b98be21830cee5ef22701f9641a4418d04c0414aeff08876b34ab56"
+	    "a1d425a1225833549adb841b51c9b3176a272bdebba1d078478f62b397f33c8d"
+	}
+};
+
+/* Check precomputed-key HMAC against computing the HMAC directly. */
+static size_t
+selftest_hmac_prekeyed(void)
+{
+	static const size_t keylens[] = {0, 1, 32, 64, 65, 200};
+	HMAC_SHA256_KEY key;
+	HMAC_SHA256_CTX ctx;
+	uint8_t buf[256];
+	uint8_t hbuf[32];
+	uint8_t hbuf_ref[32];
+	size_t i, len;
+	size_t failures = 0;
+
+	printf("Computing HMAC-SHA256 with precomputed keys...");
+	for (i = 0; i < 256; i++)
+		buf[i] = (uint8_t)(i * 7 + 3);
+	for (i = 0; i < sizeof(keylens) / sizeof(keylens[0]); i++) {
+		HMAC_SHA256_Key_Init(&key, buf, keylens[i]);
+		for (len = 0; len < 200; len++) {
+			HMAC_SHA256_Buf(buf, keylens[i], &buf[56], len,
+			    hbuf_ref);
+
+			/* One-shot. */
+			HMAC_SHA256_Buf_prekeyed(&key, &buf[56], len, hbuf);
+			if (memcmp(hbuf, hbuf_ref, 32))
+				failures++;
+
+			/* Incremental. */
+			HMAC_SHA256_Init_prekeyed(&ctx, &key);
+			HMAC_SHA256_Update(&ctx, &buf[56], len / 3);
+			HMAC_SHA256_Update(&ctx, &buf[56 + len / 3],
+			    len - len / 3);
+			HMAC_SHA256_Final(hbuf, &ctx);
+			if (memcmp(hbuf, hbuf_ref, 32))
+				failures++;
+		}
+	}
+	if (failures)
+		printf(" FAILED!\n");
+	else
+		printf(" PASSED!\n");
+
+	return (failures);
+}
+
+/* Check PBKDF2_SHA256 against test vectors. */
+static size_t
+selftest_pbkdf2(void)
+{
+	uint8_t dk[64];
+	char dk_hex[129];
+	size_t i;
+	size_t failures = 0;
+
+	for (i = 0; i < sizeof(pbkdf2_tests) / sizeof(pbkdf2_tests[0]); i++) {
+		printf("Computing PBKDF2_SHA256(\"%s\", \"%s\", %ju)...",
+		    pbkdf2_tests[i].P, pbkdf2_tests[i].S,
+		    (uintmax_t)pbkdf2_tests[i].c);
+		PBKDF2_SHA256((const uint8_t *)pbkdf2_tests[i].P,
+		    strlen(pbkdf2_tests[i].P),
+		    (const uint8_t *)pbkdf2_tests[i].S,
+		    strlen(pbkdf2_tests[i].S), pbkdf2_tests[i].c, dk,
+		    pbkdf2_tests[i].dkLen);
+		hexify(dk, dk_hex, pbkdf2_tests[i].dkLen);
+		if (strcmp(dk_hex, pbkdf2_tests[i].o)) {
+			printf(" FAILED!\n");
+			printf("Computed: %s\n", dk_hex);
+			printf("Correct:  %s\n", pbkdf2_tests[i].o);
+			failures++;
+		} else {
+			printf(" PASSED!\n");
+		}
+	}
+
+	return (failures);
+}
+
+/* Check parallel PBKDF2 against computing one block at a time. */
+static size_t
+selftest_pbkdf2_parallel(void)
+{
+	static const size_t nthreads[] = {1, 2, 3, 8};
+	uint8_t dk[200];
+	uint8_t dk_par[200];
+	size_t i;
+	size_t failures = 0;
+
+	printf("Computing PBKDF2_SHA256 in parallel...");
+	PBKDF2_SHA256((const uint8_t *)"password", 8,
+	    (const uint8_t *)"salt", 4, 1000, dk, 200);
+
+	/* Several blocks at once, starting part-way through. */
+	PBKDF2_SHA256_blocks_multi((const uint8_t *)"password", 8,
+	    (const uint8_t *)"salt", 4, 1000, dk_par, 1, 5);
+	if (memcmp(&dk[32], dk_par, 5 * 32))
+		failures++;
+
+	/* Spread across various numbers of threads. */
+	for (i = 0; i < sizeof(nthreads) / sizeof(nthreads[0]); i++) {
+		memset(dk_par, 0, 200);
+		if (PBKDF2_SHA256_parallel((const uint8_t *)"password", 8,
+		    (const uint8_t *)"salt", 4, 1000, dk_par, 200,
+		    nthreads[i]) || memcmp(dk, dk_par, 200))
+			failures++;
+	}
+	if (failures)
+		printf(" FAILED!\n");
+	else
+		printf(" PASSED!\n");
+
+	return (failures);
+}
+
+/*
+ * Check parallel PBKDF2 when it is the first use of SHA256, so that the
+ * hardware acceleration choice has not yet been made when it is called.
+ */
+static int
+selftest_pbkdf2_first(void)
+{
+	uint8_t dk[200];
+	uint8_t dk_par[200];
+	size_t failures = 0;
+
+	printf("Computing PBKDF2_SHA256 in parallel as the first SHA256...");
+	if (PBKDF2_SHA256_parallel((const uint8_t *)"password", 8,
+	    (const uint8_t *)"salt", 4, 1000, dk_par, 200, 4))
+		failures++;
+	PBKDF2_SHA256((const uint8_t *)"password", 8,
+	    (const uint8_t *)"salt", 4, 1000, dk, 200);
+	if (memcmp(dk, dk_par, 200))
+		failures++;
+
+	/* Report result. */
+	if (failures) {
+		printf(" FAILED!\n");
+		return (1);
+	} else {
+		printf(" PASSED!\n");
+		return (0);
+	}
+}
+
+/* Number of messages to hash at once in the multi-buffer test. */
+#define NMULTI 202
+
+/* Check multi-buffer hashing against hashing one message at a time. */
+static size_t
+selftest_multi(void)
+{
+	const uint8_t * in[NMULTI];
+	size_t len[NMULTI];
+	uint8_t (* digests)[32];
+	uint8_t hbuf[32];
+	uint8_t * buf;
+	size_t i;
+	size_t failures = 0;
+
+	/* Allocate buffers. */
+	if ((buf = malloc(1000000)) == NULL) {
+		warnp("malloc");
+		return (1);
+	}
+	if ((digests = malloc(NMULTI * sizeof(digests[0]))) == NULL) {
+		warnp("malloc");
+		free(buf);
+		return (1);
+	}
+
+	/* Messages of every length up to 200 bytes, plus a long one. */
+	printf("Computing SHA256 of %d messages at once...", NMULTI);
+	for (i = 0; i < 1000000; i++)
+		buf[i] = (uint8_t)(i & 0xff);
+	for (i = 0; i < NMULTI - 1; i++) {
+		in[i] = &buf[i];
+		len[i] = i;
+	}
+	in[NMULTI - 1] = buf;
+	len[NMULTI - 1] = 1000000;
+	SHA256_Buf_multi(in, len, digests, NMULTI);
+
+	/* Check each hash. */
+	for (i = 0; i < NMULTI; i++) {
+		SHA256_Buf(in[i], len[i], hbuf);
+		if (memcmp(hbuf, digests[i], 32))
+			failures++;
+	}
+	if (failures)
+		printf(" FAILED!\n");
+	else
+		printf(" PASSED!\n");
+
+	/* Clean up. */
+	free(digests);
+	free(buf);
+
+	return (failures);
+}
+
+/* Compute a tree hash level by level, as described in sha256_tree.h. */
+static void
+tree_reference(const uint8_t * buf, size_t len, uint8_t digest[32])
+{
+	uint8_t (* h)[32];
+	size_t n, i;
+
+	/* Hash the chunks. */
+	n = (len + SHA256_TREE_CHUNKLEN - 1) / SHA256_TREE_CHUNKLEN;
+	if (n == 0)
+		n = 1;
+	if ((h = malloc(n * 32)) == NULL) {
+		warnp("malloc");
+		exit(1);
+	}
+	for (i = 0; i < n; i++)
+		SHA256_Buf(&buf[i * SHA256_TREE_CHUNKLEN],
+		    (len - i * SHA256_TREE_CHUNKLEN > SHA256_TREE_CHUNKLEN) ?
+		    SHA256_TREE_CHUNKLEN : len - i * SHA256_TREE_CHUNKLEN,
+		    h[i]);
+
+	/* Hash pairs, carrying an unpaired hash up to the next level. */
+	for (; n > 1; n = (n + 1) / 2) {
+		for (i = 0; i < n / 2; i++)
+			SHA256_Buf(h[2 * i], 64, h[i]);
+		if (n % 2)
+			memcpy(h[n / 2], h[n - 1], 32);
+	}
+	memcpy(digest, h[0], 32);
+	free(h);
+}
+
+/* Check tree hashing against a level-by-level computation. */
+static size_t
+selftest_tree(void)
+{
+	static const size_t lens[] = {0, 1, SHA256_TREE_CHUNKLEN - 1,
+	    SHA256_TREE_CHUNKLEN, SHA256_TREE_CHUNKLEN + 1,
+	    3 * SHA256_TREE_CHUNKLEN, 5 * SHA256_TREE_CHUNKLEN + 7,
+	    7 * SHA256_TREE_CHUNKLEN, 12 * SHA256_TREE_CHUNKLEN + 12345};
+	static const size_t nthreads[] = {1, 2, 3, 8};
+	SHA256_TREE_CTX ctx;
+	uint8_t hbuf[32];
+	uint8_t hbuf_ref[32];
+	uint8_t * buf;
+	size_t maxlen = 12 * SHA256_TREE_CHUNKLEN + 12345;
+	size_t i, j, pos, n;
+	size_t failures = 0;
+
+	/* Allocate and fill a buffer. */
+	if ((buf = malloc(maxlen)) == NULL) {
+		warnp("malloc");
+		return (1);
+	}
+	for (i = 0; i < maxlen; i++)
+		buf[i] = (uint8_t)((i * i + (i >> 8)) & 0xff);
+
+	printf("Computing SHA256 tree hashes...");
+	for (i = 0; i < sizeof(lens) / sizeof(lens[0]); i++) {
+		tree_reference(buf, lens[i], hbuf_ref);
+
+		/* All at once, with various numbers of threads. */
+		for (j = 0; j < sizeof(nthreads) / sizeof(nthreads[0]); j++) {
+			if (SHA256_Tree_Buf(buf, lens[i], hbuf, nthreads[j]) ||
+			    memcmp(hbuf, hbuf_ref, 32))
+				failures++;
+		}
+
+		/* In awkwardly sized pieces. */
+		SHA256_Tree_Init(&ctx);
+		for (pos = 0, n = 1; pos < lens[i]; pos += n, n = n * 3 + 1) {
+			if (n > lens[i] - pos)
+				n = lens[i] - pos;
+			if (SHA256_Tree_Update_parallel(&ctx, &buf[pos], n,
+			    (n & 1) ? 2 : 1))
+				failures++;
+		}
+		SHA256_Tree_Final(hbuf, &ctx);
+		if (memcmp(hbuf, hbuf_ref, 32))
+			failures++;
+	}
+	if (failures)
+		printf(" FAILED!\n");
+	else
+		printf(" PASSED!\n");
+
+	/* Clean up. */
+	free(buf);
+
+	return (failures);
+}
+
 static int
 selftest(void)
 {
 	SHA256_CTX ctx;
 	uint8_t hbuf[32];
+	uint8_t hbuf_pub[32];
 	char hbuf_hex[65];
+	uint8_t * buf;
 	size_t i;
 	size_t failures = 0;
 
@@ -157,6 +481,57 @@ selftest(void)
 		}
 	}
 
+	/* One million 'a's, mostly processed as many blocks at once. */
+	printf("Computing SHA256 of one million 'a's...");
+	if ((buf = malloc(1000000)) == NULL) {
+		warnp("malloc");
+		return (1);
+	}
+	memset(buf, 'a', 1000000);
+	SHA256_Init(&ctx);
+	SHA256_Update(&ctx, buf, 1);
+	SHA256_Update(&ctx, &buf[1], 999999);
+	SHA256_Final(hbuf, &ctx);
+	free(buf);
+	hexify(hbuf, hbuf_hex, 32);
+	if (strcmp(hbuf_hex, million_a_hex)) {
+		printf(" FAILED!\n");
+		printf("Computed SHA256: %s\n", hbuf_hex);
+		printf("Correct SHA256:  %s\n", million_a_hex);
+		failures++;
+	} else {
+		printf(" PASSED!\n");
+	}
+
+	/* A long message again, without clearing the stack. */
+	printf("Computing SHA256 of public data...");
+	SHA256_Init(&ctx);
+	SHA256_Update_public(&ctx, (const uint8_t *)tests[7].s, 3);
+	SHA256_Update_public(&ctx, (const uint8_t *)&tests[7].s[3],
+	    strlen(tests[7].s) - 3);
+	SHA256_Final_public(hbuf, &ctx);
+	hexify(hbuf, hbuf_hex, 32);
+	SHA256_Buf_public(tests[7].s, strlen(tests[7].s), hbuf_pub);
+	if (strcmp(hbuf_hex, tests[7].o) || memcmp(hbuf, hbuf_pub, 32)) {
+		printf(" FAILED!\n");
+		failures++;
+	} else {
+		printf(" PASSED!\n");
+	}
+
+	/* Many messages at once. */
+	failures += selftest_multi();
+
+	/* HMAC with precomputed keys. */
+	failures += selftest_hmac_prekeyed();
+
+	/* Key derivation. */
+	failures += selftest_pbkdf2();
+	failures += selftest_pbkdf2_parallel();
+
+	/* Tree hashing. */
+	failures += selftest_tree();
+
 	if (failures)
 		return (1);
 	else
@@ -168,6 +543,7 @@ usage(void)
 {
 
 	fprintf(stderr, "usage: test_sha256 -t\n");
+	fprintf(stderr, "       test_sha256 -p\n");
 	fprintf(stderr, "       test_sha256 -x\n");
 	exit(1);
 }
@@ -182,6 +558,8 @@ main(int argc, char * argv[])
 	/* Process arguments. */
 	while ((ch = GETOPT(argc, argv)) != NULL) {
 		GETOPT_SWITCH(ch) {
+		GETOPT_OPT("-p"):
+			exit(selftest_pbkdf2_first());
 		GETOPT_OPT("-t"):
 			exit(perftest());
 		GETOPT_OPT("-x"):
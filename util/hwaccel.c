@@ -0,0 +1,383 @@
+/* We use non-POSIX functionality in this file. */
+#undef _POSIX_C_SOURCE
+#undef _XOPEN_SOURCE
+
+/*
+ * A setuid or setgid program must not let the user who runs it choose which
+ * implementations it uses, since they differ in their side channels; so we
+ * ignore our environment variables in such programs.  Detecting this requires
+ * platform-specific code, which must come before the regular includes.
+ */
+#if defined(__linux__)
+/* secure_getenv() for Linux. */
+#define _GNU_SOURCE 1
+
+#include <stdlib.h>
+
+#define SECURE_GETENV
+
+#elif defined(__FreeBSD__) || defined(__NetBSD__) || defined(__OpenBSD__) || \
+    defined(__APPLE__)
+/* issetugid() for FreeBSD, NetBSD, OpenBSD, MacOS X. */
+#include <unistd.h>
+
+#define ISSETUGID
+
+#else
+/* Unknown OS; compare the real and effective IDs instead. */
+#include <unistd.h>
+
+#endif /* end includes for secure_getenv() / issetugid() */
+
+#include <sys/time.h>
+
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "monoclock.h"
+#include "warnp.h"
+
+#include "hwaccel.h"
+
+/* Maximum number of primitives we record, or have forced. */
+#define MAXPRIMS 16
+
+/* Time each implementation for at least this long, this many times. */
+#define MEASURE_MINTIME 0.001
+#define MEASURE_TRIALS 3
+
+/* Implementations chosen so far. */
+static struct hwaccel_choice chosen[MAXPRIMS];
+static size_t chosen_idx[MAXPRIMS];
+static size_t nchosen = 0;
+
+/* Implementations forced via hwaccel_force. */
+static struct {
+	const char * primitive;
+	const char * name;
+} forced[MAXPRIMS];
+static size_t nforced = 0;
+
+/* Are we timing implementations? */
+static int measuring = 0;
+
+/*
+ * Return the value of the environment variable ${name}, or NULL if it is not
+ * set or we are running with elevated privileges.
+ */
+static const char *
+getenv_unprivileged(const char * name)
+{
+
+#if defined(SECURE_GETENV)
+	return (secure_getenv(name));
+#elif defined(ISSETUGID)
+	if (issetugid())
+		return (NULL);
+	return (getenv(name));
+#else
+	if ((getuid() != geteuid()) || (getgid() != getegid()))
+		return (NULL);
+	return (getenv(name));
+#endif
+}
+
+/* Find the recorded choice for ${primitive}, or return NULL. */
+static const struct hwaccel_choice *
+lookup(const char * primitive, size_t * idx)
+{
+	size_t i;
+
+	for (i = 0; i < nchosen; i++) {
+		if (strcmp(chosen[i].primitive, primitive) == 0) {
+			*idx = chosen_idx[i];
+			return (&chosen[i]);
+		}
+	}
+
+	/* Not found. */
+	return (NULL);
+}
+
+/*
+ * Look for "${primitive}=name" in the comma-separated list ${s}, and if it
+ * is present, return the index of the implementation in ${C} with that name,
+ * or ${C}->n if there is no such implementation.  Return -1 if ${primitive}
+ * is not in the list.
+ */
+static int
+findenv(const struct hwaccel_choice * C, const char * s)
+{
+	size_t plen = strlen(C->primitive);
+	size_t nlen;
+	size_t i;
+
+	while (*s != '\0') {
+		/* Length of this name, if this entry is for our primitive. */
+		nlen = strcspn(s, ",");
+		if ((strncmp(s, C->primitive, plen) == 0) && (s[plen] == '=') &&
+		    (plen < nlen)) {
+			s += plen + 1;
+			nlen -= plen + 1;
+			for (i = 0; i < C->n; i++) {
+				if ((strncmp(C->names[i], s, nlen) == 0) &&
+				    (C->names[i][nlen] == '\0'))
+					break;
+			}
+			return ((int)i);
+		}
+
+		/* Move on to the next entry. */
+		s += nlen;
+		if (*s == ',')
+			s++;
+	}
+
+	/* Not found. */
+	return (-1);
+}
+
+/* Return the index of the implementation which has been forced, or -1. */
+static int
+findforced(const struct hwaccel_choice * C)
+{
+	const char * s;
+	size_t i, j;
+	int k;
+
+	/* Look for an implementation forced via the API. */
+	for (i = 0; i < nforced; i++) {
+		if (strcmp(forced[i].primitive, C->primitive))
+			continue;
+		for (j = 0; j < C->n; j++) {
+			if (strcmp(forced[i].name, C->names[j]) == 0)
+				return ((int)j);
+		}
+		warn0("Cannot use %s for %s", forced[i].name, C->primitive);
+		return (-1);
+	}
+
+	/* Look for an implementation forced via the environment. */
+	if ((s = getenv_unprivileged("LIBCPERCIVA_HWACCEL")) == NULL)
+		return (-1);
+	if ((k = findenv(C, s)) == (int)C->n) {
+		warn0("Cannot use requested implementation for %s",
+		    C->primitive);
+		return (-1);
+	}
+	return (k);
+}
+
+/* Should we time the implementations? */
+static int
+measurewanted(void)
+{
+	const char * s;
+
+	if (measuring)
+		return (1);
+	s = getenv_unprivileged("LIBCPERCIVA_HWACCEL_MEASURE");
+	return ((s != NULL) && (*s != '\0'));
+}
+
+/* Return the time taken per call to ${bench}(${id}), or -1 on error. */
+static double
+measure(void (* bench)(int), int id)
+{
+	struct timeval begin, end;
+	double t, best = -1;
+	size_t n;
+	int i;
+
+	for (i = 0; i < MEASURE_TRIALS; i++) {
+		if (monoclock_get(&begin))
+			goto err0;
+		n = 0;
+		do {
+			bench(id);
+			n++;
+			if (monoclock_get(&end))
+				goto err0;
+		} while ((t = timeval_diff(begin, end)) < MEASURE_MINTIME);
+		t /= (double)n;
+		if ((best < 0) || (t < best))
+			best = t;
+	}
+
+	/* Success! */
+	return (best);
+
+err0:
+	/* Failure! */
+	warnp("monoclock_get");
+	return (-1);
+}
+
+/* Return the index of the fastest implementation in ${C}. */
+static size_t
+fastest(const struct hwaccel_choice * C, void (* bench)(int))
+{
+	double t, best = -1;
+	size_t i, besti = 0;
+
+	for (i = 0; i < C->n; i++) {
+		if ((t = measure(bench, C->ids[i])) < 0)
+			return (0);
+		if ((best < 0) || (t < best)) {
+			best = t;
+			besti = i;
+		}
+	}
+
+	return (besti);
+}
+
+/**
+ * hwaccel_begin(C, primitive):
+ * Start choosing an implementation of ${primitive}, whose name must be a
+ * string which remains valid for the lifetime of the program.
+ */
+void
+hwaccel_begin(struct hwaccel_choice * C, const char * primitive)
+{
+
+	C->primitive = primitive;
+	C->n = 0;
+}
+
+/**
+ * hwaccel_offer(C, id, name):
+ * Offer the implementation ${id} named ${name} to the choice ${C}.
+ * Implementations must be offered in decreasing order of preference, and
+ * their names must remain valid for the lifetime of the program.
+ */
+void
+hwaccel_offer(struct hwaccel_choice * C, int id, const char * name)
+{
+
+	/* Ignore implementations we have no room for. */
+	if (C->n == HWACCEL_MAXIMPLS)
+		return;
+
+	C->ids[C->n] = id;
+	C->names[C->n] = name;
+	C->n++;
+}
+
+/**
+ * hwaccel_choose(C, bench):
+ * Choose one of the implementations offered to ${C}, and record the choice.
+ * If implementations are being measured, call ${bench}(id) repeatedly to
+ * time each implementation ${id}; ${bench} may be NULL if the primitive
+ * cannot be timed.  Return the ${id} of the chosen implementation.
+ */
+int
+hwaccel_choose(struct hwaccel_choice * C, void (* bench)(int))
+{
+	size_t i;
+	int k;
+
+	/* Sanity-check: There must be at least one implementation. */
+	if (C->n == 0) {
+		warn0("No implementations of %s", C->primitive);
+		abort();
+	}
+
+	/* Use a forced implementation, or time them, or use the first. */
+	if ((k = findforced(C)) >= 0)
+		i = (size_t)k;
+	else if (measurewanted() && (bench != NULL) && (C->n > 1))
+		i = fastest(C, bench);
+	else
+		i = 0;
+
+	/* Record the choice, if we have room. */
+	if (nchosen < MAXPRIMS) {
+		memcpy(&chosen[nchosen], C, sizeof(struct hwaccel_choice));
+		chosen_idx[nchosen] = i;
+		nchosen++;
+	}
+
+	return (C->ids[i]);
+}
+
+/**
+ * hwaccel_force(primitive, name):
+ * Use the implementation named ${name} for ${primitive} if it is usable,
+ * overriding the LIBCPERCIVA_HWACCEL environment variable.  This must be
+ * called before ${primitive} is first used, and the strings must remain valid
+ * until then.  Return 0 on success, or -1 if too many implementations have
+ * been forced.
+ */
+int
+hwaccel_force(const char * primitive, const char * name)
+{
+	size_t i;
+
+	/* Replace an earlier request for the same primitive. */
+	for (i = 0; i < nforced; i++) {
+		if (strcmp(forced[i].primitive, primitive) == 0)
+			break;
+	}
+	if (i == MAXPRIMS) {
+		warn0("Too many hardware acceleration overrides");
+		goto err0;
+	}
+	forced[i].primitive = primitive;
+	forced[i].name = name;
+	if (i == nforced)
+		nforced++;
+
+	/* Success! */
+	return (0);
+
+err0:
+	/* Failure! */
+	return (-1);
+}
+
+/**
+ * hwaccel_measure(void):
+ * Time each implementation of primitives which are used after this point,
+ * and use the fastest.
+ */
+void
+hwaccel_measure(void)
+{
+
+	measuring = 1;
+}
+
+/**
+ * hwaccel_selected(primitive):
+ * Return the name of the implementation chosen for ${primitive}, or NULL if
+ * ${primitive} has not been used yet.
+ */
+const char *
+hwaccel_selected(const char * primitive)
+{
+	const struct hwaccel_choice * C;
+	size_t idx;
+
+	if ((C = lookup(primitive, &idx)) == NULL)
+		return (NULL);
+	return (C->names[idx]);
+}
+
+/**
+ * hwaccel_candidate(primitive, i):
+ * Return the name of the ${i}th (counting from zero) usable implementation of
+ * ${primitive}, or NULL if there are no more or ${primitive} has not been
+ * used yet.
+ */
+const char *
+hwaccel_candidate(const char * primitive, size_t i)
+{
+	const struct hwaccel_choice * C;
+	size_t idx;
+
+	if (((C = lookup(primitive, &idx)) == NULL) || (i >= C->n))
+		return (NULL);
+	return (C->names[i]);
+}
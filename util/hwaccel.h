@@ -0,0 +1,111 @@
+#ifndef _HWACCEL_H_
+#define _HWACCEL_H_
+
+#include <stddef.h>
+
+/**
+ * Registry of hardware-accelerated implementations.  Modules which choose
+ * between several implementations of a primitive at run time offer each
+ * usable implementation in decreasing order of preference, and then let the
+ * registry choose between them.  The registry normally picks the first
+ * (i.e., most preferred) implementation; but an implementation may be forced
+ * via hwaccel_force() or the LIBCPERCIVA_HWACCEL environment variable (e.g.,
+ * "sha256=software,crc32c=x86-crc32"), and if hwaccel_measure() has been
+ * called or the LIBCPERCIVA_HWACCEL_MEASURE environment variable is set to a
+ * non-empty value, each implementation is timed and the fastest is picked.
+ *
+ * The environment variables are ignored in setuid and setgid programs, so
+ * that users cannot choose which implementations a privileged program uses.
+ *
+ * An implementation is chosen for each primitive the first time that
+ * primitive is used; forcing an implementation has no effect on primitives
+ * which have already been used.  Like the modules using it, this code is not
+ * thread-safe; primitives should be used once before starting threads.
+ */
+
+/* Maximum number of implementations of a primitive. */
+#define HWACCEL_MAXIMPLS 8
+
+/* Implementations of a primitive offered so far. */
+struct hwaccel_choice {
+	const char * primitive;
+	size_t n;
+	int ids[HWACCEL_MAXIMPLS];
+	const char * names[HWACCEL_MAXIMPLS];
+};
+
+/**
+ * HWACCEL_OFFER(C, id, name, cpusupport_checks, check):
+ * If the ${cpusupport_checks} pass and ${check} is zero, offer the
+ * implementation ${id} named ${name} to the choice ${C}.  If the
+ * ${cpusupport_checks} pass but the ${check} is non-zero, produce a warning
+ * which includes a stringified ${id}.
+ */
+#define HWACCEL_OFFER(C, id, name, cpusupport_checks, check) do {	\
+	if ((cpusupport_checks)) {					\
+		if ((check) == 0) {					\
+			hwaccel_offer((C), (id), (name));		\
+		} else {						\
+			warn0("Disabling " #id				\
+			    " due to failed self-test");		\
+		}							\
+	}								\
+} while (0)
+
+/**
+ * hwaccel_begin(C, primitive):
+ * Start choosing an implementation of ${primitive}, whose name must be a
+ * string which remains valid for the lifetime of the program.
+ */
+void hwaccel_begin(struct hwaccel_choice *, const char *);
+
+/**
+ * hwaccel_offer(C, id, name):
+ * Offer the implementation ${id} named ${name} to the choice ${C}.
+ * Implementations must be offered in decreasing order of preference, and
+ * their names must remain valid for the lifetime of the program.
+ */
+void hwaccel_offer(struct hwaccel_choice *, int, const char *);
+
+/**
+ * hwaccel_choose(C, bench):
+ * Choose one of the implementations offered to ${C}, and record the choice.
+ * If implementations are being measured, call ${bench}(id) repeatedly to
+ * time each implementation ${id}; ${bench} may be NULL if the primitive
+ * cannot be timed.  Return the ${id} of the chosen implementation.
+ */
+int hwaccel_choose(struct hwaccel_choice *, void (*)(int));
+
+/**
+ * hwaccel_force(primitive, name):
+ * Use the implementation named ${name} for ${primitive} if it is usable,
+ * overriding the LIBCPERCIVA_HWACCEL environment variable.  This must be
+ * called before ${primitive} is first used, and the strings must remain valid
+ * until then.  Return 0 on success, or -1 if too many implementations have
+ * been forced.
+ */
+int hwaccel_force(const char *, const char *);
+
+/**
+ * hwaccel_measure(void):
+ * Time each implementation of primitives which are used after this point,
+ * and use the fastest.
+ */
+void hwaccel_measure(void);
+
+/**
+ * hwaccel_selected(primitive):
+ * Return the name of the implementation chosen for ${primitive}, or NULL if
+ * ${primitive} has not been used yet.
+ */
+const char * hwaccel_selected(const char *);
+
+/**
+ * hwaccel_candidate(primitive, i):
+ * Return the name of the ${i}th (counting from zero) usable implementation of
+ * ${primitive}, or NULL if there are no more or ${primitive} has not been
+ * used yet.
+ */
+const char * hwaccel_candidate(const char *, size_t);
+
+#endif /* !_HWACCEL_H_ */
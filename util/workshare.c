@@ -0,0 +1,83 @@
+#include <pthread.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "warnp.h"
+
+#include "workshare.h"
+
+/**
+ * workshare_len(n, nshares, i):
+ * Return the number of items which share ${i} gets when ${n} items of work
+ * are divided as evenly as possible into ${nshares} shares, with any extra
+ * items going to the first shares.
+ */
+size_t
+workshare_len(size_t n, size_t nshares, size_t i)
+{
+
+	return (n / nshares + ((i < n % nshares) ? 1 : 0));
+}
+
+/**
+ * workshare_run(func, shares, sharelen, nshares):
+ * Call ${func}(S) for each of the ${nshares} elements S of the array
+ * ${shares}, each of which is ${sharelen} bytes long.  The first share is run
+ * in the calling thread and each of the others in a thread of its own; if
+ * threads cannot be started, the calling thread runs the remaining shares
+ * itself.  Return 0 on success or -1 on error; after an error, threads might
+ * still be running, so ${shares} and anything they use must not be freed.
+ */
+int
+workshare_run(void * (* func)(void *), void * shares, size_t sharelen,
+    size_t nshares)
+{
+	uint8_t * S = shares;
+	pthread_t * thr = NULL;
+	size_t i;
+	size_t nstarted;
+	int rc;
+
+	/* Nothing to do? */
+	if (nshares == 0)
+		return (0);
+
+	/* Allocate space to keep track of the threads. */
+	if (nshares > 1) {
+		if ((thr = malloc((nshares - 1) * sizeof(pthread_t))) == NULL)
+			warnp("malloc");
+	}
+
+	/* Start threads for all but the first share, if we can. */
+	for (nstarted = 1; (thr != NULL) && (nstarted < nshares); nstarted++) {
+		if ((rc = pthread_create(&thr[nstarted - 1], NULL, func,
+		    &S[nstarted * sharelen])) != 0) {
+			warn0("pthread_create: %s", strerror(rc));
+			break;
+		}
+	}
+
+	/* Do the first share ourselves, then wait for the others. */
+	func(&S[0]);
+	for (i = 1; i < nstarted; i++) {
+		if ((rc = pthread_join(thr[i - 1], NULL)) != 0) {
+			/* The thread might still be running; leak its state. */
+			warn0("pthread_join: %s", strerror(rc));
+			goto err0;
+		}
+	}
+	free(thr);
+
+	/* If we couldn't start all the threads, finish their work here. */
+	for (i = nstarted; i < nshares; i++)
+		func(&S[i * sharelen]);
+
+	/* Success! */
+	return (0);
+
+err0:
+	/* Failure! */
+	return (-1);
+}
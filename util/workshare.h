@@ -0,0 +1,25 @@
+#ifndef _WORKSHARE_H_
+#define _WORKSHARE_H_
+
+#include <stddef.h>
+
+/**
+ * workshare_len(n, nshares, i):
+ * Return the number of items which share ${i} gets when ${n} items of work
+ * are divided as evenly as possible into ${nshares} shares, with any extra
+ * items going to the first shares.
+ */
+size_t workshare_len(size_t, size_t, size_t);
+
+/**
+ * workshare_run(func, shares, sharelen, nshares):
+ * Call ${func}(S) for each of the ${nshares} elements S of the array
+ * ${shares}, each of which is ${sharelen} bytes long.  The first share is run
+ * in the calling thread and each of the others in a thread of its own; if
+ * threads cannot be started, the calling thread runs the remaining shares
+ * itself.  Return 0 on success or -1 on error; after an error, threads might
+ * still be running, so ${shares} and anything they use must not be freed.
+ */
+int workshare_run(void * (*)(void *), void *, size_t, size_t);
+
+#endif /* !_WORKSHARE_H_ */